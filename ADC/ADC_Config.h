@@ -20,6 +20,12 @@
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL MACROS
 ---------------------------------------------------------------------------------------------------------------------*/
+/*Ratiometric conversion constants (datasheet typical values), the temperature table in ADC_program.c
+*is generated from ADC_VDDA_NOMINAL_MV, ADC_TS_V25_MV and ADC_TS_AVG_SLOPE_UV; regenerate it when these change*/
+#define ADC_VREFINT_MV              (1200)      /*internal reference voltage in mV*/
+#define ADC_VDDA_NOMINAL_MV         (3300)      /*supply the corrected codes are referred to*/
+#define ADC_TS_V25_MV               (1430)      /*temperature sensor voltage at 25 C in mV*/
+#define ADC_TS_AVG_SLOPE_UV         (4300)      /*temperature sensor slope in uV/C*/
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL DATA
 ---------------------------------------------------------------------------------------------------------------------*/
@@ -57,6 +57,10 @@
 #define ADC_CH17              (0b100000000000000000)
 #define ADC_CH18              (0b1000000000000000000)
 
+/** @defgroup InternalChannels_t channel numbers of the internal inputs for @ref MADC_VoidConfigureChannel */
+#define ADC_CHANNEL_TEMPSENSOR      (16)/*!< temperature sensor  */
+#define ADC_CHANNEL_VREFINT         (17)/*!< internal reference voltage  */
+
 
 
 
@@ -161,6 +165,17 @@ typedef struct
                                                     *this parameter can be a value of @ref ADC_Trigger_t*/
 } ADC_GroupTypeDef;
 
+/**
+  * @brief  ratiometric correction computed from the latest VREFINT sample of a scan
+  */
+typedef struct
+{
+    uint32 GainQ16;                                 /*!< factor referring raw codes to ADC_VDDA_NOMINAL_MV, 1.0 = 65536 */
+    uint32 MvPerCodeQ16;                            /*!< millivolts per raw code at the measured VDDA in Q16 */
+    uint16 VddaMv;                                  /*!< measured analog supply in mV */
+    uint16 VrefintRaw;                              /*!< VREFINT raw code the correction was computed from */
+} ADC_Ratiometric_t;
+
 
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL FUNCTIONS
@@ -184,7 +199,7 @@ void MADC_VoidStartConversion(ADC_Trigger_t ADC_Triggertype);
 * @brief           : Configure the conversion on the regular channel  
 * @param (in)      : @ref Channels_t u8ChannelNumber  channel number to configure and start conversion.
 * @param (in)      : @ref samplingTime_t u8sampplingTime  channel number to configure and start conversion.
-* @param (in)      : u8Rank rank (order) of the channel conversion in regular group value from 0 -16
+* @param (in)      : u8Rank rank (order) of the channel conversion in regular group value from 1 -16, 0 for the rank after the last one given by 0
 * @retval          : void
 *******************************************************************************/
 void MADC_VoidConfigureChannel(uint8 u8ChannelNumber,uint8 u8samplingTime,uint8 u8Rank);
@@ -225,5 +240,49 @@ void MADC_VoidPollOnConversion(void) ;
 *******************************************************************************/
 uint16 MADC_VoidGetConversionData(void) ;
 
+/******************************************************************************
+* @brief           : update the VDDA correction from a VREFINT (channel 17) sample,
+*                    called once per scan, the only place with a division
+* @param (out)     : pRatio correction to update @ref ADC_Ratiometric_t
+* @param (in)      : u16VrefintRaw raw VREFINT code
+* @retval          : Std_ReturnType N_OK when the sample is zero (correction unchanged)
+*******************************************************************************/
+Std_ReturnType MADC_u8RatiometricUpdate(ADC_Ratiometric_t* pRatio,uint16 u16VrefintRaw);
+
+/******************************************************************************
+* @brief           : correct a raw code for the actual VDDA (code the same input gives at ADC_VDDA_NOMINAL_MV)
+* @param (in)      : pRatio correction @ref ADC_Ratiometric_t
+* @param (in)      : u16Raw raw code
+* @retval          : uint16 corrected code, saturated to 12 bits
+*******************************************************************************/
+uint16 MADC_u16RatiometricCorrect(const ADC_Ratiometric_t* pRatio,uint16 u16Raw);
+
+/******************************************************************************
+* @brief           : correct a whole scan buffer in place, the VREFINT sample of the scan
+*                    updates the correction first and is left unchanged
+* @param (in/out)  : pRatio correction @ref ADC_Ratiometric_t
+* @param (in/out)  : pScan raw samples in rank order (e.g. the DMA buffer)
+* @param (in)      : u8Count number of samples in the scan
+* @param (in)      : u8VrefintIndex index of the VREFINT sample in the scan
+* @retval          : void
+*******************************************************************************/
+void MADC_VoidRatiometricScan(ADC_Ratiometric_t* pRatio,uint16* pScan,uint8 u8Count,uint8 u8VrefintIndex);
+
+/******************************************************************************
+* @brief           : convert a raw code to millivolts at the measured VDDA
+* @param (in)      : pRatio correction @ref ADC_Ratiometric_t
+* @param (in)      : u16Raw raw code
+* @retval          : uint16 input voltage in mV
+*******************************************************************************/
+uint16 MADC_u16ToMillivolts(const ADC_Ratiometric_t* pRatio,uint16 u16Raw);
+
+/******************************************************************************
+* @brief           : convert a temperature sensor (channel 16) code to centi degrees using the
+*                    lookup table with linear interpolation (no division, no float)
+* @param (in)      : u16CorrectedRaw sensor code already corrected by @ref MADC_u16RatiometricCorrect
+* @retval          : sint16 temperature in 0.01 C, clamped to the table range
+*******************************************************************************/
+sint16 MADC_s16TempCentiDegrees(uint16 u16CorrectedRaw);
+
 
 #endif
@@ -193,4 +193,15 @@ typedef struct
 
 #define 	ADC 		((volatile ADC_t *) ADC_Base_Address)
 
+/*full scale code of the 12 bit converter*/
+#define     ADC_FULL_SCALE              (4095)
+
+/*VREFINT code expected when VDDA equals ADC_VDDA_NOMINAL_MV, in Q16 (1489.09 * 65536)*/
+#define     ADC_VREFINT_NOMINAL_Q16     ((uint32)(((uint64)ADC_VREFINT_MV * ADC_FULL_SCALE << 16) / ADC_VDDA_NOMINAL_MV))
+
+/*temperature table: corrected sensor code ADC_TS_LUT_FIRST + i * 2^ADC_TS_LUT_SHIFT -> centi degrees*/
+#define     ADC_TS_LUT_FIRST            (1216)
+#define     ADC_TS_LUT_SHIFT            (5)
+#define     ADC_TS_LUT_SIZE             (31)
+
 #endif
\ No newline at end of file
@@ -25,6 +25,19 @@
 #include "../RCC/RCC_interface.h"
 #include "../AFIO/AFIO_interface.h"
 #include "../GPIO/GPIO_interface.h"
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA
+---------------------------------------------------------------------------------------------------------------------*/
+/*temperature in 0.01 C for corrected sensor codes ADC_TS_LUT_FIRST + i*32 (-50 C .. 130 C),
+*T = 25 + (V25 - code*VDDA/4095) / Avg_Slope evaluated offline; replace with a calibrated table per board if needed*/
+static const sint16 ADC_TempCentiLut[ADC_TS_LUT_SIZE] =
+{
+    12967, 12367, 11767, 11168, 10568,  9968,  9369,  8769,  8169,  7569,
+     6970,  6370,  5770,  5171,  4571,  3971,  3371,  2772,  2172,  1572,
+      973,   373,  -227,  -827, -1426, -2026, -2626, -3225, -3825, -4425,
+    -5024
+};
+
 /*---------------------------------------------------------------------------------------------------------------------
  *  Global Variables
 ---------------------------------------------------------------------------------------------------------------------*/
@@ -112,15 +125,16 @@ void MADC_VoidInit(const ADC_InitTypeDef* pInitConfig)
 * @brief           : Configure the conversion on the regular channel  
 * @param (in)      : -@ref Channels_t u8ChannelNumber  channel number to configure and start conversion.
 * @param (in)      : -@ref samplingTime_t u8sampplingTime  channel number to configure and start conversion.
-* @param (in)      : u8Rank rank (order) of the channel conversion in regular group value from 0 -16
+* @param (in)      : u8Rank rank (order) of the channel conversion in regular group value from 1 -16, 0 for the rank after the last one given by 0
 * @retval          : void
 *******************************************************************************/
 void MADC_VoidConfigureChannel(uint8 u8ChannelNumber,uint8 u8samplingTime,uint8 u8Rank)
 {
-    static uint8 local_u8Rank=0;/*to be used if rank is not provided*/
+    static uint8 local_u8Rank=1;/*to be used if rank is not provided*/
     uint8 local_u8UsedRank;
+    uint8 local_u8Shift;
     /*set the ranking of channel*/
-    if(u8Rank>=0)/*provided*/
+    if(u8Rank!=0)/*provided*/
     {
         local_u8UsedRank=u8Rank;
     }
@@ -130,23 +144,25 @@ void MADC_VoidConfigureChannel(uint8 u8ChannelNumber,uint8 u8samplingTime,uint8
         /*not provided*/
         local_u8Rank++;
     }
-    /*set rank of channel (specify the order of conversion for this channel)*/
-    if(local_u8UsedRank <=6)
+    /*set rank of channel (specify the order of conversion for this channel): 5 bits per rank from bit 0,
+      SQ1-SQ6 in SQR3, SQ7-SQ12 in SQR2, SQ13-SQ16 in SQR1*/
+    if(local_u8UsedRank>=1 && local_u8UsedRank<=6)
     {
-        ADC->SQR3.r &= ~((0b11111)<<(local_u8UsedRank*5));//clear the channel sample time section
-        ADC->SQR3.r |= ((u8ChannelNumber)<<(local_u8UsedRank*3));//clear the channel sample time section
+        local_u8Shift=(local_u8UsedRank-1)*5;
+        ADC->SQR3.r &= ~((uint32)0b11111<<local_u8Shift);//clear the rank section
+        ADC->SQR3.r |= ((uint32)u8ChannelNumber<<local_u8Shift);//channel converted at this rank
     }
     else if(local_u8UsedRank>6 &&local_u8UsedRank<=12)
     {
-        local_u8UsedRank-=6;
-        ADC->SQR2.r &= ~((0b11111)<<(local_u8UsedRank*5));//clear the channel sample time section
-        ADC->SQR2.r |= ((u8ChannelNumber)<<(local_u8UsedRank*3));//clear the channel sample time section
+        local_u8Shift=(local_u8UsedRank-7)*5;
+        ADC->SQR2.r &= ~((uint32)0b11111<<local_u8Shift);//clear the rank section
+        ADC->SQR2.r |= ((uint32)u8ChannelNumber<<local_u8Shift);//channel converted at this rank
     }
     else if(local_u8UsedRank>12 &&local_u8UsedRank<=16)
     {
-        local_u8UsedRank-=12;
-        ADC->SQR1.r &= ~((0b11111)<<(local_u8UsedRank*5));//clear the channel sample time section
-        ADC->SQR1.r |= ((u8ChannelNumber)<<(local_u8UsedRank*3));//clear the channel sample time section
+        local_u8Shift=(local_u8UsedRank-13)*5;
+        ADC->SQR1.r &= ~((uint32)0b11111<<local_u8Shift);//clear the rank section
+        ADC->SQR1.r |= ((uint32)u8ChannelNumber<<local_u8Shift);//channel converted at this rank
     }
     else{}
 
@@ -156,15 +172,15 @@ void MADC_VoidConfigureChannel(uint8 u8ChannelNumber,uint8 u8samplingTime,uint8
         ADC->SMPR2 &= ~((0b111)<<(u8ChannelNumber*3));//clear the channel sample time section
         ADC->SMPR2 |= ((u8samplingTime)<<(u8ChannelNumber*3));//clear the channel sample time section
     }
-    else if(u8ChannelNumber>9 &&u8ChannelNumber<16)
+    else if(u8ChannelNumber>9 &&u8ChannelNumber<ADC_CHANNEL_TEMPSENSOR)
     {
-        u8ChannelNumber-=9;
+        u8ChannelNumber-=10;/*SMPR1 starts at channel 10*/
         ADC->SMPR1 &= ~((0b111)<<(u8ChannelNumber*3));//clear the channel sample time section
         ADC->SMPR1 |= ((u8samplingTime)<<(u8ChannelNumber*3));//clear the channel sample time section
     }
-    else if(u8ChannelNumber==16)//internal tempsensor
+    else if(u8ChannelNumber==ADC_CHANNEL_TEMPSENSOR || u8ChannelNumber==ADC_CHANNEL_VREFINT)//internal tempsensor / VREFINT
     {
-        u8ChannelNumber-=9;
+        u8ChannelNumber-=10;
         //set TSVREFE bit
         ADC->CR2.B.TSVREFE=1;
         /*sampling time 17.1 us , freq=4MHZ after prescaler then cycle time 1/4us 71.5 cycles = 17.8us close to 17.1us*/
@@ -238,4 +254,107 @@ void MADC_VoidPollOnConversion(void)
 uint16 MADC_VoidGetConversionData(void)
 {
     return ADC->DR.B.REGULARDATA;
-}
\ No newline at end of file
+}
+
+/******************************************************************************
+* @brief           : update the VDDA correction from a VREFINT (channel 17) sample,
+*                    called once per scan, the only place with a division
+* @param (out)     : pRatio correction to update @ref ADC_Ratiometric_t
+* @param (in)      : u16VrefintRaw raw VREFINT code
+* @retval          : Std_ReturnType N_OK when the sample is zero (correction unchanged)
+*******************************************************************************/
+Std_ReturnType MADC_u8RatiometricUpdate(ADC_Ratiometric_t* pRatio,uint16 u16VrefintRaw)
+{
+    if(u16VrefintRaw == 0)
+    {
+        return N_OK;
+    }
+    /*VDDA = VREFINT * 4095 / raw: the same ratio gives the gain to the nominal supply*/
+    pRatio->GainQ16 = ADC_VREFINT_NOMINAL_Q16 / u16VrefintRaw;
+    pRatio->MvPerCodeQ16 = ((uint32)ADC_VREFINT_MV << 16) / u16VrefintRaw;
+    pRatio->VddaMv = (uint16)((pRatio->GainQ16 * ADC_VDDA_NOMINAL_MV) >> 16);
+    pRatio->VrefintRaw = u16VrefintRaw;
+    return OK;
+}
+
+/******************************************************************************
+* @brief           : correct a raw code for the actual VDDA (code the same input gives at ADC_VDDA_NOMINAL_MV)
+* @param (in)      : pRatio correction @ref ADC_Ratiometric_t
+* @param (in)      : u16Raw raw code
+* @retval          : uint16 corrected code, saturated to 12 bits
+*******************************************************************************/
+uint16 MADC_u16RatiometricCorrect(const ADC_Ratiometric_t* pRatio,uint16 u16Raw)
+{
+    uint32 Local_u32Code = ((uint32)u16Raw * pRatio->GainQ16 + 0x8000) >> 16;
+    if(Local_u32Code > ADC_FULL_SCALE)
+    {
+        Local_u32Code = ADC_FULL_SCALE;
+    }
+    return (uint16)Local_u32Code;
+}
+
+/******************************************************************************
+* @brief           : correct a whole scan buffer in place, the VREFINT sample of the scan
+*                    updates the correction first and is left unchanged
+* @param (in/out)  : pRatio correction @ref ADC_Ratiometric_t
+* @param (in/out)  : pScan raw samples in rank order (e.g. the DMA buffer)
+* @param (in)      : u8Count number of samples in the scan
+* @param (in)      : u8VrefintIndex index of the VREFINT sample in the scan
+* @retval          : void
+*******************************************************************************/
+void MADC_VoidRatiometricScan(ADC_Ratiometric_t* pRatio,uint16* pScan,uint8 u8Count,uint8 u8VrefintIndex)
+{
+    uint8 Local_u8Itr;
+    if(u8VrefintIndex < u8Count)
+    {
+        /*a zero sample keeps the previous correction*/
+        MADC_u8RatiometricUpdate(pRatio,pScan[u8VrefintIndex]);
+    }
+    for(Local_u8Itr=0;Local_u8Itr<u8Count;Local_u8Itr++)
+    {
+        if(Local_u8Itr != u8VrefintIndex)
+        {
+            pScan[Local_u8Itr] = MADC_u16RatiometricCorrect(pRatio,pScan[Local_u8Itr]);
+        }
+    }
+}
+
+/******************************************************************************
+* @brief           : convert a raw code to millivolts at the measured VDDA
+* @param (in)      : pRatio correction @ref ADC_Ratiometric_t
+* @param (in)      : u16Raw raw code
+* @retval          : uint16 input voltage in mV
+*******************************************************************************/
+uint16 MADC_u16ToMillivolts(const ADC_Ratiometric_t* pRatio,uint16 u16Raw)
+{
+    return (uint16)(((uint32)u16Raw * pRatio->MvPerCodeQ16 + 0x8000) >> 16);
+}
+
+/******************************************************************************
+* @brief           : convert a temperature sensor (channel 16) code to centi degrees using the
+*                    lookup table with linear interpolation (no division, no float)
+* @param (in)      : u16CorrectedRaw sensor code already corrected by @ref MADC_u16RatiometricCorrect
+* @retval          : sint16 temperature in 0.01 C, clamped to the table range
+*******************************************************************************/
+sint16 MADC_s16TempCentiDegrees(uint16 u16CorrectedRaw)
+{
+    uint16 Local_u16Offset;
+    uint16 Local_u16Index;
+    sint32 Local_s32Frac;
+    sint32 Local_s32Span;
+
+    if(u16CorrectedRaw <= ADC_TS_LUT_FIRST)
+    {
+        return ADC_TempCentiLut[0];
+    }
+    Local_u16Offset = u16CorrectedRaw - ADC_TS_LUT_FIRST;
+    Local_u16Index = Local_u16Offset >> ADC_TS_LUT_SHIFT;
+    if(Local_u16Index >= (ADC_TS_LUT_SIZE - 1))
+    {
+        return ADC_TempCentiLut[ADC_TS_LUT_SIZE - 1];
+    }
+    /*interpolate between the two neighbouring entries, the step is a power of two*/
+    Local_s32Frac = Local_u16Offset & ((1 << ADC_TS_LUT_SHIFT) - 1);
+    Local_s32Span = (sint32)ADC_TempCentiLut[Local_u16Index + 1] - ADC_TempCentiLut[Local_u16Index];
+    return (sint16)(ADC_TempCentiLut[Local_u16Index] + ((Local_s32Span * Local_s32Frac) >> ADC_TS_LUT_SHIFT));
+}
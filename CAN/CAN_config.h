@@ -41,6 +41,32 @@
  * 					 CAN_1MBPS
  	 	 	 	 	 	 	 	 	 	 	 	 *************************/
 #define BAUDRATE		CAN_1Mbps
+
+/*sample point the bit timing is solved for, in 1/1000 of the bit (CiA recommends 875)*/
+#define CAN_SAMPLE_POINT_PERMILLE       (875)
+
+/*largest bit rate error accepted from the solver in ppm, otherwise the fixed 8 MHz table is used*/
+#define CAN_BIT_TIMING_MAX_ERROR_PPM    (5000)
+
+/*number of frames the software TX queue holds behind the 3 hardware mailboxes (up to 252, the queue keeps
+  3 more slots for the frames the mailboxes give back)*/
+#define CAN_TX_QUEUE_SIZE       (32)
+
+/*frames each RX ring holds (per FIFO), must be a power of two*/
+#define CAN_RX_RING_SIZE        (64)
+
+/*largest number of id/mask terms the filter compiler works on (ranges expand to several terms)*/
+#define CAN_FILTER_MAX_TERMS    (64)
+
+/*bus-off recovery (MCAN_VoidSetRecoveryMode): period of the MCAN_VoidRecoveryTick calls in ms*/
+#define CAN_RECOVERY_TICK_MS            (1)
+/*CAN_RECOVERY_BACKOFF: the first bus-off is left at once, each following one waits twice longer,
+*from MIN up to MAX, before the re-init. STABLE ms without bus-off restart at once*/
+#define CAN_BUSOFF_BACKOFF_MIN_MS       (10)
+#define CAN_BUSOFF_BACKOFF_MAX_MS       (1000)
+#define CAN_BUSOFF_STABLE_MS            (5000)
+/*bus-off episodes kept for MCAN_u8GetBusOffEpisodes (latest ones)*/
+#define CAN_BUSOFF_EPISODES             (8)
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL DATA
 ---------------------------------------------------------------------------------------------------------------------*/
@@ -48,7 +74,8 @@
 /******** BoudRate value rating to table at web site {http://www.bittiming.can-wiki.info/}
  * 1. select ST Microelectronics bxCAN
  * 2. put freq with 8Mhz (APB1 freq)
- * 3. click Request Table						        ***********************************/
+ * 3. click Request Table
+ * MCAN_VoidInit now solves the timing from the real APB1 clock, this table is only the fallback ***********/
 // CAN_BitTimingConfig CAN_bitRateConfig[7] = {{2, 13, 10}, {2, 13, 5}, {2, 13, 4}, {2, 13, 2}, {2, 13, 1},{1, 8, 1}, {1, 6, 1}};
 
 
@@ -36,6 +36,101 @@
 #define CAN_RX_FIFO0                (0x0)  /*!< CAN receive FIFO 0 */
 #define CAN_RX_FIFO1                (0x1)  /*!< CAN receive FIFO 1 */
 
+/** @defgroup CAN_filter_banks number of filter banks of the (single CAN) STM32F103 **/
+#define CAN_FILTER_BANKS            (14)
+/** @defgroup CAN_filter_numbers a bank holds up to 4 filters (16-bit list), the FMI of a FIFO counts them in bank order **/
+#define CAN_FILTERS_PER_BANK        (4)
+#define CAN_FMI_MAX                 (CAN_FILTER_BANKS * CAN_FILTERS_PER_BANK)
+
+/** @defgroup CAN_filter_encoding filter register words for data frames, usable in static const tables **/
+/*32-bit scale: STID[10:0]/EXID[28:18] | EXID[17:0] | IDE | RTR | 0*/
+#define CAN_FILTER32_STD(ID)                ((uint32)(ID) << 21)
+#define CAN_FILTER32_EXT(ID)                (((uint32)(ID) << 3) | ((uint32)1 << 2))
+/*32-bit masks also compare IDE and RTR so a filter only accepts its own frame format*/
+#define CAN_FILTER32_STD_MASK(MASK)         (((uint32)(MASK) << 21) | ((uint32)1 << 2) | ((uint32)1 << 1))
+#define CAN_FILTER32_EXT_MASK(MASK)         (((uint32)(MASK) << 3) | ((uint32)1 << 2) | ((uint32)1 << 1))
+/*16-bit scale: STID[10:0] | RTR | IDE | EXID[17:15]*/
+#define CAN_FILTER16_STD(ID)                ((uint32)(ID) << 5)
+#define CAN_FILTER16_STD_MASK(MASK)         (((uint32)(MASK) << 5) | ((uint32)1 << 4) | ((uint32)1 << 3))
+
+/** @defgroup CAN_filter_bank_images initializers of CAN_FilterBankImage_t for compile time filter tables **/
+#define CAN_FILTER_BANK_LIST32(BANK,FIFO,ID1,ID2)            {(BANK),CAN_IDENTIFIERLIST_MODE,CAN_ONE_32BIT_FILTER,(FIFO),(ID1),(ID2)}
+#define CAN_FILTER_BANK_MASK32(BANK,FIFO,ID,MASK)            {(BANK),CAN_MASK_MODE,CAN_ONE_32BIT_FILTER,(FIFO),(ID),(MASK)}
+#define CAN_FILTER_BANK_LIST16(BANK,FIFO,ID1,ID2,ID3,ID4)    {(BANK),CAN_IDENTIFIERLIST_MODE,CAN_TWO16BIT_FILTER,(FIFO), \
+                                                             (((uint32)(ID2) << 16) | (ID1)),(((uint32)(ID4) << 16) | (ID3))}
+#define CAN_FILTER_BANK_MASK16(BANK,FIFO,ID1,MASK1,ID2,MASK2) {(BANK),CAN_MASK_MODE,CAN_TWO16BIT_FILTER,(FIFO), \
+                                                             (((uint32)(MASK1) << 16) | (ID1)),(((uint32)(MASK2) << 16) | (ID2))}
+
+/** @defgroup CAN_filter_update mode of MCAN_u8UpdateFilters **/
+#define CAN_FILTER_UPDATE_ALL               (0x0)  /*!< rewrite every bank given */
+#define CAN_FILTER_UPDATE_DIFF              (0x1)  /*!< skip active banks already holding the image */
+
+/** @defgroup CAN_frame_id identifier of CAN_Frame_t, kept in TIR/RIR layout: STID/EXID[28:18] | EXID[17:0] | IDE | RTR | 0 **/
+#define CAN_FRAME_ID_IDE                    ((uint32)1 << 2)
+#define CAN_FRAME_ID_RTR                    ((uint32)1 << 1)
+#define CAN_FRAME_ID_STD(ID)                ((uint32)(ID) << 21)
+#define CAN_FRAME_ID_EXT(ID)                (((uint32)(ID) << 3) | CAN_FRAME_ID_IDE)
+#define CAN_FRAME_IS_EXT(FRAME_ID)          (((FRAME_ID) & CAN_FRAME_ID_IDE) != 0)
+#define CAN_FRAME_IS_REMOTE(FRAME_ID)       (((FRAME_ID) & CAN_FRAME_ID_RTR) != 0)
+#define CAN_FRAME_GET_STD(FRAME_ID)         ((uint32)(FRAME_ID) >> 21)
+#define CAN_FRAME_GET_EXT(FRAME_ID)         ((uint32)(FRAME_ID) >> 3)
+
+/** @defgroup CAN_frame_dlc_flags flag or-ed into CAN_Frame_t DLC of a frame to transmit **/
+#define CAN_FRAME_DLC_TGT           (0x80) /*!< send the time stamp in the last 2 data bytes (TTCM, DLC 8) */
+
+/** @defgroup CAN_transmission_status value returned by MCAN_u8Transmission when no mailbox was loaded directly **/
+#define CAN_TX_QUEUED               (0x3)  /*!< frame held in the software queue, sent from the TX interrupt */
+#define CAN_TX_REPLACED             (0x4)  /*!< MCAN_u8TransmitLatest: an older copy with the same Id was replaced */
+#define CAN_TX_QUEUE_FULL           (0xFF) /*!< queue full, frame not accepted */
+
+/** @defgroup CAN_reserved_mailbox MCAN_u8ReserveMailbox argument releasing the reserved mailbox **/
+#define CAN_MAILBOX_NONE            (0x3)
+
+/** @defgroup CAN_reserved_status returned by MCAN_u8ReservedMailboxStatus **/
+#define CAN_RESERVED_IDLE           (0x0)  /*!< nothing loaded since the reservation */
+#define CAN_RESERVED_PENDING        (0x1)  /*!< waiting for the bus or on it */
+#define CAN_RESERVED_SENT           (0x2)  /*!< transmitted */
+#define CAN_RESERVED_FAILED         (0x3)  /*!< aborted, or lost / in error with automatic retransmission off */
+
+/** @defgroup CAN_last_error_code ESR LEC values, index of CAN_BusStats_t LecCount **/
+#define CAN_LEC_NONE                (0x0)
+#define CAN_LEC_STUFF               (0x1)
+#define CAN_LEC_FORM                (0x2)
+#define CAN_LEC_ACK                 (0x3)
+#define CAN_LEC_BIT_RECESSIVE       (0x4)
+#define CAN_LEC_BIT_DOMINANT        (0x5)
+#define CAN_LEC_CRC                 (0x6)
+#define CAN_LEC_COUNT               (7)
+
+/** @defgroup CAN_error_state fault confinement state **/
+#define CAN_ERROR_ACTIVE            (0x0)
+#define CAN_ERROR_WARNING           (0x1)  /*!< TEC or REC >= 96 */
+#define CAN_ERROR_PASSIVE           (0x2)  /*!< TEC or REC > 127 */
+#define CAN_ERROR_BUS_OFF           (0x3)
+
+/** @defgroup CAN_recovery_mode bus-off handling selected by MCAN_VoidSetRecoveryMode **/
+#define CAN_RECOVERY_OFF            (0x0)  /*!< only CAN_BOF_Error_Callback, ABOM as given to MCAN_VoidInit */
+#define CAN_RECOVERY_ABOM           (0x1)  /*!< hardware rejoins after 128 x 11 recessive bits */
+#define CAN_RECOVERY_BACKOFF        (0x2)  /*!< software re-init after an exponential backoff */
+
+/** @defgroup CAN_recovery_state returned by MCAN_u8RecoveryState **/
+#define CAN_RECOVERY_ACTIVE         (0x0)  /*!< on the bus */
+#define CAN_RECOVERY_WAIT_BACKOFF   (0x1)  /*!< bus-off, backoff delay running */
+#define CAN_RECOVERY_REINIT         (0x2)  /*!< bus-off, initialization requested */
+#define CAN_RECOVERY_WAIT_BUS       (0x3)  /*!< bus-off, waiting for 128 x 11 recessive bits */
+
+/** @defgroup CAN_bit_timing range searched by MCAN_u8SolveBitTiming **/
+#define CAN_BRP_MAX                 (1024)
+#define CAN_TS1_MAX                 (16)
+#define CAN_TS2_MAX                 (8)
+#define CAN_SJW_MAX                 (4)
+#define CAN_TQ_MIN                  (8)    /*!< fewer quanta give a too coarse sample point */
+#define CAN_TQ_MAX                  (1 + CAN_TS1_MAX + CAN_TS2_MAX)
+
+/** @defgroup CAN_btr_value BTR word of a timing (values in time quanta, not minus one), usable in static const
+ *  tables when the timing is solved off line for a known clock **/
+#define CAN_BTR_VALUE(BRP,TS1,TS2,SJW)  ((((uint32)(SJW) - 1) << 24) | (((uint32)(TS2) - 1) << 20) | \
+                                         (((uint32)(TS1) - 1) << 16) | ((uint32)(BRP) - 1))
 
 #define CAN_ENABLE 1
 #define CAN_DISABLE 0
@@ -119,6 +214,43 @@ uint32 FilterFIFOAssignment;  /*!< Specifies the Recevier FIFO (0 or 1U) which w
 uint32 FilterBank;            /*!< Specifies the filter bank which will be initialized.*/  
 }CAN_Filter_t;
 
+/**
+  * @brief  identifiers one FIFO should accept: a single identifier (IdLow == IdHigh) or an inclusive range
+  */
+typedef struct
+{
+  uint32 IdLow;                 /*!< first identifier (11 or 29 bit) */
+  uint32 IdHigh;                /*!< last identifier */
+  uint8 IDE;                    /*!< @ref CAN_identifier_type */
+  uint8 FIFO;                   /*!< @ref CAN_receive_FIFO_number */
+}CAN_FilterSpec_t;
+
+/**
+  * @brief  register image of one filter bank, produced by MCAN_u8CompileFilters or written by hand
+  *         with the CAN_FILTER_BANK_xxx initializers
+  */
+typedef struct
+{
+  uint8 Bank;                   /*!< filter bank number 0 .. CAN_FILTER_BANKS-1 */
+  uint8 Mode;                   /*!< @ref CAN_filterMode_t */
+  uint8 Scale;                  /*!< @ref CAN_SCALABLEWIDTH_t */
+  uint8 FIFO;                   /*!< @ref CAN_receive_FIFO_number */
+  uint32 FR1;                   /*!< filter bank register 1 */
+  uint32 FR2;                   /*!< filter bank register 2 */
+}CAN_FilterBankImage_t;
+
+/**
+  * @brief  result of a filter compilation
+  */
+typedef struct
+{
+  uint8 BanksUsed;              /*!< number of images produced */
+  uint8 MaskMerges;             /*!< number of approximations made to fit in the bank budget */
+  uint32 WantedIds;             /*!< identifiers requested by the specs */
+  uint32 AcceptedIds;           /*!< identifiers the hardware will accept (estimate, >= WantedIds) */
+  uint16 FalseAcceptPermille;   /*!< share of accepted identifiers that were not requested, in 1/1000 */
+}CAN_FilterReport_t;
+
 
 typedef struct 
 {
@@ -144,6 +276,91 @@ typedef struct
 
 }CAN_RX_Frame_t;
 
+/**
+  * @brief  packed frame (16 bytes) used by the RX rings, the TX queue and the fast TX/RX paths.
+  *         Id is in TIR/RIR layout so it moves to/from the mailbox with one word access and
+  *         compares like the bus arbitration (lower Id wins). The 64-bit time stamps of the ring
+  *         frames are kept beside the rings, read them with MCAN_u64RxStamp
+  */
+typedef struct
+{
+  uint32 Id;                    /*!< @ref CAN_frame_id */
+  uint8 DLC;                    /*!< data length code 0-8, on transmission may be or-ed with @ref CAN_frame_dlc_flags */
+  uint8 FMI;                    /*!< filter match index of a received frame */
+  uint16 TimeStamp;             /*!< time stamp of a received frame (TIME captured at start of frame) */
+  union
+  {
+    uint8 Bytes[8];
+    uint32 Words[2];            /*!< Words[0] bytes 0-3 (TDLR/RDLR), Words[1] bytes 4-7 (TDHR/RDHR) */
+  }Data;                        /*!< bytes after DLC are not cleared on reception */
+}CAN_Frame_t;
+
+/**
+  * @brief  bit timing found by MCAN_u8SolveBitTiming, segments in time quanta (not minus one)
+  */
+typedef struct
+{
+  uint16 BRP;                   /*!< prescaler 1-1024, tq = BRP / PCLK1 */
+  uint8 TS1;                    /*!< propagation + phase segment 1, 1-16 */
+  uint8 TS2;                    /*!< phase segment 2, 1-8 */
+  uint8 SJW;                    /*!< resynchronization jump width, 1-4 */
+  uint8 Quanta;                 /*!< 1 + TS1 + TS2 */
+  uint16 SamplePointPermille;   /*!< (1 + TS1) / Quanta */
+  uint32 Bitrate;               /*!< bit rate obtained in bit/s */
+  uint32 ErrorPpm;              /*!< distance between the obtained and the requested bit rate */
+}CAN_BitTiming_t;
+
+/**
+  * @brief  one bus-off episode, times in MCAN_VoidRecoveryTick ticks
+  */
+typedef struct
+{
+  uint32 StartTick;             /*!< tick count when bus-off was detected */
+  uint32 DurationTicks;         /*!< time until the node was back on the bus, 0 while it lasts */
+  uint16 BackoffTicks;          /*!< delay waited before the re-init (CAN_RECOVERY_BACKOFF) */
+  uint8 Lec;                    /*!< last error code before bus-off @ref CAN_last_error_code */
+  uint8 FramesHeld;             /*!< frames in the TX queue and mailboxes when bus-off was detected */
+}CAN_BusOffEpisode_t;
+
+/**
+  * @brief  RX ring overrun counters
+  */
+typedef struct
+{
+  uint32 SoftwareOverruns;    /*!< frames dropped because the ring was full */
+  uint32 HardwareOverruns;    /*!< FOVR events: frames lost in the 3 slot hardware FIFO */
+}CAN_RxRingStatus_t;
+
+/**
+  * @brief  bus statistics of one window (between two MCAN_VoidGetBusStats calls)
+  */
+typedef struct
+{
+  uint32 WindowUs;              /*!< length of the window given by the caller */
+  uint16 FramesRx;              /*!< frames received in both FIFOs (including frames dropped by a full RX ring) */
+  uint16 FramesTx;              /*!< frames transmitted successfully */
+  uint16 BusLoadPermille;       /*!< bits of these frames (worst case stuffing, with IFS) / bits of the window */
+  uint16 TxArbitrationLost;     /*!< mailbox completions with arbitration lost */
+  uint16 TxErrors;              /*!< mailbox completions with transmission error */
+  uint16 LecCount[CAN_LEC_COUNT]; /*!< last error codes sampled, index @ref CAN_last_error_code (0 unused) */
+  uint8 TecMin;                 /*!< transmit error counter: lowest, highest and last value sampled */
+  uint8 TecMax;
+  uint8 TecLast;
+  uint8 RecMin;                 /*!< receive error counter: lowest, highest and last value sampled */
+  uint8 RecMax;
+  uint8 RecLast;
+  uint8 ErrorStateWorst;        /*!< worst @ref CAN_error_state sampled */
+  uint8 TxMailboxHighWater;     /*!< most mailboxes pending at once 0-3 */
+  uint8 TxQueueHighWater;       /*!< most frames in the software TX queue */
+  uint8 RxFifoHighWater[2];     /*!< most frames waiting in each hardware FIFO 0-3 */
+  uint16 RxRingHighWater[2];    /*!< most frames waiting in each RX ring */
+}CAN_BusStats_t;
+
+/**
+  * @brief  handler of the frames accepted by one filter, called by the FMI dispatcher
+  */
+typedef void (*CAN_FrameHandler_t)(const CAN_Frame_t* pFrame,void* pContext);
+
 typedef enum
 {
   TxMailbox0_completed,
@@ -193,6 +410,63 @@ void MCAN_VoidInit(const CAN_InitTypeDef* pInitConfig) ;
 *******************************************************************************/
 void MCAN_VoidConfigureIDFilter(CAN_Filter_t *pFilterConfig);
 
+/******************************************************************************
+* \Syntax          : Std_ReturnType MCAN_u8CompileFilters(const CAN_FilterSpec_t* pSpecs,uint8 u8SpecCount,
+*                                                         uint8 u8FirstBank,uint8 u8MaxBanks,
+*                                                         CAN_FilterBankImage_t* pImages,CAN_FilterReport_t* pReport)                                      
+* \Description     : pack identifiers and ranges into the fewest filter banks: standard ids in 16-bit list
+*                    banks (4 per bank), ranges as aligned masks (2 per 16-bit bank for standard, 1 per bank
+*                    for extended), extended ids in 32-bit list banks (2 per bank). When the result does not
+*                    fit u8MaxBanks, the terms whose merge adds the fewest unwanted ids are merged into masks.
+*                    No register is touched so it can also run in a host build step to generate static tables.                                                                          
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : pSpecs identifiers per FIFO, u8SpecCount number of specs, u8FirstBank first bank to use,
+*                    u8MaxBanks bank budget                   
+* \Parameters (out): pImages u8MaxBanks bank images in bank order, pReport size and false accept rate (may be NULL)                                                      
+* \Return value:   : Std_ReturnType N_OK when the specs do not fit (too many terms or fewer banks than FIFO/IDE groups)
+*******************************************************************************/
+Std_ReturnType MCAN_u8CompileFilters(const CAN_FilterSpec_t* pSpecs,uint8 u8SpecCount,uint8 u8FirstBank,uint8 u8MaxBanks,
+                                     CAN_FilterBankImage_t* pImages,CAN_FilterReport_t* pReport);
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidApplyFilters(const CAN_FilterBankImage_t* pImages,uint8 u8Count)                                      
+* \Description     : write and activate filter bank images in one filter initialization window                                                                          
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : pImages bank images (compiled or a static const table), u8Count number of images                   
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidApplyFilters(const CAN_FilterBankImage_t* pImages,uint8 u8Count);
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8UpdateFilters(const CAN_FilterBankImage_t* pImages,uint8 u8Count,uint8 u8Mode)
+* \Description     : rewrite filter banks while the controller keeps receiving. A bank keeping its mode,
+*                    scale and FIFO is deactivated in FA1R, its FR1 / FR2 rewritten and reactivated: the
+*                    other banks never stop filtering. Banks changing mode, scale or FIFO need filter
+*                    initialization mode, which suspends reception: they are written together in one
+*                    FINIT window and the FMI table is rebuilt
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pImages bank images, u8Count number of images, u8Mode @ref CAN_filter_update
+* \Parameters (out): None
+* \Return value:   : uint8 number of banks written
+*******************************************************************************/
+uint8 MCAN_u8UpdateFilters(const CAN_FilterBankImage_t* pImages,uint8 u8Count,uint8 u8Mode);
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidDeactivateFilterBanks(uint32 u32BankMask)
+* \Description     : stop filtering with some banks (dropped subscriptions) while the controller keeps
+*                    receiving, MCAN_u8UpdateFilters activates them again
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u32BankMask bit n set deactivates bank n
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidDeactivateFilterBanks(uint32 u32BankMask);
+
 /******************************************************************************
 * \Syntax          : uint8 MCAN_u8Transmission(CAN_TX_Frame_t * TXframe,uint8 Data[])                                      
 * \Description     : initialize CAN Frame to be send and put it in Tx mailbox and                                                                           
@@ -200,10 +474,48 @@ void MCAN_VoidConfigureIDFilter(CAN_Filter_t *pFilterConfig);
 * \Reentrancy      : Non Reentrant                                             
 * \Parameters (in) : CAN_TX_Frame * TXframe , Data array represent the data bytes                  
 * \Parameters (out): None                                                      
-* \Return value:   : return the mailbox number used to transmit
+* \Return value:   : mailbox number (0-2) when loaded directly, CAN_TX_QUEUED when held in the software
+*                    queue ordered by identifier priority, CAN_TX_QUEUE_FULL when the queue is full
 *******************************************************************************/
 uint8 MCAN_u8Transmission(CAN_TX_Frame_t * TXframe,uint8 Data[]);
 
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8TransmitFrame(const CAN_Frame_t* pFrame)                                      
+* \Description     : transmit a packed frame: identifier written to TIR in one word, payload in two
+*                    word stores, same mailbox / software queue handling as MCAN_u8Transmission                                                                           
+* \Sync\Async      : ASynchronous (when tx is transmitted interrupt notify the app)                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : pFrame frame to send (all 8 data bytes are copied whatever the DLC)                  
+* \Parameters (out): None                                                      
+* \Return value:   : mailbox number (0-2) when loaded directly, CAN_TX_QUEUED or CAN_TX_QUEUE_FULL
+*******************************************************************************/
+uint8 MCAN_u8TransmitFrame(const CAN_Frame_t* pFrame);
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8TransmitLatest(const CAN_Frame_t* pFrame)
+* \Description     : "latest value wins" transmission for cyclic status frames: a queued frame with the same Id
+*                    is overwritten in place, a pending mailbox with the same Id is aborted (ABRQ) and the fresh
+*                    frame takes its place, so at most one copy of an Id waits for the bus
+* \Sync\Async      : ASynchronous (when tx is transmitted interrupt notify the app)
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pFrame frame to send
+* \Parameters (out): None
+* \Return value:   : CAN_TX_REPLACED when an older copy was replaced, otherwise as MCAN_u8TransmitFrame
+*******************************************************************************/
+uint8 MCAN_u8TransmitLatest(const CAN_Frame_t* pFrame);
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8TxQueueCount(void)                                      
+* \Description     : Return the number of frames waiting in the software TX queue                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : None                
+* \Parameters (out): None                                                      
+* \Return value:   : number of queued frames-> 0-CAN_TX_QUEUE_SIZE, up to CAN_TX_QUEUE_SIZE + 3 while
+*                    frames taken back from the mailboxes wait
+*******************************************************************************/
+uint8 MCAN_u8TxQueueCount(void);
+
 /******************************************************************************
 * \Syntax          : void MCAN_VoidReception(uint8 RX_FIFO,CAN_RX_Frame_t * RXframe,uint8 Data[])                                      
 * \Description     : Read CAN frame from RX FIFO and store its data in Data Array.                                                                           
@@ -215,6 +527,17 @@ uint8 MCAN_u8Transmission(CAN_TX_Frame_t * TXframe,uint8 Data[]);
 *******************************************************************************/
 void MCAN_VoidReception(uint8 RX_FIFO,CAN_RX_Frame_t * RXframe,uint8 Data[]);
 
+/******************************************************************************
+* \Syntax          : Std_ReturnType MCAN_u8ReceiveFrame(uint8 RX_FIFO,CAN_Frame_t* pFrame)                                      
+* \Description     : read the oldest frame of a FIFO into a packed frame (four word loads) and release it                                                                           
+* \Sync\Async      : Synchronous                                                
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : RX_FIFO number of fifo to read from                  
+* \Parameters (out): pFrame received frame                                                      
+* \Return value:   : Std_ReturnType N_OK when the FIFO is empty
+*******************************************************************************/
+Std_ReturnType MCAN_u8ReceiveFrame(uint8 RX_FIFO,CAN_Frame_t* pFrame);
+
 /******************************************************************************
 * \Syntax          : void MCAN_VoidStart()                                      
 * \Description     : Start CAN by leaving the initialization mode to normal mode                                                                             
@@ -226,6 +549,160 @@ void MCAN_VoidReception(uint8 RX_FIFO,CAN_RX_Frame_t * RXframe,uint8 Data[]);
 *******************************************************************************/
 void MCAN_VoidStart(void);
 
+/******************************************************************************
+* \Syntax          : void MCAN_VoidStop(void)                                      
+* \Description     : leave the bus: request initialization mode and wait for INAK. Pending mailboxes are
+*                    not aborted, they are sent after the next MCAN_VoidStart
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : None                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidStop(void);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType MCAN_u8SetBitrate(uint32 u32Bitrate,uint8 u8Mode)                                      
+* \Description     : change the bit rate and the test mode after MCAN_VoidInit, solved like MCAN_VoidInit
+*                    with MRCC_u32GetPclk1Hz() and CAN_SAMPLE_POINT_PERMILLE. Only while stopped
+*                    (after MCAN_VoidInit or MCAN_VoidStop), then MCAN_VoidStart
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : u32Bitrate bit rate in bit/s, u8Mode CAN_MODE_NORMAL / _LOOPBACK / _SILENT / _SILENT_LOOPBACK
+* \Parameters (out): None                                                      
+* \Return value:   : Std_ReturnType N_OK when the controller is not in initialization mode or
+*                    no timing is within CAN_BIT_TIMING_MAX_ERROR_PPM (BTR is left unchanged)
+*******************************************************************************/
+Std_ReturnType MCAN_u8SetBitrate(uint32 u32Bitrate,uint8 u8Mode);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType MCAN_u8EnableTimeStamps(void)                                      
+* \Description     : turn on TTCM and stamp every frame the RX interrupt moves into a ring (MCAN_u64RxStamp).
+*                    The 16-bit TIME counter (one count per bit) and the cycle counter run from the same
+*                    crystal, so one anchor maps TIME to MSYSTICK_u64GetCycles without drift; the anchor
+*                    is moved earlier whenever a frame would be valid after it was read, so it settles on
+*                    the frame read with the lowest interrupt latency (resolution one bit time).
+*                    Needs MSYSTICK_VoidEnableCycleCounter with SysTick running, and the RX0 / RX1
+*                    interrupts at one priority. Call while stopped (after MCAN_VoidInit or MCAN_VoidStop)
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : None                
+* \Parameters (out): None                                                      
+* \Return value:   : Std_ReturnType N_OK when the controller is not in initialization mode
+*******************************************************************************/
+Std_ReturnType MCAN_u8EnableTimeStamps(void);
+
+/******************************************************************************
+* \Syntax          : uint64 MCAN_u64ExtendTimeStamp(uint16 u16TimeStamp)                                      
+* \Description     : map a TIME value captured less than 65536 bit times ago (TimeStamp of the legacy
+*                    CAN_RX_Frame_t, TIME of a TX mailbox) to HCLK cycles. Call from the CAN RX interrupt
+*                    priority or with it masked: the anchor is updated there
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : u16TimeStamp captured TIME value                
+* \Parameters (out): None                                                      
+* \Return value:   : uint64 start of frame in HCLK cycles, 0 before the first frame was received
+*******************************************************************************/
+uint64 MCAN_u64ExtendTimeStamp(uint16 u16TimeStamp);
+
+/******************************************************************************
+* \Syntax          : uint64 MCAN_u64RxStamp(const CAN_Frame_t* pFrame)
+* \Description     : start of frame of a frame still in an RX ring: from MCAN_u16RxRingPeek or passed to a
+*                    dispatch handler, before it is released. Frames copied out with MCAN_u16RxRingRead
+*                    keep only their 16-bit TimeStamp
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : pFrame frame in an RX ring
+* \Parameters (out): None
+* \Return value:   : uint64 start of frame in HCLK cycles of MSYSTICK_u64GetCycles, 0 unless
+*                    MCAN_u8EnableTimeStamps or for a frame outside the rings
+*******************************************************************************/
+uint64 MCAN_u64RxStamp(const CAN_Frame_t* pFrame);
+
+/******************************************************************************
+* \Syntax          : uint32 MCAN_u32CyclesPerBit(void)
+* \Description     : HCLK cycles of one bit time, the unit between TIME and MSYSTICK_u64GetCycles
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint32 cycles per bit, 0 unless MCAN_u8EnableTimeStamps
+*******************************************************************************/
+uint32 MCAN_u32CyclesPerBit(void);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType MCAN_u8ReserveMailbox(uint8 u8Mailbox)
+* \Description     : take a mailbox away from the TX queue and MCAN_u8TransmitFrame for an external scheduler
+*                    (time-triggered slots), or give it back with CAN_MAILBOX_NONE. The queue keeps the two
+*                    other mailboxes. With time stamps enabled a frame sent from it moves the time stamp
+*                    anchor: keep the CAN TX and RX interrupts at the same priority
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Mailbox mailbox 0-2, CAN_MAILBOX_NONE to release the reserved one
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK when the mailbox is pending (retry) or out of range
+*******************************************************************************/
+Std_ReturnType MCAN_u8ReserveMailbox(uint8 u8Mailbox);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType MCAN_u8LoadReservedMailbox(const CAN_Frame_t* pFrame)
+* \Description     : request transmission of a frame in the reserved mailbox, it leaves on the next bus idle.
+*                    May be called from an interrupt of lower or equal priority than the CAN TX interrupt,
+*                    so the previous result is always served before the mailbox is reused
+* \Sync\Async      : ASynchronous (result from MCAN_u8ReservedMailboxStatus)
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pFrame frame to send
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK when no mailbox is reserved, it is pending or TX is held by bus-off
+*******************************************************************************/
+Std_ReturnType MCAN_u8LoadReservedMailbox(const CAN_Frame_t* pFrame);
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidAbortReservedMailbox(void)
+* \Description     : abort the frame of the reserved mailbox unless it is already on the bus (end of its
+*                    time window), the status turns to CAN_RESERVED_FAILED or CAN_RESERVED_SENT
+* \Sync\Async      : ASynchronous (result from MCAN_u8ReservedMailboxStatus)
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidAbortReservedMailbox(void);
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8ReservedMailboxStatus(uint64* pSof)
+* \Description     : state of the last frame loaded in the reserved mailbox
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): pSof start of frame in HCLK cycles when sent (0 unless MCAN_u8EnableTimeStamps), may be NULL
+* \Return value:   : uint8 @ref CAN_reserved_status
+*******************************************************************************/
+uint8 MCAN_u8ReservedMailboxStatus(uint64* pSof);
+
+/******************************************************************************
+* \Syntax          : uint32 MCAN_u32EnterCritical(void)
+* \Description     : mask the interrupts with the lock of the driver TX path (PRIMASK saved, so it nests), for
+*                    a sequence of driver calls that an interrupt must not see half done
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint32 previous state, for MCAN_VoidExitCritical
+*******************************************************************************/
+uint32 MCAN_u32EnterCritical(void);
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidExitCritical(uint32 u32State)
+* \Description     : back to the state saved by MCAN_u32EnterCritical, interrupts stay masked inside an outer one
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : u32State value returned by MCAN_u32EnterCritical
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidExitCritical(uint32 u32State);
+
 /******************************************************************************
 * \Syntax          : uint8 MCAN_u8FreeMailboxes(void)                                      
 * \Description     : Return the number of free mailboxes to start transmit                                                                             
@@ -260,6 +737,164 @@ uint8 MCAN_u8MailboxPendingStatus(uint8 mailboxNumber);
 *******************************************************************************/
 uint8 MCAN_u8RX_FIFOMeassages(uint8 RX_FIFO);
 
+/******************************************************************************
+* \Syntax          : void MCAN_VoidEnableRxRing(uint8 RX_FIFO)                                      
+* \Description     : Drain the FIFO completely from its interrupt into a lock free ring,
+*                    the RX_FIFOx_FMP callback (if any) is then called once per interrupt as a notification                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : uint8 RX_FIFO number of FIFO 0->FIFO0,1->FIFO1                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidEnableRxRing(uint8 RX_FIFO);
+
+/******************************************************************************
+* \Syntax          : uint16 MCAN_u16RxRingCount(uint8 RX_FIFO)                                      
+* \Description     : Return the number of frames waiting in the RX ring                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : uint8 RX_FIFO number of FIFO 0->FIFO0,1->FIFO1                
+* \Parameters (out): None                                                      
+* \Return value:   : number of frames in the ring
+*******************************************************************************/
+uint16 MCAN_u16RxRingCount(uint8 RX_FIFO);
+
+/******************************************************************************
+* \Syntax          : uint16 MCAN_u16RxRingRead(uint8 RX_FIFO,CAN_Frame_t* pFrames,uint16 u16Max)                                      
+* \Description     : Copy up to u16Max frames out of the RX ring and release them                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant (single consumer per FIFO)                                            
+* \Parameters (in) : RX_FIFO number of FIFO, u16Max capacity of pFrames                
+* \Parameters (out): pFrames received frames, oldest first                                                      
+* \Return value:   : number of frames copied
+*******************************************************************************/
+uint16 MCAN_u16RxRingRead(uint8 RX_FIFO,CAN_Frame_t* pFrames,uint16 u16Max);
+
+/******************************************************************************
+* \Syntax          : uint16 MCAN_u16RxRingPeek(uint8 RX_FIFO,const CAN_Frame_t** ppFrames)                                      
+* \Description     : Zero copy batch access: point at the oldest frame and return how many frames
+*                    follow it contiguously in the ring, release them with MCAN_VoidRxRingRelease                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant (single consumer per FIFO)                                             
+* \Parameters (in) : RX_FIFO number of FIFO                
+* \Parameters (out): ppFrames pointer to the oldest frame                                                      
+* \Return value:   : number of contiguous frames (0 when empty)
+*******************************************************************************/
+uint16 MCAN_u16RxRingPeek(uint8 RX_FIFO,const CAN_Frame_t** ppFrames);
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidRxRingRelease(uint8 RX_FIFO,uint16 u16Count)                                      
+* \Description     : Release frames obtained with MCAN_u16RxRingPeek                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant (single consumer per FIFO)                                             
+* \Parameters (in) : RX_FIFO number of FIFO, u16Count frames to release                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidRxRingRelease(uint8 RX_FIFO,uint16 u16Count);
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidGetRxRingStatus(uint8 RX_FIFO,CAN_RxRingStatus_t* pStatus)                                      
+* \Description     : Read the overrun counters of a FIFO                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Reentrant                                             
+* \Parameters (in) : RX_FIFO number of FIFO                
+* \Parameters (out): pStatus overrun counters                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidGetRxRingStatus(uint8 RX_FIFO,CAN_RxRingStatus_t* pStatus);
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidBusMonitorSample(void)                                      
+* \Description     : sample TEC/REC, the error state and LEC into the current statistics window and clear LEC.
+*                    Also done by the error interrupt and by MCAN_VoidGetBusStats; call it periodically
+*                    when the LEC interrupt is not enabled to catch more error codes                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : None                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidBusMonitorSample(void);
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidGetBusStats(CAN_BusStats_t* pStats,uint32 u32WindowUs)                                      
+* \Description     : close the statistics window and start the next one                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : u32WindowUs time since the previous call in microseconds (used for the bus load)                
+* \Parameters (out): pStats statistics of the window                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidGetBusStats(CAN_BusStats_t* pStats,uint32 u32WindowUs);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType MCAN_u8SolveBitTiming(uint32 u32PclkHz,uint32 u32Bitrate,
+*                                                       uint16 u16SamplePointPermille,CAN_BitTiming_t* pTiming)
+* \Description     : search every prescaler / segment combination for the one closest to the requested bit rate,
+*                    then to the requested sample point, then with the most quanta. Touches no register, so it
+*                    can also run on the host to fill a static table of CAN_BTR_VALUE words.
+*                    MCAN_VoidInit calls it with MRCC_u32GetPclk1Hz() and CAN_SAMPLE_POINT_PERMILLE
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : u32PclkHz APB1 clock, u32Bitrate bit rate in bit/s,
+*                    u16SamplePointPermille sample point (e.g. 875 for 87.5 %)
+* \Parameters (out): pTiming best timing
+* \Return value:   : Std_ReturnType N_OK when no timing is within CAN_BIT_TIMING_MAX_ERROR_PPM
+*******************************************************************************/
+Std_ReturnType MCAN_u8SolveBitTiming(uint32 u32PclkHz,uint32 u32Bitrate,uint16 u16SamplePointPermille,
+                                     CAN_BitTiming_t* pTiming);
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidSetRecoveryMode(uint8 u8Mode)
+* \Description     : select the bus-off handling and enable the bus-off interrupt. In ABOM and BACKOFF modes
+*                    the frames pending in the mailboxes are taken back into the TX queue on bus-off, new frames
+*                    are queued, and the queue is replayed most urgent first once the node is back on the bus.
+*                    Call between MCAN_VoidInit and MCAN_VoidStart
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Mode @ref CAN_recovery_mode
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidSetRecoveryMode(uint8 u8Mode);
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidRecoveryTick(void)
+* \Description     : time base of the bus-off recovery, call every CAN_RECOVERY_TICK_MS from the main loop
+*                    or a timer interrupt of lower priority than the CAN interrupts: runs the backoff, the
+*                    re-init and detects the return on the bus
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidRecoveryTick(void);
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8RecoveryState(void)
+* \Description     : state of the bus-off recovery
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint8 @ref CAN_recovery_state
+*******************************************************************************/
+uint8 MCAN_u8RecoveryState(void);
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8GetBusOffEpisodes(CAN_BusOffEpisode_t* pEpisodes,uint8 u8Max)
+* \Description     : copy the latest bus-off episodes, most recent first (up to CAN_BUSOFF_EPISODES)
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Max size of pEpisodes
+* \Parameters (out): pEpisodes episodes
+* \Return value:   : uint8 number of episodes copied
+*******************************************************************************/
+uint8 MCAN_u8GetBusOffEpisodes(CAN_BusOffEpisode_t* pEpisodes,uint8 u8Max);
+
 /******************************************************************************
 * \Syntax          : void MCAN_VoidEnableNotifications(CAN_notifications_t notification,void (*callback_ptr)())                                      
 * \Description     : Enable interrupt enable of CAN interrupt and set the callback function                                                                             
@@ -282,4 +917,52 @@ void MCAN_VoidEnableNotifications(CAN_notifications_t notification,void (*callba
 *******************************************************************************/
 void MCAN_VoidDisableNotifications(CAN_notifications_t notification);
 
+/******************************************************************************
+* \Syntax          : void MCAN_VoidSetFilterHandler(uint8 u8Bank,uint8 u8Filter,CAN_FrameHandler_t pHandler,void* pContext)                                      
+* \Description     : attach a handler to one filter of a bank and rebuild the FMI dispatch table.
+*                    u8Filter is the filter inside the bank: 0 for a 32-bit mask bank, 0-1 for a 32-bit list or
+*                    16-bit mask bank (FR1,FR2), 0-3 for a 16-bit list bank (FR1 low/high, FR2 low/high)                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : u8Bank filter bank, u8Filter filter in the bank, pHandler handler (NULL to detach),
+*                    pContext passed back to the handler                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidSetFilterHandler(uint8 u8Bank,uint8 u8Filter,CAN_FrameHandler_t pHandler,void* pContext);
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidSetDefaultHandler(CAN_FrameHandler_t pHandler,void* pContext)                                      
+* \Description     : handler for frames whose filter has no handler attached                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : pHandler handler (NULL to ignore such frames), pContext passed back to the handler                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidSetDefaultHandler(CAN_FrameHandler_t pHandler,void* pContext);
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidDispatchMessage(uint8 RX_FIFO,const CAN_Frame_t* pFrame)                                      
+* \Description     : call the handler of the filter that accepted the frame: one table load indexed by
+*                    FIFO and FMI, no identifier comparison                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Reentrant                                             
+* \Parameters (in) : RX_FIFO FIFO the frame was received in, pFrame received frame                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidDispatchMessage(uint8 RX_FIFO,const CAN_Frame_t* pFrame);
+
+/******************************************************************************
+* \Syntax          : uint16 MCAN_u16DispatchRxRing(uint8 RX_FIFO,uint16 u16Max)                                      
+* \Description     : dispatch up to u16Max frames straight from the RX ring (no copy) and release them                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant (single consumer per FIFO)                                             
+* \Parameters (in) : RX_FIFO number of FIFO, u16Max largest number of frames to dispatch                
+* \Parameters (out): None                                                      
+* \Return value:   : number of frames dispatched
+*******************************************************************************/
+uint16 MCAN_u16DispatchRxRing(uint8 RX_FIFO,uint16 u16Max);
+
 #endif
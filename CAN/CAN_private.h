@@ -61,46 +61,55 @@ typedef struct
     uint32 FxR2;
 }FilterBank_t;
 
-typedef struct
+typedef union
 {
-    volatile uint32 RQCP0:1;
-    volatile uint32 TXOK0:1;
-    volatile uint32 ALST0:1;
-    volatile uint32 TERR0:1;
-    volatile uint32      :3;
-    volatile uint32 ABRQ0:1;
-   
-    volatile uint32 RQCP1:1;
-    volatile uint32 TXOK1:1;
-    volatile uint32 ALST1:1;
-    volatile uint32 TERR1:1;
-    volatile uint32      :3;
-    volatile uint32 ABRQ1:1;
-   
-    volatile uint32 RQCP2:1;
-    volatile uint32 TXOK2:1;
-    volatile uint32 ALST2:1;
-    volatile uint32 TERR2:1;
-    volatile uint32      :3;
-    volatile uint32 ABRQ2:1;
-   
-    volatile uint32 CODE :2;
-    
-    volatile uint32 TME0 :1;
-    volatile uint32 TME1 :1;
-    volatile uint32 TME2 :1;
-    volatile uint32 LOW0 :1;
-    volatile uint32 LOW1 :1;
-    volatile uint32 LOW2 :1;
+    uint32 r;
+    struct TSR_Reg_TAG
+    {
+        uint32 RQCP0:1;
+        uint32 TXOK0:1;
+        uint32 ALST0:1;
+        uint32 TERR0:1;
+        uint32      :3;
+        uint32 ABRQ0:1;
+       
+        uint32 RQCP1:1;
+        uint32 TXOK1:1;
+        uint32 ALST1:1;
+        uint32 TERR1:1;
+        uint32      :3;
+        uint32 ABRQ1:1;
+       
+        uint32 RQCP2:1;
+        uint32 TXOK2:1;
+        uint32 ALST2:1;
+        uint32 TERR2:1;
+        uint32      :3;
+        uint32 ABRQ2:1;
+       
+        uint32 CODE :2;
+        
+        uint32 TME0 :1;
+        uint32 TME1 :1;
+        uint32 TME2 :1;
+        uint32 LOW0 :1;
+        uint32 LOW1 :1;
+        uint32 LOW2 :1;
+    }B;
 }TSR_Reg_t;
 
-typedef struct
+typedef union
 {
-    volatile uint32 FMP    :2;
-    volatile uint32        :1;
-    volatile uint32 FULL   :1;
-    volatile uint32 FOVR   :1;
-    volatile uint32 RFOM   :1;
+    uint32 r;
+    struct RFR_Reg_TAG
+    {
+        uint32 FMP    :2;
+        uint32        :1;
+        uint32 FULL   :1;
+        uint32 FOVR   :1;
+        uint32 RFOM   :1;
+        uint32        :26;
+    }B;
 }RFR_Reg_t;
 
 typedef union
@@ -171,30 +180,41 @@ typedef struct
 }CAN_CONTROL_STATUS_t;
 
 /*******************************TX Mailbox Registers********************************************** */
-typedef struct
+typedef union
 {
-    volatile uint32 TXRQ:1;
-    volatile uint32 RTR:1;
-    volatile uint32 IDE:1;
-    volatile uint32 EXID:18;
-    volatile uint32 STD_EXID18_28:11;
+    uint32 r;
+    struct TIR_Reg_TAG
+    {
+        uint32 TXRQ:1;
+        uint32 RTR:1;
+        uint32 IDE:1;
+        uint32 EXID:18;
+        uint32 STD_EXID18_28:11;
+    }B;
 }TIR_Reg_t;
-typedef struct
+typedef union
 {
-    volatile uint32 DLC:4;
-    volatile uint32    :4;
-    volatile uint32 TGT:1;/*this bit determine if the time stamp is send in the last 2 bytes of 8-bytes data or not
-    DLC must be 8 for timestamp transfer*/
-    volatile uint32    :7;
-    volatile uint32 TIME:16;
+    uint32 r;
+    struct TDTR_Reg_TAG
+    {
+        uint32 DLC:4;
+        uint32    :4;
+        uint32 TGT:1;/*this bit determine if the time stamp is send in the last 2 bytes of 8-bytes data or not
+        DLC must be 8 for timestamp transfer*/
+        uint32    :7;
+        uint32 TIME:16;
+    }B;
 }TDTR_Reg_t;
-typedef struct
+/*data registers: r moves 4 bytes at once, byte 0 of the frame is in bits 7:0*/
+typedef union
 {
-    volatile uint8 DATA[4];
+    uint32 r;
+    uint8 DATA[4];
 }TDLR_Reg_t;
-typedef struct
+typedef union
 {
-    volatile uint8 DATA[4];
+    uint32 r;
+    uint8 DATA[4];
 }TDHR_Reg_t;
 
 typedef struct
@@ -207,28 +227,36 @@ typedef struct
 
 /****************************************************************************************************************** */
 /***********************************RX FIFO Registers**************************************************** */
-typedef struct
+typedef union
 {
-    volatile uint32    :1;
-    volatile uint32 RTR:1;
-    volatile uint32 IDE:1;
-    volatile uint32 EXID:18;
-    volatile uint32 STD_EXID18_28:11;
+    uint32 r;
+    struct RIR_Reg_TAG
+    {
+        uint32    :1;
+        uint32 RTR:1;
+        uint32 IDE:1;
+        uint32 EXID:18;
+        uint32 STD_EXID18_28:11;
+    }B;
 }RIR_Reg_t;
-typedef struct
+typedef union
 {
-    volatile uint32 DLC:4;
-    volatile uint32    :4;
-    volatile uint32 FMI:8;/*The Filter Match index can be used in two ways:
-                            • Compare the Filter Match index with a list of expected values.
-                            • Use the Filter Match Index as an index on an array to access the data destination
-                            location.*/
-                            /*each filter bank according to its configuration there is a filter number with it , 
-                            when receiving frame and pass through this filter ,filter number is the filter match index.
-                            we defines filters to pass frame with needed Data , then the data with specific filter index match 
-                            we gonna store it in related data variable in the app */
-    
-    volatile uint32 TIME:16;
+    uint32 r;
+    struct RDTR_Reg_TAG
+    {
+        uint32 DLC:4;
+        uint32    :4;
+        uint32 FMI:8;/*The Filter Match index can be used in two ways:
+                                • Compare the Filter Match index with a list of expected values.
+                                • Use the Filter Match Index as an index on an array to access the data destination
+                                location.*/
+                                /*each filter bank according to its configuration there is a filter number with it , 
+                                when receiving frame and pass through this filter ,filter number is the filter match index.
+                                we defines filters to pass frame with needed Data , then the data with specific filter index match 
+                                we gonna store it in related data variable in the app */
+        
+        uint32 TIME:16;
+    }B;
 }RDTR_Reg_t;
 typedef struct
 {
@@ -261,10 +289,140 @@ typedef struct
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL MACROS
 ---------------------------------------------------------------------------------------------------------------------*/
+#define     CAN_TX_MAILBOXES        (3)
+
+/*FMI dispatch table entries per FIFO: CAN_FMI_MAX rounded up to a power of two so the index is masked, not checked*/
+#define     CAN_FMI_TABLE_SIZE      (64)
+
+/*TSR flags of one mailbox (8 bits per mailbox), written as a whole word: RQCP is rc_w1 and ABRQ is rs
+*so writing 0 to the other bits has no effect*/
+#define     CAN_TSR_RQCP(MB)        ((uint32)0x01 << ((MB) * 8))
+#define     CAN_TSR_TXOK(MB)        ((uint32)0x02 << ((MB) * 8))
+#define     CAN_TSR_ALST(MB)        ((uint32)0x04 << ((MB) * 8))
+#define     CAN_TSR_TERR(MB)        ((uint32)0x08 << ((MB) * 8))
+#define     CAN_TSR_ABRQ(MB)        ((uint32)0x80 << ((MB) * 8))
+#define     CAN_TSR_TME(MB)         ((uint32)0x01 << (26 + (MB)))
+
+/*RFR flags, FULL and FOVR are rc_w1 and RFOM is rs: write the word with only the wanted bit*/
+#define     CAN_RFR_FULL            ((uint32)0x08)
+#define     CAN_RFR_FOVR            ((uint32)0x10)
+#define     CAN_RFR_RFOM            ((uint32)0x20)
+
+/*MSR error interrupt flag, rc_w1 like WKUI and SLAKI so the word is written with only this bit*/
+#define     CAN_MSR_ERRI            ((uint32)0x04)
+#define     CAN_MSR_INAK            ((uint32)0x01)
+
+/*AbortRequested of a mailbox shadow: what the TX interrupt does with a frame aborted by the driver*/
+#define     CAN_ABORT_NONE          (0)
+#define     CAN_ABORT_REQUEUE       (1)     /*preempted by a more urgent frame or bus-off: back to the queue*/
+#define     CAN_ABORT_DROP          (2)     /*superseded by a fresher copy: discarded*/
+
+/*MCR bits used by the bus-off recovery*/
+#define     CAN_MCR_INRQ            ((uint32)0x01)
+#define     CAN_MCR_ABOM            ((uint32)0x40)
+#define     CAN_MCR_TTCM            ((uint32)0x80)
+
+/*BTR fields of the 64-bit time stamps: prescaler and quanta per bit (SYNC + TS1 + TS2)*/
+#define     CAN_BTR_BRP(BTR)        ((((uint32)(BTR)) & 0x3FF) + 1)
+#define     CAN_BTR_QUANTA(BTR)     (3 + ((((uint32)(BTR)) >> 16) & 0x0F) + ((((uint32)(BTR)) >> 20) & 0x07))
+
+/*bits from SOF to the 6th EOF bit, where a received frame becomes valid, without stuff bits:
+  standard 19 + 8n + 24, extended 39 + 8n + 24 (n = 0 for a remote frame)*/
+#define     CAN_TS_FRAME_BITS(ID,DLC)   ((((ID) & CAN_FRAME_ID_IDE) ? 63U : 43U) + \
+                                         (((ID) & CAN_FRAME_ID_RTR) ? 0U : 8U * (DLC)))
+
+/*ESR fields*/
+#define     CAN_ESR_EWGF            ((uint32)0x01)
+#define     CAN_ESR_EPVF            ((uint32)0x02)
+#define     CAN_ESR_BOFF            ((uint32)0x04)
+#define     CAN_ESR_LEC(ESR)        ((uint8)(((ESR) >> 4) & 0x07))
+#define     CAN_ESR_TEC(ESR)        ((uint8)((ESR) >> 16))
+#define     CAN_ESR_REC(ESR)        ((uint8)((ESR) >> 24))
+
+/*keep the compiler from moving ring slot accesses across the index update (single core, no reordering in hardware)*/
+#define     CAN_COMPILER_BARRIER()  __asm volatile ("" ::: "memory")
+
+/*TIR request bit, bit 0 of an identifier word in TIR/RIR layout (reserved in RIR)*/
+#define     CAN_TIR_TXRQ            ((uint32)0x01)
+
+/*TDTR word of a packed frame: DLC in bits 3:0, CAN_FRAME_DLC_TGT (bit 7 of the DLC byte) moved to TGT (bit 8)*/
+#define     CAN_TDTR_WORD(DLC)      (((uint32)(DLC) & 0x0F) | (((uint32)(DLC) & CAN_FRAME_DLC_TGT) << 1))
+
+/*RDTR fields*/
+#define     CAN_RDTR_DLC(RDTR)      ((uint8)((RDTR) & 0x0F))
+#define     CAN_RDTR_FMI(RDTR)      ((uint8)((RDTR) >> 8))
+#define     CAN_RDTR_TIME(RDTR)     ((uint16)((RDTR) >> 16))
+
+/*identifier of the legacy frame structures in TIR layout: STID/EXID[28:18] | EXID[17:0] | IDE | RTR,
+*it is also the arbitration key of the TX queue (lower key wins)*/
+#define     CAN_TX_KEY(IDE,STDID,EXTID,RTR)     (((IDE) == CAN_ID_STD) ?                                         \
+                                                (((uint32)(STDID) << 21) | ((uint32)(RTR) << 1)) :              \
+                                                (((uint32)(EXTID) << 3) | ((uint32)1 << 2) | ((uint32)(RTR) << 1)))
+
+/*the TX queue and the mailbox shadows are shared by the TX interrupt, the bus-off handling and any context
+*that transmits (main loop or an interrupt of another priority): they are modified with the interrupts
+*masked. PRIMASK is saved in STATE (a uint32 local) and restored, so the sections nest and are usable
+*from an interrupt; keep them short, they delay every interrupt*/
+#define     CAN_TX_LOCK(STATE)      ((STATE) = CAN_u32IrqSave())
+#define     CAN_TX_UNLOCK(STATE)    (CAN_VoidIrqRestore(STATE), CAN_HW_SYNC())
+
+#ifdef CAN_SIMULATION
+/*host build: the registers are those of the node selected in the CANSIM bus model. The writes with a side
+*effect (rc_w1 / rs bits, TXRQ, RFOM) go through the model, CAN_HW_SYNC lets it apply mode changes and
+*raise interrupts, one bit time per poll of a wait loop*/
+typedef struct
+{
+    CAN_CONTROL_STATUS_t Control;
+    CAN_MAILBOX_REGISTERS_t Mailbox;
+    CAN_FILTER_REGISTERS_t Filter;
+}CAN_SIM_REGISTERS_t;
+
+extern CAN_SIM_REGISTERS_t* volatile CANSIM_pRegs;
+
+void CANSIM_VoidWriteTsr(uint32 u32Value);
+void CANSIM_VoidWriteRfr(uint8 u8Fifo,uint32 u32Value);
+void CANSIM_VoidWriteMsr(uint32 u32Value);
+void CANSIM_VoidWriteTir(uint8 u8Mailbox,uint32 u32Value);
+void CANSIM_VoidSync(void);
+uint32 CANSIM_u32IrqSave(void);
+void CANSIM_VoidIrqRestore(uint32 u32State);
+
+#define     CAN_u32IrqSave()            CANSIM_u32IrqSave()
+#define     CAN_VoidIrqRestore(STATE)   CANSIM_VoidIrqRestore(STATE)
+#define     CAN_TSR_WRITE(VALUE)        CANSIM_VoidWriteTsr(VALUE)
+#define     CAN_RFR_WRITE(FIFO,VALUE)   CANSIM_VoidWriteRfr((FIFO),(VALUE))
+#define     CAN_MSR_WRITE(VALUE)        CANSIM_VoidWriteMsr(VALUE)
+#define     CAN_TIR_WRITE(MB,VALUE)     CANSIM_VoidWriteTir((MB),(VALUE))
+#define     CAN_HW_SYNC()               CANSIM_VoidSync()
+
+#define 	CAN_Control 		((volatile CAN_CONTROL_STATUS_t *) &CANSIM_pRegs->Control)
+#define 	CAN_Mailbox 		((volatile CAN_MAILBOX_REGISTERS_t *) &CANSIM_pRegs->Mailbox)
+#define 	CAN_Filter 		((volatile CAN_FILTER_REGISTERS_t *) &CANSIM_pRegs->Filter)
+#else
+#define     CAN_TSR_WRITE(VALUE)        (CAN_Control->TSR.r = (VALUE))
+#define     CAN_RFR_WRITE(FIFO,VALUE)   (CAN_Control->RFR[(FIFO)].r = (VALUE))
+#define     CAN_MSR_WRITE(VALUE)        (CAN_Control->MSR = (VALUE))
+#define     CAN_TIR_WRITE(MB,VALUE)     (CAN_Mailbox->Txmailbox[(MB)].TIR.r = (VALUE))
+#define     CAN_HW_SYNC()               ((void)0)
+
+/*PRIMASK of the caller, then every maskable interrupt off*/
+static inline uint32 CAN_u32IrqSave(void)
+{
+    uint32 Local_u32Primask;
+    __asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (Local_u32Primask) :: "memory");
+    return Local_u32Primask;
+}
+/*back to the PRIMASK saved by CAN_u32IrqSave: interrupts stay off inside an outer section*/
+static inline void CAN_VoidIrqRestore(uint32 u32Primask)
+{
+    __asm volatile ("msr primask, %0" :: "r" (u32Primask) : "memory");
+}
+
 #define 	CAN_Base_Address        0x40006400          // Base address of bxCAN1
 
 #define 	CAN_Control 		((volatile CAN_CONTROL_STATUS_t *) CAN_Base_Address)
 #define 	CAN_Mailbox 		((volatile CAN_MAILBOX_REGISTERS_t *) (CAN_Base_Address +0x180 ) )
 #define 	CAN_Filter 		((volatile CAN_FILTER_REGISTERS_t *) (CAN_Base_Address +0x200 ) )
+#endif
 
 #endif
@@ -17,6 +17,7 @@
 
 #include "../../LIB/Std_Types.h"
 #include "../../LIB/Bit_Math.h"
+#include "../../LIB/Bit_Band.h"
 
 #include "CAN_config.h"
 #include "CAN_private.h"
@@ -26,6 +27,116 @@
 #include "../GPIO/GPIO_interface.h"
 #include "../RCC/RCC_interface.h"
 #include "../AFIO/AFIO_interface.h"
+#include "../SYSTick/SYSTick_interface.h"
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA TYPES AND STRUCTURES
+---------------------------------------------------------------------------------------------------------------------*/
+/*copy of the frame held by each hardware mailbox, needed to requeue it after an abort*/
+typedef struct
+{
+    CAN_Frame_t Frame;
+    uint8 Pending;          /*frame loaded and not yet completed*/
+    uint8 AbortRequested;   /*ABRQ set by the driver, CAN_ABORT_REQUEUE or CAN_ABORT_DROP*/
+}CAN_TxMailboxShadow_t;
+
+/*one acceptance term of the filter compiler: identifiers with (id & Mask) == Value*/
+typedef struct
+{
+    uint32 Value;
+    uint32 Mask;
+    uint8 IDE;
+    uint8 FIFO;
+}CAN_FilterTerm_t;
+
+/*handler and context of one filter*/
+typedef struct
+{
+    CAN_FrameHandler_t Handler;
+    void* Context;
+}CAN_FilterHandler_t;
+
+/*bus monitor totals, they only grow and are each written by one interrupt; a statistics window is the
+*difference between two snapshots so the interrupts never race with a reset*/
+typedef struct
+{
+    uint32 FramesRx[2];
+    uint32 BitsRx[2];
+    uint32 FramesTx;
+    uint32 BitsTx;
+    uint32 ArbitrationLost;
+    uint32 TxErrors;
+    uint32 Lec[CAN_LEC_COUNT];
+}CAN_MonitorTotals_t;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA
+---------------------------------------------------------------------------------------------------------------------*/
+/*software TX queue sorted by Id (the arbitration key), highest priority (lowest Id) at the end
+*so the next frame is popped in O(1). New frames are accepted up to CAN_TX_QUEUE_SIZE, the extra slots
+*keep room for every frame the mailboxes may give back (abort for a more urgent frame, bus-off)*/
+static CAN_Frame_t CAN_TxQueue[CAN_TX_QUEUE_SIZE + CAN_TX_MAILBOXES];
+static volatile uint8 CAN_TxQueueCount = 0;
+
+static CAN_TxMailboxShadow_t CAN_TxShadow[CAN_TX_MAILBOXES];
+/*set during bus-off: frames stay in the queue, the mailboxes are not refilled*/
+static volatile uint8 CAN_TxHold = 0;
+
+/*single producer (FIFO interrupt) / single consumer (main loop) RX rings, Head is written by the
+*interrupt only and Tail by the consumer only so no locking is needed*/
+static CAN_Frame_t CAN_RxRing[2][CAN_RX_RING_SIZE];
+/*start of frame of each ring slot (MCAN_u64RxStamp), out of CAN_Frame_t so the slots stay 16 bytes*/
+static uint64 CAN_RxStamp[2][CAN_RX_RING_SIZE];
+static volatile uint16 CAN_RxRingHead[2] = {0,0};
+static volatile uint16 CAN_RxRingTail[2] = {0,0};
+static volatile uint8 CAN_RxRingEnabled[2] = {0,0};
+static volatile CAN_RxRingStatus_t CAN_RxRingStatus[2];
+
+/*work buffer of the filter compiler*/
+static CAN_FilterTerm_t CAN_FilterTerms[CAN_FILTER_MAX_TERMS];
+
+/*handlers attached per bank / filter in bank, and the FMI table built from them and the bank configuration*/
+static CAN_FilterHandler_t CAN_BankHandlers[CAN_FILTER_BANKS][CAN_FILTERS_PER_BANK];
+static CAN_FilterHandler_t CAN_DefaultHandler = {NULL,NULL};
+static CAN_FilterHandler_t CAN_FmiTable[2][CAN_FMI_TABLE_SIZE];
+
+/*bits on the bus of a data frame per IDE and DLC: fixed fields + 8*DLC + worst case stuff bits over
+*SOF..CRC + 3 bit interframe space (standard 47 + 8n + (33+8n)/4, extended 67 + 8n + (53+8n)/4)*/
+static const uint8 CAN_FrameBits[2][9] =
+{
+    { 55,  65,  75,  85,  95, 105, 115, 125, 135},
+    { 80,  90, 100, 110, 120, 130, 140, 150, 160}
+};
+/*nominal bit rate of each BAUDRATE option, used for the bus load*/
+static const uint16 CAN_BitrateKbpsTable[7] = {50, 100, 125, 250, 500, 800, 1000};
+static uint16 CAN_u16BitrateKbps = 1000;
+
+static volatile CAN_MonitorTotals_t CAN_MonitorTotals;
+static CAN_MonitorTotals_t CAN_MonitorLast;
+/*extremes of the current window, restarted by each snapshot*/
+static volatile CAN_BusStats_t CAN_MonitorWindow;
+
+/*bus-off recovery*/
+static uint8 CAN_RecoveryMode = CAN_RECOVERY_OFF;
+static volatile uint8 CAN_RecoveryState = CAN_RECOVERY_ACTIVE;
+static uint32 CAN_RecoveryTicks = 0;
+static uint16 CAN_RecoveryTimer = 0;
+static uint32 CAN_RecoveryStableTicks = 0;
+static uint8 CAN_BackoffLevel = 0;
+static CAN_BusOffEpisode_t CAN_BusOffEpisodes[CAN_BUSOFF_EPISODES];
+static uint16 CAN_BusOffEpisodeCount = 0;
+
+/*64-bit time stamps: one anchor maps the TIME bit counter to the cycle counter*/
+static uint8 CAN_TsEnabled = 0;
+static uint8 CAN_TsValid = 0;               /*anchor set by a received frame*/
+static uint32 CAN_TsCyclesPerBit = 0;
+static uint32 CAN_TsAnchorTicks = 0;        /*TIME of the anchor frame, extended (only the low 16 bits matter)*/
+static uint64 CAN_TsAnchorCycles = 0;       /*its start of frame in HCLK cycles*/
+
+/*mailbox kept out of the queue for an external scheduler, and the result of its last frame*/
+static volatile uint8 CAN_TxReserved = CAN_MAILBOX_NONE;
+static volatile uint8 CAN_ReservedStatus = CAN_RESERVED_IDLE;
+static volatile uint64 CAN_ReservedSof = 0;
 
 /*---------------------------------------------------------------------------------------------------------------------
  *  Global Variables
@@ -68,411 +179,2202 @@ void (*CAN_Multi_Error_Callback)();//Error from the errors in Error code(ack , s
 extern uint8 Error_Code;
 
 /*---------------------------------------------------------------------------------------------------------------------
- *  GLOBAL FUNCTIONS
+ *  LOCAL FUNCTIONS
 ---------------------------------------------------------------------------------------------------------------------*/
 /******************************************************************************
-* \Syntax          : void MCAN_VoidInit(const CAN_InitTypeDef* pInitConfig)                                      
-* \Description     : initialize CAN asnd check the default configuation supported                                                                             
-* \Sync\Async      : Synchronous                                               
-* \Reentrancy      : Non Reentrant                                             
-* \Parameters (in) : pInitConfig  pointer to CAN initalization configurations.                   
-* \Parameters (out): None                                                      
-* \Return value:   : None
+* \Description     : bits a frame takes on the bus (remote frames carry no data field)
 *******************************************************************************/
-void MCAN_VoidInit(const CAN_InitTypeDef* pInitConfig) 
+static uint8 CAN_u8FrameBits(uint32 u32Id,uint8 u8Dlc)
 {
-    /*Enable CAN clock and setup the AFIO configuarions*/
-    MRCC_voidEnableClock(RCC_APB1,PERIPHERAL_EN_CAN1);
-    MRCC_voidEnableClock(RCC_APB2,PERIPHERAL_EN_AFIO);
-    MRCC_voidEnableClock(RCC_APB2,PERIPHERAL_EN_IOPB);
+    u8Dlc &= 0x0F;
+    if((u32Id & CAN_FRAME_ID_RTR)!=0)
+    {
+        u8Dlc = 0;
+    }
+    else if(u8Dlc > 8)
+    {
+        u8Dlc = 8;
+    }
+    return CAN_FrameBits[(u32Id & CAN_FRAME_ID_IDE)!=0][u8Dlc];
+}
 
-    /*set AFIO pins*/
-    MAFIO_voidRemapPeripheralPins(CAN_REMAP);//Rx pinB8, TX pinB9
-    /*setup AFIO pins for CAN Tx,Rx */
-    MGPIO_VoidSetPinMode_TYPE(_GPIOB_PORT,pin8,INPUT_FLOATING);//RX
-    MGPIO_VoidSetPinMode_TYPE(_GPIOB_PORT,pin9,OUTPUT_SPEED_2MHZ_AFPUSHPULL);//RX
+/******************************************************************************
+* \Description     : first empty mailbox the queue may use, CAN_MAILBOX_NONE when all are pending or reserved
+*******************************************************************************/
+static uint8 CAN_u8FreeMailbox(void)
+{
+    uint32 Local_u32Tsr = CAN_Control->TSR.r;
+    uint8 Local_u8Mailbox;
 
-    /* After Reset CAN boot up in sleep mode
-    first we need to exit from it*/
-    //clear SLEEP bit
-    CLEAR_BIT(CAN_Control->MCR,1);	
-    /* wait to exit sleep mode SLAK bit ack of sleep  */
-    while (!(READ_BIT(CAN_Control->MSR,1) == 0));
+    for(Local_u8Mailbox=0;Local_u8Mailbox<CAN_TX_MAILBOXES;Local_u8Mailbox++)
+    {
+        if(Local_u8Mailbox != CAN_TxReserved && (Local_u32Tsr & CAN_TSR_TME(Local_u8Mailbox)) != 0)
+        {
+            break;
+        }
+    }
+    return Local_u8Mailbox;
+}
 
-    /*Switch to initialization mode for init*/
-    /*set INRQ bit */
-    SET_BIT(CAN_Control->MCR,0);
-    /*wait until hardware set the INAK bit ack of init*/
-    while (!(READ_BIT(CAN_Control->MSR,0)==1));
-    
-    /*from bits of control register*/
+/******************************************************************************
+* \Description     : start a statistics window: extremes from the current error counters and queue levels
+*******************************************************************************/
+static void CAN_VoidMonitorWindowStart(void)
+{
+    uint32 Local_u32Esr = CAN_Control->ESR.r;
+    uint8 Local_u8Mailbox;
+    uint8 Local_u8Pending = 0;
 
-    /** CHECK Transmit FIFO priority **/
-    /** CHECK Receive FIFO locked mode **/
-    /** CHECK automatic retransmission **/
-    /** CHECK automatic wakeup mode **/
-    /** CHECK automatic bus-off management **/
-    /** CHECK Time triggered communication mode **/
-    
-    /** CHECK Transmit FIFO priority **/
-    if(pInitConfig->TransmitFifoPriority==CAN_ENABLE)
-    /*by identifer:lowest ID has higher priority. if all IDs is equal then lowest number mailbox is sent */
-    CLEAR_BIT(CAN_Control->MCR,2);//TXFP Transmit FIFO priority
-    else
-    /*by transmit request order*/
-    SET_BIT(CAN_Control->MCR,2);
+    CAN_MonitorWindow.TecMin = CAN_MonitorWindow.TecMax = CAN_ESR_TEC(Local_u32Esr);
+    CAN_MonitorWindow.RecMin = CAN_MonitorWindow.RecMax = CAN_ESR_REC(Local_u32Esr);
+    CAN_MonitorWindow.ErrorStateWorst = CAN_ERROR_ACTIVE;
+    for(Local_u8Mailbox=0;Local_u8Mailbox<CAN_TX_MAILBOXES;Local_u8Mailbox++)
+    {
+        Local_u8Pending += CAN_TxShadow[Local_u8Mailbox].Pending;
+    }
+    CAN_MonitorWindow.TxMailboxHighWater = Local_u8Pending;
+    CAN_MonitorWindow.TxQueueHighWater = CAN_TxQueueCount;
+    CAN_MonitorWindow.RxFifoHighWater[0] = (uint8)CAN_Control->RFR[0].B.FMP;
+    CAN_MonitorWindow.RxFifoHighWater[1] = (uint8)CAN_Control->RFR[1].B.FMP;
+    CAN_MonitorWindow.RxRingHighWater[0] = (uint16)(CAN_RxRingHead[0] - CAN_RxRingTail[0]);
+    CAN_MonitorWindow.RxRingHighWater[1] = (uint16)(CAN_RxRingHead[1] - CAN_RxRingTail[1]);
+}
 
-    /** CHECK Receive FIFO locked mode **/
-    /*RFLM: Receive FIFO locked mode
-    0: Receive FIFO not locked on overrun. Once a receive FIFO is full the next incoming
-    message will overwrite the previous one.
-    1: Receive FIFO locked against overrun. Once a receive FIFO is full the next incoming
-    message will be discarded.*/
-    // #if ReceiveFIFOLockedMode == CAN_ENABLE
-    if(pInitConfig->ReceiveFifoLocked==CAN_ENABLE)
-    SET_BIT(CAN_Control->MCR,3);//discard
-    else
-    CLEAR_BIT(CAN_Control->MCR,3);//overwrite
-    
+/******************************************************************************
+* \Description     : load a frame into a free mailbox, keep its copy and request transmission,
+*                    one word store per register and TXRQ set together with the identifier
+* \Parameters (in) : u8Mailbox empty mailbox number, pFrame frame to load
+*******************************************************************************/
+static void CAN_VoidLoadMailbox(uint8 u8Mailbox,const CAN_Frame_t* pFrame)
+{
+    volatile CAN_TXMailBoxes_t* Local_pMailbox = &CAN_Mailbox->Txmailbox[u8Mailbox];
+    uint8 Local_u8Pending;
 
-    /*NART: No automatic retransmission
-    0: The CAN hardware will automatically retransmit the message until it has been
-    successfully transmitted according to the CAN standard.
-    1: A message will be transmitted only once, independently of the transmission result
-    (successful, error or arbitration lost).*/
-    if(pInitConfig->AutoRetransmission ==CAN_DISABLE)    
-    SET_BIT(CAN_Control->MCR,4);
-    else
-    CLEAR_BIT(CAN_Control->MCR,4);
-    
-    /*AWUM: Automatic wakeup mode
-    This bit controls the behavior of the CAN hardware on message reception during Sleep
-    mode.
-    0: The Sleep mode is left on software request by clearing the SLEEP bit of the CAN_MCR
-    register.
-    1: The Sleep mode is left automatically by hardware on CAN message detection.
-    */
-   if(pInitConfig->AutoWakeUp==CAN_ENABLE)
-    SET_BIT(CAN_Control->MCR,5);
-    else
-    CLEAR_BIT(CAN_Control->MCR,5);
-    
-    /*ABOM: Automatic bus-off management
-    This bit controls the behavior of the CAN hardware on leaving the Bus-Off state.
-    0: The Bus-Off state is left on software request, once 128 occurrences of 11 recessive bits
-    have been monitored and the software has first set and cleared the INRQ bit of the
-    CAN_MCR register.
-    1: The Bus-Off state is left automatically by hardware once 128 occurrences of 11 recessive
-    bits have been monitored.*/
-    if(pInitConfig->AutoBusOff==CAN_ENABLE)
-    SET_BIT(CAN_Control->MCR,6);
-    else
-    CLEAR_BIT(CAN_Control->MCR,6);
-    
-    /*Time stamp in TX and RX mailbox*/
-    if (pInitConfig->TimeTriggeredMode==CAN_ENABLE)
-    SET_BIT(CAN_Control->MCR,7);
-    else
-    CLEAR_BIT(CAN_Control->MCR,7);
-    
-    CAN_BitTimingConfig CAN_bitRateConfig[7] = {{2, 13, 10}, {2, 13, 5}, {2, 13, 4}, {2, 13, 2}, {2, 13, 1},{1, 8, 1}, {1, 6, 1}};
+    Local_pMailbox->TDTR.r = CAN_TDTR_WORD(pFrame->DLC);
+    Local_pMailbox->TDLR.r = pFrame->Data.Words[0];
+    Local_pMailbox->TDHR.r = pFrame->Data.Words[1];
 
+    CAN_TxShadow[u8Mailbox].Frame = *pFrame;
+    CAN_TxShadow[u8Mailbox].Pending = 1;
+    CAN_TxShadow[u8Mailbox].AbortRequested = CAN_ABORT_NONE;
+    Local_u8Pending = CAN_TxShadow[0].Pending + CAN_TxShadow[1].Pending + CAN_TxShadow[2].Pending;
+    if(Local_u8Pending > CAN_MonitorWindow.TxMailboxHighWater)
+    {
+        CAN_MonitorWindow.TxMailboxHighWater = Local_u8Pending;
+    }
 
+    /*Identifier and request to send*/
+    CAN_TIR_WRITE(u8Mailbox,pFrame->Id | CAN_TIR_TXRQ);
+}
 
-    /** Set the bit timing register **/
-    // CAN_Control->BTR = (uint32) (
-	// 	  (((CAN_bitRateConfig[BAUDRATE].TS2-1) << 20) |
-	// 	  ((CAN_bitRateConfig[BAUDRATE].TS1-1) << 16) |
-	// 	  (CAN_bitRateConfig[BAUDRATE].BRP-1)));
-    CAN_Control->BTR.B.TS2 = (CAN_bitRateConfig[BAUDRATE].TS2-1);
-    CAN_Control->BTR.B.TS1 = (CAN_bitRateConfig[BAUDRATE].TS1-1);
-    CAN_Control->BTR.B.BRP = (CAN_bitRateConfig[BAUDRATE].BRP-1);
-    
-    
-			
-    /*Testing mode*/
-    if( pInitConfig->Mode == CAN_MODE_NORMAL)
+/******************************************************************************
+* \Description     : insert a frame in the priority queue, frames with equal key keep FIFO order
+* \Parameters (in) : pFrame frame to insert, u8Ahead 1 to go before frames with the same key
+*                    (used for a frame taken back from a mailbox or replacing one, it may use the
+*                    CAN_TX_MAILBOXES slots above CAN_TX_QUEUE_SIZE)
+* \Return value:   : Std_ReturnType N_OK when the queue is full
+*******************************************************************************/
+static Std_ReturnType CAN_u8TxQueueInsert(const CAN_Frame_t* pFrame,uint8 u8Ahead)
+{
+    uint8 Local_u8Pos = CAN_TxQueueCount;
+    /*a new frame enters only below CAN_TX_QUEUE_SIZE, so the queue plus the pending mailboxes never hold
+    *more than CAN_TX_QUEUE_SIZE + CAN_TX_MAILBOXES frames and a frame given back always finds a slot*/
+    uint8 Local_u8Limit = (u8Ahead != 0) ? (CAN_TX_QUEUE_SIZE + CAN_TX_MAILBOXES) : CAN_TX_QUEUE_SIZE;
+    if(CAN_TxQueueCount >= Local_u8Limit)
     {
-        CAN_Control->BTR.B.SILM=0;
-        CAN_Control->BTR.B.LBKM=0;
+        return N_OK;
     }
-    else if( pInitConfig->Mode == CAN_MODE_SILENT)/*receive only*/
+    /*the array is sorted by descending key: shift the more urgent frames up by one*/
+    while(Local_u8Pos > 0)
     {
-        CAN_Control->BTR.B.SILM=1;
-        CAN_Control->BTR.B.LBKM=0;
+        uint32 Local_u32Key = CAN_TxQueue[Local_u8Pos-1].Id;
+        if(Local_u32Key > pFrame->Id || (u8Ahead != 0 && Local_u32Key == pFrame->Id))
+        {
+            break;
+        }
+        CAN_TxQueue[Local_u8Pos] = CAN_TxQueue[Local_u8Pos-1];
+        Local_u8Pos--;
     }
-    else if( pInitConfig->Mode == CAN_MODE_LOOPBACK)
+    CAN_TxQueue[Local_u8Pos] = *pFrame;
+    CAN_TxQueueCount++;
+    if(CAN_TxQueueCount > CAN_MonitorWindow.TxQueueHighWater)
     {
-        CAN_Control->BTR.B.SILM=0;
-        CAN_Control->BTR.B.LBKM=1;
+        CAN_MonitorWindow.TxQueueHighWater = CAN_TxQueueCount;
     }
-    else if( pInitConfig->Mode == CAN_MODE_SILENT_LOOPBACK)
+    return OK;
+}
+
+/******************************************************************************
+* \Description     : move queued frames into the empty mailboxes, most urgent first
+*******************************************************************************/
+static void CAN_VoidTxQueueRefill(void)
+{
+    uint8 Local_u8Mailbox;
+    for(Local_u8Mailbox=0;Local_u8Mailbox<CAN_TX_MAILBOXES && CAN_TxQueueCount>0 && CAN_TxHold==0;Local_u8Mailbox++)
     {
-        CAN_Control->BTR.B.SILM=1;
-        CAN_Control->BTR.B.LBKM=1;
+        if(Local_u8Mailbox != CAN_TxReserved && (CAN_Control->TSR.r & CAN_TSR_TME(Local_u8Mailbox)) != 0)
+        {
+            CAN_TxQueueCount--;
+            CAN_VoidLoadMailbox(Local_u8Mailbox,&CAN_TxQueue[CAN_TxQueueCount]);
+        }
     }
-    else{}
+}
+
+/******************************************************************************
+* \Description     : when every mailbox is pending and the queue head beats the least urgent one,
+*                    abort that mailbox; the TX interrupt requeues it and loads the queue head
+*******************************************************************************/
+static void CAN_VoidTxPreempt(void)
+{
+    uint8 Local_u8Mailbox;
+    uint8 Local_u8Victim = CAN_TX_MAILBOXES;
+    uint32 Local_u32VictimKey = 0;
 
+    if(CAN_TxQueueCount == 0 || CAN_TxHold != 0)
+    {
+        return;
+    }
+    for(Local_u8Mailbox=0;Local_u8Mailbox<CAN_TX_MAILBOXES;Local_u8Mailbox++)
+    {
+        if(Local_u8Mailbox == CAN_TxReserved)
+        {
+            /*never taken back by the queue*/
+            continue;
+        }
+        if((CAN_Control->TSR.r & CAN_TSR_TME(Local_u8Mailbox)) != 0)
+        {
+            /*a mailbox is still free, refill will use it*/
+            return;
+        }
+        if(CAN_TxShadow[Local_u8Mailbox].AbortRequested != 0)
+        {
+            /*one abort at a time*/
+            return;
+        }
+        if(CAN_TxShadow[Local_u8Mailbox].Frame.Id >= Local_u32VictimKey)
+        {
+            Local_u32VictimKey = CAN_TxShadow[Local_u8Mailbox].Frame.Id;
+            Local_u8Victim = Local_u8Mailbox;
+        }
+    }
+    if(Local_u8Victim < CAN_TX_MAILBOXES && CAN_TxQueue[CAN_TxQueueCount-1].Id < Local_u32VictimKey)
+    {
+        CAN_TxShadow[Local_u8Victim].AbortRequested = CAN_ABORT_REQUEUE;
+        CAN_TSR_WRITE(CAN_TSR_ABRQ(Local_u8Victim));
+    }
 }
 
 /******************************************************************************
-* \Syntax          : void MCAN_VoidConfigureIDFilter(CAN_Filter_t *pFilterConfig)                                      
-* \Description     : initialize CAN filter banks and filers modes based on configuraion parameters                                                                          
-* \Sync\Async      : Synchronous                                               
-* \Reentrancy      : Non Reentrant                                             
-* \Parameters (in) : CAN_Filter_t *pFilterConfig                   
-* \Parameters (out): None                                                      
-* \Return value:   : None
+* \Description     : bus-off detected: hold the TX queue, take the pending mailboxes back (ABRQ, the TX
+*                    interrupt requeues them ahead of equal keys in the slots kept above CAN_TX_QUEUE_SIZE,
+*                    so every held frame is replayed), open an episode and start the recovery
+* \Parameters (in) : u8Lec last error code read before the monitor cleared it
 *******************************************************************************/
-void MCAN_VoidConfigureIDFilter(CAN_Filter_t *pFilterConfig)
+static void CAN_VoidBusOffEnter(uint8 u8Lec)
 {
-    /*at first we enter initalization mode for filter banks FINIT=1 in CAN_FMR*/
-    SET_BIT(CAN_Filter->FMR,0);
-    /*deactivate the filter bank to start the init  in CAN_FA1R filter number bit*/
-    CLEAR_BIT(CAN_Filter->FA1R,pFilterConfig->FilterBank);
+    CAN_BusOffEpisode_t* Local_pEpisode = &CAN_BusOffEpisodes[CAN_BusOffEpisodeCount % CAN_BUSOFF_EPISODES];
+    uint8 Local_u8Mailbox;
+    uint8 Local_u8Held;
+    uint32 Local_u32Irq;
 
-		
-		/*set the Mode*/
-			if(pFilterConfig->filterMode == CAN_IDENTIFIERLIST_MODE)
-			{
-				SET_BIT(CAN_Filter->FM1R,pFilterConfig->FilterBank);
-			}
-			else if( pFilterConfig->filterMode == CAN_MASK_MODE)
-			{
-				CLEAR_BIT(CAN_Filter->FM1R,pFilterConfig->FilterBank);
-			}
-			else{}
-	
-    /*configure filter bank according to mode and scalable width*/
-    if(pFilterConfig->filterScalableWidth == CAN_ONE_32BIT_FILTER)
+    if(CAN_RecoveryState != CAN_RECOVERY_ACTIVE)
     {
-        /*set scale width*/
-        SET_BIT(CAN_Filter->FS1R,pFilterConfig->FilterBank);
-			/*ID in mask mode or first ID in ID List*/
-			/*																																STDID -EXTID[17:13]				                 EXTID[12:5]	<-RTR		*/
-				CAN_Filter->FiRx[pFilterConfig->FilterBank].FxR1 = (((0x0000FFFF & pFilterConfig->FilterIdHigh) <<16) | pFilterConfig->FilterIdLow);
-			/*Mask in mask mode or second ID in ID List*/
-			/*																																STDID -EXTID[17:13]				                 EXTID[12:5]	<-RTR		*/
-				CAN_Filter->FiRx[pFilterConfig->FilterBank].FxR2 = (((0x0000FFFF & pFilterConfig->FilterMaskIdHigh) <<16) | pFilterConfig->FilterMaskIdLow);
-			
+        return;
+    }
+    CAN_TX_LOCK(Local_u32Irq);
+    Local_u8Held = CAN_TxQueueCount;
+    CAN_TxHold = 1;
+    for(Local_u8Mailbox=0;Local_u8Mailbox<CAN_TX_MAILBOXES;Local_u8Mailbox++)
+    {
+        if(CAN_TxShadow[Local_u8Mailbox].Pending != 0)
+        {
+            Local_u8Held++;
+            if(CAN_TxShadow[Local_u8Mailbox].AbortRequested == CAN_ABORT_NONE)
+            {
+                /*a scheduled frame is late after the recovery: dropped, its scheduler sees it failed*/
+                CAN_TxShadow[Local_u8Mailbox].AbortRequested = (Local_u8Mailbox == CAN_TxReserved) ? CAN_ABORT_DROP : CAN_ABORT_REQUEUE;
+                CAN_TSR_WRITE(CAN_TSR_ABRQ(Local_u8Mailbox));
+            }
+        }
+    }
+    CAN_TX_UNLOCK(Local_u32Irq);
+
+    /*a bus-off soon after the previous one doubles the delay*/
+    if(CAN_RecoveryStableTicks >= (CAN_BUSOFF_STABLE_MS / CAN_RECOVERY_TICK_MS))
+    {
+        CAN_BackoffLevel = 0;
+    }
+    if(CAN_BackoffLevel == 0)
+    {
+        CAN_RecoveryTimer = 0;
+    }
+    else
+    {
+        uint32 Local_u32Delay = (uint32)CAN_BUSOFF_BACKOFF_MIN_MS << (CAN_BackoffLevel - 1);
+        if(Local_u32Delay > CAN_BUSOFF_BACKOFF_MAX_MS)
+        {
+            Local_u32Delay = CAN_BUSOFF_BACKOFF_MAX_MS;
+        }
+        CAN_RecoveryTimer = (uint16)(Local_u32Delay / CAN_RECOVERY_TICK_MS);
+    }
+    /*stop doubling once the delay reached MAX*/
+    if(((uint32)CAN_BUSOFF_BACKOFF_MIN_MS << CAN_BackoffLevel) <= ((uint32)CAN_BUSOFF_BACKOFF_MAX_MS << 1))
+    {
+        CAN_BackoffLevel++;
+    }
+    CAN_RecoveryStableTicks = 0;
+
+    Local_pEpisode->StartTick = CAN_RecoveryTicks;
+    Local_pEpisode->DurationTicks = 0;
+    Local_pEpisode->BackoffTicks = (CAN_RecoveryMode == CAN_RECOVERY_BACKOFF) ? CAN_RecoveryTimer : 0;
+    Local_pEpisode->Lec = u8Lec;
+    Local_pEpisode->FramesHeld = Local_u8Held;
+    CAN_BusOffEpisodeCount++;
+
+    CAN_RecoveryState = (CAN_RecoveryMode == CAN_RECOVERY_BACKOFF) ? CAN_RECOVERY_WAIT_BACKOFF : CAN_RECOVERY_WAIT_BUS;
+}
+
+/******************************************************************************
+* \Description     : back on the bus: close the episode and replay the held queue, most urgent first
+*******************************************************************************/
+static void CAN_VoidBusOffLeave(void)
+{
+    CAN_BusOffEpisode_t* Local_pEpisode = &CAN_BusOffEpisodes[(CAN_BusOffEpisodeCount - 1) % CAN_BUSOFF_EPISODES];
+    uint32 Local_u32Irq;
+
+    Local_pEpisode->DurationTicks = CAN_RecoveryTicks - Local_pEpisode->StartTick;
+    CAN_RecoveryState = CAN_RECOVERY_ACTIVE;
+
+    CAN_TX_LOCK(Local_u32Irq);
+    CAN_TxHold = 0;
+    CAN_VoidTxQueueRefill();
+    CAN_TX_UNLOCK(Local_u32Irq);
+}
+
+/******************************************************************************
+* \Description     : map a TIME value to HCLK cycles through the anchor
+* \Parameters (in) : u16Time captured TIME, u64Now current cycles (after the capture)
+* \Parameters (out): pTicks TIME extended like the anchor
+* \Return value:   : uint64 HCLK cycles of the captured bit
+*******************************************************************************/
+static uint64 CAN_u64TsFromTime(uint16 u16Time,uint64 u64Now,uint32* pTicks)
+{
+    uint64 Local_u64Elapsed = u64Now - CAN_TsAnchorCycles;
+    uint64 Local_u64Bits;
+    uint16 Local_u16Back;
+    sint64 Local_s64Bits;
+
+    /*whole bits from the anchor to now, 32-bit division unless no frame came for 2^32 cycles*/
+    if((Local_u64Elapsed >> 32) == 0)
+    {
+        Local_u64Bits = (uint32)Local_u64Elapsed / CAN_TsCyclesPerBit;
+    }
+    else
+    {
+        Local_u64Bits = Local_u64Elapsed / CAN_TsCyclesPerBit;
+    }
+    /*the counter now, minus the bits since the captured value (wraps handled by the 16-bit difference)*/
+    Local_u16Back = (uint16)((uint16)(CAN_TsAnchorTicks + (uint32)Local_u64Bits) - u16Time);
+    Local_s64Bits = (sint64)Local_u64Bits - Local_u16Back;
+
+    *pTicks = CAN_TsAnchorTicks + (uint32)Local_s64Bits;
+    return CAN_TsAnchorCycles + (uint64)(Local_s64Bits * (sint64)CAN_TsCyclesPerBit);
+}
+
+/******************************************************************************
+* \Description     : start of frame of a frame just read from a FIFO, the anchor is moved to it
+* \Parameters (in) : pFrame frame with Id, DLC and TimeStamp
+* \Return value:   : uint64 start of frame in HCLK cycles
+*******************************************************************************/
+static uint64 CAN_u64TsStamp(const CAN_Frame_t* pFrame)
+{
+    uint64 Local_u64Now = MSYSTICK_u64GetCycles();
+    uint8 Local_u8Dlc = (pFrame->DLC > 8) ? 8 : pFrame->DLC;
+    uint32 Local_u32FrameCycles = CAN_TS_FRAME_BITS(pFrame->Id,Local_u8Dlc) * CAN_TsCyclesPerBit;
+    uint64 Local_u64Sof;
+    uint32 Local_u32Ticks;
+
+    if(CAN_TsValid == 0)
+    {
+        /*first frame: assume it is read right when it became valid*/
+        Local_u64Sof = Local_u64Now - Local_u32FrameCycles;
+        Local_u32Ticks = pFrame->TimeStamp;
+        CAN_TsValid = 1;
+    }
+    else
+    {
+        Local_u64Sof = CAN_u64TsFromTime(pFrame->TimeStamp,Local_u64Now,&Local_u32Ticks);
+        /*a frame is not read before it is valid: the mapping is late, move it earlier.
+          Never moved later, so it settles on the frame read with the lowest latency*/
+        if(Local_u64Sof + Local_u32FrameCycles > Local_u64Now)
+        {
+            Local_u64Sof = Local_u64Now - Local_u32FrameCycles;
+        }
+    }
+    CAN_TsAnchorTicks = Local_u32Ticks;
+    CAN_TsAnchorCycles = Local_u64Sof;
+    return Local_u64Sof;
+}
+
+/******************************************************************************
+* \Description     : cycles per bit from BTR and the clocks, forget the anchor (bit rate changed or restart)
+*******************************************************************************/
+static void CAN_VoidTsSetRate(void)
+{
+    uint32 Local_u32Btr = CAN_Control->BTR.r;
+
+    CAN_TsCyclesPerBit = CAN_BTR_BRP(Local_u32Btr) * CAN_BTR_QUANTA(Local_u32Btr) *
+                         (MRCC_u32GetHclkHz() / MRCC_u32GetPclk1Hz());
+    CAN_TsValid = 0;
+}
+
+/******************************************************************************
+* \Description     : result of the frame of the reserved mailbox, from the TX interrupt. A sent frame is
+*                    stamped like a received one: the interrupt follows its end of frame
+*******************************************************************************/
+static void CAN_VoidReservedComplete(uint8 u8Mailbox,uint32 u32Tsr)
+{
+    CAN_Frame_t Local_Frame;
+
+    if((u32Tsr & CAN_TSR_TXOK(u8Mailbox)) == 0)
+    {
+        CAN_ReservedStatus = CAN_RESERVED_FAILED;
+        return;
+    }
+    CAN_ReservedSof = 0;
+    if(CAN_TsEnabled != 0)
+    {
+        Local_Frame.Id = CAN_TxShadow[u8Mailbox].Frame.Id;
+        Local_Frame.DLC = CAN_TxShadow[u8Mailbox].Frame.DLC & 0x0F;
+        Local_Frame.TimeStamp = (uint16)CAN_Mailbox->Txmailbox[u8Mailbox].TDTR.B.TIME;
+        CAN_ReservedSof = CAN_u64TsStamp(&Local_Frame);
+    }
+    CAN_ReservedStatus = CAN_RESERVED_SENT;
+}
+
+/******************************************************************************
+* \Description     : read the oldest frame of a FIFO and release it, one word load per register
+* \Parameters (in) : RX_FIFO number of fifo to read from
+* \Parameters (out): pFrame received frame
+* \Return value:   : uint64 start of frame in HCLK cycles, 0 unless MCAN_u8EnableTimeStamps
+*******************************************************************************/
+static uint64 CAN_u64ReadFifo(uint8 RX_FIFO,CAN_Frame_t* pFrame)
+{
+    /*FIFO Registers Contain the frame to be read (the first received one)*/
+    volatile CAN_RXFIFO_t* Local_pFifo = &CAN_Mailbox->RXFIFO[RX_FIFO];
+    uint32 Local_u32Rdtr = Local_pFifo->RDTR.r;
+    uint8 Local_u8Waiting = (uint8)CAN_Control->RFR[RX_FIFO].B.FMP;
+    uint64 Local_u64Sof = 0;
+
+    pFrame->Id = Local_pFifo->RIR.r & ~CAN_TIR_TXRQ;
+    pFrame->DLC = CAN_RDTR_DLC(Local_u32Rdtr);
+    /*this index indicates which filter is accept this frame then it tells us this data related to which variable according to out mapping (index->variable)*/
+    pFrame->FMI = CAN_RDTR_FMI(Local_u32Rdtr);
+    pFrame->TimeStamp = CAN_RDTR_TIME(Local_u32Rdtr);
+    pFrame->Data.Words[0] = Local_pFifo->RDLR.r;
+    pFrame->Data.Words[1] = Local_pFifo->RDHR.r;
+
+    /*After reading the frame ,Release the FIFO to reduce the msgs count and receive another one*/
+    CAN_RFR_WRITE(RX_FIFO,CAN_RFR_RFOM);
+
+    if(CAN_TsEnabled != 0)
+    {
+        Local_u64Sof = CAN_u64TsStamp(pFrame);
+    }
+    else{}
+
+    CAN_MonitorTotals.FramesRx[RX_FIFO]++;
+    CAN_MonitorTotals.BitsRx[RX_FIFO] += CAN_u8FrameBits(pFrame->Id,pFrame->DLC);
+    if(Local_u8Waiting > CAN_MonitorWindow.RxFifoHighWater[RX_FIFO])
+    {
+        CAN_MonitorWindow.RxFifoHighWater[RX_FIFO] = Local_u8Waiting;
+    }
+    return Local_u64Sof;
+}
+
+/******************************************************************************
+* \Description     : interrupt side of the RX ring: empty the hardware FIFO completely,
+*                    frames that do not fit in the ring are released and counted
+* \Parameters (in) : RX_FIFO number of fifo to drain
+*******************************************************************************/
+static void CAN_VoidRxDrain(uint8 RX_FIFO)
+{
+    uint16 Local_u16Head = CAN_RxRingHead[RX_FIFO];
+
+    while(CAN_Control->RFR[RX_FIFO].B.FMP != 0)
+    {
+        if((uint16)(Local_u16Head - CAN_RxRingTail[RX_FIFO]) >= CAN_RX_RING_SIZE)
+        {
+            /*ring full: drop the frame so the hardware FIFO keeps accepting new ones*/
+            CAN_MonitorTotals.FramesRx[RX_FIFO]++;
+            CAN_MonitorTotals.BitsRx[RX_FIFO] += CAN_u8FrameBits(CAN_Mailbox->RXFIFO[RX_FIFO].RIR.r,
+                                                                  (uint8)CAN_Mailbox->RXFIFO[RX_FIFO].RDTR.r);
+            CAN_RFR_WRITE(RX_FIFO,CAN_RFR_RFOM);
+            CAN_RxRingStatus[RX_FIFO].SoftwareOverruns++;
+            continue;
+        }
+        CAN_RxStamp[RX_FIFO][Local_u16Head & (CAN_RX_RING_SIZE-1)] =
+            CAN_u64ReadFifo(RX_FIFO,&CAN_RxRing[RX_FIFO][Local_u16Head & (CAN_RX_RING_SIZE-1)]);
+        Local_u16Head++;
+        /*publish the slot only after it is completely written*/
+        CAN_COMPILER_BARRIER();
+        CAN_RxRingHead[RX_FIFO] = Local_u16Head;
+    }
+    if((uint16)(Local_u16Head - CAN_RxRingTail[RX_FIFO]) > CAN_MonitorWindow.RxRingHighWater[RX_FIFO])
+    {
+        CAN_MonitorWindow.RxRingHighWater[RX_FIFO] = (uint16)(Local_u16Head - CAN_RxRingTail[RX_FIFO]);
+    }
+
+    if(CAN_Control->RFR[RX_FIFO].B.FOVR == 1)
+    {
+        CAN_RxRingStatus[RX_FIFO].HardwareOverruns++;
+        CAN_RFR_WRITE(RX_FIFO,CAN_RFR_FOVR);
+    }
+    if(CAN_Control->RFR[RX_FIFO].B.FULL == 1)
+    {
+        CAN_RFR_WRITE(RX_FIFO,CAN_RFR_FULL);
+    }
+}
+
+/******************************************************************************
+* \Description     : number of identifiers a filter term accepts (2^don't care bits)
+*******************************************************************************/
+static uint32 CAN_u32FilterTermSize(uint32 u32Mask,uint8 u8IDE)
+{
+    uint8 Local_u8Width = (u8IDE==CAN_ID_STD) ? 11 : 29;
+    uint8 Local_u8Itr;
+    uint32 Local_u32Size = 1;
+    for(Local_u8Itr=0;Local_u8Itr<Local_u8Width;Local_u8Itr++)
+    {
+        if(READ_BIT(u32Mask,Local_u8Itr)==0)
+        {
+            Local_u32Size <<= 1;
+        }
+    }
+    return Local_u32Size;
+}
+
+/******************************************************************************
+* \Description     : append one bank image (or only count it when pImages is NULL)
+*******************************************************************************/
+static void CAN_VoidFilterEmit(CAN_FilterBankImage_t* pImages,uint8* pIndex,uint8 u8Bank,uint8 u8Mode,uint8 u8Scale,
+                               uint8 u8FIFO,uint32 u32FR1,uint32 u32FR2)
+{
+    if(pImages!=NULL)
+    {
+        pImages[*pIndex].Bank = u8Bank + *pIndex;
+        pImages[*pIndex].Mode = u8Mode;
+        pImages[*pIndex].Scale = u8Scale;
+        pImages[*pIndex].FIFO = u8FIFO;
+        pImages[*pIndex].FR1 = u32FR1;
+        pImages[*pIndex].FR2 = u32FR2;
+    }
+    (*pIndex)++;
+}
+
+/******************************************************************************
+* \Description     : pack the terms of one FIFO / identifier type into banks
+*                    standard: masks two per 16-bit mask bank (an odd slot takes a single id),
+*                              single ids four per 16-bit list bank
+*                    extended: masks one per 32-bit mask bank, single ids two per 32-bit list bank
+*                    unused list slots repeat the last id so they accept nothing new
+* \Parameters (in) : u8TermCount terms in CAN_FilterTerms, u8FIFO/u8IDE group, u8FirstBank bank of image 0
+* \Parameters (out): pImages images (NULL to count only), pIndex running image count
+*******************************************************************************/
+static void CAN_VoidFilterPackGroup(uint8 u8TermCount,uint8 u8FIFO,uint8 u8IDE,uint8 u8FirstBank,
+                                    CAN_FilterBankImage_t* pImages,uint8* pIndex)
+{
+    uint8 Local_au8Masks[CAN_FILTER_MAX_TERMS];
+    uint8 Local_au8Singles[CAN_FILTER_MAX_TERMS];
+    uint8 Local_u8MaskCount = 0;
+    uint8 Local_u8SingleCount = 0;
+    uint32 Local_u32Full = (u8IDE==CAN_ID_STD) ? 0x7FF : 0x1FFFFFFF;
+    uint8 Local_u8M = 0;
+    uint8 Local_u8S = 0;
+    uint8 Local_u8Itr;
+
+    for(Local_u8Itr=0;Local_u8Itr<u8TermCount;Local_u8Itr++)
+    {
+        if(CAN_FilterTerms[Local_u8Itr].FIFO!=u8FIFO || CAN_FilterTerms[Local_u8Itr].IDE!=u8IDE)
+        {
+            continue;
+        }
+        if(CAN_FilterTerms[Local_u8Itr].Mask==Local_u32Full)
+        {
+            Local_au8Singles[Local_u8SingleCount++] = Local_u8Itr;
+        }
+        else
+        {
+            Local_au8Masks[Local_u8MaskCount++] = Local_u8Itr;
+        }
+    }
+
+    if(u8IDE==CAN_ID_STD)
+    {
+        while(Local_u8M<Local_u8MaskCount)
+        {
+            const CAN_FilterTerm_t* Local_pFirst = &CAN_FilterTerms[Local_au8Masks[Local_u8M++]];
+            const CAN_FilterTerm_t* Local_pSecond = Local_pFirst;
+            if(Local_u8M<Local_u8MaskCount)
+            {
+                Local_pSecond = &CAN_FilterTerms[Local_au8Masks[Local_u8M++]];
+            }
+            else if(Local_u8S<Local_u8SingleCount)
+            {
+                Local_pSecond = &CAN_FilterTerms[Local_au8Singles[Local_u8S++]];
+            }
+            CAN_VoidFilterEmit(pImages,pIndex,u8FirstBank,CAN_MASK_MODE,CAN_TWO16BIT_FILTER,u8FIFO,
+                (CAN_FILTER16_STD_MASK(Local_pFirst->Mask) << 16) | CAN_FILTER16_STD(Local_pFirst->Value),
+                (CAN_FILTER16_STD_MASK(Local_pSecond->Mask) << 16) | CAN_FILTER16_STD(Local_pSecond->Value));
+        }
+        while(Local_u8S<Local_u8SingleCount)
+        {
+            uint32 Local_au32Ids[4];
+            for(Local_u8Itr=0;Local_u8Itr<4;Local_u8Itr++)
+            {
+                if(Local_u8S<Local_u8SingleCount)
+                {
+                    Local_au32Ids[Local_u8Itr] = CAN_FILTER16_STD(CAN_FilterTerms[Local_au8Singles[Local_u8S++]].Value);
+                }
+                else
+                {
+                    Local_au32Ids[Local_u8Itr] = Local_au32Ids[Local_u8Itr-1];
+                }
+            }
+            CAN_VoidFilterEmit(pImages,pIndex,u8FirstBank,CAN_IDENTIFIERLIST_MODE,CAN_TWO16BIT_FILTER,u8FIFO,
+                (Local_au32Ids[1] << 16) | Local_au32Ids[0],(Local_au32Ids[3] << 16) | Local_au32Ids[2]);
+        }
+    }
+    else
+    {
+        for(Local_u8M=0;Local_u8M<Local_u8MaskCount;Local_u8M++)
+        {
+            const CAN_FilterTerm_t* Local_pTerm = &CAN_FilterTerms[Local_au8Masks[Local_u8M]];
+            CAN_VoidFilterEmit(pImages,pIndex,u8FirstBank,CAN_MASK_MODE,CAN_ONE_32BIT_FILTER,u8FIFO,
+                CAN_FILTER32_EXT(Local_pTerm->Value),CAN_FILTER32_EXT_MASK(Local_pTerm->Mask));
+        }
+        while(Local_u8S<Local_u8SingleCount)
+        {
+            uint32 Local_u32First = CAN_FILTER32_EXT(CAN_FilterTerms[Local_au8Singles[Local_u8S++]].Value);
+            uint32 Local_u32Second = Local_u32First;
+            if(Local_u8S<Local_u8SingleCount)
+            {
+                Local_u32Second = CAN_FILTER32_EXT(CAN_FilterTerms[Local_au8Singles[Local_u8S++]].Value);
+            }
+            CAN_VoidFilterEmit(pImages,pIndex,u8FirstBank,CAN_IDENTIFIERLIST_MODE,CAN_ONE_32BIT_FILTER,u8FIFO,
+                Local_u32First,Local_u32Second);
+        }
+    }
+}
+
+/******************************************************************************
+* \Description     : pack every FIFO / identifier type group, FIFO 0 banks first
+* \Return value:   : number of banks
+*******************************************************************************/
+static uint8 CAN_u8FilterPack(uint8 u8TermCount,uint8 u8FirstBank,CAN_FilterBankImage_t* pImages)
+{
+    uint8 Local_u8Index = 0;
+    uint8 Local_u8FIFO;
+    for(Local_u8FIFO=CAN_RX_FIFO0;Local_u8FIFO<=CAN_RX_FIFO1;Local_u8FIFO++)
+    {
+        CAN_VoidFilterPackGroup(u8TermCount,Local_u8FIFO,CAN_ID_STD,u8FirstBank,pImages,&Local_u8Index);
+        CAN_VoidFilterPackGroup(u8TermCount,Local_u8FIFO,CAN_ID_EXT,u8FirstBank,pImages,&Local_u8Index);
+    }
+    return Local_u8Index;
+}
+
+/******************************************************************************
+* \Description     : merge the pair of terms (same FIFO and identifier type) that adds the fewest
+*                    unwanted identifiers: the merged mask keeps the bits both terms care about and agree on
+* \Return value:   : new number of terms, unchanged when no pair can be merged
+*******************************************************************************/
+static uint8 CAN_u8FilterMergeBest(uint8 u8TermCount)
+{
+    uint8 Local_u8Best1 = 0;
+    uint8 Local_u8Best2 = 0;
+    uint32 Local_u32BestCost = 0xFFFFFFFF;
+    uint32 Local_u32BestMask = 0;
+    uint8 Local_u8I;
+    uint8 Local_u8J;
+
+    for(Local_u8I=0;Local_u8I<u8TermCount;Local_u8I++)
+    {
+        const CAN_FilterTerm_t* Local_pA = &CAN_FilterTerms[Local_u8I];
+        uint32 Local_u32SizeA = CAN_u32FilterTermSize(Local_pA->Mask,Local_pA->IDE);
+        for(Local_u8J=Local_u8I+1;Local_u8J<u8TermCount;Local_u8J++)
+        {
+            const CAN_FilterTerm_t* Local_pB = &CAN_FilterTerms[Local_u8J];
+            uint32 Local_u32Mask;
+            uint32 Local_u32Merged;
+            uint32 Local_u32Parts;
+            uint32 Local_u32Cost;
+            if(Local_pA->FIFO!=Local_pB->FIFO || Local_pA->IDE!=Local_pB->IDE)
+            {
+                continue;
+            }
+            Local_u32Mask = Local_pA->Mask & Local_pB->Mask & ~(Local_pA->Value ^ Local_pB->Value);
+            Local_u32Merged = CAN_u32FilterTermSize(Local_u32Mask,Local_pA->IDE);
+            Local_u32Parts = Local_u32SizeA + CAN_u32FilterTermSize(Local_pB->Mask,Local_pB->IDE);
+            /*a term inside the other costs nothing*/
+            Local_u32Cost = (Local_u32Merged > Local_u32Parts) ? (Local_u32Merged - Local_u32Parts) : 0;
+            if(Local_u32Cost < Local_u32BestCost)
+            {
+                Local_u32BestCost = Local_u32Cost;
+                Local_u32BestMask = Local_u32Mask;
+                Local_u8Best1 = Local_u8I;
+                Local_u8Best2 = Local_u8J;
+            }
+        }
+    }
+    if(Local_u32BestCost == 0xFFFFFFFF)
+    {
+        return u8TermCount;
+    }
+    CAN_FilterTerms[Local_u8Best1].Mask = Local_u32BestMask;
+    CAN_FilterTerms[Local_u8Best1].Value &= Local_u32BestMask;
+    /*remove the second term by moving the last one into its place*/
+    CAN_FilterTerms[Local_u8Best2] = CAN_FilterTerms[u8TermCount-1];
+    return u8TermCount-1;
+}
+
+/******************************************************************************
+* \Description     : rebuild the FMI -> handler table from the bank configuration. The filters of a FIFO are
+*                    numbered in bank order over every bank assigned to it, active or not: a 32-bit mask bank
+*                    takes 1 number, a 32-bit list or 16-bit mask bank 2 and a 16-bit list bank 4
+*******************************************************************************/
+static void CAN_VoidRebuildFmiTable(void)
+{
+    uint8 Local_au8Next[2] = {0,0};
+    uint8 Local_u8Bank;
+    uint8 Local_u8Itr;
+
+    for(Local_u8Bank=0;Local_u8Bank<CAN_FILTER_BANKS;Local_u8Bank++)
+    {
+        uint8 Local_u8FIFO = READ_BIT(CAN_Filter->FFA1R,Local_u8Bank);
+        uint8 Local_u8List = READ_BIT(CAN_Filter->FM1R,Local_u8Bank);
+        uint8 Local_u8Scale32 = READ_BIT(CAN_Filter->FS1R,Local_u8Bank);
+        uint8 Local_u8Filters = (Local_u8Scale32==1) ? ((Local_u8List==1) ? 2 : 1) : ((Local_u8List==1) ? 4 : 2);
+        for(Local_u8Itr=0;Local_u8Itr<Local_u8Filters;Local_u8Itr++)
+        {
+            CAN_FilterHandler_t Local_Entry = CAN_BankHandlers[Local_u8Bank][Local_u8Itr];
+            if(Local_Entry.Handler==NULL)
+            {
+                Local_Entry = CAN_DefaultHandler;
+            }
+            CAN_FmiTable[Local_u8FIFO][Local_au8Next[Local_u8FIFO]++] = Local_Entry;
+        }
+    }
+    /*numbers no bank produces*/
+    for(Local_u8Itr=0;Local_u8Itr<2;Local_u8Itr++)
+    {
+        while(Local_au8Next[Local_u8Itr]<CAN_FMI_TABLE_SIZE)
+        {
+            CAN_FmiTable[Local_u8Itr][Local_au8Next[Local_u8Itr]++] = CAN_DefaultHandler;
+        }
+    }
+}
+
+/******************************************************************************
+* \Description     : write a complete bank image and activate the bank, in filter initialization mode
+*******************************************************************************/
+static void CAN_VoidWriteFilterBank(const CAN_FilterBankImage_t* pImage)
+{
+    uint8 Local_u8Bank = pImage->Bank;
+    /*deactivate the filter bank before writing it*/
+    BB_CLEAR_BIT(CAN_Filter->FA1R,Local_u8Bank);
+    BB_WRITE_BIT(CAN_Filter->FM1R,Local_u8Bank,(pImage->Mode == CAN_IDENTIFIERLIST_MODE));
+    BB_WRITE_BIT(CAN_Filter->FS1R,Local_u8Bank,(pImage->Scale == CAN_ONE_32BIT_FILTER));
+    BB_WRITE_BIT(CAN_Filter->FFA1R,Local_u8Bank,(pImage->FIFO != CAN_RX_FIFO0));
+    CAN_Filter->FiRx[Local_u8Bank].FxR1 = pImage->FR1;
+    CAN_Filter->FiRx[Local_u8Bank].FxR2 = pImage->FR2;
+    /*filter Acivate*/
+    BB_SET_BIT(CAN_Filter->FA1R,Local_u8Bank);
+}
+
+/******************************************************************************
+* \Description     : the mode, scale or FIFO of a bank image differs from the registers: these bits are
+*                    only writable in filter initialization mode and change the filter numbering
+*******************************************************************************/
+static uint8 CAN_u8FilterLayoutChanged(const CAN_FilterBankImage_t* pImage)
+{
+    uint8 Local_u8Bank = pImage->Bank;
+
+    return (uint8)((READ_BIT(CAN_Filter->FM1R,Local_u8Bank) != (pImage->Mode == CAN_IDENTIFIERLIST_MODE)) ||
+                   (READ_BIT(CAN_Filter->FS1R,Local_u8Bank) != (pImage->Scale == CAN_ONE_32BIT_FILTER)) ||
+                   (READ_BIT(CAN_Filter->FFA1R,Local_u8Bank) != (pImage->FIFO != CAN_RX_FIFO0)));
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Syntax          : void MCAN_VoidInit(const CAN_InitTypeDef* pInitConfig)                                      
+* \Description     : initialize CAN asnd check the default configuation supported                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : pInitConfig  pointer to CAN initalization configurations.                   
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidInit(const CAN_InitTypeDef* pInitConfig) 
+{
+    /*Enable CAN clock and setup the AFIO configuarions*/
+    MRCC_voidEnableClock(RCC_APB1,PERIPHERAL_EN_CAN1);
+    MRCC_voidEnableClock(RCC_APB2,PERIPHERAL_EN_AFIO);
+    MRCC_voidEnableClock(RCC_APB2,PERIPHERAL_EN_IOPB);
+
+    /*set AFIO pins*/
+    MAFIO_voidRemapPeripheralPins(CAN_REMAP);//Rx pinB8, TX pinB9
+    /*setup AFIO pins for CAN Tx,Rx */
+    MGPIO_VoidSetPinMode_TYPE(_GPIOB_PORT,pin8,INPUT_FLOATING);//RX
+    MGPIO_VoidSetPinMode_TYPE(_GPIOB_PORT,pin9,OUTPUT_SPEED_2MHZ_AFPUSHPULL);//RX
+
+    /* After Reset CAN boot up in sleep mode
+    first we need to exit from it*/
+    //clear SLEEP bit
+    CLEAR_BIT(CAN_Control->MCR,1);	
+    /* wait to exit sleep mode SLAK bit ack of sleep  */
+    while (!(READ_BIT(CAN_Control->MSR,1) == 0))
+    {
+        CAN_HW_SYNC();
+    }
+
+    /*Switch to initialization mode for init*/
+    /*set INRQ bit */
+    SET_BIT(CAN_Control->MCR,0);
+    /*wait until hardware set the INAK bit ack of init*/
+    while (!(READ_BIT(CAN_Control->MSR,0)==1))
+    {
+        CAN_HW_SYNC();
+    }
+    
+    /*from bits of control register*/
+
+    /** CHECK Transmit FIFO priority **/
+    /** CHECK Receive FIFO locked mode **/
+    /** CHECK automatic retransmission **/
+    /** CHECK automatic wakeup mode **/
+    /** CHECK automatic bus-off management **/
+    /** CHECK Time triggered communication mode **/
+    
+    /** CHECK Transmit FIFO priority **/
+    if(pInitConfig->TransmitFifoPriority==CAN_ENABLE)
+    /*by identifer:lowest ID has higher priority. if all IDs is equal then lowest number mailbox is sent */
+    CLEAR_BIT(CAN_Control->MCR,2);//TXFP Transmit FIFO priority
+    else
+    /*by transmit request order*/
+    SET_BIT(CAN_Control->MCR,2);
+
+    /** CHECK Receive FIFO locked mode **/
+    /*RFLM: Receive FIFO locked mode
+    0: Receive FIFO not locked on overrun. Once a receive FIFO is full the next incoming
+    message will overwrite the previous one.
+    1: Receive FIFO locked against overrun. Once a receive FIFO is full the next incoming
+    message will be discarded.*/
+    // #if ReceiveFIFOLockedMode == CAN_ENABLE
+    if(pInitConfig->ReceiveFifoLocked==CAN_ENABLE)
+    SET_BIT(CAN_Control->MCR,3);//discard
+    else
+    CLEAR_BIT(CAN_Control->MCR,3);//overwrite
+    
+
+    /*NART: No automatic retransmission
+    0: The CAN hardware will automatically retransmit the message until it has been
+    successfully transmitted according to the CAN standard.
+    1: A message will be transmitted only once, independently of the transmission result
+    (successful, error or arbitration lost).*/
+    if(pInitConfig->AutoRetransmission ==CAN_DISABLE)    
+    SET_BIT(CAN_Control->MCR,4);
+    else
+    CLEAR_BIT(CAN_Control->MCR,4);
+    
+    /*AWUM: Automatic wakeup mode
+    This bit controls the behavior of the CAN hardware on message reception during Sleep
+    mode.
+    0: The Sleep mode is left on software request by clearing the SLEEP bit of the CAN_MCR
+    register.
+    1: The Sleep mode is left automatically by hardware on CAN message detection.
+    */
+   if(pInitConfig->AutoWakeUp==CAN_ENABLE)
+    SET_BIT(CAN_Control->MCR,5);
+    else
+    CLEAR_BIT(CAN_Control->MCR,5);
+    
+    /*ABOM: Automatic bus-off management
+    This bit controls the behavior of the CAN hardware on leaving the Bus-Off state.
+    0: The Bus-Off state is left on software request, once 128 occurrences of 11 recessive bits
+    have been monitored and the software has first set and cleared the INRQ bit of the
+    CAN_MCR register.
+    1: The Bus-Off state is left automatically by hardware once 128 occurrences of 11 recessive
+    bits have been monitored.*/
+    if(pInitConfig->AutoBusOff==CAN_ENABLE)
+    SET_BIT(CAN_Control->MCR,6);
+    else
+    CLEAR_BIT(CAN_Control->MCR,6);
+    
+    /*Time stamp in TX and RX mailbox*/
+    if (pInitConfig->TimeTriggeredMode==CAN_ENABLE)
+    SET_BIT(CAN_Control->MCR,7);
+    else
+    CLEAR_BIT(CAN_Control->MCR,7);
+    
+    CAN_BitTimingConfig CAN_bitRateConfig[7] = {{2, 13, 10}, {2, 13, 5}, {2, 13, 4}, {2, 13, 2}, {2, 13, 1},{1, 8, 1}, {1, 6, 1}};
+    CAN_BitTiming_t Local_Timing;
+
+    /** Set the bit timing register **/
+    /*solve for the clock APB1 really runs at, the table only holds for 8 MHz*/
+    if (MCAN_u8SolveBitTiming(MRCC_u32GetPclk1Hz(), (uint32)CAN_BitrateKbpsTable[BAUDRATE] * 1000,
+                              CAN_SAMPLE_POINT_PERMILLE, &Local_Timing) == OK)
+    {
+        CAN_Control->BTR.r = CAN_BTR_VALUE(Local_Timing.BRP, Local_Timing.TS1, Local_Timing.TS2, Local_Timing.SJW);
+    }
+    else
+    {
+        CAN_Control->BTR.B.TS2 = (CAN_bitRateConfig[BAUDRATE].TS2-1);
+        CAN_Control->BTR.B.TS1 = (CAN_bitRateConfig[BAUDRATE].TS1-1);
+        CAN_Control->BTR.B.BRP = (CAN_bitRateConfig[BAUDRATE].BRP-1);
+    }
+    CAN_u16BitrateKbps = CAN_BitrateKbpsTable[BAUDRATE];
+    
+    
+			
+    /*Testing mode*/
+    if( pInitConfig->Mode == CAN_MODE_NORMAL)
+    {
+        CAN_Control->BTR.B.SILM=0;
+        CAN_Control->BTR.B.LBKM=0;
+    }
+    else if( pInitConfig->Mode == CAN_MODE_SILENT)/*receive only*/
+    {
+        CAN_Control->BTR.B.SILM=1;
+        CAN_Control->BTR.B.LBKM=0;
+    }
+    else if( pInitConfig->Mode == CAN_MODE_LOOPBACK)
+    {
+        CAN_Control->BTR.B.SILM=0;
+        CAN_Control->BTR.B.LBKM=1;
+    }
+    else if( pInitConfig->Mode == CAN_MODE_SILENT_LOOPBACK)
+    {
+        CAN_Control->BTR.B.SILM=1;
+        CAN_Control->BTR.B.LBKM=1;
+    }
+    else{}
+
+    CAN_VoidMonitorWindowStart();
+
+    /*the TX queue is refilled from the mailbox empty interrupt, it stays enabled*/
+    CAN_Control->IER.B.TMEIE = 1;
+}
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidConfigureIDFilter(CAN_Filter_t *pFilterConfig)                                      
+* \Description     : initialize CAN filter banks and filers modes based on configuraion parameters                                                                          
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : CAN_Filter_t *pFilterConfig                   
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidConfigureIDFilter(CAN_Filter_t *pFilterConfig)
+{
+    /*at first we enter initalization mode for filter banks FINIT=1 in CAN_FMR*/
+    SET_BIT(CAN_Filter->FMR,0);
+    /*deactivate the filter bank to start the init  in CAN_FA1R filter number bit*/
+    CLEAR_BIT(CAN_Filter->FA1R,pFilterConfig->FilterBank);
+
+		
+		/*set the Mode*/
+			if(pFilterConfig->filterMode == CAN_IDENTIFIERLIST_MODE)
+			{
+				SET_BIT(CAN_Filter->FM1R,pFilterConfig->FilterBank);
+			}
+			else if( pFilterConfig->filterMode == CAN_MASK_MODE)
+			{
+				CLEAR_BIT(CAN_Filter->FM1R,pFilterConfig->FilterBank);
+			}
+			else{}
+	
+    /*configure filter bank according to mode and scalable width*/
+    if(pFilterConfig->filterScalableWidth == CAN_ONE_32BIT_FILTER)
+    {
+        /*set scale width*/
+        SET_BIT(CAN_Filter->FS1R,pFilterConfig->FilterBank);
+			/*ID in mask mode or first ID in ID List*/
+			/*																																STDID -EXTID[17:13]				                 EXTID[12:5]	<-RTR		*/
+				CAN_Filter->FiRx[pFilterConfig->FilterBank].FxR1 = (((0x0000FFFF & pFilterConfig->FilterIdHigh) <<16) | pFilterConfig->FilterIdLow);
+			/*Mask in mask mode or second ID in ID List*/
+			/*																																STDID -EXTID[17:13]				                 EXTID[12:5]	<-RTR		*/
+				CAN_Filter->FiRx[pFilterConfig->FilterBank].FxR2 = (((0x0000FFFF & pFilterConfig->FilterMaskIdHigh) <<16) | pFilterConfig->FilterMaskIdLow);
+			
+    }
+    else if(pFilterConfig->filterScalableWidth==CAN_TWO16BIT_FILTER)
+    {
+        /*set scale width*/
+        CLEAR_BIT(CAN_Filter->FS1R,pFilterConfig->FilterBank);
+				
+			/*two IDs in ID List mode and Mask(FilterMaskIdLow) and ID(FilterIdLow) in ID Mask mode*/
+			/*																		ID:				STDID-RTR-IDE-EXTID[17:15]																																*/
+				CAN_Filter->FiRx[pFilterConfig->FilterBank].FxR1 = (((0x0000FFFF & pFilterConfig->FilterMaskIdLow) <<16) | pFilterConfig->FilterIdLow);
+			/*two IDs in ID List mode and Mask(FilterMaskIdHigh) and ID(FilterMaskIdLow) in ID Mask mode*/
+			/*																		ID:				STDID-RTR-IDE-EXTID[17:15]																																*/
+				CAN_Filter->FiRx[pFilterConfig->FilterBank].FxR2 = (((0x0000FFFF & pFilterConfig->FilterMaskIdHigh) <<16) | pFilterConfig->FilterIdHigh);
+			
+    }
+    else{}
+
+    /*after configure filter bank registers add it to specific FIFO*/
+    if(pFilterConfig->FilterFIFOAssignment==0)
+    {
+        /*assign this filter bank to fifo 0*/
+        CLEAR_BIT(CAN_Filter->FFA1R,pFilterConfig->FilterBank);
+    }
+    else
+    {
+        /*assign this filter bank to fifo 1*/
+        SET_BIT(CAN_Filter->FFA1R,pFilterConfig->FilterBank);
+    }
+
+    /*filter Acivate*/
+    SET_BIT(CAN_Filter->FA1R,pFilterConfig->FilterBank);
+
+    /*leave init mode of filterbank */
+    CLEAR_BIT(CAN_Filter->FMR,0);
+
+    /*filter numbering may have changed*/
+    CAN_VoidRebuildFmiTable();
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType MCAN_u8CompileFilters(const CAN_FilterSpec_t* pSpecs,uint8 u8SpecCount,
+*                                                         uint8 u8FirstBank,uint8 u8MaxBanks,
+*                                                         CAN_FilterBankImage_t* pImages,CAN_FilterReport_t* pReport)                                      
+* \Description     : pack identifiers and ranges into the fewest filter banks: standard ids in 16-bit list
+*                    banks (4 per bank), ranges as aligned masks (2 per 16-bit bank for standard, 1 per bank
+*                    for extended), extended ids in 32-bit list banks (2 per bank). When the result does not
+*                    fit u8MaxBanks, the terms whose merge adds the fewest unwanted ids are merged into masks.
+*                    No register is touched so it can also run in a host build step to generate static tables.                                                                          
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : pSpecs identifiers per FIFO, u8SpecCount number of specs, u8FirstBank first bank to use,
+*                    u8MaxBanks bank budget                   
+* \Parameters (out): pImages u8MaxBanks bank images in bank order, pReport size and false accept rate (may be NULL)                                                      
+* \Return value:   : Std_ReturnType N_OK when the specs do not fit (too many terms or fewer banks than FIFO/IDE groups)
+*******************************************************************************/
+Std_ReturnType MCAN_u8CompileFilters(const CAN_FilterSpec_t* pSpecs,uint8 u8SpecCount,uint8 u8FirstBank,uint8 u8MaxBanks,
+                                     CAN_FilterBankImage_t* pImages,CAN_FilterReport_t* pReport)
+{
+    uint8 Local_u8TermCount = 0;
+    uint8 Local_u8Merges = 0;
+    uint8 Local_u8Banks;
+    uint32 Local_u32Wanted = 0;
+    uint32 Local_u32Accepted = 0;
+    uint8 Local_u8Itr;
+
+    if(u8FirstBank >= CAN_FILTER_BANKS || u8MaxBanks > (CAN_FILTER_BANKS - u8FirstBank))
+    {
+        return N_OK;
+    }
+
+    /*split every range into aligned power of two blocks, each block is one id/mask term*/
+    for(Local_u8Itr=0;Local_u8Itr<u8SpecCount;Local_u8Itr++)
+    {
+        uint32 Local_u32Full = (pSpecs[Local_u8Itr].IDE==CAN_ID_STD) ? 0x7FF : 0x1FFFFFFF;
+        uint32 Local_u32Low = pSpecs[Local_u8Itr].IdLow & Local_u32Full;
+        uint32 Local_u32High = pSpecs[Local_u8Itr].IdHigh & Local_u32Full;
+        if(Local_u32High < Local_u32Low)
+        {
+            return N_OK;
+        }
+        Local_u32Wanted += Local_u32High - Local_u32Low + 1;
+        while(1)
+        {
+            uint32 Local_u32Block = 1;
+            /*largest block aligned on Low that does not pass High*/
+            while((Local_u32Low & ((Local_u32Block << 1) - 1)) == 0 &&
+                  (Local_u32Block << 1) <= Local_u32Full &&
+                  (Local_u32Low + (Local_u32Block << 1) - 1) <= Local_u32High)
+            {
+                Local_u32Block <<= 1;
+            }
+            if(Local_u8TermCount >= CAN_FILTER_MAX_TERMS)
+            {
+                return N_OK;
+            }
+            CAN_FilterTerms[Local_u8TermCount].Value = Local_u32Low;
+            CAN_FilterTerms[Local_u8TermCount].Mask = Local_u32Full & ~(Local_u32Block - 1);
+            CAN_FilterTerms[Local_u8TermCount].IDE = pSpecs[Local_u8Itr].IDE;
+            CAN_FilterTerms[Local_u8TermCount].FIFO = pSpecs[Local_u8Itr].FIFO;
+            Local_u8TermCount++;
+            if((Local_u32Low + Local_u32Block - 1) >= Local_u32High)
+            {
+                break;
+            }
+            Local_u32Low += Local_u32Block;
+        }
+    }
+
+    /*approximate until the banks fit the budget*/
+    Local_u8Banks = CAN_u8FilterPack(Local_u8TermCount,u8FirstBank,NULL);
+    while(Local_u8Banks > u8MaxBanks)
+    {
+        uint8 Local_u8NewCount = CAN_u8FilterMergeBest(Local_u8TermCount);
+        if(Local_u8NewCount == Local_u8TermCount)
+        {
+            /*one term per group left and still too many groups*/
+            return N_OK;
+        }
+        Local_u8TermCount = Local_u8NewCount;
+        Local_u8Merges++;
+        Local_u8Banks = CAN_u8FilterPack(Local_u8TermCount,u8FirstBank,NULL);
+    }
+    CAN_u8FilterPack(Local_u8TermCount,u8FirstBank,pImages);
+
+    if(pReport!=NULL)
+    {
+        for(Local_u8Itr=0;Local_u8Itr<Local_u8TermCount;Local_u8Itr++)
+        {
+            Local_u32Accepted += CAN_u32FilterTermSize(CAN_FilterTerms[Local_u8Itr].Mask,CAN_FilterTerms[Local_u8Itr].IDE);
+        }
+        /*merged terms may overlap, the wanted ids are always accepted*/
+        if(Local_u32Accepted < Local_u32Wanted)
+        {
+            Local_u32Accepted = Local_u32Wanted;
+        }
+        pReport->BanksUsed = Local_u8Banks;
+        pReport->MaskMerges = Local_u8Merges;
+        pReport->WantedIds = Local_u32Wanted;
+        pReport->AcceptedIds = Local_u32Accepted;
+        pReport->FalseAcceptPermille = (Local_u32Accepted == 0) ? 0 :
+            (uint16)(((uint64)(Local_u32Accepted - Local_u32Wanted) * 1000) / Local_u32Accepted);
+    }
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidApplyFilters(const CAN_FilterBankImage_t* pImages,uint8 u8Count)                                      
+* \Description     : write and activate filter bank images in one filter initialization window                                                                          
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : pImages bank images (compiled or a static const table), u8Count number of images                   
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidApplyFilters(const CAN_FilterBankImage_t* pImages,uint8 u8Count)
+{
+    uint8 Local_u8Itr;
+    /*at first we enter initalization mode for filter banks FINIT=1 in CAN_FMR*/
+    SET_BIT(CAN_Filter->FMR,0);
+    for(Local_u8Itr=0;Local_u8Itr<u8Count;Local_u8Itr++)
+    {
+        CAN_VoidWriteFilterBank(&pImages[Local_u8Itr]);
+    }
+    /*leave init mode of filterbank */
+    CLEAR_BIT(CAN_Filter->FMR,0);
+
+    /*filter numbering may have changed*/
+    CAN_VoidRebuildFmiTable();
+}
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8UpdateFilters(const CAN_FilterBankImage_t* pImages,uint8 u8Count,uint8 u8Mode)
+* \Description     : rewrite filter banks while the controller keeps receiving
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pImages bank images, u8Count number of images, u8Mode @ref CAN_filter_update
+* \Parameters (out): None
+* \Return value:   : uint8 number of banks written
+*******************************************************************************/
+uint8 MCAN_u8UpdateFilters(const CAN_FilterBankImage_t* pImages,uint8 u8Count,uint8 u8Mode)
+{
+    uint32 Local_u32Layout = 0;
+    uint8 Local_u8Written = 0;
+    uint8 Local_u8Itr;
+
+    for(Local_u8Itr=0;Local_u8Itr<u8Count;Local_u8Itr++)
+    {
+        uint8 Local_u8Bank = pImages[Local_u8Itr].Bank;
+        if(CAN_u8FilterLayoutChanged(&pImages[Local_u8Itr]))
+        {
+            /*left for one filter initialization window below*/
+            Local_u32Layout |= (uint32)1 << Local_u8Bank;
+            continue;
+        }
+        if(u8Mode == CAN_FILTER_UPDATE_DIFF && READ_BIT(CAN_Filter->FA1R,Local_u8Bank) == 1 &&
+           CAN_Filter->FiRx[Local_u8Bank].FxR1 == pImages[Local_u8Itr].FR1 &&
+           CAN_Filter->FiRx[Local_u8Bank].FxR2 == pImages[Local_u8Itr].FR2)
+        {
+            continue;
+        }
+        /*same layout: FR1 / FR2 are writable once this bank alone is deactivated, the other banks
+          keep filtering and the filter numbers do not move*/
+        BB_CLEAR_BIT(CAN_Filter->FA1R,Local_u8Bank);
+        CAN_Filter->FiRx[Local_u8Bank].FxR1 = pImages[Local_u8Itr].FR1;
+        CAN_Filter->FiRx[Local_u8Bank].FxR2 = pImages[Local_u8Itr].FR2;
+        BB_SET_BIT(CAN_Filter->FA1R,Local_u8Bank);
+        Local_u8Written++;
+    }
+
+    if(Local_u32Layout != 0)
+    {
+        /*reception is suspended while FINIT is set, keep the window to these banks*/
+        SET_BIT(CAN_Filter->FMR,0);
+        for(Local_u8Itr=0;Local_u8Itr<u8Count;Local_u8Itr++)
+        {
+            if(READ_BIT(Local_u32Layout,pImages[Local_u8Itr].Bank) == 1)
+            {
+                CAN_VoidWriteFilterBank(&pImages[Local_u8Itr]);
+                Local_u8Written++;
+            }
+        }
+        CLEAR_BIT(CAN_Filter->FMR,0);
+        CAN_VoidRebuildFmiTable();
+    }
+    return Local_u8Written;
+}
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidDeactivateFilterBanks(uint32 u32BankMask)
+* \Description     : stop filtering with some banks while the controller keeps receiving
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u32BankMask bit n set deactivates bank n
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidDeactivateFilterBanks(uint32 u32BankMask)
+{
+    /*FA1R is writable outside filter initialization mode and the filter numbering does not depend on it*/
+    CAN_Filter->FA1R &= ~u32BankMask;
+}
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8Transmission(CAN_TX_Frame_t * TXframe,uint8 Data[])                                      
+* \Description     : initialize CAN Frame to be send and put it in Tx mailbox and                                                                           
+* \Sync\Async      : ASynchronous (when tx is transmitted interrupt notify the app)                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : CAN_TX_Frame * TXframe , Data array represent the data bytes                  
+* \Parameters (out): None                                                      
+* \Return value:   : return the mailbox number used to transmit
+*******************************************************************************/
+uint8 MCAN_u8Transmission(CAN_TX_Frame_t * TXframe,uint8 Data[])
+{
+    CAN_Frame_t Local_Frame;
+    uint8 Local_u8itr=0;
+
+    Local_Frame.Id = CAN_TX_KEY(TXframe->IDE,TXframe->StdId,TXframe->ExtId,TXframe->RTR);
+    Local_Frame.DLC = (uint8)TXframe->DLC;
+    /*Enable or Disable sending time stamp*/
+    if(TXframe->TransmitGlobalTime!=0)
+    {
+        Local_Frame.DLC |= CAN_FRAME_DLC_TGT;
+    }
+    Local_Frame.Data.Words[0] = 0;
+    Local_Frame.Data.Words[1] = 0;
+    for(Local_u8itr=0;Local_u8itr<TXframe->DLC && Local_u8itr<8;Local_u8itr++)
+    {
+        Local_Frame.Data.Bytes[Local_u8itr] = Data[Local_u8itr];
+    }
+    return MCAN_u8TransmitFrame(&Local_Frame);
+}
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8TransmitFrame(const CAN_Frame_t* pFrame)                                      
+* \Description     : transmit a packed frame: identifier written to TIR in one word, payload in two
+*                    word stores, same mailbox / software queue handling as MCAN_u8Transmission                                                                           
+* \Sync\Async      : ASynchronous (when tx is transmitted interrupt notify the app)                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : pFrame frame to send (all 8 data bytes are copied whatever the DLC)                  
+* \Parameters (out): None                                                      
+* \Return value:   : mailbox number (0-2) when loaded directly, CAN_TX_QUEUED or CAN_TX_QUEUE_FULL
+*******************************************************************************/
+uint8 MCAN_u8TransmitFrame(const CAN_Frame_t* pFrame)
+{
+    uint8 Local_u8Result = CAN_TX_QUEUED;
+    uint8 Local_u8Mailbox;
+    uint32 Local_u32Irq;
+
+    CAN_TX_LOCK(Local_u32Irq);
+    /*get the empty mailbox number, TSR CODE may point to the reserved mailbox*/
+    Local_u8Mailbox = CAN_u8FreeMailbox();
+    if(CAN_TxQueueCount==0 && CAN_TxHold==0 && Local_u8Mailbox<CAN_TX_MAILBOXES)
+    {
+        /*nothing waiting: load the mailbox directly and let the hardware arbitrate between mailboxes*/
+        Local_u8Result = Local_u8Mailbox;
+        CAN_VoidLoadMailbox(Local_u8Result,pFrame);
+    }
+    else if(CAN_u8TxQueueInsert(pFrame,0)==OK)
+    {
+        CAN_VoidTxQueueRefill();
+        CAN_VoidTxPreempt();
+    }
+    else
+    {
+        Local_u8Result = CAN_TX_QUEUE_FULL;
+    }
+    CAN_TX_UNLOCK(Local_u32Irq);
+    //return the mailbox number to be used for polling
+    return Local_u8Result;
+}
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8TransmitLatest(const CAN_Frame_t* pFrame)
+* \Description     : transmit a frame whose older copies are worthless: a queued frame with the same Id is
+*                    overwritten in place, a pending mailbox with the same Id is aborted (if it still loses
+*                    the race and goes out, the fresh frame follows it)
+* \Sync\Async      : ASynchronous (when tx is transmitted interrupt notify the app)
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pFrame frame to send
+* \Parameters (out): None
+* \Return value:   : CAN_TX_REPLACED when an older copy was replaced, otherwise as MCAN_u8TransmitFrame
+*******************************************************************************/
+uint8 MCAN_u8TransmitLatest(const CAN_Frame_t* pFrame)
+{
+    uint8 Local_u8Superseded = 0;
+    uint8 Local_u8Index;
+    uint8 Local_u8Result = CAN_TX_REPLACED;
+    uint32 Local_u32Irq;
+
+    CAN_TX_LOCK(Local_u32Irq);
+    for(Local_u8Index=0;Local_u8Index<CAN_TX_MAILBOXES;Local_u8Index++)
+    {
+        if(Local_u8Index != CAN_TxReserved && CAN_TxShadow[Local_u8Index].Pending != 0 &&
+           CAN_TxShadow[Local_u8Index].Frame.Id == pFrame->Id)
+        {
+            /*ABRQ has no effect once the frame is on the bus: TXOK then wins in the TX interrupt*/
+            if(CAN_TxShadow[Local_u8Index].AbortRequested == CAN_ABORT_NONE)
+            {
+                CAN_TSR_WRITE(CAN_TSR_ABRQ(Local_u8Index));
+            }
+            CAN_TxShadow[Local_u8Index].AbortRequested = CAN_ABORT_DROP;
+            Local_u8Superseded = 1;
+        }
+    }
+    for(Local_u8Index=0;Local_u8Index<CAN_TxQueueCount;Local_u8Index++)
+    {
+        if(CAN_TxQueue[Local_u8Index].Id == pFrame->Id)
+        {
+            /*same key, same place in the priority order*/
+            CAN_TxQueue[Local_u8Index] = *pFrame;
+            break;
+        }
+    }
+    if(Local_u8Index < CAN_TxQueueCount)
+    {
+        /*overwritten in the queue*/
+    }
+    else if(Local_u8Superseded != 0)
+    {
+        /*queued where the aborted copy would have gone, loaded by the TX interrupt of the abort*/
+        if(CAN_u8TxQueueInsert(pFrame,1) != OK)
+        {
+            Local_u8Result = CAN_TX_QUEUE_FULL;
+        }
+    }
+    else
+    {
+        /*no older copy: enqueued under the same lock as the scan, otherwise a copy queued by an interrupt
+          in between would be sent as well (the lock nests)*/
+        Local_u8Result = MCAN_u8TransmitFrame(pFrame);
+    }
+    CAN_TX_UNLOCK(Local_u32Irq);
+    return Local_u8Result;
+}
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8TxQueueCount(void)                                      
+* \Description     : Return the number of frames waiting in the software TX queue                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : None                
+* \Parameters (out): None                                                      
+* \Return value:   : number of queued frames-> 0-CAN_TX_QUEUE_SIZE, up to CAN_TX_QUEUE_SIZE + 3 while
+*                    frames taken back from the mailboxes wait
+*******************************************************************************/
+uint8 MCAN_u8TxQueueCount(void)
+{
+    return CAN_TxQueueCount;
+}
+
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidReception(uint8 RX_FIFO,CAN_RX_Frame_t * RXframe,uint8 Data[])                                      
+* \Description     : Read CAN frame from RX FIFO and store its data in Data Array.                                                                           
+* \Sync\Async      : Synchronous                                                
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) :  RX_ FIFO number of fifo to read from,CAN_RX_Frame * RXframe , Data array represent the data bytes                  
+* \Parameters (out): CAN_RX_Frame * RXframe , Data array represent the data bytes                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidReception(uint8 RX_FIFO,CAN_RX_Frame_t * RXframe,uint8 Data[])
+{
+    /*we enter this function after RX interrupt and the callback of specific FIFO call this function
+    * so the Frame is ready in the FIFO mailbox*/
+    CAN_Frame_t Local_Frame;
+    uint8 Local_u8Itr;
+
+    (void)CAN_u64ReadFifo(RX_FIFO,&Local_Frame);
+    /*Read the IDE from received frame*/
+    RXframe->IDE = CAN_FRAME_IS_EXT(Local_Frame.Id) ? CAN_ID_EXT : CAN_ID_STD;
+    if(RXframe->IDE==CAN_ID_STD)
+    {
+        RXframe->StdId = CAN_FRAME_GET_STD(Local_Frame.Id);
+    }
+    else
+    {
+        RXframe->ExtId = CAN_FRAME_GET_EXT(Local_Frame.Id);
+    }
+    RXframe->RTR = CAN_FRAME_IS_REMOTE(Local_Frame.Id) ? CAN_RTR_REMOTE : CAN_RTR_DATA;
+    RXframe->DLC = Local_Frame.DLC;
+    RXframe->FilterMatchIndex = Local_Frame.FMI;
+    RXframe->TimeStamp = Local_Frame.TimeStamp;
+    for(Local_u8Itr=0;Local_u8Itr<8;Local_u8Itr++)
+    {
+        Data[Local_u8Itr] = (Local_u8Itr<Local_Frame.DLC) ? Local_Frame.Data.Bytes[Local_u8Itr] : 0;
+    }
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType MCAN_u8ReceiveFrame(uint8 RX_FIFO,CAN_Frame_t* pFrame)                                      
+* \Description     : read the oldest frame of a FIFO into a packed frame (four word loads) and release it                                                                           
+* \Sync\Async      : Synchronous                                                
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : RX_FIFO number of fifo to read from                  
+* \Parameters (out): pFrame received frame                                                      
+* \Return value:   : Std_ReturnType N_OK when the FIFO is empty
+*******************************************************************************/
+Std_ReturnType MCAN_u8ReceiveFrame(uint8 RX_FIFO,CAN_Frame_t* pFrame)
+{
+    if(CAN_Control->RFR[RX_FIFO].B.FMP == 0)
+    {
+        return N_OK;
+    }
+    (void)CAN_u64ReadFifo(RX_FIFO,pFrame);
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidStart()                                      
+* \Description     : Start CAN by leaving the initialization mode to normal mode                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : None                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidStart()
+{  
+    /*the TIME counter is not known to keep running in initialization mode: new anchor*/
+    CAN_TsValid = 0;
+    /*Clearing the INRQ bit in CAN_MCR Register*/
+    CLEAR_BIT(CAN_Control->MCR,0);
+    /*confirm that normal mode is start when INAK bit in CAN_MSR Register is cleared*/
+    while(!(READ_BIT(CAN_Control->MSR,0)==0))
+    {
+        CAN_HW_SYNC();
+    }
+    
+}
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidStop(void)                                      
+* \Description     : leave the bus: request initialization mode and wait for INAK                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : None                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidStop(void)
+{
+    CAN_Control->MCR |= CAN_MCR_INRQ;
+    /*INAK is set once the current frame on the bus is finished*/
+    while((CAN_Control->MSR & CAN_MSR_INAK) == 0)
+    {
+        CAN_HW_SYNC();
+    }
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType MCAN_u8SetBitrate(uint32 u32Bitrate,uint8 u8Mode)                                      
+* \Description     : change the bit rate and the test mode while in initialization mode                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : u32Bitrate bit rate in bit/s, u8Mode CAN_MODE_NORMAL / _LOOPBACK / _SILENT / _SILENT_LOOPBACK
+* \Parameters (out): None                                                      
+* \Return value:   : Std_ReturnType N_OK when not in initialization mode or no timing fits
+*******************************************************************************/
+Std_ReturnType MCAN_u8SetBitrate(uint32 u32Bitrate,uint8 u8Mode)
+{
+    CAN_BitTiming_t Local_Timing;
+    uint32 Local_u32Btr;
+
+    if((CAN_Control->MSR & CAN_MSR_INAK) == 0)
+    {
+        return N_OK;
+    }
+    if(MCAN_u8SolveBitTiming(MRCC_u32GetPclk1Hz(), u32Bitrate, CAN_SAMPLE_POINT_PERMILLE, &Local_Timing) != OK)
+    {
+        return N_OK;
+    }
+    Local_u32Btr = CAN_BTR_VALUE(Local_Timing.BRP, Local_Timing.TS1, Local_Timing.TS2, Local_Timing.SJW);
+    /*LBKM bit 30, SILM bit 31: CAN_MODE_LOOPBACK is 1 and CAN_MODE_SILENT is 2, so the mode is the field*/
+    Local_u32Btr |= (uint32)(u8Mode & 0x3) << 30;
+    CAN_Control->BTR.r = Local_u32Btr;
+    CAN_u16BitrateKbps = (uint16)(u32Bitrate / 1000);
+    CAN_VoidMonitorWindowStart();
+    if(CAN_TsEnabled != 0)
+    {
+        CAN_VoidTsSetRate();
+    }
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType MCAN_u8EnableTimeStamps(void)                                      
+* \Description     : turn on TTCM and stamp every received frame                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : None                
+* \Parameters (out): None                                                      
+* \Return value:   : Std_ReturnType N_OK when not in initialization mode
+*******************************************************************************/
+Std_ReturnType MCAN_u8EnableTimeStamps(void)
+{
+    if((CAN_Control->MSR & CAN_MSR_INAK) == 0)
+    {
+        return N_OK;
+    }
+    /*TTCM activates the internal bit counter captured into TIME*/
+    CAN_Control->MCR |= CAN_MCR_TTCM;
+    CAN_VoidTsSetRate();
+    CAN_TsEnabled = 1;
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : uint64 MCAN_u64ExtendTimeStamp(uint16 u16TimeStamp)                                      
+* \Description     : map a TIME value captured less than 65536 bit times ago to HCLK cycles                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : u16TimeStamp captured TIME value                
+* \Parameters (out): None                                                      
+* \Return value:   : uint64 start of frame in HCLK cycles, 0 before the first frame was received
+*******************************************************************************/
+uint64 MCAN_u64ExtendTimeStamp(uint16 u16TimeStamp)
+{
+    uint32 Local_u32Ticks;
+
+    if(CAN_TsEnabled == 0 || CAN_TsValid == 0)
+    {
+        return 0;
+    }
+    return CAN_u64TsFromTime(u16TimeStamp,MSYSTICK_u64GetCycles(),&Local_u32Ticks);
+}
+
+/******************************************************************************
+* \Syntax          : uint64 MCAN_u64RxStamp(const CAN_Frame_t* pFrame)
+* \Description     : start of frame of a frame still in an RX ring (MCAN_u16RxRingPeek, dispatch handler)
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : pFrame frame in an RX ring, not released yet
+* \Parameters (out): None
+* \Return value:   : uint64 start of frame in HCLK cycles, 0 unless MCAN_u8EnableTimeStamps or for a frame
+*                    outside the rings
+*******************************************************************************/
+uint64 MCAN_u64RxStamp(const CAN_Frame_t* pFrame)
+{
+    /*both arrays have the same shape: the slot index of the frame is the index of its stamp.
+      A frame below the rings wraps to a large offset*/
+    uintptr_t Local_Offset = (uintptr_t)pFrame - (uintptr_t)&CAN_RxRing[0][0];
+
+    if(Local_Offset >= sizeof(CAN_RxRing))
+    {
+        return 0;
+    }
+    return (&CAN_RxStamp[0][0])[Local_Offset / sizeof(CAN_Frame_t)];
+}
+
+/******************************************************************************
+* \Syntax          : uint32 MCAN_u32CyclesPerBit(void)
+* \Description     : HCLK cycles of one bit time, the unit between TIME and MSYSTICK_u64GetCycles
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint32 cycles per bit, 0 unless MCAN_u8EnableTimeStamps
+*******************************************************************************/
+uint32 MCAN_u32CyclesPerBit(void)
+{
+    return (CAN_TsEnabled != 0) ? CAN_TsCyclesPerBit : 0;
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType MCAN_u8ReserveMailbox(uint8 u8Mailbox)
+* \Description     : take a mailbox away from the TX queue for an external scheduler, or give it back
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Mailbox mailbox 0-2, CAN_MAILBOX_NONE to release the reserved one
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK when the mailbox is pending (retry) or out of range
+*******************************************************************************/
+Std_ReturnType MCAN_u8ReserveMailbox(uint8 u8Mailbox)
+{
+    Std_ReturnType Local_u8Result = OK;
+    uint32 Local_u32Irq;
+
+    CAN_TX_LOCK(Local_u32Irq);
+    if(u8Mailbox == CAN_MAILBOX_NONE)
+    {
+        CAN_TxReserved = CAN_MAILBOX_NONE;
+        CAN_VoidTxQueueRefill();
+    }
+    else if(u8Mailbox < CAN_TX_MAILBOXES && CAN_TxShadow[u8Mailbox].Pending == 0)
+    {
+        CAN_TxReserved = u8Mailbox;
+        CAN_ReservedStatus = CAN_RESERVED_IDLE;
+    }
+    else
+    {
+        Local_u8Result = N_OK;
+    }
+    CAN_TX_UNLOCK(Local_u32Irq);
+    return Local_u8Result;
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType MCAN_u8LoadReservedMailbox(const CAN_Frame_t* pFrame)
+* \Description     : request transmission of a frame in the reserved mailbox, it leaves on the next bus idle
+* \Sync\Async      : ASynchronous (result from MCAN_u8ReservedMailboxStatus)
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pFrame frame to send
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK when no mailbox is reserved, it is pending or TX is held by bus-off
+*******************************************************************************/
+Std_ReturnType MCAN_u8LoadReservedMailbox(const CAN_Frame_t* pFrame)
+{
+    uint8 Local_u8Mailbox = CAN_TxReserved;
+
+    /*no TX lock: the queue never touches this mailbox, the TX interrupt only serves it once it is pending*/
+    if(Local_u8Mailbox >= CAN_TX_MAILBOXES || CAN_TxShadow[Local_u8Mailbox].Pending != 0 || CAN_TxHold != 0)
+    {
+        return N_OK;
+    }
+    CAN_ReservedStatus = CAN_RESERVED_PENDING;
+    CAN_VoidLoadMailbox(Local_u8Mailbox,pFrame);
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidAbortReservedMailbox(void)
+* \Description     : abort the frame of the reserved mailbox unless it is already on the bus
+* \Sync\Async      : ASynchronous (result from MCAN_u8ReservedMailboxStatus)
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidAbortReservedMailbox(void)
+{
+    uint8 Local_u8Mailbox = CAN_TxReserved;
+    uint32 Local_u32Irq;
+
+    CAN_TX_LOCK(Local_u32Irq);
+    if(Local_u8Mailbox < CAN_TX_MAILBOXES && CAN_TxShadow[Local_u8Mailbox].Pending != 0 &&
+       CAN_TxShadow[Local_u8Mailbox].AbortRequested == CAN_ABORT_NONE)
+    {
+        CAN_TxShadow[Local_u8Mailbox].AbortRequested = CAN_ABORT_DROP;
+        CAN_TSR_WRITE(CAN_TSR_ABRQ(Local_u8Mailbox));
+    }
+    CAN_TX_UNLOCK(Local_u32Irq);
+}
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8ReservedMailboxStatus(uint64* pSof)
+* \Description     : state of the last frame loaded in the reserved mailbox
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): pSof start of frame in HCLK cycles when sent (0 unless MCAN_u8EnableTimeStamps), may be NULL
+* \Return value:   : uint8 @ref CAN_reserved_status
+*******************************************************************************/
+uint8 MCAN_u8ReservedMailboxStatus(uint64* pSof)
+{
+    uint8 Local_u8Status = CAN_ReservedStatus;
+
+    if(Local_u8Status == CAN_RESERVED_SENT && pSof != NULL)
+    {
+        *pSof = CAN_ReservedSof;
+    }
+    return Local_u8Status;
+}
+
+/******************************************************************************
+* \Syntax          : uint32 MCAN_u32EnterCritical(void)
+* \Description     : mask the interrupts like the TX path of the driver does (PRIMASK), nests
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint32 previous state, for MCAN_VoidExitCritical
+*******************************************************************************/
+uint32 MCAN_u32EnterCritical(void)
+{
+    uint32 Local_u32Irq;
+
+    CAN_TX_LOCK(Local_u32Irq);
+    return Local_u32Irq;
+}
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidExitCritical(uint32 u32State)
+* \Description     : back to the state saved by MCAN_u32EnterCritical
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : u32State value returned by MCAN_u32EnterCritical
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidExitCritical(uint32 u32State)
+{
+    CAN_TX_UNLOCK(u32State);
+}
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8FreeMailboxes(void)                                      
+* \Description     : Return the number of free mailboxes to start transmit                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : None                
+* \Parameters (out): None                                                      
+* \Return value:   : number of free mailboxes-> 0-3
+*******************************************************************************/
+uint8 MCAN_u8FreeMailboxes(void)
+{
+    uint8 local_u8counter=0;
+    if(CAN_Control->TSR.B.TME0==1)
+        local_u8counter++;
+    if(CAN_Control->TSR.B.TME1==1)
+        local_u8counter++;
+    if(CAN_Control->TSR.B.TME2==1)
+            local_u8counter++;
+    /*the reserved mailbox is not available to the application*/
+    if(CAN_TxReserved<CAN_TX_MAILBOXES && (CAN_Control->TSR.r & CAN_TSR_TME(CAN_TxReserved))!=0)
+        local_u8counter--;
+    return local_u8counter;
+}
+
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8MailboxPendingStatus(uint8 mailboxNumber)                                      
+* \Description     : Return whether the transmission is completed or not                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : uint8 mailboxNumber:number of the mailbox                
+* \Parameters (out): None                                                      
+* \Return value:   : status of mailbox 0->pending,1->not pending(completed)
+*******************************************************************************/
+uint8 MCAN_u8MailboxPendingStatus(uint8 mailboxNumber)
+{
+    switch (mailboxNumber)
+    {
+    case 0:
+        return CAN_Control->TSR.B.RQCP0;
+        break;
+        case 1:
+        return CAN_Control->TSR.B.RQCP1;
+        break;
+        case 2:
+        return CAN_Control->TSR.B.RQCP2;
+        break;
+    }
+}
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8RX_FIFOMeassages(uint8 RX_FIFO)                                      
+* \Description     : Return the number of messages in fifo                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : uint8 RX_FIFO number of FIFO 0->FIFO0,1->FIFO1                
+* \Parameters (out): None                                                      
+* \Return value:   : number of messages in FIFO
+*******************************************************************************/
+uint8 MCAN_u8RX_FIFOMeassages(uint8 RX_FIFO)
+{
+    return CAN_Control->RFR[RX_FIFO].B.FMP;    
+}
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidEnableRxRing(uint8 RX_FIFO)                                      
+* \Description     : Drain the FIFO completely from its interrupt into a lock free ring,
+*                    the RX_FIFOx_FMP callback (if any) is then called once per interrupt as a notification                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : uint8 RX_FIFO number of FIFO 0->FIFO0,1->FIFO1                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidEnableRxRing(uint8 RX_FIFO)
+{
+    CAN_RxRingHead[RX_FIFO] = 0;
+    CAN_RxRingTail[RX_FIFO] = 0;
+    CAN_RxRingStatus[RX_FIFO].SoftwareOverruns = 0;
+    CAN_RxRingStatus[RX_FIFO].HardwareOverruns = 0;
+    CAN_RxRingEnabled[RX_FIFO] = 1;
+    if(RX_FIFO == CAN_RX_FIFO0)
+    {
+        CAN_Control->IER.B.FMPIE0=1;
+        CAN_Control->IER.B.FOVIE0=1;
+    }
+    else
+    {
+        CAN_Control->IER.B.FMPIE1=1;
+        CAN_Control->IER.B.FOVIE1=1;
+    }
+}
+
+/******************************************************************************
+* \Syntax          : uint16 MCAN_u16RxRingCount(uint8 RX_FIFO)                                      
+* \Description     : Return the number of frames waiting in the RX ring                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : uint8 RX_FIFO number of FIFO 0->FIFO0,1->FIFO1                
+* \Parameters (out): None                                                      
+* \Return value:   : number of frames in the ring
+*******************************************************************************/
+uint16 MCAN_u16RxRingCount(uint8 RX_FIFO)
+{
+    return (uint16)(CAN_RxRingHead[RX_FIFO] - CAN_RxRingTail[RX_FIFO]);
+}
+
+/******************************************************************************
+* \Syntax          : uint16 MCAN_u16RxRingRead(uint8 RX_FIFO,CAN_Frame_t* pFrames,uint16 u16Max)                                      
+* \Description     : Copy up to u16Max frames out of the RX ring and release them                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant (single consumer per FIFO)                                            
+* \Parameters (in) : RX_FIFO number of FIFO, u16Max capacity of pFrames                
+* \Parameters (out): pFrames received frames, oldest first                                                      
+* \Return value:   : number of frames copied
+*******************************************************************************/
+uint16 MCAN_u16RxRingRead(uint8 RX_FIFO,CAN_Frame_t* pFrames,uint16 u16Max)
+{
+    uint16 Local_u16Tail = CAN_RxRingTail[RX_FIFO];
+    uint16 Local_u16Count = (uint16)(CAN_RxRingHead[RX_FIFO] - Local_u16Tail);
+    uint16 Local_u16Itr;
+
+    if(Local_u16Count > u16Max)
+    {
+        Local_u16Count = u16Max;
+    }
+    /*read the slots only after the head that publishes them*/
+    CAN_COMPILER_BARRIER();
+    for(Local_u16Itr=0;Local_u16Itr<Local_u16Count;Local_u16Itr++)
+    {
+        pFrames[Local_u16Itr] = CAN_RxRing[RX_FIFO][(uint16)(Local_u16Tail + Local_u16Itr) & (CAN_RX_RING_SIZE-1)];
+    }
+    /*give the slots back only after they are copied*/
+    CAN_COMPILER_BARRIER();
+    CAN_RxRingTail[RX_FIFO] = (uint16)(Local_u16Tail + Local_u16Count);
+    return Local_u16Count;
+}
+
+/******************************************************************************
+* \Syntax          : uint16 MCAN_u16RxRingPeek(uint8 RX_FIFO,const CAN_Frame_t** ppFrames)                                      
+* \Description     : Zero copy batch access: point at the oldest frame and return how many frames
+*                    follow it contiguously in the ring, release them with MCAN_VoidRxRingRelease                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant (single consumer per FIFO)                                             
+* \Parameters (in) : RX_FIFO number of FIFO                
+* \Parameters (out): ppFrames pointer to the oldest frame                                                      
+* \Return value:   : number of contiguous frames (0 when empty)
+*******************************************************************************/
+uint16 MCAN_u16RxRingPeek(uint8 RX_FIFO,const CAN_Frame_t** ppFrames)
+{
+    uint16 Local_u16Tail = CAN_RxRingTail[RX_FIFO];
+    uint16 Local_u16Count = (uint16)(CAN_RxRingHead[RX_FIFO] - Local_u16Tail);
+    uint16 Local_u16ToEnd = CAN_RX_RING_SIZE - (Local_u16Tail & (CAN_RX_RING_SIZE-1));
+
+    CAN_COMPILER_BARRIER();
+    if(Local_u16Count > Local_u16ToEnd)
+    {
+        /*the rest is at the start of the ring, returned by the next peek*/
+        Local_u16Count = Local_u16ToEnd;
+    }
+    *ppFrames = &CAN_RxRing[RX_FIFO][Local_u16Tail & (CAN_RX_RING_SIZE-1)];
+    return Local_u16Count;
+}
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidRxRingRelease(uint8 RX_FIFO,uint16 u16Count)                                      
+* \Description     : Release frames obtained with MCAN_u16RxRingPeek                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant (single consumer per FIFO)                                             
+* \Parameters (in) : RX_FIFO number of FIFO, u16Count frames to release                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidRxRingRelease(uint8 RX_FIFO,uint16 u16Count)
+{
+    uint16 Local_u16Available = (uint16)(CAN_RxRingHead[RX_FIFO] - CAN_RxRingTail[RX_FIFO]);
+    if(u16Count > Local_u16Available)
+    {
+        u16Count = Local_u16Available;
+    }
+    CAN_COMPILER_BARRIER();
+    CAN_RxRingTail[RX_FIFO] = (uint16)(CAN_RxRingTail[RX_FIFO] + u16Count);
+}
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidGetRxRingStatus(uint8 RX_FIFO,CAN_RxRingStatus_t* pStatus)                                      
+* \Description     : Read the overrun counters of a FIFO                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Reentrant                                             
+* \Parameters (in) : RX_FIFO number of FIFO                
+* \Parameters (out): pStatus overrun counters                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidGetRxRingStatus(uint8 RX_FIFO,CAN_RxRingStatus_t* pStatus)
+{
+    pStatus->SoftwareOverruns = CAN_RxRingStatus[RX_FIFO].SoftwareOverruns;
+    pStatus->HardwareOverruns = CAN_RxRingStatus[RX_FIFO].HardwareOverruns;
+}
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidBusMonitorSample(void)                                      
+* \Description     : sample TEC/REC, the error state and LEC into the current statistics window and clear LEC.
+*                    Also done by the error interrupt and by MCAN_VoidGetBusStats; call it periodically
+*                    when the LEC interrupt is not enabled to catch more error codes                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : None                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidBusMonitorSample(void)
+{
+    uint32 Local_u32Esr = CAN_Control->ESR.r;
+    uint8 Local_u8Tec = CAN_ESR_TEC(Local_u32Esr);
+    uint8 Local_u8Rec = CAN_ESR_REC(Local_u32Esr);
+    uint8 Local_u8Lec = CAN_ESR_LEC(Local_u32Esr);
+    uint8 Local_u8State = CAN_ERROR_ACTIVE;
+
+    if(Local_u8Lec!=CAN_LEC_NONE && Local_u8Lec<CAN_LEC_COUNT)
+    {
+        CAN_MonitorTotals.Lec[Local_u8Lec]++;
+        /*LEC keeps the last error: clear it so the same error is not counted again*/
+        CAN_Control->ESR.B.LEC = CAN_LEC_NONE;
+    }
+    if((Local_u32Esr & CAN_ESR_BOFF)!=0)
+    {
+        Local_u8State = CAN_ERROR_BUS_OFF;
     }
-    else if(pFilterConfig->filterScalableWidth==CAN_TWO16BIT_FILTER)
+    else if((Local_u32Esr & CAN_ESR_EPVF)!=0)
     {
-        /*set scale width*/
-        CLEAR_BIT(CAN_Filter->FS1R,pFilterConfig->FilterBank);
-				
-			/*two IDs in ID List mode and Mask(FilterMaskIdLow) and ID(FilterIdLow) in ID Mask mode*/
-			/*																		ID:				STDID-RTR-IDE-EXTID[17:15]																																*/
-				CAN_Filter->FiRx[pFilterConfig->FilterBank].FxR1 = (((0x0000FFFF & pFilterConfig->FilterMaskIdLow) <<16) | pFilterConfig->FilterIdLow);
-			/*two IDs in ID List mode and Mask(FilterMaskIdHigh) and ID(FilterMaskIdLow) in ID Mask mode*/
-			/*																		ID:				STDID-RTR-IDE-EXTID[17:15]																																*/
-				CAN_Filter->FiRx[pFilterConfig->FilterBank].FxR2 = (((0x0000FFFF & pFilterConfig->FilterMaskIdHigh) <<16) | pFilterConfig->FilterIdHigh);
-			
+        Local_u8State = CAN_ERROR_PASSIVE;
+    }
+    else if((Local_u32Esr & CAN_ESR_EWGF)!=0)
+    {
+        Local_u8State = CAN_ERROR_WARNING;
     }
     else{}
 
-    /*after configure filter bank registers add it to specific FIFO*/
-    if(pFilterConfig->FilterFIFOAssignment==0)
+    if(Local_u8State > CAN_MonitorWindow.ErrorStateWorst)
     {
-        /*assign this filter bank to fifo 0*/
-        CLEAR_BIT(CAN_Filter->FFA1R,pFilterConfig->FilterBank);
+        CAN_MonitorWindow.ErrorStateWorst = Local_u8State;
     }
-    else
+    if(Local_u8Tec < CAN_MonitorWindow.TecMin)
     {
-        /*assign this filter bank to fifo 1*/
-        SET_BIT(CAN_Filter->FFA1R,pFilterConfig->FilterBank);
+        CAN_MonitorWindow.TecMin = Local_u8Tec;
+    }
+    if(Local_u8Tec > CAN_MonitorWindow.TecMax)
+    {
+        CAN_MonitorWindow.TecMax = Local_u8Tec;
+    }
+    if(Local_u8Rec < CAN_MonitorWindow.RecMin)
+    {
+        CAN_MonitorWindow.RecMin = Local_u8Rec;
     }
+    if(Local_u8Rec > CAN_MonitorWindow.RecMax)
+    {
+        CAN_MonitorWindow.RecMax = Local_u8Rec;
+    }
+    CAN_MonitorWindow.TecLast = Local_u8Tec;
+    CAN_MonitorWindow.RecLast = Local_u8Rec;
+}
 
-    /*filter Acivate*/
-    SET_BIT(CAN_Filter->FA1R,pFilterConfig->FilterBank);
+/******************************************************************************
+* \Syntax          : void MCAN_VoidGetBusStats(CAN_BusStats_t* pStats,uint32 u32WindowUs)                                      
+* \Description     : close the statistics window and start the next one                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : u32WindowUs time since the previous call in microseconds (used for the bus load)                
+* \Parameters (out): pStats statistics of the window                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidGetBusStats(CAN_BusStats_t* pStats,uint32 u32WindowUs)
+{
+    CAN_MonitorTotals_t Local_Totals;
+    uint64 Local_u64Capacity;
+    uint32 Local_u32Bits;
+    uint8 Local_u8Itr;
 
-    /*leave init mode of filterbank */
-    CLEAR_BIT(CAN_Filter->FMR,0);
+    MCAN_VoidBusMonitorSample();
+    Local_Totals = *(const CAN_MonitorTotals_t*)&CAN_MonitorTotals;
+    *pStats = *(const CAN_BusStats_t*)&CAN_MonitorWindow;
+    CAN_VoidMonitorWindowStart();
+
+    pStats->WindowUs = u32WindowUs;
+    pStats->FramesRx = (uint16)((Local_Totals.FramesRx[0] - CAN_MonitorLast.FramesRx[0]) +
+                                (Local_Totals.FramesRx[1] - CAN_MonitorLast.FramesRx[1]));
+    pStats->FramesTx = (uint16)(Local_Totals.FramesTx - CAN_MonitorLast.FramesTx);
+    pStats->TxArbitrationLost = (uint16)(Local_Totals.ArbitrationLost - CAN_MonitorLast.ArbitrationLost);
+    pStats->TxErrors = (uint16)(Local_Totals.TxErrors - CAN_MonitorLast.TxErrors);
+    for(Local_u8Itr=0;Local_u8Itr<CAN_LEC_COUNT;Local_u8Itr++)
+    {
+        pStats->LecCount[Local_u8Itr] = (uint16)(Local_Totals.Lec[Local_u8Itr] - CAN_MonitorLast.Lec[Local_u8Itr]);
+    }
+
+    /*bus load: frame bits over the bits the window can carry (kbit/s * us / 1000)*/
+    Local_u32Bits = (Local_Totals.BitsRx[0] - CAN_MonitorLast.BitsRx[0]) + (Local_Totals.BitsRx[1] - CAN_MonitorLast.BitsRx[1]) +
+                    (Local_Totals.BitsTx - CAN_MonitorLast.BitsTx);
+    Local_u64Capacity = (uint64)u32WindowUs * CAN_u16BitrateKbps;
+    if(Local_u64Capacity==0)
+    {
+        pStats->BusLoadPermille = 0;
+    }
+    else
+    {
+        uint64 Local_u64Load = ((uint64)Local_u32Bits * 1000000) / Local_u64Capacity;
+        pStats->BusLoadPermille = (Local_u64Load > 1000) ? 1000 : (uint16)Local_u64Load;
+    }
+    CAN_MonitorLast = Local_Totals;
 }
 
 /******************************************************************************
-* \Syntax          : uint8 MCAN_u8Transmission(CAN_TX_Frame_t * TXframe,uint8 Data[])                                      
-* \Description     : initialize CAN Frame to be send and put it in Tx mailbox and                                                                           
-* \Sync\Async      : ASynchronous (when tx is transmitted interrupt notify the app)                                               
-* \Reentrancy      : Non Reentrant                                             
-* \Parameters (in) : CAN_TX_Frame * TXframe , Data array represent the data bytes                  
-* \Parameters (out): None                                                      
-* \Return value:   : return the mailbox number used to transmit
+* \Syntax          : Std_ReturnType MCAN_u8SolveBitTiming(uint32 u32PclkHz,uint32 u32Bitrate,
+*                                                       uint16 u16SamplePointPermille,CAN_BitTiming_t* pTiming)
+* \Description     : search every prescaler / segment combination for the one closest to the requested bit rate,
+*                    then to the requested sample point, then with the most quanta
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : u32PclkHz APB1 clock, u32Bitrate bit rate in bit/s, u16SamplePointPermille sample point
+* \Parameters (out): pTiming best timing
+* \Return value:   : Std_ReturnType N_OK when no timing is within CAN_BIT_TIMING_MAX_ERROR_PPM
 *******************************************************************************/
-uint8 MCAN_u8Transmission(CAN_TX_Frame_t * TXframe,uint8 Data[])
+Std_ReturnType MCAN_u8SolveBitTiming(uint32 u32PclkHz,uint32 u32Bitrate,uint16 u16SamplePointPermille,
+                                     CAN_BitTiming_t* pTiming)
 {
-    /*get the empty mailbox number (CODE in CAN TSR)*/
-    /*In case at least one transmit mailbox is free, the code value is equal to the number of the
-    *next transmit mailbox free.
-    *In case all transmit mailboxes are pending, the code value is equal to the number of the
-    *transmit mailbox with the lowest priority.*/
-    uint8 Local_u8EmptyMailboxNumber = (uint8)CAN_Control->TSR.CODE;
+    uint32 Local_u32BestError = 0xFFFFFFFF;
+    uint16 Local_u16BestSpError = 0xFFFF;
+    uint8 Local_u8Quanta;
 
-    /*check if there is any empty mailbox not to overwrite any pending mailbox  */
-    if(CAN_Control->TSR.TME0==1||CAN_Control->TSR.TME1==1||CAN_Control->TSR.TME2==1)
+    if ((u32Bitrate == 0) || (u32PclkHz == 0))
+    {
+        return N_OK;
+    }
+    /*from the most quanta down so a tie keeps the finer resolution*/
+    for (Local_u8Quanta = CAN_TQ_MAX; Local_u8Quanta >= CAN_TQ_MIN; Local_u8Quanta--)
     {
-        CAN_Mailbox->Txmailbox[Local_u8EmptyMailboxNumber].TIR.IDE=TXframe->IDE;
-        if(TXframe->IDE==CAN_ID_STD)
+        uint32 Local_u32Quantum = u32Bitrate * Local_u8Quanta;
+        /*nearest prescaler for this number of quanta, the others are further from the bit rate*/
+        uint32 Local_u32Brp = (u32PclkHz + Local_u32Quantum / 2) / Local_u32Quantum;
+        uint64 Local_u64Actual;
+        uint64 Local_u64Diff;
+        uint32 Local_u32Error;
+        sint32 Local_s32Ts2;
+        uint8 Local_u8Ts1;
+        uint8 Local_u8Ts2;
+        uint16 Local_u16Sp;
+        uint16 Local_u16SpError;
+
+        if ((Local_u32Brp == 0) || (Local_u32Brp > CAN_BRP_MAX))
         {
-            CAN_Mailbox->Txmailbox[Local_u8EmptyMailboxNumber].TIR.STD_EXID18_28 = TXframe->StdId;
+            continue;
         }
-        else if(TXframe->IDE==CAN_ID_EXT)
+        Local_u64Actual = (uint64)Local_u32Brp * Local_u32Quantum;
+        Local_u64Diff = (Local_u64Actual > u32PclkHz) ? (Local_u64Actual - u32PclkHz) : (u32PclkHz - Local_u64Actual);
+        Local_u32Error = (uint32)((Local_u64Diff * 1000000) / Local_u64Actual);
+
+        /*sample point at the end of TS1: TS2 = quanta after it, clamped to the segment ranges*/
+        Local_s32Ts2 = (sint32)(((uint32)Local_u8Quanta * (1000 - u16SamplePointPermille) + 500) / 1000);
+        if (Local_s32Ts2 < 1)
         {
-            /*Txframe->ExtId is the 29 bit Id contains standard and extended*/
-            CAN_Mailbox->Txmailbox[Local_u8EmptyMailboxNumber].TIR.EXID = TXframe->ExtId;
-            CAN_Mailbox->Txmailbox[Local_u8EmptyMailboxNumber].TIR.STD_EXID18_28 = (TXframe->ExtId>>18);
+            Local_s32Ts2 = 1;
         }
-        CAN_Mailbox->Txmailbox[Local_u8EmptyMailboxNumber].TIR.RTR = TXframe->RTR;
-        CAN_Mailbox->Txmailbox[Local_u8EmptyMailboxNumber].TDTR.DLC = TXframe->DLC;
-        /*Enable or Disable sending time stamp*/
-        CAN_Mailbox->Txmailbox[Local_u8EmptyMailboxNumber].TDTR.TGT = TXframe->TransmitGlobalTime;
-
-
-        uint8 Local_u8itr=0;
-        for(Local_u8itr=0;Local_u8itr<TXframe->DLC;Local_u8itr++)
+        if (Local_s32Ts2 > CAN_TS2_MAX)
         {
-            if(Local_u8itr<=3)
-            {
-                CAN_Mailbox->Txmailbox[Local_u8EmptyMailboxNumber].TDLR.DATA[Local_u8itr] = Data[Local_u8itr];
-            }
-            else
-            {
-                CAN_Mailbox->Txmailbox[Local_u8EmptyMailboxNumber].TDHR.DATA[Local_u8itr-4] = Data[Local_u8itr];
-            }
+            Local_s32Ts2 = CAN_TS2_MAX;
+        }
+        if ((Local_u8Quanta - 1 - Local_s32Ts2) > CAN_TS1_MAX)
+        {
+            Local_s32Ts2 = Local_u8Quanta - 1 - CAN_TS1_MAX;
         }
+        Local_u8Ts2 = (uint8)Local_s32Ts2;
+        Local_u8Ts1 = (uint8)(Local_u8Quanta - 1 - Local_u8Ts2);
+        Local_u16Sp = (uint16)(((uint32)(1 + Local_u8Ts1) * 1000 + Local_u8Quanta / 2) / Local_u8Quanta);
+        Local_u16SpError = (Local_u16Sp > u16SamplePointPermille) ? (Local_u16Sp - u16SamplePointPermille)
+                                                                  : (u16SamplePointPermille - Local_u16Sp);
 
-        /*Request to send*/
-        CAN_Mailbox->Txmailbox[Local_u8EmptyMailboxNumber].TIR.TXRQ=1;
-        //return the mailbox number to be used for polling
-        return Local_u8EmptyMailboxNumber;
-        //while(CAN_Mailbox->Txmailbox[Local_u8EmptyMailboxNumber].TIR.TXRQ == 1); // clear by hardware when mailbox empty
+        if ((Local_u32Error < Local_u32BestError) ||
+            ((Local_u32Error == Local_u32BestError) && (Local_u16SpError < Local_u16BestSpError)))
+        {
+            Local_u32BestError = Local_u32Error;
+            Local_u16BestSpError = Local_u16SpError;
+            pTiming->BRP = (uint16)Local_u32Brp;
+            pTiming->TS1 = Local_u8Ts1;
+            pTiming->TS2 = Local_u8Ts2;
+            pTiming->SJW = (Local_u8Ts2 < CAN_SJW_MAX) ? Local_u8Ts2 : CAN_SJW_MAX;
+            pTiming->Quanta = Local_u8Quanta;
+            pTiming->SamplePointPermille = Local_u16Sp;
+            pTiming->Bitrate = (u32PclkHz + Local_u32Brp * Local_u8Quanta / 2) / (Local_u32Brp * Local_u8Quanta);
+            pTiming->ErrorPpm = Local_u32Error;
+        }
     }
+    return (Local_u32BestError <= CAN_BIT_TIMING_MAX_ERROR_PPM) ? OK : N_OK;
 }
 
-
 /******************************************************************************
-* \Syntax          : void MCAN_VoidReception(uint8 RX_FIFO,CAN_RX_Frame_t * RXframe,uint8 Data[])                                      
-* \Description     : Read CAN frame from RX FIFO and store its data in Data Array.                                                                           
-* \Sync\Async      : Synchronous                                                
-* \Reentrancy      : Non Reentrant                                             
-* \Parameters (in) :  RX_ FIFO number of fifo to read from,CAN_RX_Frame * RXframe , Data array represent the data bytes                  
-* \Parameters (out): CAN_RX_Frame * RXframe , Data array represent the data bytes                                                      
+* \Syntax          : void MCAN_VoidSetRecoveryMode(uint8 u8Mode)
+* \Description     : select the bus-off handling and enable the bus-off interrupt
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Mode @ref CAN_recovery_mode
+* \Parameters (out): None
 * \Return value:   : None
 *******************************************************************************/
-void MCAN_VoidReception(uint8 RX_FIFO,CAN_RX_Frame_t * RXframe,uint8 Data[])
+void MCAN_VoidSetRecoveryMode(uint8 u8Mode)
 {
-    /*we enter this function after RX interrupt and the callback of specific FIFO call this function
-    * so the Frame is ready in the FIFO mailbox*/
-    /*FIFO Registers Contain the frame to be read (the first received one)*/
-    uint8 msg_count=CAN_Control->RFR[RX_FIFO].FMP;
-		// while(msg_count<=0);
-    /*Read the IDE from received frame*/
-    RXframe->IDE = CAN_Mailbox->RXFIFO[RX_FIFO].RIR.IDE;
-    if(CAN_Mailbox->RXFIFO[RX_FIFO].RIR.IDE==CAN_ID_STD)
+    CAN_RecoveryMode = u8Mode;
+    CAN_RecoveryState = CAN_RECOVERY_ACTIVE;
+    CAN_RecoveryTimer = 0;
+    CAN_RecoveryStableTicks = 0;
+    CAN_BackoffLevel = 0;
+    CAN_TxHold = 0;
+    if(u8Mode == CAN_RECOVERY_ABOM)
     {
-        RXframe->StdId = CAN_Mailbox->RXFIFO[RX_FIFO].RIR.STD_EXID18_28;
+        CAN_Control->MCR |= CAN_MCR_ABOM;
     }
-    else if(CAN_Mailbox->RXFIFO[RX_FIFO].RIR.IDE==CAN_ID_EXT)
+    else if(u8Mode == CAN_RECOVERY_BACKOFF)
     {
-        RXframe->ExtId = (CAN_Mailbox->RXFIFO[RX_FIFO].RIR.STD_EXID18_28<<18)|CAN_Mailbox->RXFIFO[RX_FIFO].RIR.EXID;
+        /*bus-off is left on software request only*/
+        CAN_Control->MCR &= ~CAN_MCR_ABOM;
     }
     else{}
-    RXframe->RTR = CAN_Mailbox->RXFIFO[RX_FIFO].RIR.RTR;
-    RXframe->DLC = CAN_Mailbox->RXFIFO[RX_FIFO].RDTR.DLC;
-    /*this index indicates which filter is accept this frame then it tells us this data related to which variable according to out mapping (index->variable)*/
-    RXframe->FilterMatchIndex = CAN_Mailbox->RXFIFO[RX_FIFO].RDTR.FMI;
-    RXframe->TimeStamp = CAN_Mailbox->RXFIFO[RX_FIFO].RDTR.TIME;
-    uint8 Local_u8Itr;
-		for(Local_u8Itr=0;Local_u8Itr<8;Local_u8Itr++)
-				Data[Local_u8Itr]=0;
-    for(Local_u8Itr=0;Local_u8Itr<RXframe->DLC;Local_u8Itr++)
+    if(u8Mode != CAN_RECOVERY_OFF)
     {
-        if(Local_u8Itr<=3)
-            Data[Local_u8Itr] = CAN_Mailbox->RXFIFO[RX_FIFO].RDLR.DATA[Local_u8Itr];
-        else
-            Data[Local_u8Itr] = CAN_Mailbox->RXFIFO[RX_FIFO].RDHR.DATA[Local_u8Itr-4];
+        CAN_Control->IER.B.BOFIE = 1;
+        CAN_Control->IER.B.ERRIE = 1;
     }
-    
-    /*After reading the frame ,Release the FIFO to reduce the msgs count and receive another one*/
-    CAN_Control->RFR[RX_FIFO].RFOM=1;   
 }
 
 /******************************************************************************
-* \Syntax          : void MCAN_VoidStart()                                      
-* \Description     : Start CAN by leaving the initialization mode to normal mode                                                                             
-* \Sync\Async      : Synchronous                                               
-* \Reentrancy      : Non Reentrant                                             
-* \Parameters (in) : None                
-* \Parameters (out): None                                                      
+* \Syntax          : void MCAN_VoidRecoveryTick(void)
+* \Description     : time base of the bus-off recovery, call every CAN_RECOVERY_TICK_MS
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
 * \Return value:   : None
 *******************************************************************************/
-void MCAN_VoidStart()
-{  
-    /*Clearing the INRQ bit in CAN_MCR Register*/
-    CLEAR_BIT(CAN_Control->MCR,0);
-    /*confirm that normal mode is start when INAK bit in CAN_MSR Register is cleared*/
-    while(!(READ_BIT(CAN_Control->MSR,0)==0));
-    
-}
-/******************************************************************************
-* \Syntax          : uint8 MCAN_u8FreeMailboxes(void)                                      
-* \Description     : Return the number of free mailboxes to start transmit                                                                             
-* \Sync\Async      : Synchronous                                               
-* \Reentrancy      : Non Reentrant                                             
-* \Parameters (in) : None                
-* \Parameters (out): None                                                      
-* \Return value:   : number of free mailboxes-> 0-3
-*******************************************************************************/
-uint8 MCAN_u8FreeMailboxes(void)
+void MCAN_VoidRecoveryTick(void)
 {
-    uint8 local_u8counter=0;
-    if(CAN_Control->TSR.TME0==1)
-        local_u8counter++;
-    if(CAN_Control->TSR.TME1==1)
-        local_u8counter++;
-    if(CAN_Control->TSR.TME2==1)
-            local_u8counter++;
-    return local_u8counter;
-}
+    uint32 Local_u32Esr = CAN_Control->ESR.r;
 
-
-/******************************************************************************
-* \Syntax          : uint8 MCAN_u8MailboxPendingStatus(uint8 mailboxNumber)                                      
-* \Description     : Return whether the transmission is completed or not                                                                             
-* \Sync\Async      : Synchronous                                               
-* \Reentrancy      : Non Reentrant                                             
-* \Parameters (in) : uint8 mailboxNumber:number of the mailbox                
-* \Parameters (out): None                                                      
-* \Return value:   : status of mailbox 0->pending,1->not pending(completed)
-*******************************************************************************/
-uint8 MCAN_u8MailboxPendingStatus(uint8 mailboxNumber)
-{
-    switch (mailboxNumber)
+    CAN_RecoveryTicks++;
+    if(CAN_RecoveryMode == CAN_RECOVERY_OFF)
     {
-    case 0:
-        return CAN_Control->TSR.RQCP0;
+        return;
+    }
+    switch(CAN_RecoveryState)
+    {
+        case CAN_RECOVERY_ACTIVE:
+            if((Local_u32Esr & CAN_ESR_BOFF) != 0)
+            {
+                /*bus-off interrupt masked or not yet served: keep it out while the episode opens, then put
+                *back the mask the application chose*/
+                uint8 Local_u8Errie = CAN_Control->IER.B.ERRIE;
+                CAN_Control->IER.B.ERRIE = 0;
+                CAN_VoidBusOffEnter(CAN_ESR_LEC(Local_u32Esr));
+                CAN_Control->IER.B.ERRIE = Local_u8Errie;
+            }
+            else if(CAN_RecoveryStableTicks < (CAN_BUSOFF_STABLE_MS / CAN_RECOVERY_TICK_MS))
+            {
+                CAN_RecoveryStableTicks++;
+            }
+            else{}
         break;
-        case 1:
-        return CAN_Control->TSR.RQCP1;
+
+        case CAN_RECOVERY_WAIT_BACKOFF:
+            if(CAN_RecoveryTimer > 0)
+            {
+                CAN_RecoveryTimer--;
+            }
+            else
+            {
+                /*leaving bus-off by software: set then clear INRQ*/
+                CAN_Control->MCR |= CAN_MCR_INRQ;
+                CAN_RecoveryState = CAN_RECOVERY_REINIT;
+                CAN_TsValid = 0;
+            }
         break;
-        case 2:
-        return CAN_Control->TSR.RQCP2;
+
+        case CAN_RECOVERY_REINIT:
+            if((CAN_Control->MSR & CAN_MSR_INAK) != 0)
+            {
+                CAN_Control->MCR &= ~CAN_MCR_INRQ;
+                CAN_RecoveryState = CAN_RECOVERY_WAIT_BUS;
+            }
+        break;
+
+        case CAN_RECOVERY_WAIT_BUS:
+            /*the hardware leaves bus-off after 128 x 11 recessive bits, then synchronizes (INAK cleared)*/
+            if((Local_u32Esr & CAN_ESR_BOFF) == 0 && (CAN_Control->MSR & CAN_MSR_INAK) == 0)
+            {
+                CAN_VoidBusOffLeave();
+            }
+        break;
+
+        default:
         break;
     }
 }
 
 /******************************************************************************
-* \Syntax          : uint8 MCAN_u8RX_FIFOMeassages(uint8 RX_FIFO)                                      
-* \Description     : Return the number of messages in fifo                                                                             
-* \Sync\Async      : Synchronous                                               
-* \Reentrancy      : Non Reentrant                                             
-* \Parameters (in) : uint8 RX_FIFO number of FIFO 0->FIFO0,1->FIFO1                
-* \Parameters (out): None                                                      
-* \Return value:   : number of messages in FIFO
+* \Syntax          : uint8 MCAN_u8RecoveryState(void)
+* \Description     : state of the bus-off recovery
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint8 @ref CAN_recovery_state
 *******************************************************************************/
-uint8 MCAN_u8RX_FIFOMeassages(uint8 RX_FIFO)
+uint8 MCAN_u8RecoveryState(void)
+{
+    return CAN_RecoveryState;
+}
+
+/******************************************************************************
+* \Syntax          : uint8 MCAN_u8GetBusOffEpisodes(CAN_BusOffEpisode_t* pEpisodes,uint8 u8Max)
+* \Description     : copy the latest bus-off episodes, most recent first
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Max size of pEpisodes
+* \Parameters (out): pEpisodes episodes
+* \Return value:   : uint8 number of episodes copied
+*******************************************************************************/
+uint8 MCAN_u8GetBusOffEpisodes(CAN_BusOffEpisode_t* pEpisodes,uint8 u8Max)
 {
-    return CAN_Control->RFR[RX_FIFO].FMP;    
+    uint16 Local_u16Count = (CAN_BusOffEpisodeCount < CAN_BUSOFF_EPISODES) ? CAN_BusOffEpisodeCount : CAN_BUSOFF_EPISODES;
+    uint8 Local_u8Index;
+
+    if(Local_u16Count > u8Max)
+    {
+        Local_u16Count = u8Max;
+    }
+    for(Local_u8Index=0;Local_u8Index<Local_u16Count;Local_u8Index++)
+    {
+        pEpisodes[Local_u8Index] = CAN_BusOffEpisodes[(uint16)(CAN_BusOffEpisodeCount - 1 - Local_u8Index) % CAN_BUSOFF_EPISODES];
+    }
+    return (uint8)Local_u16Count;
 }
 
 /******************************************************************************
@@ -592,40 +2494,41 @@ void MCAN_VoidEnableNotifications(CAN_notifications_t notification,void (*callba
 *******************************************************************************/
 void MCAN_VoidDisableNotifications(CAN_notifications_t notification)
 {
+    /*TX notifications only drop the callback: the mailbox empty interrupt refills the TX queue*/
     switch (notification)
     {
     case TxMailbox0_completed:
-        CAN_Control->IER.B.TMEIE=0;
+        CAN_TxMailbox0_Completed_Callback=NULL;
         break;
     
     case TxMailbox1_completed:
-        CAN_Control->IER.B.TMEIE=0;
+        CAN_TxMailbox1_Completed_Callback=NULL;
         break;
     
     case TxMailbox2_completed:
-        CAN_Control->IER.B.TMEIE=0;
+        CAN_TxMailbox2_Completed_Callback=NULL;
         break;
     case TxMailbox0_Abort:
-        CAN_Control->IER.B.TMEIE=0;
+        CAN_TxMailbox0_Abort_Callback=NULL;
         break;
     
     case TxMailbox1_Abort:
-        CAN_Control->IER.B.TMEIE=0;
+        CAN_TxMailbox1_Abort_Callback=NULL;
         break;
     
     case TxMailbox2_Abort:
-        CAN_Control->IER.B.TMEIE=0;
+        CAN_TxMailbox2_Abort_Callback=NULL;
         break;
     case TxMailbox0_TXERR:
-        CAN_Control->IER.B.TMEIE=0;
+        CAN_TxMailbox0_TXERR_Callback=NULL;
         break;
     
     case TxMailbox1_TXERR:
-        CAN_Control->IER.B.TMEIE=0;
+        CAN_TxMailbox1_TXERR_Callback=NULL;
         break;
     
     case TxMailbox2_TXERR:
-        CAN_Control->IER.B.TMEIE=0;
+        CAN_TxMailbox2_TXERR_Callback=NULL;
         break;
     
     case RX_FIFO0_FMP:
@@ -667,144 +2570,263 @@ void MCAN_VoidDisableNotifications(CAN_notifications_t notification)
     }
 }
 
+/******************************************************************************
+* \Syntax          : void MCAN_VoidSetFilterHandler(uint8 u8Bank,uint8 u8Filter,CAN_FrameHandler_t pHandler,void* pContext)                                      
+* \Description     : attach a handler to one filter of a bank and rebuild the FMI dispatch table.
+*                    u8Filter is the filter inside the bank: 0 for a 32-bit mask bank, 0-1 for a 32-bit list or
+*                    16-bit mask bank (FR1,FR2), 0-3 for a 16-bit list bank (FR1 low/high, FR2 low/high)                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : u8Bank filter bank, u8Filter filter in the bank, pHandler handler (NULL to detach),
+*                    pContext passed back to the handler                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidSetFilterHandler(uint8 u8Bank,uint8 u8Filter,CAN_FrameHandler_t pHandler,void* pContext)
+{
+    if(u8Bank<CAN_FILTER_BANKS && u8Filter<CAN_FILTERS_PER_BANK)
+    {
+        CAN_BankHandlers[u8Bank][u8Filter].Handler = pHandler;
+        CAN_BankHandlers[u8Bank][u8Filter].Context = pContext;
+        CAN_VoidRebuildFmiTable();
+    }
+}
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidSetDefaultHandler(CAN_FrameHandler_t pHandler,void* pContext)                                      
+* \Description     : handler for frames whose filter has no handler attached                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : pHandler handler (NULL to ignore such frames), pContext passed back to the handler                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidSetDefaultHandler(CAN_FrameHandler_t pHandler,void* pContext)
+{
+    CAN_DefaultHandler.Handler = pHandler;
+    CAN_DefaultHandler.Context = pContext;
+    CAN_VoidRebuildFmiTable();
+}
+
+/******************************************************************************
+* \Syntax          : void MCAN_VoidDispatchMessage(uint8 RX_FIFO,const CAN_Frame_t* pFrame)                                      
+* \Description     : call the handler of the filter that accepted the frame: one table load indexed by
+*                    FIFO and FMI, no identifier comparison                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Reentrant                                             
+* \Parameters (in) : RX_FIFO FIFO the frame was received in, pFrame received frame                
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MCAN_VoidDispatchMessage(uint8 RX_FIFO,const CAN_Frame_t* pFrame)
+{
+    const CAN_FilterHandler_t* Local_pEntry = &CAN_FmiTable[RX_FIFO][pFrame->FMI & (CAN_FMI_TABLE_SIZE-1)];
+    if(Local_pEntry->Handler!=NULL)
+    {
+        Local_pEntry->Handler(pFrame,Local_pEntry->Context);
+    }
+}
+
+/******************************************************************************
+* \Syntax          : uint16 MCAN_u16DispatchRxRing(uint8 RX_FIFO,uint16 u16Max)                                      
+* \Description     : dispatch up to u16Max frames straight from the RX ring (no copy) and release them                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant (single consumer per FIFO)                                             
+* \Parameters (in) : RX_FIFO number of FIFO, u16Max largest number of frames to dispatch                
+* \Parameters (out): None                                                      
+* \Return value:   : number of frames dispatched
+*******************************************************************************/
+uint16 MCAN_u16DispatchRxRing(uint8 RX_FIFO,uint16 u16Max)
+{
+    const CAN_FilterHandler_t* Local_pTable = CAN_FmiTable[RX_FIFO];
+    const CAN_Frame_t* Local_pFrames;
+    uint16 Local_u16Done = 0;
+    uint16 Local_u16Count;
+    uint16 Local_u16Itr;
+
+    /*at most two contiguous runs (before and after the ring wraps)*/
+    while(Local_u16Done<u16Max && (Local_u16Count = MCAN_u16RxRingPeek(RX_FIFO,&Local_pFrames)) != 0)
+    {
+        if(Local_u16Count > (u16Max - Local_u16Done))
+        {
+            Local_u16Count = u16Max - Local_u16Done;
+        }
+        for(Local_u16Itr=0;Local_u16Itr<Local_u16Count;Local_u16Itr++)
+        {
+            const CAN_FilterHandler_t* Local_pEntry = &Local_pTable[Local_pFrames[Local_u16Itr].FMI & (CAN_FMI_TABLE_SIZE-1)];
+            if(Local_pEntry->Handler!=NULL)
+            {
+                Local_pEntry->Handler(&Local_pFrames[Local_u16Itr],Local_pEntry->Context);
+            }
+        }
+        MCAN_VoidRxRingRelease(RX_FIFO,Local_u16Count);
+        Local_u16Done += Local_u16Count;
+    }
+    return Local_u16Done;
+}
+
 /*---------------------------------------------------------------------------------------------------------------------
  *  Interrupt Handlers
 ---------------------------------------------------------------------------------------------------------------------*/
   void USB_HP_CAN1_TX_IRQHandler()
   {
-    /*according to the state of the flags determine which callback to call*/
-    if(CAN_Control->TSR.RQCP0==1)
+    static void (**const Local_pCompleted[CAN_TX_MAILBOXES])() = {&CAN_TxMailbox0_Completed_Callback,&CAN_TxMailbox1_Completed_Callback,&CAN_TxMailbox2_Completed_Callback};
+    static void (**const Local_pArbitration[CAN_TX_MAILBOXES])() = {&CAN_TxMailbox0_ArbitrationERR_Callback,&CAN_TxMailbox1_ArbitrationERR_Callback,&CAN_TxMailbox2_ArbitrationERR_Callback};
+    static void (**const Local_pTxErr[CAN_TX_MAILBOXES])() = {&CAN_TxMailbox0_TXERR_Callback,&CAN_TxMailbox1_TXERR_Callback,&CAN_TxMailbox2_TXERR_Callback};
+    static void (**const Local_pAbort[CAN_TX_MAILBOXES])() = {&CAN_TxMailbox0_Abort_Callback,&CAN_TxMailbox1_Abort_Callback,&CAN_TxMailbox2_Abort_Callback};
+    uint32 Local_u32Tsr = CAN_Control->TSR.r;
+    uint8 Local_u8Mailbox;
+    uint32 Local_u32Irq;
+    void (*Local_pCallback)() = NULL;
+
+    /*serve every completed mailbox, the order does not matter as all of them are refilled below*/
+    for(Local_u8Mailbox=0;Local_u8Mailbox<CAN_TX_MAILBOXES;Local_u8Mailbox++)
     {
-        /*After transmit mailbox state turns from transmit to empty in both cases : passed or failed or aborted*/
-        if(CAN_Control->TSR.TXOK0==1)
-        {
-            if(CAN_TxMailbox0_Completed_Callback!=NULL)
-            {
-                CAN_TxMailbox0_Completed_Callback();
-            }
-        }
-        else if(CAN_Control->TSR.ALST0==1)
-        {
-            CAN_TxMailbox0_ArbitrationERR_Callback();
-        }
-        else if(CAN_Control->TSR.TERR0==1)
-        {
-            CAN_TxMailbox0_TXERR_Callback();
-        }
-        else if(CAN_Control->TSR.ABRQ0==1)
+        if((Local_u32Tsr & CAN_TSR_RQCP(Local_u8Mailbox)) == 0)
         {
-            CAN_TxMailbox0_Abort_Callback();
+            continue;
         }
-        /*clear flag*/
-        CAN_Control->TSR.RQCP0 = 1;
-    }
-    else if(CAN_Control->TSR.RQCP1==1)
-    {
-        if(CAN_Control->TSR.TXOK1==1)
+        /*a transmitting interrupt of higher priority must not see the shadow and the queue half updated,
+        *the callback runs unlocked*/
+        CAN_TX_LOCK(Local_u32Irq);
+        /*After transmit mailbox state turns from transmit to empty in both cases : passed or failed or aborted*/
+        if((Local_u32Tsr & CAN_TSR_TXOK(Local_u8Mailbox)) != 0)
         {
-            if(CAN_TxMailbox1_Completed_Callback!=NULL)
-            {
-                CAN_TxMailbox1_Completed_Callback();
-            }
+            CAN_MonitorTotals.FramesTx++;
+            CAN_MonitorTotals.BitsTx += CAN_u8FrameBits(CAN_TxShadow[Local_u8Mailbox].Frame.Id,CAN_TxShadow[Local_u8Mailbox].Frame.DLC);
+            Local_pCallback = *Local_pCompleted[Local_u8Mailbox];
         }
-        else if(CAN_Control->TSR.ALST1==1)
+        else if(CAN_TxShadow[Local_u8Mailbox].AbortRequested == CAN_ABORT_REQUEUE)
         {
-            CAN_TxMailbox1_ArbitrationERR_Callback();
+            /*aborted by the driver for a more urgent frame: take it back, ahead of equal keys
+            *(cannot fail, a slot above CAN_TX_QUEUE_SIZE is kept for each mailbox)*/
+            (void)CAN_u8TxQueueInsert(&CAN_TxShadow[Local_u8Mailbox].Frame,1);
+            Local_pCallback = NULL;
         }
-        else if(CAN_Control->TSR.TERR1==1)
+        else if(CAN_TxShadow[Local_u8Mailbox].AbortRequested == CAN_ABORT_DROP)
         {
-            CAN_TxMailbox1_TXERR_Callback();
+            /*stale value replaced by MCAN_u8TransmitLatest, the fresh one is in the queue*/
+            Local_pCallback = NULL;
         }
-        else if(CAN_Control->TSR.ABRQ1==1)
+        else if((Local_u32Tsr & CAN_TSR_ALST(Local_u8Mailbox)) != 0)
         {
-            CAN_TxMailbox1_Abort_Callback();
+            CAN_MonitorTotals.ArbitrationLost++;
+            Local_pCallback = *Local_pArbitration[Local_u8Mailbox];
         }
-        /*clear flag*/
-        CAN_Control->TSR.RQCP1 = 1;
-    }
-    else if(CAN_Control->TSR.RQCP2==1)
-    {
-        if(CAN_Control->TSR.TXOK2==1)
+        else if((Local_u32Tsr & CAN_TSR_TERR(Local_u8Mailbox)) != 0)
         {
-            if(CAN_TxMailbox2_Completed_Callback!=NULL)
-            {
-                CAN_TxMailbox2_Completed_Callback();
-            }
+            CAN_MonitorTotals.TxErrors++;
+            Local_pCallback = *Local_pTxErr[Local_u8Mailbox];
         }
-        else if(CAN_Control->TSR.ALST2=1)
+        else
         {
-            CAN_TxMailbox2_ArbitrationERR_Callback();
+            Local_pCallback = *Local_pAbort[Local_u8Mailbox];
         }
-        else if(CAN_Control->TSR.TERR2==1)
+        if(Local_u8Mailbox == CAN_TxReserved)
         {
-            CAN_TxMailbox2_TXERR_Callback();
+            CAN_VoidReservedComplete(Local_u8Mailbox,Local_u32Tsr);
         }
-        else if(CAN_Control->TSR.ABRQ2==1)
+        CAN_TxShadow[Local_u8Mailbox].Pending = 0;
+        CAN_TxShadow[Local_u8Mailbox].AbortRequested = CAN_ABORT_NONE;
+        /*clear flag (also clears TXOK/ALST/TERR)*/
+        CAN_TSR_WRITE(CAN_TSR_RQCP(Local_u8Mailbox));
+        CAN_TX_UNLOCK(Local_u32Irq);
+        if(Local_pCallback!=NULL)
         {
-            CAN_TxMailbox2_Abort_Callback();
+            Local_pCallback();
         }
-        /*clear flag*/
-        CAN_Control->TSR.RQCP2 = 1;
     }
+
+    /*keep the mailboxes busy with the most urgent queued frames*/
+    CAN_TX_LOCK(Local_u32Irq);
+    CAN_VoidTxQueueRefill();
+    CAN_VoidTxPreempt();
+    CAN_TX_UNLOCK(Local_u32Irq);
   }
   void USB_LP_CAN1_RX0_IRQHandler()
   {
-    if(CAN_Control->IER.B.FMPIE0==1 &&CAN_Control->RFR[CAN_RX_FIFO0].FMP<3)
+    if(CAN_RxRingEnabled[CAN_RX_FIFO0]==1)
+    {
+        /*drain everything in one interrupt, the callback only notifies that frames are waiting*/
+        CAN_VoidRxDrain(CAN_RX_FIFO0);
+        if(CAN_RxFIFO0_FMP_Callback!=NULL)
+        {
+            CAN_RxFIFO0_FMP_Callback();
+        }
+    }
+    else if(CAN_Control->IER.B.FMPIE0==1 &&CAN_Control->RFR[CAN_RX_FIFO0].B.FMP<3)
     {
         if(CAN_RxFIFO0_FMP_Callback!=NULL)
         {
             CAN_RxFIFO0_FMP_Callback();
         }
     }
-    else if(CAN_Control->IER.B.FFIE0==1 &&CAN_Control->RFR[CAN_RX_FIFO0].FULL==1)
+    else if(CAN_Control->IER.B.FFIE0==1 &&CAN_Control->RFR[CAN_RX_FIFO0].B.FULL==1)
     {
         if(CAN_RxFIFO0_FULL_Callback!=NULL)
         {
             CAN_RxFIFO0_FULL_Callback();
         }
         /*clear flag*/
-        CAN_Control->RFR[CAN_RX_FIFO0].FULL=0;
+        CAN_RFR_WRITE(CAN_RX_FIFO0,CAN_RFR_FULL);
     }
-    else if(CAN_Control->IER.B.FOVIE0==1 &&CAN_Control->RFR[CAN_RX_FIFO0].FOVR==1)
+    else if(CAN_Control->IER.B.FOVIE0==1 &&CAN_Control->RFR[CAN_RX_FIFO0].B.FOVR==1)
     {
         if(CAN_RxFIFO0_FOVR_Callback!=NULL)
         {
             CAN_RxFIFO0_FOVR_Callback();
         }
         /*clear flag*/
-        CAN_Control->RFR[CAN_RX_FIFO0].FOVR=0;
+        CAN_RFR_WRITE(CAN_RX_FIFO0,CAN_RFR_FOVR);
     } 
   }
   void CAN1_RX1_IRQHandler()
   {
-        if(CAN_Control->IER.B.FMPIE1==1 &&CAN_Control->RFR[CAN_RX_FIFO1].FMP<3)
+    if(CAN_RxRingEnabled[CAN_RX_FIFO1]==1)
+    {
+        /*drain everything in one interrupt, the callback only notifies that frames are waiting*/
+        CAN_VoidRxDrain(CAN_RX_FIFO1);
+        if(CAN_RxFIFO1_FMP_Callback!=NULL)
+        {
+            CAN_RxFIFO1_FMP_Callback();
+        }
+    }
+    else if(CAN_Control->IER.B.FMPIE1==1 &&CAN_Control->RFR[CAN_RX_FIFO1].B.FMP<3)
     {
         if(CAN_RxFIFO1_FMP_Callback!=NULL)
         {
             CAN_RxFIFO1_FMP_Callback();
         }
     }
-    else if(CAN_Control->IER.B.FFIE1==1 &&CAN_Control->RFR[CAN_RX_FIFO1].FULL==1)
+    else if(CAN_Control->IER.B.FFIE1==1 &&CAN_Control->RFR[CAN_RX_FIFO1].B.FULL==1)
     {
         if(CAN_RxFIFO1_FULL_Callback!=NULL)
         {
             CAN_RxFIFO1_FULL_Callback();
         }
         /*clear flag*/
-        CAN_Control->RFR[CAN_RX_FIFO1].FULL=0;
+        CAN_RFR_WRITE(CAN_RX_FIFO1,CAN_RFR_FULL);
     }
-    else if(CAN_Control->IER.B.FOVIE1==1 &&CAN_Control->RFR[CAN_RX_FIFO1].FOVR==1)
+    else if(CAN_Control->IER.B.FOVIE1==1 &&CAN_Control->RFR[CAN_RX_FIFO1].B.FOVR==1)
     {
         if(CAN_RxFIFO1_FOVR_Callback!=NULL)
         {
             CAN_RxFIFO1_FOVR_Callback();
         }
         /*clear flag*/
-        CAN_Control->RFR[CAN_RX_FIFO1].FOVR=0;
+        CAN_RFR_WRITE(CAN_RX_FIFO1,CAN_RFR_FOVR);
     } 
   }
   void CAN1_SCE_IRQHandler()
   {
+    /*LEC for the legacy callback, read before the monitor clears it*/
+    uint8 Local_u8Lec = CAN_ESR_LEC(CAN_Control->ESR.r);
+
+    if(CAN_RecoveryMode!=CAN_RECOVERY_OFF && (CAN_Control->ESR.r & CAN_ESR_BOFF)!=0)
+    {
+        CAN_VoidBusOffEnter(Local_u8Lec);
+    }
+    MCAN_VoidBusMonitorSample();
     if(CAN_Control->IER.B.ERRIE==1 && CAN_Control->IER.B.EWGIE==1)
     {
         if(CAN_EWG_Error_Callback!=NULL)
@@ -831,11 +2853,13 @@ void MCAN_VoidDisableNotifications(CAN_notifications_t notification)
     }
     else if(CAN_Control->IER.B.ERRIE==1 && CAN_Control->IER.B.LECIE>0)
     {
+        Error_Code = Local_u8Lec;
         if(CAN_Multi_Error_Callback!=NULL)
         {
             CAN_Multi_Error_Callback();
-            Error_Code = CAN_Control->ESR.B.LEC;
         }
         CAN_Control->ESR.B.LEC=0;
     }
+    /*clear the error interrupt flag, the interrupt stays pending otherwise*/
+    CAN_MSR_WRITE(CAN_MSR_ERRI);
   }
\ No newline at end of file
@@ -0,0 +1,103 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANDB_interface.h
+ *  module:  CANDB Module
+ *  @details:  helpers of the signal pack / unpack headers generated by tools/candb_gen.py from a DBC file.
+ *             A frame payload is handled as one 64-bit word: byte 0 in bits 7:0 (Intel signals), the byte
+ *             swapped word for Motorola signals, so each signal is one shift and one mask, no loop
+*********************************************************************************************************************/
+#ifndef _CANDB_INTERFACE_H
+#define _CANDB_INTERFACE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+#include "../../LIB/Std_Types.h"
+
+#include "../CAN/CAN_interface.h"
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/** @defgroup CANDB_bits field access on a 64-bit payload word **/
+#define CANDB_MASK(LEN)                 ((LEN) >= 64 ? ~(uint64)0 : (((uint64)1 << (LEN)) - 1))
+#define CANDB_GET(WORD,POS,LEN)         (((WORD) >> (POS)) & CANDB_MASK(LEN))
+#define CANDB_PUT(VALUE,POS,LEN)        (((uint64)(VALUE) & CANDB_MASK(LEN)) << (POS))
+/*two's complement sign extension of a LEN bit raw value, branch free*/
+#define CANDB_SIGN(RAW,LEN)             ((sint64)(((uint64)(RAW) ^ ((uint64)1 << ((LEN) - 1))) - ((uint64)1 << ((LEN) - 1))))
+
+/*byte order swap: byte 0 of the payload in bits 63:56, Motorola signals are then contiguous*/
+#define CANDB_SWAP(WORD)                __builtin_bswap64(WORD)
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Syntax          : uint64 CANDB_u64Load(const CAN_Frame_t* pFrame)
+* \Description     : payload of a received frame as one word (two word loads)
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : pFrame frame
+* \Parameters (out): None
+* \Return value:   : uint64 payload, byte 0 in bits 7:0
+*******************************************************************************/
+static inline uint64 CANDB_u64Load(const CAN_Frame_t* pFrame)
+{
+    return (uint64)pFrame->Data.Words[0] | ((uint64)pFrame->Data.Words[1] << 32);
+}
+
+/******************************************************************************
+* \Syntax          : void CANDB_VoidStore(CAN_Frame_t* pFrame,uint64 u64Payload)
+* \Description     : write a packed payload into a frame to transmit (two word stores)
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : u64Payload payload, byte 0 in bits 7:0
+* \Parameters (out): pFrame frame
+* \Return value:   : None
+*******************************************************************************/
+static inline void CANDB_VoidStore(CAN_Frame_t* pFrame,uint64 u64Payload)
+{
+    pFrame->Data.Words[0] = (uint32)u64Payload;
+    pFrame->Data.Words[1] = (uint32)(u64Payload >> 32);
+}
+
+/******************************************************************************
+* \Syntax          : uint64 CANDB_u64LoadBytes(const uint8* pData)
+* \Description     : payload of the 8 byte arrays used by MCAN_VoidReception
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : pData 8 data bytes
+* \Parameters (out): None
+* \Return value:   : uint64 payload, byte 0 in bits 7:0
+*******************************************************************************/
+static inline uint64 CANDB_u64LoadBytes(const uint8* pData)
+{
+    return (uint64)pData[0]         | ((uint64)pData[1] << 8)  | ((uint64)pData[2] << 16) |
+           ((uint64)pData[3] << 24) | ((uint64)pData[4] << 32) | ((uint64)pData[5] << 40) |
+           ((uint64)pData[6] << 48) | ((uint64)pData[7] << 56);
+}
+
+/******************************************************************************
+* \Syntax          : void CANDB_VoidStoreBytes(uint8* pData,uint64 u64Payload)
+* \Description     : write a packed payload into the 8 byte arrays used by MCAN_u8Transmission
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : u64Payload payload, byte 0 in bits 7:0
+* \Parameters (out): pData 8 data bytes
+* \Return value:   : None
+*******************************************************************************/
+static inline void CANDB_VoidStoreBytes(uint8* pData,uint64 u64Payload)
+{
+    pData[0] = (uint8)u64Payload;         pData[1] = (uint8)(u64Payload >> 8);
+    pData[2] = (uint8)(u64Payload >> 16); pData[3] = (uint8)(u64Payload >> 24);
+    pData[4] = (uint8)(u64Payload >> 32); pData[5] = (uint8)(u64Payload >> 40);
+    pData[6] = (uint8)(u64Payload >> 48); pData[7] = (uint8)(u64Payload >> 56);
+}
+
+#endif
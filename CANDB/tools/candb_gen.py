@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""Generate the CAN signal pack / unpack header of a DBC file.
+
+usage: candb_gen.py input.dbc output.h
+
+Only the message (BO_) and signal (SG_) lines are read. Each message gets:
+  CANDB_<Msg>_ID / _DLC      identifier in CAN_Frame_t layout and data length
+  CANDB_<Msg>_t              raw value of every signal
+  CANDB_<Msg>_<type>Get<Sig>  one signal from the 64-bit payload word (shift, mask, sign)
+  CANDB_<Msg>_u64Pack        all signals to the payload word
+  CANDB_<Msg>_VoidUnpack     payload word to all signals
+  CANDB_<Msg>_<Sig>_TO_PHYS / _FROM_PHYS  scaling (factor, offset) of the DBC
+
+Intel (@1) signals are taken from the payload word, byte 0 in bits 7:0. Motorola (@0)
+signals from the byte swapped word, where they are contiguous.
+
+Multiplexed signals (m<k>) may share bits with the signals of other multiplexer values.
+u64Pack puts them in the word only when the multiplexor signal (M) of the message holds k.
+VoidUnpack and the getters read them whatever the multiplexor: use the ones of the value
+received.
+
+The header includes "CANDB_interface.h": generate it into the CANDB folder or add that
+folder to the include path.
+"""
+
+import re
+import sys
+
+BO_RE = re.compile(r'^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+)\s+(\w+)')
+SG_RE = re.compile(r'^SG_\s+(\w+)\s*(M|m\d+)?\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*'
+                   r'\(([^,]+),([^)]+)\)\s*\[([^|]*)\|([^\]]*)\]\s*"([^"]*)"')
+
+
+class Signal:
+    def __init__(self, name, start, length, intel, signed, factor, offset, unit, dlc, mux):
+        self.name = name
+        # None for a plain signal, 'M' for the multiplexor, the multiplexer value k of m<k>
+        self.mux = mux
+        self.length = length
+        self.intel = intel
+        self.signed = signed
+        self.factor = factor
+        self.offset = offset
+        self.unit = unit
+        if intel:
+            self.pos = start
+        else:
+            # DBC gives the msb in the byte / bit numbering, the swapped word has byte 0 on top
+            msb = (7 - start // 8) * 8 + start % 8
+            self.pos = msb - length + 1
+        if length < 1 or length > 64 or self.pos < 0 or self.pos + length > 64:
+            raise ValueError('signal %s does not fit in 64 bits' % name)
+        # intel grows up from byte 0, motorola down from the top of the swapped word (byte dlc - 1 at (8 - dlc) * 8)
+        if (intel and self.pos + length > dlc * 8) or (not intel and self.pos < (8 - dlc) * 8):
+            raise ValueError('signal %s does not fit in %d data bytes' % (name, dlc))
+
+    def ctype(self):
+        for bits in (8, 16, 32, 64):
+            if self.length <= bits:
+                return ('s' if self.signed else 'u') + str(bits)
+
+    def word(self):
+        return 'Local_u64Swapped' if not self.intel else 'u64Payload'
+
+
+class Message:
+    def __init__(self, frame_id, name, dlc):
+        self.extended = (frame_id & 0x80000000) != 0
+        self.frame_id = frame_id & 0x1FFFFFFF
+        self.name = name
+        self.dlc = dlc
+        self.signals = []
+
+
+def parse(path):
+    messages = []
+    with open(path) as dbc:
+        for line in dbc:
+            line = line.strip()
+            bo = BO_RE.match(line)
+            if bo:
+                messages.append(Message(int(bo.group(1)), bo.group(2), int(bo.group(3))))
+                continue
+            sg = SG_RE.match(line)
+            if sg and messages:
+                messages[-1].signals.append(Signal(
+                    sg.group(1), int(sg.group(3)), int(sg.group(4)), sg.group(5) == '1',
+                    sg.group(6) == '-', sg.group(7).strip(), sg.group(8).strip(), sg.group(11),
+                    messages[-1].dlc, sg.group(2) if sg.group(2) in (None, 'M') else int(sg.group(2)[1:])))
+    return [m for m in messages if m.signals]
+
+
+def multiplexor(msg):
+    selectors = [s for s in msg.signals if s.mux == 'M']
+    if len(selectors) > 1:
+        raise ValueError('%s has more than one multiplexor signal' % msg.name)
+    if not selectors and any(s.mux is not None for s in msg.signals):
+        raise ValueError('%s has multiplexed signals but no multiplexor' % msg.name)
+    return selectors[0] if selectors else None
+
+
+def check_overlap(msg):
+    multiplexor(msg)
+    used = []
+    for sig in msg.signals:
+        # both byte orders are compared on the byte swapped word
+        bits = ((1 << sig.length) - 1) << sig.pos
+        if sig.intel:
+            bits = int.from_bytes(bits.to_bytes(8, 'little'), 'big')
+        for other, other_bits in used:
+            # signals of two multiplexer values are never in the same frame
+            if isinstance(sig.mux, int) and isinstance(other.mux, int) and sig.mux != other.mux:
+                continue
+            if other_bits & bits:
+                raise ValueError('signal %s of %s overlaps signal %s' % (sig.name, msg.name, other.name))
+        used.append((sig, bits))
+
+
+def emit_message(out, msg):
+    p = 'CANDB_' + msg.name
+    has_motorola = any(not s.intel for s in msg.signals)
+    kind = 'EXT' if msg.extended else 'STD'
+    out.append('/*%s: id 0x%X, dlc %d*/' % (msg.name, msg.frame_id, msg.dlc))
+    out.append('#define %s_ID%sCAN_FRAME_ID_%s(0x%X)' % (p, ' ' * 8, kind, msg.frame_id))
+    out.append('#define %s_DLC%s(%d)' % (p, ' ' * 7, msg.dlc))
+    for s in msg.signals:
+        out.append('#define %s_%s_TO_PHYS(RAW)%s((RAW) * (%s) + (%s))%s' % (
+            p, s.name, ' ', s.factor, s.offset, '  /*%s*/' % s.unit if s.unit else ''))
+        out.append('#define %s_%s_FROM_PHYS(PHYS) (((PHYS) - (%s)) / (%s))' % (p, s.name, s.offset, s.factor))
+    out.append('')
+    out.append('typedef struct')
+    out.append('{')
+    for s in msg.signals:
+        note = ''
+        if s.mux == 'M':
+            note = '  /*multiplexor*/'
+        elif s.mux is not None:
+            note = '  /*multiplexer value %d*/' % s.mux
+        out.append('    %sint%s %s;%s' % ('s' if s.signed else 'u', s.ctype()[1:], s.name, note))
+    out.append('}%s_t;' % p)
+    out.append('')
+
+    for s in msg.signals:
+        t = '%sint%s' % ('s' if s.signed else 'u', s.ctype()[1:])
+        word = 'u64Payload' if s.intel else 'CANDB_SWAP(u64Payload)'
+        raw = 'CANDB_GET(%s, %d, %d)' % (word, s.pos, s.length)
+        if s.signed:
+            raw = 'CANDB_SIGN(%s, %d)' % (raw, s.length)
+        out.append('static inline %s %s_%sGet%s(uint64 u64Payload)' % (t, p, s.ctype(), s.name))
+        out.append('{')
+        out.append('    return (%s)%s;' % (t, raw))
+        out.append('}')
+        out.append('')
+
+    selector = multiplexor(msg)
+
+    def put(s):
+        term = 'CANDB_PUT(pMsg->%s, %d, %d)' % (s.name, s.pos, s.length)
+        if isinstance(s.mux, int):
+            term = '((pMsg->%s == %d) ? %s : 0)' % (selector.name, s.mux, term)
+        return term
+
+    out.append('static inline uint64 %s_u64Pack(const %s_t* pMsg)' % (p, p))
+    out.append('{')
+    intel = [put(s) for s in msg.signals if s.intel]
+    motorola = [put(s) for s in msg.signals if not s.intel]
+    terms = list(intel)
+    if motorola:
+        terms.append('CANDB_SWAP(' + ' |\n                       '.join(motorola) + ')')
+    out.append('    return ' + ' |\n           '.join(terms) + ';')
+    out.append('}')
+    out.append('')
+
+    out.append('static inline void %s_VoidUnpack(uint64 u64Payload,%s_t* pMsg)' % (p, p))
+    out.append('{')
+    if has_motorola:
+        out.append('    uint64 Local_u64Swapped = CANDB_SWAP(u64Payload);')
+        out.append('')
+    for s in msg.signals:
+        t = '%sint%s' % ('s' if s.signed else 'u', s.ctype()[1:])
+        raw = 'CANDB_GET(%s, %d, %d)' % (s.word(), s.pos, s.length)
+        if s.signed:
+            raw = 'CANDB_SIGN(%s, %d)' % (raw, s.length)
+        out.append('    pMsg->%s = (%s)%s;' % (s.name, t, raw))
+    out.append('}')
+    out.append('')
+
+
+def main(argv):
+    if len(argv) != 3:
+        sys.stderr.write(__doc__)
+        return 1
+    try:
+        messages = parse(argv[1])
+        for msg in messages:
+            check_overlap(msg)
+    except ValueError as error:
+        sys.stderr.write('candb_gen: %s\n' % error)
+        return 1
+    guard = '_' + re.sub(r'\W', '_', argv[2].split('/')[-1]).upper()
+    out = ['/*generated by candb_gen.py from %s, do not edit*/' % argv[1].split('/')[-1],
+           '#ifndef %s' % guard,
+           '#define %s' % guard,
+           '',
+           '#include "CANDB_interface.h"',
+           '']
+    for msg in messages:
+        emit_message(out, msg)
+    out.append('#endif')
+    with open(argv[2], 'w') as header:
+        header.write('\n'.join(out) + '\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+"""Test of candb_gen.py: pack / unpack round trips of the generated header and DBC rejections.
+
+usage: candb_gen_test.py
+
+Random raw values of Intel, Motorola, signed and multiplexed signals are placed bit by bit
+following the DBC definition (independent of the shift / mask code of the generator). A C
+program compiled with the generated header checks that u64Pack gives the same payload word
+and that VoidUnpack gives the values back. Needs gcc (or $CC). Prints PASS / FAIL for every
+check, the exit code is the number of failed checks.
+"""
+
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+TOOLS = os.path.dirname(os.path.abspath(__file__))
+GENERATOR = os.path.join(TOOLS, 'candb_gen.py')
+VECTORS = 200
+
+TEST_DBC = '''
+BO_ 256 IntelMix: 8 ECU
+ SG_ Flag : 0|1@1+ (1,0) [0|1] "" GW
+ SG_ Cross : 3|13@1+ (1,0) [0|8191] "" GW
+ SG_ Temp : 16|8@1- (1,-40) [-40|215] "" GW
+ SG_ Wide : 24|20@1- (1,0) [0|0] "" GW
+ SG_ Tail : 44|20@1+ (1,0) [0|0] "" GW
+
+BO_ 2566844926 MotorolaMix: 5 ECU
+ SG_ Speed : 7|16@0+ (1,0) [0|0] "" GW
+ SG_ Odd : 21|11@0- (1,0) [0|0] "" GW
+ SG_ Bit : 26|1@0+ (1,0) [0|1] "" GW
+ SG_ Low : 39|8@0+ (1,0) [0|0] "" GW
+
+BO_ 512 Mux: 8 ECU
+ SG_ Sel M : 0|8@1+ (1,0) [0|0] "" GW
+ SG_ A m0 : 8|16@1+ (1,0) [0|0] "" GW
+ SG_ B m1 : 8|16@1+ (1,0) [0|0] "" GW
+ SG_ C m1 : 31|12@0- (1,0) [0|0] "" GW
+ SG_ D : 56|8@1+ (1,0) [0|0] "" GW
+'''
+
+# DBC lines that the generator must refuse, appended to a message of 6 data bytes
+REJECTED = [
+    ('intel signal beyond the DLC', ' SG_ Beyond : 56|8@1+ (1,0) [0|0] "" GW'),
+    ('motorola signal beyond the DLC', ' SG_ Beyond : 55|8@0+ (1,0) [0|0] "" GW'),
+    ('overlapping signals', ' SG_ Over : 4|8@1+ (1,0) [0|0] "" GW'),
+    ('same multiplexer value overlapping', ' SG_ Sel M : 40|4@1+ (1,0) [0|0] "" GW\n'
+                                          ' SG_ P m2 : 44|4@1+ (1,0) [0|0] "" GW\n'
+                                          ' SG_ Q m2 : 46|2@1+ (1,0) [0|0] "" GW'),
+    ('multiplexed signal without multiplexor', ' SG_ Orphan m1 : 40|8@1+ (1,0) [0|0] "" GW'),
+]
+REJECT_BASE = 'BO_ 300 Small: 6 ECU\n SG_ First : 0|8@1+ (1,0) [0|0] "" GW\n'
+
+
+def load_generator():
+    sys.path.insert(0, TOOLS)
+    import candb_gen
+    return candb_gen
+
+
+def bit_positions(sig, start):
+    """payload bit numbers (byte * 8 + bit) of the signal, lsb first"""
+    if sig.intel:
+        return [start + i for i in range(sig.length)]
+    positions = []
+    pos = start
+    for _ in range(sig.length):
+        positions.append(pos)
+        # motorola: down to bit 0 of the byte, then bit 7 of the next byte
+        pos = pos + 15 if pos % 8 == 0 else pos - 1
+    return positions[::-1]
+
+
+def pack(signals, values):
+    payload = 0
+    for sig, start in signals:
+        if sig.name not in values:
+            continue
+        raw = values[sig.name] & ((1 << sig.length) - 1)
+        for i, pos in enumerate(bit_positions(sig, start)):
+            if (raw >> i) & 1:
+                payload |= 1 << pos
+    return payload
+
+
+def random_value(rng, sig):
+    if sig.signed:
+        return rng.randrange(-(1 << (sig.length - 1)), 1 << (sig.length - 1))
+    return rng.randrange(0, 1 << sig.length)
+
+
+def c_literal(value):
+    return ('%dLL' % value) if value < 0 else ('%dULL' % value)
+
+
+def write_program(path, header, messages, starts, rng):
+    lines = ['#include <stdio.h>', '#include "%s"' % header, '',
+             'int main(void)', '{', '    unsigned failures = 0;', '    uint64 Local_u64Word;', '']
+    for msg in messages:
+        p = 'CANDB_' + msg.name
+        selector = next((s for s in msg.signals if s.mux == 'M'), None)
+        signals = [(s, starts[(msg.name, s.name)]) for s in msg.signals]
+        lines.append('    {')
+        lines.append('        %s_t Local_In;' % p)
+        lines.append('        %s_t Local_Out;' % p)
+        for vector in range(VECTORS):
+            values = {s.name: random_value(rng, s) for s in msg.signals}
+            if selector is not None:
+                values[selector.name] = vector % 3
+            # multiplexed signals of other values are not in the frame
+            value = values[selector.name] if selector is not None else None
+            present = {s.name: values[s.name] for s in msg.signals if not isinstance(s.mux, int) or s.mux == value}
+            expected = pack(signals, present)
+            for name, raw in values.items():
+                lines.append('        Local_In.%s = %s;' % (name, c_literal(raw)))
+            lines.append('        Local_u64Word = %s_u64Pack(&Local_In);' % p)
+            lines.append('        if(Local_u64Word != 0x%016XULL) { printf("pack %s %d: %%016llx\\n", '
+                         '(unsigned long long)Local_u64Word); failures++; }' % (expected, msg.name, vector))
+            lines.append('        %s_VoidUnpack(0x%016XULL, &Local_Out);' % (p, expected))
+            for name, value in present.items():
+                lines.append('        if(Local_Out.%s != %s) { printf("unpack %s.%s %d\\n"); failures++; }'
+                             % (name, c_literal(value), msg.name, name, vector))
+        lines.append('    }')
+    lines += ['    return (int)failures;', '}', '']
+    with open(path, 'w') as out:
+        out.write('\n'.join(lines))
+
+
+def run_generator(dbc_text, work):
+    dbc = os.path.join(work, 'case.dbc')
+    with open(dbc, 'w') as out:
+        out.write(dbc_text)
+    return subprocess.run([sys.executable, GENERATOR, dbc, os.path.join(work, 'case.h')],
+                          stdout=subprocess.PIPE, stderr=subprocess.PIPE).returncode
+
+
+def check(name, passed, failures):
+    print('%-58s %s' % (name, 'PASS' if passed else 'FAIL'))
+    return failures + (0 if passed else 1)
+
+
+def main():
+    candb_gen = load_generator()
+    failures = 0
+    rng = random.Random(1)
+    with tempfile.TemporaryDirectory() as work:
+        dbc = os.path.join(work, 'test.dbc')
+        with open(dbc, 'w') as out:
+            out.write(TEST_DBC)
+        failures = check('generate the test DBC',
+                         candb_gen.main(['candb_gen.py', dbc, os.path.join(work, 'test_dbc.h')]) == 0, failures)
+
+        # start bits as written in the DBC, for the reference placement
+        starts = {}
+        message = None
+        for line in TEST_DBC.splitlines():
+            line = line.strip()
+            bo = candb_gen.BO_RE.match(line)
+            if bo:
+                message = bo.group(2)
+            sg = candb_gen.SG_RE.match(line)
+            if sg:
+                starts[(message, sg.group(1))] = int(sg.group(3))
+
+        program = os.path.join(work, 'roundtrip.c')
+        write_program(program, 'test_dbc.h', candb_gen.parse(dbc), starts, rng)
+        # the drivers include ../../LIB: resolved from a directory two levels below the root of the tree
+        build = subprocess.run([os.environ.get('CC', 'gcc'), '-std=c99', '-Wall', '-Wextra', '-Werror',
+                                '-I', work, '-I', os.path.join(TOOLS, '..'), '-I', TOOLS,
+                                '-o', os.path.join(work, 'roundtrip'), program],
+                               stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+        failures = check('compile the generated header', build.returncode == 0, failures)
+        if build.returncode == 0:
+            run = subprocess.run([os.path.join(work, 'roundtrip')], stdout=subprocess.PIPE,
+                                 universal_newlines=True)
+            sys.stdout.write(run.stdout)
+            failures = check('pack / unpack round trips (Intel, Motorola, multiplexed)', run.returncode == 0,
+                             failures)
+        else:
+            sys.stdout.write(build.stdout)
+
+        failures = check('multiplexed signals of different values share bits',
+                         run_generator(REJECT_BASE + ' SG_ Sel M : 40|4@1+ (1,0) [0|0] "" GW\n'
+                                       ' SG_ P m1 : 8|8@1+ (1,0) [0|0] "" GW\n'
+                                       ' SG_ Q m2 : 8|8@1+ (1,0) [0|0] "" GW\n', work) == 0, failures)
+        for name, lines in REJECTED:
+            failures = check('reject ' + name, run_generator(REJECT_BASE + lines + '\n', work) == 1, failures)
+    print('%d check(s) failed' % failures)
+    return failures
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,25 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANSIG_config.h
+ *  module:  CANSIG Module
+ *  @details:  Configuration header file for the cyclic CAN signal publisher
+*********************************************************************************************************************/
+#ifndef _CANSIG_CONFIG_H
+#define _CANSIG_CONFIG_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*period of the CANSIG_VoidTick calls in ms (e.g. the SYSTick period)*/
+#define CANSIG_TICK_MS                  (1)
+
+/*number of cyclic frames the publisher can hold*/
+#define CANSIG_MAX_SIGNALS              (16)
+
+#endif
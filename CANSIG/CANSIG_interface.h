@@ -0,0 +1,106 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANSIG_interface.h
+ *  module:  CANSIG Module
+ *  @details:  interface header file for the cyclic CAN signal publisher: each frame is sent every period with
+ *             the latest value written, an older copy still waiting for the bus is replaced, never queued behind
+*********************************************************************************************************************/
+#ifndef _CANSIG_INTERFACE_H
+#define _CANSIG_INTERFACE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+#include "../../LIB/Std_Types.h"
+#include "../../LIB/Bit_Math.h"
+
+#include "../CAN/CAN_interface.h"
+#include "CANSIG_config.h"
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/** @defgroup CANSIG_handle returned by CANSIG_u8Add when no slot is free **/
+#define CANSIG_INVALID_HANDLE           (0xFF)
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL DATA TYPES AND STRUCTURES
+---------------------------------------------------------------------------------------------------------------------*/
+/**
+  * @brief  counters of one cyclic frame
+  */
+typedef struct
+{
+  uint16 Sent;                  /*!< periods the frame was handed to the CAN driver */
+  uint16 Replaced;              /*!< periods where the previous copy was still waiting and was replaced */
+  uint16 Dropped;               /*!< periods lost because the CAN TX queue was full */
+}CANSIG_Status_t;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Syntax          : uint8 CANSIG_u8Add(uint32 u32Id,uint8 u8Dlc,uint16 u16PeriodMs,uint16 u16OffsetMs)
+* \Description     : register a cyclic frame, it is sent from the first CANSIG_u8Write on. Give the frames of
+*                    the same period different offsets to spread them over the ticks
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u32Id identifier @ref CAN_frame_id, u8Dlc data length 0-8, u16PeriodMs period,
+*                    u16OffsetMs delay of the first transmission after the first write
+* \Parameters (out): None
+* \Return value:   : uint8 handle of the frame, CANSIG_INVALID_HANDLE when every slot is used
+*******************************************************************************/
+uint8 CANSIG_u8Add(uint32 u32Id,uint8 u8Dlc,uint16 u16PeriodMs,uint16 u16OffsetMs);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANSIG_u8Write(uint8 u8Handle,const uint8* pData)
+* \Description     : store the latest value of a frame (DLC bytes copied), sent at the next period.
+*                    CANSIG_u8Write and CANSIG_VoidTick must not preempt each other
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Handle handle from CANSIG_u8Add, pData data bytes
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK on an invalid handle
+*******************************************************************************/
+Std_ReturnType CANSIG_u8Write(uint8 u8Handle,const uint8* pData);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANSIG_u8Stop(uint8 u8Handle)
+* \Description     : stop sending a frame until the next CANSIG_u8Write
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Handle handle from CANSIG_u8Add
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK on an invalid handle
+*******************************************************************************/
+Std_ReturnType CANSIG_u8Stop(uint8 u8Handle);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANSIG_u8GetStatus(uint8 u8Handle,CANSIG_Status_t* pStatus)
+* \Description     : read the counters of a frame
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Handle handle from CANSIG_u8Add
+* \Parameters (out): pStatus counters
+* \Return value:   : Std_ReturnType N_OK on an invalid handle
+*******************************************************************************/
+Std_ReturnType CANSIG_u8GetStatus(uint8 u8Handle,CANSIG_Status_t* pStatus);
+
+/******************************************************************************
+* \Syntax          : void CANSIG_VoidTick(void)
+* \Description     : scheduler, call every CANSIG_TICK_MS: each frame whose period elapsed is handed to
+*                    MCAN_u8TransmitLatest with its latest value
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANSIG_VoidTick(void);
+
+#endif
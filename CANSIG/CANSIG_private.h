@@ -0,0 +1,41 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANSIG_private.h
+ *  module:  CANSIG Module
+ *  @details:  private header file for the cyclic CAN signal publisher
+*********************************************************************************************************************/
+#ifndef _CANSIG_PRIVATE_H
+#define _CANSIG_PRIVATE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*periods and offsets in ticks, at least one tick*/
+#define CANSIG_MS_TO_TICKS(MS)          ((uint16)((((uint32)(MS) + CANSIG_TICK_MS - 1) / CANSIG_TICK_MS) ? \
+                                                  (((uint32)(MS) + CANSIG_TICK_MS - 1) / CANSIG_TICK_MS) : 1))
+
+/*state of a slot*/
+#define CANSIG_SLOT_FREE                (0)
+#define CANSIG_SLOT_STOPPED             (1)    /*!< added, not sent until the first CANSIG_u8Write */
+#define CANSIG_SLOT_RUNNING             (2)
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL DATA TYPES AND STRUCTURES
+---------------------------------------------------------------------------------------------------------------------*/
+/*one cyclic frame: latest value written by the application and its schedule*/
+typedef struct
+{
+    CAN_Frame_t Frame;
+    uint16 PeriodTicks;
+    uint16 Countdown;
+    uint8 State;
+    CANSIG_Status_t Status;
+}CANSIG_Slot_t;
+
+#endif
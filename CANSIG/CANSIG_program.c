@@ -0,0 +1,182 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANSIG_program.c
+ *  module:  CANSIG Module
+ *  @details:  program file for the cyclic CAN signal publisher
+*********************************************************************************************************************/
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+
+#include "../../LIB/Std_Types.h"
+#include "../../LIB/Bit_Math.h"
+
+#include "CANSIG_config.h"
+#include "CANSIG_interface.h"
+#include "CANSIG_private.h"
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA
+---------------------------------------------------------------------------------------------------------------------*/
+static CANSIG_Slot_t CANSIG_Slots[CANSIG_MAX_SIGNALS];
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Syntax          : uint8 CANSIG_u8Add(uint32 u32Id,uint8 u8Dlc,uint16 u16PeriodMs,uint16 u16OffsetMs)
+* \Description     : register a cyclic frame, sent from the first CANSIG_u8Write on
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u32Id identifier, u8Dlc data length 0-8, u16PeriodMs period, u16OffsetMs first delay
+* \Parameters (out): None
+* \Return value:   : uint8 handle of the frame, CANSIG_INVALID_HANDLE when every slot is used
+*******************************************************************************/
+uint8 CANSIG_u8Add(uint32 u32Id,uint8 u8Dlc,uint16 u16PeriodMs,uint16 u16OffsetMs)
+{
+    uint8 Local_u8Handle;
+    CANSIG_Slot_t* Local_pSlot;
+
+    for(Local_u8Handle=0;Local_u8Handle<CANSIG_MAX_SIGNALS;Local_u8Handle++)
+    {
+        if(CANSIG_Slots[Local_u8Handle].State == CANSIG_SLOT_FREE)
+        {
+            break;
+        }
+    }
+    if(Local_u8Handle >= CANSIG_MAX_SIGNALS || u8Dlc > 8)
+    {
+        return CANSIG_INVALID_HANDLE;
+    }
+    Local_pSlot = &CANSIG_Slots[Local_u8Handle];
+    Local_pSlot->Frame.Id = u32Id;
+    Local_pSlot->Frame.DLC = u8Dlc;
+    Local_pSlot->Frame.FMI = 0;
+    Local_pSlot->Frame.TimeStamp = 0;
+    Local_pSlot->Frame.Data.Words[0] = 0;
+    Local_pSlot->Frame.Data.Words[1] = 0;
+    Local_pSlot->PeriodTicks = CANSIG_MS_TO_TICKS(u16PeriodMs);
+    /*offset 0 sends at the first tick after the first write*/
+    Local_pSlot->Countdown = (uint16)(u16OffsetMs / CANSIG_TICK_MS) + 1;
+    Local_pSlot->Status.Sent = 0;
+    Local_pSlot->Status.Replaced = 0;
+    Local_pSlot->Status.Dropped = 0;
+    Local_pSlot->State = CANSIG_SLOT_STOPPED;
+    return Local_u8Handle;
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANSIG_u8Write(uint8 u8Handle,const uint8* pData)
+* \Description     : store the latest value of a frame, sent at the next period
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Handle handle from CANSIG_u8Add, pData data bytes
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK on an invalid handle
+*******************************************************************************/
+Std_ReturnType CANSIG_u8Write(uint8 u8Handle,const uint8* pData)
+{
+    CANSIG_Slot_t* Local_pSlot;
+    uint8 Local_u8Index;
+
+    if(u8Handle >= CANSIG_MAX_SIGNALS || CANSIG_Slots[u8Handle].State == CANSIG_SLOT_FREE)
+    {
+        return N_OK;
+    }
+    Local_pSlot = &CANSIG_Slots[u8Handle];
+    for(Local_u8Index=0;Local_u8Index<Local_pSlot->Frame.DLC;Local_u8Index++)
+    {
+        Local_pSlot->Frame.Data.Bytes[Local_u8Index] = pData[Local_u8Index];
+    }
+    Local_pSlot->State = CANSIG_SLOT_RUNNING;
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANSIG_u8Stop(uint8 u8Handle)
+* \Description     : stop sending a frame until the next CANSIG_u8Write
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Handle handle from CANSIG_u8Add
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK on an invalid handle
+*******************************************************************************/
+Std_ReturnType CANSIG_u8Stop(uint8 u8Handle)
+{
+    if(u8Handle >= CANSIG_MAX_SIGNALS || CANSIG_Slots[u8Handle].State == CANSIG_SLOT_FREE)
+    {
+        return N_OK;
+    }
+    CANSIG_Slots[u8Handle].State = CANSIG_SLOT_STOPPED;
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANSIG_u8GetStatus(uint8 u8Handle,CANSIG_Status_t* pStatus)
+* \Description     : read the counters of a frame
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Handle handle from CANSIG_u8Add
+* \Parameters (out): pStatus counters
+* \Return value:   : Std_ReturnType N_OK on an invalid handle
+*******************************************************************************/
+Std_ReturnType CANSIG_u8GetStatus(uint8 u8Handle,CANSIG_Status_t* pStatus)
+{
+    if(u8Handle >= CANSIG_MAX_SIGNALS || CANSIG_Slots[u8Handle].State == CANSIG_SLOT_FREE)
+    {
+        return N_OK;
+    }
+    *pStatus = CANSIG_Slots[u8Handle].Status;
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : void CANSIG_VoidTick(void)
+* \Description     : scheduler, call every CANSIG_TICK_MS
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANSIG_VoidTick(void)
+{
+    uint8 Local_u8Handle;
+    CANSIG_Slot_t* Local_pSlot;
+
+    for(Local_u8Handle=0;Local_u8Handle<CANSIG_MAX_SIGNALS;Local_u8Handle++)
+    {
+        Local_pSlot = &CANSIG_Slots[Local_u8Handle];
+        if(Local_pSlot->State != CANSIG_SLOT_RUNNING)
+        {
+            continue;
+        }
+        if(--Local_pSlot->Countdown != 0)
+        {
+            continue;
+        }
+        Local_pSlot->Countdown = Local_pSlot->PeriodTicks;
+        switch(MCAN_u8TransmitLatest(&Local_pSlot->Frame))
+        {
+            case CAN_TX_REPLACED:
+                Local_pSlot->Status.Replaced++;
+                Local_pSlot->Status.Sent++;
+            break;
+
+            case CAN_TX_QUEUE_FULL:
+                Local_pSlot->Status.Dropped++;
+            break;
+
+            default:
+                Local_pSlot->Status.Sent++;
+            break;
+        }
+    }
+}
@@ -0,0 +1,30 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANSIM_config.h
+ *  module:  CANSIM Module
+ *  @details:  Configuration header file for the host bxCAN bus model
+*********************************************************************************************************************/
+#ifndef _CANSIM_CONFIG_H
+#define _CANSIM_CONFIG_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*bxCAN controllers on the virtual bus*/
+#define CANSIM_NODES                    (4)
+
+/*clocks reported to the driver, the bit time follows from them and BTR*/
+#define CANSIM_HCLK_HZ                  (72000000UL)
+#define CANSIM_PCLK1_HZ                 (36000000UL)
+
+/*1: provide the RCC / AFIO / GPIO / SYSTick functions the CAN driver calls, with MSYSTICK_u64GetCycles on the
+  bus time. 0 when the application links its own host versions*/
+#define CANSIM_HOST_STANDINS            (1)
+
+#endif
@@ -0,0 +1,198 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANSIM_interface.h
+ *  module:  CANSIM Module
+ *  @details:  interface header file for the host bxCAN bus model: CANSIM_NODES register blocks (mailboxes,
+ *             FIFOs, filter banks, error counters and interrupt flags) on one virtual bus, with arbitration by
+ *             identifier and exact frame lengths (stuff bits included) in bit times. Build the CAN driver and
+ *             this module with CAN_SIMULATION defined on a Linux host, from a directory two levels below the
+ *             root of the tree (CANSIM/tools) so that -I. resolves the ../../LIB includes:
+ *               gcc -DCAN_SIMULATION -I. ../CANSIM_program.c ../../CAN/CAN_program.c app.c
+ *             The driver runs on node 0 and the other nodes are peers driven by the CANSIM_u8Peer functions.
+ *             Time only moves in CANSIM_VoidRun (and while the driver waits for a mode change), so a run is
+ *             deterministic. To run the driver on several nodes build CAN_program.c once per node with its
+ *             symbols renamed and select the node (CANSIM_VoidSelect) before calling into each copy
+*********************************************************************************************************************/
+#ifndef _CANSIM_INTERFACE_H
+#define _CANSIM_INTERFACE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+#include "../../LIB/Std_Types.h"
+#include "../../LIB/Bit_Math.h"
+
+#include "../CAN/CAN_interface.h"
+#include "CANSIM_config.h"
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/** @defgroup CANSIM_peer_mode test mode of a peer node, may be or-ed **/
+#define CANSIM_PEER_NORMAL              (0x0)
+#define CANSIM_PEER_LOOPBACK            (0x1)    /*!< receives its own frames and ignores the acknowledge */
+#define CANSIM_PEER_SILENT              (0x2)    /*!< receives and does not transmit or acknowledge */
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL DATA TYPES AND STRUCTURES
+---------------------------------------------------------------------------------------------------------------------*/
+/**
+  * @brief  interrupt handlers of a node, called while the line is pending and not masked in IER
+  */
+typedef struct
+{
+  void (*pTx)(void);            /*!< USB_HP_CAN1_TX_IRQHandler: TMEIE and a RQCP flag */
+  void (*pRx0)(void);           /*!< USB_LP_CAN1_RX0_IRQHandler: FMPIE0 / FFIE0 / FOVIE0 and its flag */
+  void (*pRx1)(void);           /*!< CAN1_RX1_IRQHandler */
+  void (*pSce)(void);           /*!< CAN1_SCE_IRQHandler: ERRI, WKUI or SLAKI and its enable */
+}CANSIM_Irq_t;
+
+/**
+  * @brief  counters of the bus since CANSIM_VoidInit, in bit times
+  */
+typedef struct
+{
+  uint64 Bits;                  /*!< bus time */
+  uint64 BusyBits;              /*!< bus time taken by frames, error frames and interframe spaces */
+  uint32 Frames;                /*!< frames sent without error */
+  uint32 ErrorFrames;           /*!< frames ended by an error frame */
+  uint32 ArbitrationLost;       /*!< mailboxes that lost the arbitration */
+  uint32 Overruns;              /*!< frames lost or overwritten on a full FIFO */
+}CANSIM_Stats_t;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Syntax          : void CANSIM_VoidInit(void)
+* \Description     : reset every node (registers to their reset values, sleep mode), the bus time and the
+*                    counters, detach the handlers and select node 0
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANSIM_VoidInit(void);
+
+/******************************************************************************
+* \Syntax          : void CANSIM_VoidSelect(uint8 u8Node)
+* \Description     : point the CAN driver registers (CAN_Control, CAN_Mailbox, CAN_Filter) to a node
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Node node less than CANSIM_NODES
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANSIM_VoidSelect(uint8 u8Node);
+
+/******************************************************************************
+* \Syntax          : void CANSIM_VoidAttachIrq(uint8 u8Node,const CANSIM_Irq_t* pIrq)
+* \Description     : set the interrupt handlers of a node, the node is selected while they run. A line is
+*                    served once per bus event or CAN_HW_SYNC of the driver, handlers are not nested
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Node node, pIrq handlers (NULL entries or NULL to detach)
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANSIM_VoidAttachIrq(uint8 u8Node,const CANSIM_Irq_t* pIrq);
+
+/******************************************************************************
+* \Syntax          : void CANSIM_VoidRun(uint32 u32Bits)
+* \Description     : advance the bus by a number of bit times: arbitration, frames, acknowledge, errors and
+*                    bus-off recovery of every node, interrupts served as they are raised
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u32Bits bit times to run
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANSIM_VoidRun(uint32 u32Bits);
+
+/******************************************************************************
+* \Syntax          : uint64 CANSIM_u64GetBits(void)
+* \Description     : bus time in bit times, TIME of the time-triggered mode is its lower 16 bits
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint64 bit times since CANSIM_VoidInit
+*******************************************************************************/
+uint64 CANSIM_u64GetBits(void);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANSIM_u8PeerStart(uint8 u8Node,uint8 u8Mode)
+* \Description     : start a node without driver: bit timing of node 0, filter bank 0 accepting every frame to
+*                    FIFO 0, no automatic retransmission options, normal operation
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Node node, u8Mode @ref CANSIM_peer_mode
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK on an invalid node
+*******************************************************************************/
+Std_ReturnType CANSIM_u8PeerStart(uint8 u8Node,uint8 u8Mode);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANSIM_u8PeerTransmit(uint8 u8Node,const CAN_Frame_t* pFrame)
+* \Description     : request a frame in a free mailbox of a node
+* \Sync\Async      : Asynchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Node node, pFrame frame (Id, DLC and data)
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK when the three mailboxes are pending
+*******************************************************************************/
+Std_ReturnType CANSIM_u8PeerTransmit(uint8 u8Node,const CAN_Frame_t* pFrame);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANSIM_u8PeerReceive(uint8 u8Node,CAN_Frame_t* pFrame)
+* \Description     : take the oldest frame of FIFO 0, or of FIFO 1 when FIFO 0 is empty
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Node node
+* \Parameters (out): pFrame frame with FMI and TimeStamp
+* \Return value:   : Std_ReturnType N_OK when both FIFOs are empty
+*******************************************************************************/
+Std_ReturnType CANSIM_u8PeerReceive(uint8 u8Node,CAN_Frame_t* pFrame);
+
+/******************************************************************************
+* \Syntax          : void CANSIM_VoidSetPeerHandler(uint8 u8Node,void (*pHandler)(uint8 u8Node))
+* \Description     : handler called like an interrupt while a FIFO of the node holds frames, it may receive
+*                    and transmit (an echo or a protocol stack under test)
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Node node, pHandler handler or NULL
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANSIM_VoidSetPeerHandler(uint8 u8Node,void (*pHandler)(uint8 u8Node));
+
+/******************************************************************************
+* \Syntax          : void CANSIM_VoidInjectErrors(uint8 u8Node,uint16 u16Frames)
+* \Description     : end the next frames sent by a node with a bit error (error frame, TEC + 8 on the
+*                    transmitter, REC + 1 on the receivers), to test the fault confinement and the recovery
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Node node, u16Frames number of frames
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANSIM_VoidInjectErrors(uint8 u8Node,uint16 u16Frames);
+
+/******************************************************************************
+* \Syntax          : void CANSIM_VoidGetStats(CANSIM_Stats_t* pStats)
+* \Description     : read the bus counters
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): pStats counters
+* \Return value:   : None
+*******************************************************************************/
+void CANSIM_VoidGetStats(CANSIM_Stats_t* pStats);
+
+#endif
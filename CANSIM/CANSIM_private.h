@@ -0,0 +1,151 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANSIM_private.h
+ *  module:  CANSIM Module
+ *  @details:  private header file for the host bxCAN bus model
+*********************************************************************************************************************/
+#ifndef _CANSIM_PRIVATE_H
+#define _CANSIM_PRIVATE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*operating mode of a node, from MCR and the fault confinement*/
+#define CANSIM_MODE_SLEEP               (0)
+#define CANSIM_MODE_INIT                (1)
+#define CANSIM_MODE_NORMAL              (2)
+
+/*register bits and reset values (RM0008 bxCAN)*/
+#define CANSIM_MCR_INRQ                 ((uint32)0x001)
+#define CANSIM_MCR_SLEEP                ((uint32)0x002)
+#define CANSIM_MCR_TXFP                 ((uint32)0x004)
+#define CANSIM_MCR_RFLM                 ((uint32)0x008)
+#define CANSIM_MCR_NART                 ((uint32)0x010)
+#define CANSIM_MCR_AWUM                 ((uint32)0x020)
+#define CANSIM_MCR_ABOM                 ((uint32)0x040)
+#define CANSIM_MCR_TTCM                 ((uint32)0x080)
+#define CANSIM_MSR_INAK                 ((uint32)0x001)
+#define CANSIM_MSR_SLAK                 ((uint32)0x002)
+#define CANSIM_MSR_ERRI                 ((uint32)0x004)
+#define CANSIM_MSR_WKUI                 ((uint32)0x008)
+#define CANSIM_MSR_SLAKI                ((uint32)0x010)
+#define CANSIM_MSR_W1C                  ((uint32)0x01C)    /*ERRI, WKUI, SLAKI*/
+#define CANSIM_MSR_TXM                  ((uint32)0x100)
+#define CANSIM_MSR_RXM                  ((uint32)0x200)
+#define CANSIM_MSR_IDLE                 ((uint32)0xC00)    /*SAMP and RX recessive*/
+#define CANSIM_BTR_LBKM                 ((uint32)1 << 30)
+#define CANSIM_BTR_SILM                 ((uint32)1 << 31)
+#define CANSIM_TDTR_TGT                 ((uint32)0x100)
+#define CANSIM_FMR_FINIT                ((uint32)0x001)
+#define CANSIM_IER_TMEIE                ((uint32)0x00001)
+#define CANSIM_IER_EWGIE                ((uint32)0x00100)
+#define CANSIM_IER_EPVIE                ((uint32)0x00200)
+#define CANSIM_IER_BOFIE                ((uint32)0x00400)
+#define CANSIM_IER_LECIE                ((uint32)0x00800)
+#define CANSIM_IER_ERRIE                ((uint32)0x08000)
+#define CANSIM_IER_WKUIE                ((uint32)0x10000)
+#define CANSIM_IER_SLKIE                ((uint32)0x20000)
+#define CANSIM_IER_FMPIE(F)             ((uint32)0x2 << ((F) * 3))
+#define CANSIM_IER_FFIE(F)              ((uint32)0x4 << ((F) * 3))
+#define CANSIM_IER_FOVIE(F)             ((uint32)0x8 << ((F) * 3))
+#define CANSIM_RFR_FULL                 (0x08)
+#define CANSIM_RFR_FOVR                 (0x10)
+#define CANSIM_RFR_RFOM                 ((uint32)0x20)
+#define CANSIM_ESR_EWGF                 (0x01)
+#define CANSIM_ESR_EPVF                 (0x02)
+#define CANSIM_ESR_BOFF                 (0x04)
+#define CANSIM_RESET_MCR                ((uint32)0x00010002)
+#define CANSIM_RESET_MSR                ((uint32)0x00000C02)
+#define CANSIM_RESET_TSR                ((uint32)0x1C000000)
+#define CANSIM_RESET_BTR                ((uint32)0x01230000)
+#define CANSIM_RESET_FMR                ((uint32)0x2A1C0E01)
+
+/*TSR status bits of one mailbox (RQCP, TXOK, ALST, TERR), shifted by 8 per mailbox, then ABRQ, TME and LOW*/
+#define CANSIM_TX_RQCP                  (0x01)
+#define CANSIM_TX_TXOK                  (0x02)
+#define CANSIM_TX_ALST                  (0x04)
+#define CANSIM_TX_TERR                  (0x08)
+#define CANSIM_TSR_ABRQ(MB)             ((uint32)0x80 << ((MB) * 8))
+#define CANSIM_TSR_CODE(MB)             ((uint32)(MB) << 24)
+#define CANSIM_TSR_TME(MB)              ((uint32)0x01 << (26 + (MB)))
+#define CANSIM_TSR_LOW(MB)              ((uint32)0x01 << (29 + (MB)))
+#define CANSIM_MAILBOX_NONE             (0xFF)
+
+/*fault confinement (ISO 11898-1)*/
+#define CANSIM_WARNING_LIMIT            (96)
+#define CANSIM_PASSIVE_LIMIT            (128)
+#define CANSIM_BUSOFF_LIMIT             (256)
+#define CANSIM_BUSOFF_RECOVERY_BITS     (128 * 11)
+
+/*bits after the CRC up to the end of frame (delimiter, ACK slot and delimiter, EOF) and the intermission. An
+  error adds the error flag, its delimiter and the intermission, plus the suspend transmission when passive*/
+#define CANSIM_TAIL_BITS                (10)
+#define CANSIM_IFS_BITS                 (3)
+#define CANSIM_ERROR_TAIL_BITS          (6 + 8 + 3)
+#define CANSIM_SUSPEND_BITS             (8)
+
+/*LEC values*/
+#define CANSIM_LEC_STUFF                (1)
+#define CANSIM_LEC_ACK                  (3)
+#define CANSIM_LEC_BIT_DOMINANT         (5)
+
+/*channel 0 is the bus, channel 1 + n the internal loop of node n in silent loopback mode*/
+#define CANSIM_CHANNELS                 (CANSIM_NODES + 1)
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL DATA TYPES AND STRUCTURES
+---------------------------------------------------------------------------------------------------------------------*/
+/*a stored frame in register layout*/
+typedef struct
+{
+    uint32 Rir;
+    uint32 Rdtr;
+    uint32 Rdlr;
+    uint32 Rdhr;
+}CANSIM_RxEntry_t;
+
+/*state of a node behind its register block*/
+typedef struct
+{
+    CANSIM_RxEntry_t Fifo[2][3];
+    uint8 FifoCount[2];
+    uint8 FifoFlags[2];                 /*FULL / FOVR in RFR layout*/
+    uint8 TxPending[3];
+    uint8 TxAbort[3];
+    uint8 TxStatus[3];                  /*CANSIM_TX_ bits*/
+    uint32 TxOrder[3];                  /*request order for TXFP*/
+    uint16 Tec;
+    uint16 Rec;
+    uint8 Lec;
+    uint8 Mode;
+    uint8 ErrorFlags;                   /*EWGF / EPVF / BOFF in ESR layout*/
+    uint8 MsrFlags;                     /*ERRI / WKUI / SLAKI*/
+    uint64 RecoveryAt;                  /*bus-off: end of the 128 x 11 recessive bits, 0 before it starts*/
+    uint16 InjectErrors;
+    CANSIM_Irq_t Irq;
+    void (*pPeerHandler)(uint8 u8Node);
+}CANSIM_Node_t;
+
+/*frame on a channel*/
+typedef struct
+{
+    uint8 Busy;
+    uint8 Node;
+    uint8 Mailbox;
+    uint8 Error;                        /*0 or the LEC of the transmitter*/
+    uint8 Dlc;
+    uint16 Time;                        /*TIME at the start of frame*/
+    uint32 Tir;
+    uint32 Data[2];
+    uint64 Start;
+    uint64 End;                         /*end of frame or error detection*/
+    uint64 FreeAt;                      /*end of the intermission after the last frame*/
+}CANSIM_Channel_t;
+
+#endif
@@ -0,0 +1,1474 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANSIM_program.c
+ *  module:  CANSIM Module
+ *  @details:  program file for the host bxCAN bus model, compiled only with CAN_SIMULATION
+*********************************************************************************************************************/
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+
+#include "../../LIB/Std_Types.h"
+#include "../../LIB/Bit_Math.h"
+
+#include "CANSIM_config.h"
+#include "CANSIM_interface.h"
+#include "../CAN/CAN_private.h"
+#include "CANSIM_private.h"
+
+#ifdef CAN_SIMULATION
+
+#if CANSIM_HOST_STANDINS == 1
+#include "../GPIO/GPIO_interface.h"
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA
+---------------------------------------------------------------------------------------------------------------------*/
+static CAN_SIM_REGISTERS_t CANSIM_Regs[CANSIM_NODES];
+CAN_SIM_REGISTERS_t* volatile CANSIM_pRegs = &CANSIM_Regs[0];
+
+static CANSIM_Node_t CANSIM_Nodes[CANSIM_NODES];
+static CANSIM_Channel_t CANSIM_Channels[CANSIM_CHANNELS];
+static uint64 CANSIM_Now = 0;
+static uint32 CANSIM_TxOrder = 0;
+static uint8 CANSIM_InService = 0;
+/*PRIMASK of the driver critical sections: no handler is called while it is set*/
+static uint8 CANSIM_IrqMasked = 0;
+static CANSIM_Stats_t CANSIM_Stats;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Description     : index of the selected node
+*******************************************************************************/
+static uint8 CANSIM_u8Selected(void)
+{
+    return (uint8)(CANSIM_pRegs - &CANSIM_Regs[0]);
+}
+
+/******************************************************************************
+* \Description     : channel a node transmits and receives on: its own loop in silent loopback, the bus otherwise
+*******************************************************************************/
+static uint8 CANSIM_u8Channel(uint8 u8Node)
+{
+    uint32 Local_u32Btr = CANSIM_Regs[u8Node].Control.BTR.r;
+    uint8 Local_u8Channel = 0;
+
+    if((Local_u32Btr & CANSIM_BTR_LBKM) != 0 && (Local_u32Btr & CANSIM_BTR_SILM) != 0)
+    {
+        Local_u8Channel = 1 + u8Node;
+    }
+    else{}
+    return Local_u8Channel;
+}
+
+/******************************************************************************
+* \Description     : node takes part in the bus: normal mode and not bus-off
+*******************************************************************************/
+static uint8 CANSIM_u8Online(uint8 u8Node)
+{
+    return (CANSIM_Nodes[u8Node].Mode == CANSIM_MODE_NORMAL &&
+            (CANSIM_Nodes[u8Node].ErrorFlags & CANSIM_ESR_BOFF) == 0) ? 1 : 0;
+}
+
+/******************************************************************************
+* \Description     : node may start a frame: online and not in silent mode alone
+*******************************************************************************/
+static uint8 CANSIM_u8CanTransmit(uint8 u8Node)
+{
+    uint32 Local_u32Btr = CANSIM_Regs[u8Node].Control.BTR.r;
+
+    return (CANSIM_u8Online(u8Node) == 1 &&
+            ((Local_u32Btr & CANSIM_BTR_SILM) == 0 || (Local_u32Btr & CANSIM_BTR_LBKM) != 0)) ? 1 : 0;
+}
+
+/******************************************************************************
+* \Description     : node receives a frame of u8Tx on a channel: a loopback node only its own frames, the
+*                    others every frame but their own
+*******************************************************************************/
+static uint8 CANSIM_u8Receives(uint8 u8Node,uint8 u8Channel,uint8 u8Tx)
+{
+    uint8 Local_u8Loopback = ((CANSIM_Regs[u8Node].Control.BTR.r & CANSIM_BTR_LBKM) != 0) ? 1 : 0;
+
+    return (CANSIM_u8Online(u8Node) == 1 && CANSIM_u8Channel(u8Node) == u8Channel &&
+            Local_u8Loopback == ((u8Node == u8Tx) ? 1 : 0)) ? 1 : 0;
+}
+
+/******************************************************************************
+* \Description     : some node acknowledges a frame of u8Tx: a receiver not silent, or u8Tx itself in loopback
+*******************************************************************************/
+static uint8 CANSIM_u8Acknowledged(uint8 u8Channel,uint8 u8Tx)
+{
+    uint8 Local_u8Node;
+    uint8 Local_u8Ack = 0;
+
+    for(Local_u8Node=0;Local_u8Node<CANSIM_NODES;Local_u8Node++)
+    {
+        if(CANSIM_u8Receives(Local_u8Node,u8Channel,u8Tx) == 1 &&
+           (Local_u8Node == u8Tx || (CANSIM_Regs[Local_u8Node].Control.BTR.r & CANSIM_BTR_SILM) == 0))
+        {
+            Local_u8Ack = 1;
+        }
+        else{}
+    }
+    return Local_u8Ack;
+}
+
+/******************************************************************************
+* \Description     : bus order of an identifier in TIR layout (lower wins): STID, RTR of a standard frame or
+*                    SRR, IDE, EXID, RTR of an extended frame
+*******************************************************************************/
+static uint32 CANSIM_u32ArbitrationKey(uint32 u32Tir)
+{
+    uint32 Local_u32Key = (u32Tir >> 21) << 21;
+
+    if((u32Tir & CAN_FRAME_ID_IDE) != 0)
+    {
+        Local_u32Key |= ((uint32)3 << 19) | (((u32Tir >> 3) & 0x3FFFF) << 1) | ((u32Tir >> 1) & 1);
+    }
+    else
+    {
+        Local_u32Key |= ((u32Tir >> 1) & 1) << 20;
+    }
+    return Local_u32Key;
+}
+
+/******************************************************************************
+* \Description     : mailbox u8A goes before u8B: request order with TXFP, identifier then number otherwise
+*******************************************************************************/
+static uint8 CANSIM_u8Before(uint8 u8Node,uint8 u8A,uint8 u8B)
+{
+    CAN_SIM_REGISTERS_t* Local_pRegs = &CANSIM_Regs[u8Node];
+    uint32 Local_u32KeyA;
+    uint32 Local_u32KeyB;
+    uint8 Local_u8Before;
+
+    if((Local_pRegs->Control.MCR & CANSIM_MCR_TXFP) != 0)
+    {
+        Local_u8Before = (CANSIM_Nodes[u8Node].TxOrder[u8A] < CANSIM_Nodes[u8Node].TxOrder[u8B]) ? 1 : 0;
+    }
+    else
+    {
+        Local_u32KeyA = CANSIM_u32ArbitrationKey(Local_pRegs->Mailbox.Txmailbox[u8A].TIR.r);
+        Local_u32KeyB = CANSIM_u32ArbitrationKey(Local_pRegs->Mailbox.Txmailbox[u8B].TIR.r);
+        Local_u8Before = (Local_u32KeyA < Local_u32KeyB || (Local_u32KeyA == Local_u32KeyB && u8A < u8B)) ? 1 : 0;
+    }
+    return Local_u8Before;
+}
+
+/******************************************************************************
+* \Description     : pending mailbox a node sends next, CANSIM_MAILBOX_NONE when none
+*******************************************************************************/
+static uint8 CANSIM_u8NextMailbox(uint8 u8Node)
+{
+    uint8 Local_u8Mailbox;
+    uint8 Local_u8Best = CANSIM_MAILBOX_NONE;
+
+    for(Local_u8Mailbox=0;Local_u8Mailbox<CAN_TX_MAILBOXES;Local_u8Mailbox++)
+    {
+        if(CANSIM_Nodes[u8Node].TxPending[Local_u8Mailbox] == 1 &&
+           (Local_u8Best == CANSIM_MAILBOX_NONE || CANSIM_u8Before(u8Node,Local_u8Mailbox,Local_u8Best) == 1))
+        {
+            Local_u8Best = Local_u8Mailbox;
+        }
+        else{}
+    }
+    return Local_u8Best;
+}
+
+/******************************************************************************
+* \Description     : append the u8Width lower bits of a value, most significant first
+*******************************************************************************/
+static void CANSIM_VoidPushBits(uint8* pBits,uint8* pCount,uint32 u32Value,uint8 u8Width)
+{
+    while(u8Width > 0)
+    {
+        u8Width--;
+        pBits[(*pCount)++] = (uint8)((u32Value >> u8Width) & 1);
+    }
+}
+
+/******************************************************************************
+* \Description     : bits from the start of frame to the end of the CRC sequence, stuff bits included
+*******************************************************************************/
+static uint16 CANSIM_u16FrameBits(uint32 u32Tir,uint8 u8Dlc,const uint32* pData)
+{
+    uint8 Local_au8Bits[128];
+    uint8 Local_u8Count = 0;
+    uint8 Local_u8Itr;
+    uint8 Local_u8Bytes = (u8Dlc > 8) ? 8 : u8Dlc;
+    uint16 Local_u16Crc = 0;
+    uint16 Local_u16Total;
+    uint8 Local_u8Run = 1;
+    uint8 Local_u8Last;
+
+    CANSIM_VoidPushBits(Local_au8Bits,&Local_u8Count,0,1);
+    CANSIM_VoidPushBits(Local_au8Bits,&Local_u8Count,u32Tir >> 21,11);
+    if((u32Tir & CAN_FRAME_ID_IDE) != 0)
+    {
+        CANSIM_VoidPushBits(Local_au8Bits,&Local_u8Count,3,2);
+        CANSIM_VoidPushBits(Local_au8Bits,&Local_u8Count,u32Tir >> 3,18);
+        CANSIM_VoidPushBits(Local_au8Bits,&Local_u8Count,u32Tir >> 1,1);
+        CANSIM_VoidPushBits(Local_au8Bits,&Local_u8Count,0,2);
+    }
+    else
+    {
+        CANSIM_VoidPushBits(Local_au8Bits,&Local_u8Count,u32Tir >> 1,1);
+        CANSIM_VoidPushBits(Local_au8Bits,&Local_u8Count,0,2);
+    }
+    CANSIM_VoidPushBits(Local_au8Bits,&Local_u8Count,u8Dlc,4);
+    if((u32Tir & CAN_FRAME_ID_RTR) != 0)
+    {
+        Local_u8Bytes = 0;
+    }
+    else{}
+    for(Local_u8Itr=0;Local_u8Itr<Local_u8Bytes;Local_u8Itr++)
+    {
+        CANSIM_VoidPushBits(Local_au8Bits,&Local_u8Count,pData[Local_u8Itr >> 2] >> ((Local_u8Itr & 3) * 8),8);
+    }
+    /*CRC-15 of the bits so far*/
+    for(Local_u8Itr=0;Local_u8Itr<Local_u8Count;Local_u8Itr++)
+    {
+        uint8 Local_u8Next = Local_au8Bits[Local_u8Itr] ^ (uint8)((Local_u16Crc >> 14) & 1);
+        Local_u16Crc = (uint16)((Local_u16Crc << 1) & 0x7FFF);
+        if(Local_u8Next != 0)
+        {
+            Local_u16Crc ^= 0x4599;
+        }
+        else{}
+    }
+    CANSIM_VoidPushBits(Local_au8Bits,&Local_u8Count,Local_u16Crc,15);
+    /*a stuff bit after five equal bits, it starts the next run*/
+    Local_u16Total = Local_u8Count;
+    Local_u8Last = Local_au8Bits[0];
+    for(Local_u8Itr=1;Local_u8Itr<Local_u8Count;Local_u8Itr++)
+    {
+        if(Local_au8Bits[Local_u8Itr] == Local_u8Last)
+        {
+            Local_u8Run++;
+        }
+        else
+        {
+            Local_u8Run = 1;
+            Local_u8Last = Local_au8Bits[Local_u8Itr];
+        }
+        if(Local_u8Run == 5)
+        {
+            Local_u16Total++;
+            Local_u8Last ^= 1;
+            Local_u8Run = 1;
+        }
+        else{}
+    }
+    return Local_u16Total;
+}
+
+/******************************************************************************
+* \Description     : identifier of a frame in the 16-bit filter layout: STID, RTR, IDE, EXID[17:15]
+*******************************************************************************/
+static uint16 CANSIM_u16FilterId16(uint32 u32Rir)
+{
+    return (uint16)(((u32Rir >> 21) << 5) | (((u32Rir >> 1) & 1) << 4) | (((u32Rir >> 2) & 1) << 3) |
+                    ((u32Rir >> 18) & 7));
+}
+
+/******************************************************************************
+* \Description     : filter u8Filter of a bank matches an identifier in RIR layout
+*******************************************************************************/
+static uint8 CANSIM_u8FilterMatch(uint32 u32FR1,uint32 u32FR2,uint8 u8Scale32,uint8 u8List,uint8 u8Filter,
+                                  uint32 u32Rir)
+{
+    uint32 Local_u32Reg;
+    uint16 Local_u16Id = CANSIM_u16FilterId16(u32Rir);
+    uint8 Local_u8Match;
+
+    if(u8Scale32 == 1 && u8List == 0)
+    {
+        Local_u8Match = (((u32Rir ^ u32FR1) & u32FR2 & ~CAN_TIR_TXRQ) == 0) ? 1 : 0;
+    }
+    else if(u8Scale32 == 1)
+    {
+        Local_u32Reg = (u8Filter == 0) ? u32FR1 : u32FR2;
+        Local_u8Match = (((u32Rir ^ Local_u32Reg) & ~CAN_TIR_TXRQ) == 0) ? 1 : 0;
+    }
+    else if(u8List == 0)
+    {
+        /*mask in the upper half, identifier in the lower half, FR1 then FR2*/
+        Local_u32Reg = (u8Filter == 0) ? u32FR1 : u32FR2;
+        Local_u8Match = (((Local_u16Id ^ Local_u32Reg) & (Local_u32Reg >> 16) & 0xFFFF) == 0) ? 1 : 0;
+    }
+    else
+    {
+        /*FR1 lower, FR1 upper, FR2 lower, FR2 upper*/
+        Local_u32Reg = (u8Filter < 2) ? u32FR1 : u32FR2;
+        Local_u8Match = (Local_u16Id == (uint16)(Local_u32Reg >> ((u8Filter & 1) * 16))) ? 1 : 0;
+    }
+    return Local_u8Match;
+}
+
+/******************************************************************************
+* \Description     : filter a frame as bxCAN does: filter numbers per FIFO over all banks (active or not),
+*                    a match of a 32-bit filter before a 16-bit one, a list before a mask, then the lowest number
+*******************************************************************************/
+static uint8 CANSIM_u8Filter(uint8 u8Node,uint32 u32Rir,uint8* pFifo,uint8* pFmi)
+{
+    volatile CAN_FILTER_REGISTERS_t* Local_pFilter = &CANSIM_Regs[u8Node].Filter;
+    uint8 Local_au8Next[2] = {0,0};
+    uint8 Local_u8Best = 0xFF;
+    uint8 Local_u8Bank;
+    uint8 Local_u8Itr;
+
+    if((Local_pFilter->FMR & CANSIM_FMR_FINIT) != 0)
+    {
+        return 0;
+    }
+    else{}
+    for(Local_u8Bank=0;Local_u8Bank<14;Local_u8Bank++)
+    {
+        uint8 Local_u8FIFO = READ_BIT(Local_pFilter->FFA1R,Local_u8Bank);
+        uint8 Local_u8List = READ_BIT(Local_pFilter->FM1R,Local_u8Bank);
+        uint8 Local_u8Scale32 = READ_BIT(Local_pFilter->FS1R,Local_u8Bank);
+        uint8 Local_u8Filters = (Local_u8Scale32==1) ? ((Local_u8List==1) ? 2 : 1) : ((Local_u8List==1) ? 4 : 2);
+        uint8 Local_u8Rank = (uint8)((Local_u8Scale32 == 1 ? 0 : 2) + (Local_u8List == 1 ? 0 : 1));
+
+        if(READ_BIT(Local_pFilter->FA1R,Local_u8Bank) == 1 && Local_u8Rank < Local_u8Best)
+        {
+            for(Local_u8Itr=0;Local_u8Itr<Local_u8Filters;Local_u8Itr++)
+            {
+                if(CANSIM_u8FilterMatch(Local_pFilter->FiRx[Local_u8Bank].FxR1,Local_pFilter->FiRx[Local_u8Bank].FxR2,
+                                        Local_u8Scale32,Local_u8List,Local_u8Itr,u32Rir) == 1)
+                {
+                    Local_u8Best = Local_u8Rank;
+                    *pFifo = Local_u8FIFO;
+                    *pFmi = (uint8)(Local_au8Next[Local_u8FIFO] + Local_u8Itr);
+                    break;
+                }
+                else{}
+            }
+        }
+        else{}
+        Local_au8Next[Local_u8FIFO] += Local_u8Filters;
+    }
+    return (Local_u8Best != 0xFF) ? 1 : 0;
+}
+
+/******************************************************************************
+* \Description     : filter a received frame into a FIFO of the node, overrun as set by RFLM
+*******************************************************************************/
+static void CANSIM_VoidStore(uint8 u8Node,const CANSIM_Channel_t* pFrame)
+{
+    CANSIM_Node_t* Local_pNode = &CANSIM_Nodes[u8Node];
+    uint32 Local_u32Mcr = CANSIM_Regs[u8Node].Control.MCR;
+    CANSIM_RxEntry_t* Local_pEntry;
+    uint8 Local_u8Fifo = 0;
+    uint8 Local_u8Fmi = 0;
+
+    if(CANSIM_u8Filter(u8Node,pFrame->Tir,&Local_u8Fifo,&Local_u8Fmi) == 0)
+    {
+        return;
+    }
+    else{}
+    if(Local_pNode->FifoCount[Local_u8Fifo] == 3)
+    {
+        Local_pNode->FifoFlags[Local_u8Fifo] |= CANSIM_RFR_FOVR;
+        CANSIM_Stats.Overruns++;
+        if((Local_u32Mcr & CANSIM_MCR_RFLM) != 0)
+        {
+            return;
+        }
+        else{}
+        /*the last message is overwritten*/
+        Local_pEntry = &Local_pNode->Fifo[Local_u8Fifo][2];
+    }
+    else
+    {
+        Local_pEntry = &Local_pNode->Fifo[Local_u8Fifo][Local_pNode->FifoCount[Local_u8Fifo]++];
+        if(Local_pNode->FifoCount[Local_u8Fifo] == 3)
+        {
+            Local_pNode->FifoFlags[Local_u8Fifo] |= CANSIM_RFR_FULL;
+        }
+        else{}
+    }
+    Local_pEntry->Rir = pFrame->Tir & ~CAN_TIR_TXRQ;
+    Local_pEntry->Rdtr = (uint32)(pFrame->Dlc & 0x0F) | ((uint32)Local_u8Fmi << 8) |
+                         (((Local_u32Mcr & CANSIM_MCR_TTCM) != 0) ? ((uint32)pFrame->Time << 16) : 0);
+    Local_pEntry->Rdlr = pFrame->Data[0];
+    Local_pEntry->Rdhr = pFrame->Data[1];
+}
+
+/******************************************************************************
+* \Description     : end a transmit request with its TSR status bits
+*******************************************************************************/
+static void CANSIM_VoidComplete(uint8 u8Node,uint8 u8Mailbox,uint8 u8Status)
+{
+    CANSIM_Nodes[u8Node].TxPending[u8Mailbox] = 0;
+    CANSIM_Nodes[u8Node].TxAbort[u8Mailbox] = 0;
+    CANSIM_Nodes[u8Node].TxStatus[u8Mailbox] = u8Status;
+    CANSIM_Regs[u8Node].Mailbox.Txmailbox[u8Mailbox].TIR.r &= ~CAN_TIR_TXRQ;
+}
+
+/******************************************************************************
+* \Description     : EWGF / EPVF / BOFF from the counters, ERRI on a new flag or error code enabled in IER
+*******************************************************************************/
+static void CANSIM_VoidErrorState(uint8 u8Node,uint8 u8LecSet)
+{
+    CANSIM_Node_t* Local_pNode = &CANSIM_Nodes[u8Node];
+    uint32 Local_u32Ier = CANSIM_Regs[u8Node].Control.IER.r;
+    uint8 Local_u8Flags = Local_pNode->ErrorFlags & CANSIM_ESR_BOFF;
+    uint8 Local_u8Raised;
+
+    if(Local_pNode->Tec >= CANSIM_WARNING_LIMIT || Local_pNode->Rec >= CANSIM_WARNING_LIMIT)
+    {
+        Local_u8Flags |= CANSIM_ESR_EWGF;
+    }
+    else{}
+    if(Local_pNode->Tec >= CANSIM_PASSIVE_LIMIT || Local_pNode->Rec >= CANSIM_PASSIVE_LIMIT)
+    {
+        Local_u8Flags |= CANSIM_ESR_EPVF;
+    }
+    else{}
+    if(Local_pNode->Tec >= CANSIM_BUSOFF_LIMIT)
+    {
+        Local_u8Flags |= CANSIM_ESR_BOFF;
+    }
+    else{}
+    Local_u8Raised = Local_u8Flags & ~Local_pNode->ErrorFlags;
+    if((Local_u8Raised & CANSIM_ESR_BOFF) != 0)
+    {
+        /*with ABOM the recovery starts at once, else when the software leaves the initialization mode*/
+        Local_pNode->RecoveryAt = ((CANSIM_Regs[u8Node].Control.MCR & CANSIM_MCR_ABOM) != 0) ?
+                                  (CANSIM_Now + CANSIM_BUSOFF_RECOVERY_BITS) : 0;
+    }
+    else{}
+    Local_pNode->ErrorFlags = Local_u8Flags;
+    if(((Local_u8Raised & CANSIM_ESR_EWGF) != 0 && (Local_u32Ier & CANSIM_IER_EWGIE) != 0) ||
+       ((Local_u8Raised & CANSIM_ESR_EPVF) != 0 && (Local_u32Ier & CANSIM_IER_EPVIE) != 0) ||
+       ((Local_u8Raised & CANSIM_ESR_BOFF) != 0 && (Local_u32Ier & CANSIM_IER_BOFIE) != 0) ||
+       (u8LecSet == 1 && Local_pNode->Lec != 0 && (Local_u32Ier & CANSIM_IER_LECIE) != 0))
+    {
+        Local_pNode->MsrFlags |= CANSIM_MSR_ERRI;
+    }
+    else{}
+}
+
+/******************************************************************************
+* \Description     : node is sending or receiving, a mode change waits for the end of the frame
+*******************************************************************************/
+static uint8 CANSIM_u8Busy(uint8 u8Node)
+{
+    return (CANSIM_Nodes[u8Node].Mode == CANSIM_MODE_NORMAL &&
+            CANSIM_Channels[CANSIM_u8Channel(u8Node)].Busy == 1) ? 1 : 0;
+}
+
+/******************************************************************************
+* \Description     : operating mode of every node from INRQ and SLEEP, returns 1 when a change waits for the bus
+*******************************************************************************/
+static uint8 CANSIM_u8ApplyModes(void)
+{
+    uint8 Local_u8Deferred = 0;
+    uint8 Local_u8Node;
+
+    for(Local_u8Node=0;Local_u8Node<CANSIM_NODES;Local_u8Node++)
+    {
+        CANSIM_Node_t* Local_pNode = &CANSIM_Nodes[Local_u8Node];
+        uint32 Local_u32Mcr = CANSIM_Regs[Local_u8Node].Control.MCR;
+        uint8 Local_u8Mode = CANSIM_MODE_NORMAL;
+
+        if((Local_u32Mcr & CANSIM_MCR_INRQ) != 0 && (Local_u32Mcr & CANSIM_MCR_SLEEP) != 0)
+        {
+            Local_u8Mode = (Local_pNode->Mode == CANSIM_MODE_SLEEP) ? CANSIM_MODE_SLEEP : CANSIM_MODE_INIT;
+        }
+        else if((Local_u32Mcr & CANSIM_MCR_INRQ) != 0)
+        {
+            Local_u8Mode = CANSIM_MODE_INIT;
+        }
+        else if((Local_u32Mcr & CANSIM_MCR_SLEEP) != 0)
+        {
+            Local_u8Mode = CANSIM_MODE_SLEEP;
+        }
+        else{}
+        if(Local_u8Mode == Local_pNode->Mode)
+        {
+            continue;
+        }
+        else if(CANSIM_u8Busy(Local_u8Node) == 1)
+        {
+            Local_u8Deferred = 1;
+            continue;
+        }
+        else{}
+        if(Local_pNode->Mode == CANSIM_MODE_INIT && (Local_pNode->ErrorFlags & CANSIM_ESR_BOFF) != 0 &&
+           Local_pNode->RecoveryAt == 0)
+        {
+            Local_pNode->RecoveryAt = CANSIM_Now + CANSIM_BUSOFF_RECOVERY_BITS;
+        }
+        else{}
+        if(Local_u8Mode == CANSIM_MODE_SLEEP)
+        {
+            Local_pNode->MsrFlags |= CANSIM_MSR_SLAKI;
+        }
+        else{}
+        Local_pNode->Mode = Local_u8Mode;
+    }
+    return Local_u8Deferred;
+}
+
+/******************************************************************************
+* \Description     : LEC is read / write: take the value the software left in ESR since the last publish
+*******************************************************************************/
+static void CANSIM_VoidPickUp(void)
+{
+    uint8 Local_u8Node;
+
+    for(Local_u8Node=0;Local_u8Node<CANSIM_NODES;Local_u8Node++)
+    {
+        CANSIM_Nodes[Local_u8Node].Lec = (uint8)((CANSIM_Regs[Local_u8Node].Control.ESR.r >> 4) & 0x07);
+    }
+}
+
+/******************************************************************************
+* \Description     : copy the state of a node to its status registers and FIFO output registers
+*******************************************************************************/
+static void CANSIM_VoidPublish(uint8 u8Node)
+{
+    CANSIM_Node_t* Local_pNode = &CANSIM_Nodes[u8Node];
+    CAN_SIM_REGISTERS_t* Local_pRegs = &CANSIM_Regs[u8Node];
+    CANSIM_Channel_t* Local_pChannel = &CANSIM_Channels[CANSIM_u8Channel(u8Node)];
+    uint32 Local_u32Msr = Local_pNode->MsrFlags;
+    uint32 Local_u32Tsr = 0;
+    uint8 Local_u8Pending = 0;
+    uint8 Local_u8Lowest = CANSIM_MAILBOX_NONE;
+    uint8 Local_u8Code = CANSIM_MAILBOX_NONE;
+    uint8 Local_u8Itr;
+
+    if(Local_pNode->Mode == CANSIM_MODE_INIT)
+    {
+        Local_u32Msr |= CANSIM_MSR_INAK;
+    }
+    else if(Local_pNode->Mode == CANSIM_MODE_SLEEP)
+    {
+        Local_u32Msr |= CANSIM_MSR_SLAK;
+    }
+    else{}
+    if(Local_pChannel->Busy == 0)
+    {
+        Local_u32Msr |= CANSIM_MSR_IDLE;
+    }
+    else if(Local_pChannel->Node == u8Node)
+    {
+        Local_u32Msr |= CANSIM_MSR_TXM;
+    }
+    else
+    {
+        Local_u32Msr |= CANSIM_MSR_RXM;
+    }
+    Local_pRegs->Control.MSR = Local_u32Msr;
+
+    for(Local_u8Itr=0;Local_u8Itr<CAN_TX_MAILBOXES;Local_u8Itr++)
+    {
+        Local_u32Tsr |= (uint32)Local_pNode->TxStatus[Local_u8Itr] << (Local_u8Itr * 8);
+        if(Local_pNode->TxPending[Local_u8Itr] == 0)
+        {
+            Local_u32Tsr |= CANSIM_TSR_TME(Local_u8Itr);
+            if(Local_u8Code == CANSIM_MAILBOX_NONE)
+            {
+                Local_u8Code = Local_u8Itr;
+            }
+            else{}
+            continue;
+        }
+        else{}
+        if(Local_pNode->TxAbort[Local_u8Itr] == 1)
+        {
+            Local_u32Tsr |= CANSIM_TSR_ABRQ(Local_u8Itr);
+        }
+        else{}
+        Local_u8Pending++;
+        if(Local_u8Lowest == CANSIM_MAILBOX_NONE || CANSIM_u8Before(u8Node,Local_u8Lowest,Local_u8Itr) == 1)
+        {
+            Local_u8Lowest = Local_u8Itr;
+        }
+        else{}
+    }
+    /*CODE: next free mailbox, or the lowest priority one when all are pending*/
+    if(Local_u8Code == CANSIM_MAILBOX_NONE)
+    {
+        Local_u8Code = Local_u8Lowest;
+    }
+    else{}
+    Local_u32Tsr |= CANSIM_TSR_CODE(Local_u8Code);
+    if(Local_u8Pending > 1)
+    {
+        Local_u32Tsr |= CANSIM_TSR_LOW(Local_u8Lowest);
+    }
+    else{}
+    Local_pRegs->Control.TSR.r = Local_u32Tsr;
+
+    for(Local_u8Itr=0;Local_u8Itr<2;Local_u8Itr++)
+    {
+        Local_pRegs->Control.RFR[Local_u8Itr].r = (uint32)Local_pNode->FifoCount[Local_u8Itr] |
+                                                  Local_pNode->FifoFlags[Local_u8Itr];
+        if(Local_pNode->FifoCount[Local_u8Itr] > 0)
+        {
+            Local_pRegs->Mailbox.RXFIFO[Local_u8Itr].RIR.r = Local_pNode->Fifo[Local_u8Itr][0].Rir;
+            Local_pRegs->Mailbox.RXFIFO[Local_u8Itr].RDTR.r = Local_pNode->Fifo[Local_u8Itr][0].Rdtr;
+            Local_pRegs->Mailbox.RXFIFO[Local_u8Itr].RDLR.r = Local_pNode->Fifo[Local_u8Itr][0].Rdlr;
+            Local_pRegs->Mailbox.RXFIFO[Local_u8Itr].RDHR.r = Local_pNode->Fifo[Local_u8Itr][0].Rdhr;
+        }
+        else{}
+    }
+    Local_pRegs->Control.ESR.r = (uint32)Local_pNode->ErrorFlags | ((uint32)Local_pNode->Lec << 4) |
+                                 ((uint32)((Local_pNode->Tec > 255) ? 255 : Local_pNode->Tec) << 16) |
+                                 ((uint32)((Local_pNode->Rec > 255) ? 255 : Local_pNode->Rec) << 24);
+}
+
+/******************************************************************************
+* \Description     : interrupt lines of a node, level sensitive as in the NVIC
+*******************************************************************************/
+static uint8 CANSIM_u8RxLine(uint8 u8Node,uint8 u8Fifo)
+{
+    uint32 Local_u32Ier = CANSIM_Regs[u8Node].Control.IER.r;
+    CANSIM_Node_t* Local_pNode = &CANSIM_Nodes[u8Node];
+
+    return (((Local_u32Ier & CANSIM_IER_FMPIE(u8Fifo)) != 0 && Local_pNode->FifoCount[u8Fifo] > 0) ||
+            ((Local_u32Ier & CANSIM_IER_FFIE(u8Fifo)) != 0 && (Local_pNode->FifoFlags[u8Fifo] & CANSIM_RFR_FULL) != 0) ||
+            ((Local_u32Ier & CANSIM_IER_FOVIE(u8Fifo)) != 0 && (Local_pNode->FifoFlags[u8Fifo] & CANSIM_RFR_FOVR) != 0)) ? 1 : 0;
+}
+static uint8 CANSIM_u8TxLine(uint8 u8Node)
+{
+    CANSIM_Node_t* Local_pNode = &CANSIM_Nodes[u8Node];
+
+    return ((CANSIM_Regs[u8Node].Control.IER.r & CANSIM_IER_TMEIE) != 0 &&
+            ((Local_pNode->TxStatus[0] | Local_pNode->TxStatus[1] | Local_pNode->TxStatus[2]) & CANSIM_TX_RQCP) != 0) ? 1 : 0;
+}
+static uint8 CANSIM_u8SceLine(uint8 u8Node)
+{
+    uint32 Local_u32Ier = CANSIM_Regs[u8Node].Control.IER.r;
+    uint8 Local_u8Flags = CANSIM_Nodes[u8Node].MsrFlags;
+
+    return (((Local_u32Ier & CANSIM_IER_ERRIE) != 0 && (Local_u8Flags & CANSIM_MSR_ERRI) != 0) ||
+            ((Local_u32Ier & CANSIM_IER_WKUIE) != 0 && (Local_u8Flags & CANSIM_MSR_WKUI) != 0) ||
+            ((Local_u32Ier & CANSIM_IER_SLKIE) != 0 && (Local_u8Flags & CANSIM_MSR_SLAKI) != 0)) ? 1 : 0;
+}
+
+/******************************************************************************
+* \Description     : publish every node and call each pending handler once, with its node selected. A
+*                    CAN_HW_SYNC from a handler only publishes, handlers are not nested
+*******************************************************************************/
+static void CANSIM_VoidService(void)
+{
+    CAN_SIM_REGISTERS_t* Local_pSelected = CANSIM_pRegs;
+    uint8 Local_u8Node;
+
+    for(Local_u8Node=0;Local_u8Node<CANSIM_NODES;Local_u8Node++)
+    {
+        CANSIM_VoidPublish(Local_u8Node);
+    }
+    if(CANSIM_InService == 1 || CANSIM_IrqMasked == 1)
+    {
+        return;
+    }
+    else{}
+    CANSIM_InService = 1;
+    for(Local_u8Node=0;Local_u8Node<CANSIM_NODES;Local_u8Node++)
+    {
+        CANSIM_Node_t* Local_pNode = &CANSIM_Nodes[Local_u8Node];
+
+        CANSIM_pRegs = &CANSIM_Regs[Local_u8Node];
+        if(Local_pNode->Irq.pTx != NULL && CANSIM_u8TxLine(Local_u8Node) == 1)
+        {
+            Local_pNode->Irq.pTx();
+        }
+        else{}
+        if(Local_pNode->Irq.pRx0 != NULL && CANSIM_u8RxLine(Local_u8Node,0) == 1)
+        {
+            Local_pNode->Irq.pRx0();
+        }
+        else{}
+        if(Local_pNode->Irq.pRx1 != NULL && CANSIM_u8RxLine(Local_u8Node,1) == 1)
+        {
+            Local_pNode->Irq.pRx1();
+        }
+        else{}
+        if(Local_pNode->Irq.pSce != NULL && CANSIM_u8SceLine(Local_u8Node) == 1)
+        {
+            Local_pNode->Irq.pSce();
+        }
+        else{}
+        if(Local_pNode->pPeerHandler != NULL && (Local_pNode->FifoCount[0] > 0 || Local_pNode->FifoCount[1] > 0))
+        {
+            Local_pNode->pPeerHandler(Local_u8Node);
+        }
+        else{}
+        /*a handler may have cleared LEC*/
+        CANSIM_Nodes[Local_u8Node].Lec = (uint8)((CANSIM_Regs[Local_u8Node].Control.ESR.r >> 4) & 0x07);
+        CANSIM_VoidPublish(Local_u8Node);
+    }
+    CANSIM_pRegs = Local_pSelected;
+    CANSIM_InService = 0;
+}
+
+/******************************************************************************
+* \Description     : arbitration on an idle channel: the lowest key of the first mailbox of every node wins,
+*                    the others lose (their request ends with NART). Equal keys go to the lowest node
+*******************************************************************************/
+static void CANSIM_VoidStartFrame(uint8 u8Channel)
+{
+    CANSIM_Channel_t* Local_pChannel = &CANSIM_Channels[u8Channel];
+    uint8 Local_au8Mailbox[CANSIM_NODES];
+    uint32 Local_u32Best = 0;
+    uint8 Local_u8Winner = CANSIM_MAILBOX_NONE;
+    uint8 Local_u8Node;
+    CAN_SIM_REGISTERS_t* Local_pRegs;
+    volatile CAN_TXMailBoxes_t* Local_pMailbox;
+    uint16 Local_u16Bits;
+
+    for(Local_u8Node=0;Local_u8Node<CANSIM_NODES;Local_u8Node++)
+    {
+        Local_au8Mailbox[Local_u8Node] = CANSIM_MAILBOX_NONE;
+        if(CANSIM_u8Channel(Local_u8Node) == u8Channel && CANSIM_u8CanTransmit(Local_u8Node) == 1)
+        {
+            Local_au8Mailbox[Local_u8Node] = CANSIM_u8NextMailbox(Local_u8Node);
+        }
+        else{}
+        if(Local_au8Mailbox[Local_u8Node] != CANSIM_MAILBOX_NONE)
+        {
+            uint32 Local_u32Key = CANSIM_u32ArbitrationKey(
+                CANSIM_Regs[Local_u8Node].Mailbox.Txmailbox[Local_au8Mailbox[Local_u8Node]].TIR.r);
+            if(Local_u8Winner == CANSIM_MAILBOX_NONE || Local_u32Key < Local_u32Best)
+            {
+                Local_u8Winner = Local_u8Node;
+                Local_u32Best = Local_u32Key;
+            }
+            else{}
+        }
+        else{}
+    }
+    if(Local_u8Winner == CANSIM_MAILBOX_NONE)
+    {
+        return;
+    }
+    else{}
+    for(Local_u8Node=0;Local_u8Node<CANSIM_NODES;Local_u8Node++)
+    {
+        if(Local_u8Node != Local_u8Winner && Local_au8Mailbox[Local_u8Node] != CANSIM_MAILBOX_NONE)
+        {
+            CANSIM_Stats.ArbitrationLost++;
+            if((CANSIM_Regs[Local_u8Node].Control.MCR & CANSIM_MCR_NART) != 0)
+            {
+                CANSIM_VoidComplete(Local_u8Node,Local_au8Mailbox[Local_u8Node],CANSIM_TX_RQCP | CANSIM_TX_ALST);
+            }
+            else{}
+        }
+        else{}
+    }
+
+    Local_pRegs = &CANSIM_Regs[Local_u8Winner];
+    Local_pMailbox = &Local_pRegs->Mailbox.Txmailbox[Local_au8Mailbox[Local_u8Winner]];
+    Local_pChannel->Busy = 1;
+    Local_pChannel->Node = Local_u8Winner;
+    Local_pChannel->Mailbox = Local_au8Mailbox[Local_u8Winner];
+    Local_pChannel->Tir = Local_pMailbox->TIR.r;
+    Local_pChannel->Dlc = (uint8)(Local_pMailbox->TDTR.r & 0x0F);
+    Local_pChannel->Data[0] = Local_pMailbox->TDLR.r;
+    Local_pChannel->Data[1] = Local_pMailbox->TDHR.r;
+    Local_pChannel->Time = (uint16)CANSIM_Now;
+    Local_pChannel->Start = CANSIM_Now;
+    if((Local_pRegs->Control.MCR & CANSIM_MCR_TTCM) != 0)
+    {
+        /*time of the start of frame in TDTR, and in the last two bytes with TGT*/
+        Local_pMailbox->TDTR.r = (Local_pMailbox->TDTR.r & 0xFFFF) | ((uint32)Local_pChannel->Time << 16);
+        if((Local_pMailbox->TDTR.r & CANSIM_TDTR_TGT) != 0 && Local_pChannel->Dlc == 8)
+        {
+            Local_pChannel->Data[1] = (Local_pChannel->Data[1] & 0xFFFF) | ((uint32)Local_pChannel->Time << 16);
+        }
+        else{}
+    }
+    else{}
+
+    Local_u16Bits = CANSIM_u16FrameBits(Local_pChannel->Tir,Local_pChannel->Dlc,Local_pChannel->Data);
+    if(CANSIM_Nodes[Local_u8Winner].InjectErrors > 0)
+    {
+        CANSIM_Nodes[Local_u8Winner].InjectErrors--;
+        Local_pChannel->Error = CANSIM_LEC_BIT_DOMINANT;
+        Local_pChannel->End = CANSIM_Now + Local_u16Bits / 2;
+    }
+    else if(CANSIM_u8Acknowledged(u8Channel,Local_u8Winner) == 0)
+    {
+        /*no dominant bit in the ACK slot*/
+        Local_pChannel->Error = CANSIM_LEC_ACK;
+        Local_pChannel->End = CANSIM_Now + Local_u16Bits + 2;
+    }
+    else
+    {
+        Local_pChannel->Error = 0;
+        Local_pChannel->End = CANSIM_Now + Local_u16Bits + CANSIM_TAIL_BITS;
+    }
+
+    /*the start of frame wakes the sleeping nodes on the bus*/
+    for(Local_u8Node=0;Local_u8Node<CANSIM_NODES && u8Channel==0;Local_u8Node++)
+    {
+        if(CANSIM_Nodes[Local_u8Node].Mode == CANSIM_MODE_SLEEP)
+        {
+            CANSIM_Nodes[Local_u8Node].MsrFlags |= CANSIM_MSR_WKUI;
+            if((CANSIM_Regs[Local_u8Node].Control.MCR & CANSIM_MCR_AWUM) != 0)
+            {
+                CANSIM_Regs[Local_u8Node].Control.MCR &= ~CANSIM_MCR_SLEEP;
+            }
+            else{}
+        }
+        else{}
+    }
+}
+
+/******************************************************************************
+* \Description     : end of frame or error detection on a channel: status of the mailbox, reception,
+*                    error counters and the bus time to the next start of frame
+*******************************************************************************/
+static void CANSIM_VoidEndFrame(uint8 u8Channel)
+{
+    CANSIM_Channel_t* Local_pChannel = &CANSIM_Channels[u8Channel];
+    uint8 Local_u8Tx = Local_pChannel->Node;
+    CANSIM_Node_t* Local_pTx = &CANSIM_Nodes[Local_u8Tx];
+    uint32 Local_u32Mcr = CANSIM_Regs[Local_u8Tx].Control.MCR;
+    uint8 Local_u8Passive = ((Local_pTx->ErrorFlags & CANSIM_ESR_EPVF) != 0) ? 1 : 0;
+    uint8 Local_u8Node;
+
+    Local_pChannel->Busy = 0;
+    if(Local_pChannel->Error == 0)
+    {
+        CANSIM_VoidComplete(Local_u8Tx,Local_pChannel->Mailbox,CANSIM_TX_RQCP | CANSIM_TX_TXOK);
+        if(Local_pTx->Tec > 0)
+        {
+            Local_pTx->Tec--;
+        }
+        else{}
+        Local_pTx->Lec = 0;
+        CANSIM_VoidErrorState(Local_u8Tx,0);
+        for(Local_u8Node=0;Local_u8Node<CANSIM_NODES;Local_u8Node++)
+        {
+            if(CANSIM_u8Receives(Local_u8Node,u8Channel,Local_u8Tx) == 1)
+            {
+                CANSIM_VoidStore(Local_u8Node,Local_pChannel);
+                if(Local_u8Node != Local_u8Tx)
+                {
+                    CANSIM_Nodes[Local_u8Node].Rec = (CANSIM_Nodes[Local_u8Node].Rec >= CANSIM_PASSIVE_LIMIT) ? 120 :
+                                                     ((CANSIM_Nodes[Local_u8Node].Rec > 0) ? CANSIM_Nodes[Local_u8Node].Rec - 1 : 0);
+                    CANSIM_Nodes[Local_u8Node].Lec = 0;
+                    CANSIM_VoidErrorState(Local_u8Node,0);
+                }
+                else{}
+            }
+            else{}
+        }
+        CANSIM_Stats.Frames++;
+        Local_pChannel->FreeAt = CANSIM_Now + CANSIM_IFS_BITS;
+    }
+    else
+    {
+        CANSIM_Stats.ErrorFrames++;
+        Local_pTx->Lec = Local_pChannel->Error;
+        /*an error passive transmitter does not count an acknowledge error*/
+        if(Local_pChannel->Error != CANSIM_LEC_ACK || Local_u8Passive == 0)
+        {
+            Local_pTx->Tec += 8;
+        }
+        else{}
+        if((Local_u32Mcr & CANSIM_MCR_NART) != 0)
+        {
+            CANSIM_VoidComplete(Local_u8Tx,Local_pChannel->Mailbox,CANSIM_TX_RQCP | CANSIM_TX_TERR);
+        }
+        else if(Local_pTx->TxAbort[Local_pChannel->Mailbox] == 1)
+        {
+            CANSIM_VoidComplete(Local_u8Tx,Local_pChannel->Mailbox,CANSIM_TX_RQCP);
+        }
+        else{}
+        CANSIM_VoidErrorState(Local_u8Tx,1);
+        for(Local_u8Node=0;Local_u8Node<CANSIM_NODES && Local_pChannel->Error!=CANSIM_LEC_ACK;Local_u8Node++)
+        {
+            if(Local_u8Node != Local_u8Tx && CANSIM_u8Receives(Local_u8Node,u8Channel,Local_u8Tx) == 1)
+            {
+                CANSIM_Nodes[Local_u8Node].Rec++;
+                CANSIM_Nodes[Local_u8Node].Lec = CANSIM_LEC_STUFF;
+                CANSIM_VoidErrorState(Local_u8Node,1);
+            }
+            else{}
+        }
+        Local_pChannel->FreeAt = CANSIM_Now + CANSIM_ERROR_TAIL_BITS + ((Local_u8Passive == 1) ? CANSIM_SUSPEND_BITS : 0);
+    }
+    if(u8Channel == 0)
+    {
+        CANSIM_Stats.BusyBits += Local_pChannel->FreeAt - Local_pChannel->Start;
+    }
+    else{}
+}
+
+/******************************************************************************
+* \Description     : a node of the channel has a frame to send
+*******************************************************************************/
+static uint8 CANSIM_u8Contended(uint8 u8Channel)
+{
+    uint8 Local_u8Node;
+    uint8 Local_u8Contended = 0;
+
+    for(Local_u8Node=0;Local_u8Node<CANSIM_NODES;Local_u8Node++)
+    {
+        if(CANSIM_u8Channel(Local_u8Node) == u8Channel && CANSIM_u8CanTransmit(Local_u8Node) == 1 &&
+           CANSIM_u8NextMailbox(Local_u8Node) != CANSIM_MAILBOX_NONE)
+        {
+            Local_u8Contended = 1;
+        }
+        else{}
+    }
+    return Local_u8Contended;
+}
+
+#if CANSIM_HOST_STANDINS == 1
+/******************************************************************************
+* \Description     : HCLK cycles of one bit time of node 0
+*******************************************************************************/
+static uint32 CANSIM_u32CyclesPerBit(void)
+{
+    uint32 Local_u32Btr = CANSIM_Regs[0].Control.BTR.r;
+
+    return CAN_BTR_BRP(Local_u32Btr) * CAN_BTR_QUANTA(Local_u32Btr) * (CANSIM_HCLK_HZ / CANSIM_PCLK1_HZ);
+}
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Syntax          : void CANSIM_VoidInit(void)
+* \Description     : reset every node, the bus time and the counters
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANSIM_VoidInit(void)
+{
+    static const CANSIM_Node_t Local_NodeReset;
+    static const CAN_SIM_REGISTERS_t Local_RegsReset;
+    static const CANSIM_Channel_t Local_ChannelReset;
+    static const CANSIM_Stats_t Local_StatsReset;
+    uint8 Local_u8Itr;
+
+    for(Local_u8Itr=0;Local_u8Itr<CANSIM_NODES;Local_u8Itr++)
+    {
+        CANSIM_Nodes[Local_u8Itr] = Local_NodeReset;
+        CANSIM_Nodes[Local_u8Itr].Mode = CANSIM_MODE_SLEEP;
+        CANSIM_Regs[Local_u8Itr] = Local_RegsReset;
+        CANSIM_Regs[Local_u8Itr].Control.MCR = CANSIM_RESET_MCR;
+        CANSIM_Regs[Local_u8Itr].Control.MSR = CANSIM_RESET_MSR;
+        CANSIM_Regs[Local_u8Itr].Control.TSR.r = CANSIM_RESET_TSR;
+        CANSIM_Regs[Local_u8Itr].Control.BTR.r = CANSIM_RESET_BTR;
+        CANSIM_Regs[Local_u8Itr].Filter.FMR = CANSIM_RESET_FMR;
+    }
+    for(Local_u8Itr=0;Local_u8Itr<CANSIM_CHANNELS;Local_u8Itr++)
+    {
+        CANSIM_Channels[Local_u8Itr] = Local_ChannelReset;
+    }
+    CANSIM_Stats = Local_StatsReset;
+    CANSIM_Now = 0;
+    CANSIM_TxOrder = 0;
+    CANSIM_InService = 0;
+    CANSIM_IrqMasked = 0;
+    CANSIM_pRegs = &CANSIM_Regs[0];
+}
+
+/******************************************************************************
+* \Syntax          : void CANSIM_VoidSelect(uint8 u8Node)
+* \Description     : point the CAN driver registers to a node
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Node node
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANSIM_VoidSelect(uint8 u8Node)
+{
+    if(u8Node < CANSIM_NODES)
+    {
+        CANSIM_pRegs = &CANSIM_Regs[u8Node];
+    }
+    else{}
+}
+
+/******************************************************************************
+* \Syntax          : void CANSIM_VoidAttachIrq(uint8 u8Node,const CANSIM_Irq_t* pIrq)
+* \Description     : set the interrupt handlers of a node
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Node node, pIrq handlers or NULL
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANSIM_VoidAttachIrq(uint8 u8Node,const CANSIM_Irq_t* pIrq)
+{
+    static const CANSIM_Irq_t Local_None;
+
+    if(u8Node < CANSIM_NODES)
+    {
+        CANSIM_Nodes[u8Node].Irq = (pIrq != NULL) ? *pIrq : Local_None;
+    }
+    else{}
+}
+
+/******************************************************************************
+* \Syntax          : void CANSIM_VoidRun(uint32 u32Bits)
+* \Description     : advance the bus by a number of bit times, event by event
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u32Bits bit times
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANSIM_VoidRun(uint32 u32Bits)
+{
+    uint64 Local_u64End = CANSIM_Now + u32Bits;
+
+    CANSIM_VoidPickUp();
+    (void)CANSIM_u8ApplyModes();
+    CANSIM_VoidService();
+    for(;;)
+    {
+        uint64 Local_u64Next = Local_u64End + 1;
+        uint8 Local_u8Kind = 0;         /*1 end of frame, 2 start of frame, 3 bus-off recovery*/
+        uint8 Local_u8Which = 0;
+        uint8 Local_u8Itr;
+
+        for(Local_u8Itr=0;Local_u8Itr<CANSIM_CHANNELS;Local_u8Itr++)
+        {
+            CANSIM_Channel_t* Local_pChannel = &CANSIM_Channels[Local_u8Itr];
+            if(Local_pChannel->Busy == 1 && Local_pChannel->End < Local_u64Next)
+            {
+                Local_u64Next = Local_pChannel->End;
+                Local_u8Kind = 1;
+                Local_u8Which = Local_u8Itr;
+            }
+            else if(Local_pChannel->Busy == 0 && CANSIM_u8Contended(Local_u8Itr) == 1)
+            {
+                uint64 Local_u64Start = (Local_pChannel->FreeAt > CANSIM_Now) ? Local_pChannel->FreeAt : CANSIM_Now;
+                if(Local_u64Start < Local_u64Next)
+                {
+                    Local_u64Next = Local_u64Start;
+                    Local_u8Kind = 2;
+                    Local_u8Which = Local_u8Itr;
+                }
+                else{}
+            }
+            else{}
+        }
+        for(Local_u8Itr=0;Local_u8Itr<CANSIM_NODES;Local_u8Itr++)
+        {
+            if((CANSIM_Nodes[Local_u8Itr].ErrorFlags & CANSIM_ESR_BOFF) != 0 && CANSIM_Nodes[Local_u8Itr].RecoveryAt != 0 &&
+               CANSIM_Nodes[Local_u8Itr].Mode != CANSIM_MODE_INIT && CANSIM_Nodes[Local_u8Itr].RecoveryAt < Local_u64Next)
+            {
+                Local_u64Next = CANSIM_Nodes[Local_u8Itr].RecoveryAt;
+                Local_u8Kind = 3;
+                Local_u8Which = Local_u8Itr;
+            }
+            else{}
+        }
+        if(Local_u8Kind == 0)
+        {
+            CANSIM_Now = Local_u64End;
+            break;
+        }
+        else{}
+        CANSIM_Now = (Local_u64Next > CANSIM_Now) ? Local_u64Next : CANSIM_Now;
+        if(Local_u8Kind == 1)
+        {
+            CANSIM_VoidEndFrame(Local_u8Which);
+        }
+        else if(Local_u8Kind == 2)
+        {
+            CANSIM_VoidStartFrame(Local_u8Which);
+        }
+        else
+        {
+            CANSIM_Node_t* Local_pNode = &CANSIM_Nodes[Local_u8Which];
+            Local_pNode->Tec = 0;
+            Local_pNode->Rec = 0;
+            Local_pNode->ErrorFlags = 0;
+            Local_pNode->RecoveryAt = 0;
+        }
+        (void)CANSIM_u8ApplyModes();
+        CANSIM_VoidService();
+    }
+    CANSIM_Stats.Bits = CANSIM_Now;
+    CANSIM_VoidService();
+}
+
+/******************************************************************************
+* \Syntax          : uint64 CANSIM_u64GetBits(void)
+* \Description     : bus time in bit times
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint64 bit times since CANSIM_VoidInit
+*******************************************************************************/
+uint64 CANSIM_u64GetBits(void)
+{
+    return CANSIM_Now;
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANSIM_u8PeerStart(uint8 u8Node,uint8 u8Mode)
+* \Description     : start a node without driver, accepting every frame to FIFO 0
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Node node, u8Mode @ref CANSIM_peer_mode
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK on an invalid node
+*******************************************************************************/
+Std_ReturnType CANSIM_u8PeerStart(uint8 u8Node,uint8 u8Mode)
+{
+    CAN_SIM_REGISTERS_t* Local_pRegs;
+
+    if(u8Node >= CANSIM_NODES)
+    {
+        return N_OK;
+    }
+    else{}
+    Local_pRegs = &CANSIM_Regs[u8Node];
+    Local_pRegs->Control.BTR.r = (CANSIM_Regs[0].Control.BTR.r & ~(CANSIM_BTR_LBKM | CANSIM_BTR_SILM)) |
+                                 (((u8Mode & CANSIM_PEER_LOOPBACK) != 0) ? CANSIM_BTR_LBKM : 0) |
+                                 (((u8Mode & CANSIM_PEER_SILENT) != 0) ? CANSIM_BTR_SILM : 0);
+    Local_pRegs->Filter.FMR |= CANSIM_FMR_FINIT;
+    SET_BIT(Local_pRegs->Filter.FS1R,0);
+    CLEAR_BIT(Local_pRegs->Filter.FM1R,0);
+    CLEAR_BIT(Local_pRegs->Filter.FFA1R,0);
+    Local_pRegs->Filter.FiRx[0].FxR1 = 0;
+    Local_pRegs->Filter.FiRx[0].FxR2 = 0;
+    SET_BIT(Local_pRegs->Filter.FA1R,0);
+    Local_pRegs->Filter.FMR &= ~CANSIM_FMR_FINIT;
+    Local_pRegs->Control.MCR = 0;
+    (void)CANSIM_u8ApplyModes();
+    CANSIM_VoidPublish(u8Node);
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANSIM_u8PeerTransmit(uint8 u8Node,const CAN_Frame_t* pFrame)
+* \Description     : request a frame in a free mailbox of a node
+* \Sync\Async      : Asynchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Node node, pFrame frame
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK when no mailbox is free
+*******************************************************************************/
+Std_ReturnType CANSIM_u8PeerTransmit(uint8 u8Node,const CAN_Frame_t* pFrame)
+{
+    CAN_SIM_REGISTERS_t* Local_pSelected = CANSIM_pRegs;
+    volatile CAN_TXMailBoxes_t* Local_pMailbox;
+    uint8 Local_u8Mailbox;
+
+    if(u8Node >= CANSIM_NODES)
+    {
+        return N_OK;
+    }
+    else{}
+    for(Local_u8Mailbox=0;Local_u8Mailbox<CAN_TX_MAILBOXES;Local_u8Mailbox++)
+    {
+        if(CANSIM_Nodes[u8Node].TxPending[Local_u8Mailbox] == 0)
+        {
+            break;
+        }
+        else{}
+    }
+    if(Local_u8Mailbox == CAN_TX_MAILBOXES)
+    {
+        return N_OK;
+    }
+    else{}
+    Local_pMailbox = &CANSIM_Regs[u8Node].Mailbox.Txmailbox[Local_u8Mailbox];
+    Local_pMailbox->TDTR.r = CAN_TDTR_WORD(pFrame->DLC);
+    Local_pMailbox->TDLR.r = pFrame->Data.Words[0];
+    Local_pMailbox->TDHR.r = pFrame->Data.Words[1];
+    CANSIM_pRegs = &CANSIM_Regs[u8Node];
+    CANSIM_VoidWriteTir(Local_u8Mailbox,pFrame->Id | CAN_TIR_TXRQ);
+    CANSIM_pRegs = Local_pSelected;
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANSIM_u8PeerReceive(uint8 u8Node,CAN_Frame_t* pFrame)
+* \Description     : take the oldest frame of FIFO 0, else of FIFO 1
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Node node
+* \Parameters (out): pFrame frame
+* \Return value:   : Std_ReturnType N_OK when both FIFOs are empty
+*******************************************************************************/
+Std_ReturnType CANSIM_u8PeerReceive(uint8 u8Node,CAN_Frame_t* pFrame)
+{
+    CAN_SIM_REGISTERS_t* Local_pSelected = CANSIM_pRegs;
+    CANSIM_RxEntry_t* Local_pEntry;
+    uint8 Local_u8Fifo;
+
+    if(u8Node >= CANSIM_NODES)
+    {
+        return N_OK;
+    }
+    else{}
+    Local_u8Fifo = (CANSIM_Nodes[u8Node].FifoCount[0] > 0) ? 0 : 1;
+    if(CANSIM_Nodes[u8Node].FifoCount[Local_u8Fifo] == 0)
+    {
+        return N_OK;
+    }
+    else{}
+    Local_pEntry = &CANSIM_Nodes[u8Node].Fifo[Local_u8Fifo][0];
+    pFrame->Id = Local_pEntry->Rir;
+    pFrame->DLC = CAN_RDTR_DLC(Local_pEntry->Rdtr);
+    pFrame->FMI = CAN_RDTR_FMI(Local_pEntry->Rdtr);
+    pFrame->TimeStamp = CAN_RDTR_TIME(Local_pEntry->Rdtr);
+    pFrame->Data.Words[0] = Local_pEntry->Rdlr;
+    pFrame->Data.Words[1] = Local_pEntry->Rdhr;
+    CANSIM_pRegs = &CANSIM_Regs[u8Node];
+    CANSIM_VoidWriteRfr(Local_u8Fifo,CANSIM_RFR_RFOM);
+    CANSIM_pRegs = Local_pSelected;
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : void CANSIM_VoidSetPeerHandler(uint8 u8Node,void (*pHandler)(uint8 u8Node))
+* \Description     : handler called while a FIFO of the node holds frames
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Node node, pHandler handler or NULL
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANSIM_VoidSetPeerHandler(uint8 u8Node,void (*pHandler)(uint8 u8Node))
+{
+    if(u8Node < CANSIM_NODES)
+    {
+        CANSIM_Nodes[u8Node].pPeerHandler = pHandler;
+    }
+    else{}
+}
+
+/******************************************************************************
+* \Syntax          : void CANSIM_VoidInjectErrors(uint8 u8Node,uint16 u16Frames)
+* \Description     : end the next frames sent by a node with a bit error
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Node node, u16Frames number of frames
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANSIM_VoidInjectErrors(uint8 u8Node,uint16 u16Frames)
+{
+    if(u8Node < CANSIM_NODES)
+    {
+        CANSIM_Nodes[u8Node].InjectErrors = u16Frames;
+    }
+    else{}
+}
+
+/******************************************************************************
+* \Syntax          : void CANSIM_VoidGetStats(CANSIM_Stats_t* pStats)
+* \Description     : read the bus counters
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): pStats counters
+* \Return value:   : None
+*******************************************************************************/
+void CANSIM_VoidGetStats(CANSIM_Stats_t* pStats)
+{
+    *pStats = CANSIM_Stats;
+    pStats->Bits = CANSIM_Now;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  REGISTER HOOKS (CAN_private.h)
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Description     : TSR write of the selected node: RQCP clears the status of its mailbox, ABRQ aborts a
+*                    request at once unless its frame is on the bus (then at its end, if it fails)
+*******************************************************************************/
+void CANSIM_VoidWriteTsr(uint32 u32Value)
+{
+    uint8 Local_u8Node = CANSIM_u8Selected();
+    CANSIM_Node_t* Local_pNode = &CANSIM_Nodes[Local_u8Node];
+    CANSIM_Channel_t* Local_pChannel = &CANSIM_Channels[CANSIM_u8Channel(Local_u8Node)];
+    uint8 Local_u8Mailbox;
+
+    for(Local_u8Mailbox=0;Local_u8Mailbox<CAN_TX_MAILBOXES;Local_u8Mailbox++)
+    {
+        if((u32Value & ((uint32)CANSIM_TX_RQCP << (Local_u8Mailbox * 8))) != 0)
+        {
+            Local_pNode->TxStatus[Local_u8Mailbox] = 0;
+        }
+        else{}
+        if((u32Value & CANSIM_TSR_ABRQ(Local_u8Mailbox)) != 0 && Local_pNode->TxPending[Local_u8Mailbox] == 1)
+        {
+            if(Local_pChannel->Busy == 1 && Local_pChannel->Node == Local_u8Node && Local_pChannel->Mailbox == Local_u8Mailbox)
+            {
+                Local_pNode->TxAbort[Local_u8Mailbox] = 1;
+            }
+            else
+            {
+                CANSIM_VoidComplete(Local_u8Node,Local_u8Mailbox,CANSIM_TX_RQCP);
+            }
+        }
+        else{}
+    }
+    CANSIM_VoidPublish(Local_u8Node);
+}
+
+/******************************************************************************
+* \Description     : RFR write of the selected node: RFOM releases the output mailbox, FULL / FOVR clear
+*******************************************************************************/
+void CANSIM_VoidWriteRfr(uint8 u8Fifo,uint32 u32Value)
+{
+    uint8 Local_u8Node = CANSIM_u8Selected();
+    CANSIM_Node_t* Local_pNode = &CANSIM_Nodes[Local_u8Node];
+    uint8 Local_u8Itr;
+
+    Local_pNode->FifoFlags[u8Fifo] &= (uint8)~(u32Value & (CANSIM_RFR_FULL | CANSIM_RFR_FOVR));
+    if((u32Value & CANSIM_RFR_RFOM) != 0 && Local_pNode->FifoCount[u8Fifo] > 0)
+    {
+        for(Local_u8Itr=1;Local_u8Itr<Local_pNode->FifoCount[u8Fifo];Local_u8Itr++)
+        {
+            Local_pNode->Fifo[u8Fifo][Local_u8Itr - 1] = Local_pNode->Fifo[u8Fifo][Local_u8Itr];
+        }
+        Local_pNode->FifoCount[u8Fifo]--;
+    }
+    else{}
+    CANSIM_VoidPublish(Local_u8Node);
+}
+
+/******************************************************************************
+* \Description     : MSR write of the selected node: ERRI, WKUI and SLAKI are cleared by writing 1
+*******************************************************************************/
+void CANSIM_VoidWriteMsr(uint32 u32Value)
+{
+    uint8 Local_u8Node = CANSIM_u8Selected();
+
+    CANSIM_Nodes[Local_u8Node].MsrFlags &= (uint8)~(u32Value & CANSIM_MSR_W1C);
+    CANSIM_VoidPublish(Local_u8Node);
+}
+
+/******************************************************************************
+* \Description     : TIR write of the selected node: TXRQ on an empty mailbox makes it pending
+*******************************************************************************/
+void CANSIM_VoidWriteTir(uint8 u8Mailbox,uint32 u32Value)
+{
+    uint8 Local_u8Node = CANSIM_u8Selected();
+    CANSIM_Node_t* Local_pNode = &CANSIM_Nodes[Local_u8Node];
+
+    if(Local_pNode->TxPending[u8Mailbox] == 1)
+    {
+        return;
+    }
+    else{}
+    CANSIM_Regs[Local_u8Node].Mailbox.Txmailbox[u8Mailbox].TIR.r = u32Value;
+    if((u32Value & CAN_TIR_TXRQ) != 0)
+    {
+        Local_pNode->TxPending[u8Mailbox] = 1;
+        Local_pNode->TxStatus[u8Mailbox] = 0;
+        Local_pNode->TxOrder[u8Mailbox] = CANSIM_TxOrder++;
+    }
+    else{}
+    CANSIM_VoidPublish(Local_u8Node);
+}
+
+/******************************************************************************
+* \Description     : CAN_HW_SYNC of the driver: apply the mode requests and serve the interrupts. A mode change
+*                    waiting for the end of a frame advances the bus by one bit, so wait loops terminate
+*******************************************************************************/
+void CANSIM_VoidSync(void)
+{
+    if(CANSIM_InService == 1)
+    {
+        CANSIM_VoidPickUp();
+        CANSIM_VoidPublish(CANSIM_u8Selected());
+    }
+    else if(CANSIM_u8ApplyModes() == 1)
+    {
+        CANSIM_VoidRun(1);
+    }
+    else
+    {
+        CANSIM_VoidPickUp();
+        CANSIM_VoidService();
+    }
+}
+
+/******************************************************************************
+* \Description     : CAN_TX_LOCK of the driver: mask the handlers, return the previous mask
+*******************************************************************************/
+uint32 CANSIM_u32IrqSave(void)
+{
+    uint32 Local_u32State = CANSIM_IrqMasked;
+
+    CANSIM_IrqMasked = 1;
+    return Local_u32State;
+}
+
+/******************************************************************************
+* \Description     : CAN_TX_UNLOCK of the driver: back to the mask saved by CANSIM_u32IrqSave, the pending
+*                    handlers are served by the CAN_HW_SYNC that follows
+*******************************************************************************/
+void CANSIM_VoidIrqRestore(uint32 u32State)
+{
+    CANSIM_IrqMasked = (uint8)u32State;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  HOST STAND-INS
+---------------------------------------------------------------------------------------------------------------------*/
+#if CANSIM_HOST_STANDINS == 1
+uint8 Error_Code;
+
+void MRCC_voidEnableClock(uint8 Copy_uint8BusId , uint8 Copy_uint8PeripheralId)
+{
+    (void)Copy_uint8BusId;
+    (void)Copy_uint8PeripheralId;
+}
+
+void MAFIO_voidRemapPeripheralPins (uint8 Copy_u8peripheralNum)
+{
+    (void)Copy_u8peripheralNum;
+}
+
+void MGPIO_VoidSetPinMode_TYPE(GPIO_Num Copy_u8Port , GPIO_PinNum Copy_u8Pin , GPIO_PinModeType Copy_u8Mode)
+{
+    (void)Copy_u8Port;
+    (void)Copy_u8Pin;
+    (void)Copy_u8Mode;
+}
+
+uint32 MRCC_u32GetHclkHz(void)
+{
+    return CANSIM_HCLK_HZ;
+}
+
+uint32 MRCC_u32GetPclk1Hz(void)
+{
+    return CANSIM_PCLK1_HZ;
+}
+
+/*the cycle counter follows the bus time, so the 64-bit time stamps of the driver are exact*/
+uint64 MSYSTICK_u64GetCycles(void)
+{
+    return CANSIM_Now * CANSIM_u32CyclesPerBit();
+}
+#endif
+
+#endif
@@ -0,0 +1,339 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANSIM_bench.c
+ *  module:  CANSIM Module
+ *  @details:  throughput and latency benchmark of the CAN driver TX / RX paths on the virtual bus. The driver
+ *             runs on node 0, node 1 answers or floods, nodes 2 and 3 add higher priority background traffic.
+ *             Bus figures are in bit times of the simulated bus (deterministic), the host figures give the
+ *             speed of the model itself. Build and run on a Linux host from this directory (-I. resolves the
+ *             ../../LIB includes of the drivers):
+ *               gcc -O2 -DCAN_SIMULATION -I. -o cansim_bench CANSIM_bench.c ../CANSIM_program.c \
+ *                   ../../CAN/CAN_program.c
+ *               ./cansim_bench
+*********************************************************************************************************************/
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+#include "../../CAN/CAN_config.h"
+#include "../CANSIM_interface.h"
+
+#include <stdio.h>
+#include <time.h>
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*bit rate of every node*/
+#define CANSIM_BENCH_BITRATE            (500000UL)
+/*bus time of each throughput run*/
+#define CANSIM_BENCH_RUN_BITS           (2000000UL)
+/*frames measured by each latency run*/
+#define CANSIM_BENCH_LATENCY_FRAMES     (2000)
+/*bit times between two polls of the application (main loop period)*/
+#define CANSIM_BENCH_POLL_BITS          (50)
+
+/*identifiers: node 0 data, its echo by node 1 (+0x400), background of nodes 2 / 3 (more urgent)*/
+#define CANSIM_BENCH_ID_DATA            (0x300)
+#define CANSIM_BENCH_ID_ECHO            (0x700)
+#define CANSIM_BENCH_ID_BACKGROUND      (0x080)
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA TYPES AND STRUCTURES
+---------------------------------------------------------------------------------------------------------------------*/
+/*latency samples in bit times*/
+typedef struct
+{
+    uint32 Count;
+    uint64 Sum;
+    uint32 Min;
+    uint32 Max;
+}CANSIM_BenchLatency_t;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA
+---------------------------------------------------------------------------------------------------------------------*/
+void USB_HP_CAN1_TX_IRQHandler(void);
+void USB_LP_CAN1_RX0_IRQHandler(void);
+void CAN1_RX1_IRQHandler(void);
+void CAN1_SCE_IRQHandler(void);
+
+static const CANSIM_Irq_t CANSIM_BenchIrq = {USB_HP_CAN1_TX_IRQHandler, USB_LP_CAN1_RX0_IRQHandler,
+                                             CAN1_RX1_IRQHandler, CAN1_SCE_IRQHandler};
+static const CAN_FilterBankImage_t CANSIM_BenchFilters[] = {CAN_FILTER_BANK_MASK32(0, CAN_RX_FIFO0, 0, 0)};
+
+static CANSIM_BenchLatency_t CANSIM_BenchLatency;
+static uint32 CANSIM_BenchPeerFrames = 0;
+static uint8 CANSIM_BenchEcho = 0;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Description     : host time in nanoseconds
+*******************************************************************************/
+static uint64 CANSIM_u64BenchHostNs(void)
+{
+    struct timespec Local_Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Local_Now);
+    return (uint64)Local_Now.tv_sec * 1000000000ULL + (uint64)Local_Now.tv_nsec;
+}
+
+/******************************************************************************
+* \Description     : add one latency sample
+*******************************************************************************/
+static void CANSIM_VoidBenchSample(CANSIM_BenchLatency_t* pLatency,uint32 u32Bits)
+{
+    pLatency->Min = (pLatency->Count == 0 || u32Bits < pLatency->Min) ? u32Bits : pLatency->Min;
+    pLatency->Max = (u32Bits > pLatency->Max) ? u32Bits : pLatency->Max;
+    pLatency->Sum += u32Bits;
+    pLatency->Count++;
+}
+
+/******************************************************************************
+* \Description     : node 1: count the frames of node 0, sample their latency (request time in Words[1]) and
+*                    echo them when asked
+*******************************************************************************/
+static void CANSIM_VoidBenchPeer(uint8 u8Node)
+{
+    CAN_Frame_t Local_Frame;
+
+    while(CANSIM_u8PeerReceive(u8Node, &Local_Frame) == OK)
+    {
+        if(CAN_FRAME_GET_STD(Local_Frame.Id) != CANSIM_BENCH_ID_DATA)
+        {
+            continue;
+        }
+        CANSIM_BenchPeerFrames++;
+        CANSIM_VoidBenchSample(&CANSIM_BenchLatency, (uint32)CANSIM_u64GetBits() - Local_Frame.Data.Words[1]);
+        if(CANSIM_BenchEcho != 0)
+        {
+            /*request time kept: node 0 measures the round trip*/
+            Local_Frame.Id = CAN_FRAME_ID_STD(CANSIM_BENCH_ID_ECHO);
+            Local_Frame.DLC &= 0x0F;
+            (void)CANSIM_u8PeerTransmit(u8Node, &Local_Frame);
+        }
+    }
+}
+
+/******************************************************************************
+* \Description     : nodes 2 / 3: swallow the traffic of the other nodes
+*******************************************************************************/
+static void CANSIM_VoidBenchSink(uint8 u8Node)
+{
+    CAN_Frame_t Local_Frame;
+
+    while(CANSIM_u8PeerReceive(u8Node, &Local_Frame) == OK)
+    {
+    }
+}
+
+/******************************************************************************
+* \Description     : fresh bus: driver on node 0 at CANSIM_BENCH_BITRATE with the RX ring, peers 1-3 started
+*******************************************************************************/
+static void CANSIM_VoidBenchSetup(uint8 u8Echo)
+{
+    CAN_InitTypeDef Local_Config = {CAN_MODE_NORMAL, CAN_DISABLE, CAN_ENABLE, CAN_DISABLE, CAN_ENABLE,
+                                    CAN_DISABLE, CAN_ENABLE};
+    uint8 Local_u8Node;
+
+    CANSIM_VoidInit();
+    CANSIM_VoidAttachIrq(0, &CANSIM_BenchIrq);
+    MCAN_VoidInit(&Local_Config);
+    (void)MCAN_u8SetBitrate(CANSIM_BENCH_BITRATE, CAN_MODE_NORMAL);
+    MCAN_VoidApplyFilters(CANSIM_BenchFilters, 1);
+    MCAN_VoidEnableRxRing(CAN_RX_FIFO0);
+    MCAN_VoidStart();
+    for(Local_u8Node=1;Local_u8Node<CANSIM_NODES;Local_u8Node++)
+    {
+        (void)CANSIM_u8PeerStart(Local_u8Node, CANSIM_PEER_NORMAL);
+        CANSIM_VoidSetPeerHandler(Local_u8Node, (Local_u8Node == 1) ? CANSIM_VoidBenchPeer : CANSIM_VoidBenchSink);
+    }
+    CANSIM_BenchEcho = u8Echo;
+    CANSIM_BenchPeerFrames = 0;
+    CANSIM_BenchLatency = (CANSIM_BenchLatency_t){0, 0, 0, 0};
+}
+
+/******************************************************************************
+* \Description     : frame of node 0 stamped with the bus time of the request
+*******************************************************************************/
+static uint8 CANSIM_u8BenchSend(uint32 u32Sequence)
+{
+    CAN_Frame_t Local_Frame = {0};
+
+    Local_Frame.Id = CAN_FRAME_ID_STD(CANSIM_BENCH_ID_DATA);
+    Local_Frame.DLC = 8;
+    Local_Frame.Data.Words[0] = u32Sequence;
+    Local_Frame.Data.Words[1] = (uint32)CANSIM_u64GetBits();
+    return MCAN_u8TransmitFrame(&Local_Frame);
+}
+
+/******************************************************************************
+* \Description     : read the RX ring of node 0, count the frames of node 1 and sample the round trip of the
+*                    echoes (request time in Words[1])
+*******************************************************************************/
+static uint32 CANSIM_u32BenchDrain(CANSIM_BenchLatency_t* pLatency)
+{
+    CAN_Frame_t Local_Frame;
+    uint32 Local_u32Count = 0;
+
+    while(MCAN_u16RxRingRead(CAN_RX_FIFO0, &Local_Frame, 1) == 1)
+    {
+        if(CAN_FRAME_GET_STD(Local_Frame.Id) != CANSIM_BENCH_ID_ECHO)
+        {
+            continue;
+        }
+        if(pLatency != NULL)
+        {
+            CANSIM_VoidBenchSample(pLatency, (uint32)CANSIM_u64GetBits() - Local_Frame.Data.Words[1]);
+        }
+        Local_u32Count++;
+    }
+    return Local_u32Count;
+}
+
+/******************************************************************************
+* \Description     : let node 0 send everything it still holds, so the next setup starts from an empty queue
+*******************************************************************************/
+static void CANSIM_VoidBenchSettle(void)
+{
+    CANSIM_BenchEcho = 0;
+    while(MCAN_u8TxQueueCount() != 0)
+    {
+        CANSIM_VoidRun(CANSIM_BENCH_POLL_BITS);
+        (void)CANSIM_u32BenchDrain(NULL);
+    }
+    CANSIM_VoidRun(1000);
+    (void)CANSIM_u32BenchDrain(NULL);
+}
+
+/******************************************************************************
+* \Description     : print a latency line in bit times and microseconds
+*******************************************************************************/
+static void CANSIM_VoidBenchPrintLatency(const char* pName,const CANSIM_BenchLatency_t* pLatency,double f64BitUs)
+{
+    double Local_f64Avg = (pLatency->Count != 0) ? (double)pLatency->Sum / (double)pLatency->Count : 0.0;
+
+    printf("%-34s n=%-6u min %5u  avg %8.1f  max %6u bits   (avg %8.1f us)\n", pName, (unsigned)pLatency->Count,
+           (unsigned)pLatency->Min, Local_f64Avg, (unsigned)pLatency->Max, Local_f64Avg * f64BitUs);
+}
+
+/******************************************************************************
+* \Description     : print a throughput line: frames and load of the bus, speed of the model on the host
+*******************************************************************************/
+static void CANSIM_VoidBenchPrintThroughput(const char* pName,uint32 u32Frames,uint64 u64HostNs,double f64BitUs)
+{
+    CANSIM_Stats_t Local_Stats;
+    double Local_f64BusSeconds;
+
+    CANSIM_VoidGetStats(&Local_Stats);
+    Local_f64BusSeconds = (double)Local_Stats.Bits * f64BitUs / 1e6;
+    printf("%-34s %8u frames  %9.0f frames/s  load %5.1f %%  arb lost %u  ovr %u   host %6.2f Mbit/s\n",
+           pName, (unsigned)u32Frames, (double)u32Frames / Local_f64BusSeconds,
+           100.0 * (double)Local_Stats.BusyBits / (double)Local_Stats.Bits,
+           (unsigned)Local_Stats.ArbitrationLost, (unsigned)Local_Stats.Overruns,
+           (double)Local_Stats.Bits * 1e3 / (double)u64HostNs);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    static const uint32 Local_Periods[] = {2000, 1000, 600};
+    CANSIM_BenchLatency_t Local_Echo;
+    uint64 Local_u64Start;
+    uint32 Local_u32Sequence;
+    uint32 Local_u32Frames;
+    uint32 Local_u32Case;
+    double Local_f64BitUs;
+
+    CANSIM_VoidBenchSetup(0);
+    Local_f64BitUs = 1e6 / (double)CANSIM_BENCH_BITRATE;
+    printf("CANSIM benchmark, %u nodes, bit time %.3f us\n\n", (unsigned)CANSIM_NODES, Local_f64BitUs);
+
+    /*TX path: the queue of node 0 kept full, the bus saturated with 8 byte frames*/
+    Local_u32Sequence = 0;
+    Local_u64Start = CANSIM_u64BenchHostNs();
+    while(CANSIM_u64GetBits() < CANSIM_BENCH_RUN_BITS)
+    {
+        while(CANSIM_u8BenchSend(Local_u32Sequence) != CAN_TX_QUEUE_FULL)
+        {
+            Local_u32Sequence++;
+        }
+        CANSIM_VoidRun(CANSIM_BENCH_POLL_BITS);
+    }
+    CANSIM_VoidBenchPrintThroughput("TX saturated, node 0", CANSIM_BenchPeerFrames,
+                                    CANSIM_u64BenchHostNs() - Local_u64Start, Local_f64BitUs);
+    CANSIM_VoidBenchSettle();
+
+    /*RX path: node 1 keeps its mailboxes full, node 0 drains its ring from the main loop*/
+    CANSIM_VoidBenchSetup(0);
+    Local_u32Frames = 0;
+    Local_u64Start = CANSIM_u64BenchHostNs();
+    while(CANSIM_u64GetBits() < CANSIM_BENCH_RUN_BITS)
+    {
+        CAN_Frame_t Local_Frame = {0};
+
+        Local_Frame.Id = CAN_FRAME_ID_STD(CANSIM_BENCH_ID_ECHO);
+        Local_Frame.DLC = 8;
+        Local_Frame.Data.Words[1] = (uint32)CANSIM_u64GetBits();
+        while(CANSIM_u8PeerTransmit(1, &Local_Frame) == OK)
+        {
+        }
+        CANSIM_VoidRun(CANSIM_BENCH_POLL_BITS);
+        Local_u32Frames += CANSIM_u32BenchDrain(NULL);
+    }
+    CANSIM_VoidBenchPrintThroughput("RX flood, node 0 ring", Local_u32Frames,
+                                    CANSIM_u64BenchHostNs() - Local_u64Start, Local_f64BitUs);
+
+    /*round trip: node 0 sends, node 1 echoes, at rising offered load with background traffic of nodes 2 / 3*/
+    printf("\n");
+    for(Local_u32Case=0;Local_u32Case<sizeof(Local_Periods)/sizeof(Local_Periods[0]);Local_u32Case++)
+    {
+        char Local_Name[40];
+        uint32 Local_u32Period = Local_Periods[Local_u32Case];
+        uint32 Local_u32Bits = 0;
+
+        CANSIM_VoidBenchSetup(1);
+        Local_Echo = (CANSIM_BenchLatency_t){0, 0, 0, 0};
+        for(Local_u32Sequence=0;Local_u32Sequence<CANSIM_BENCH_LATENCY_FRAMES;)
+        {
+            if(Local_u32Bits % Local_u32Period == 0)
+            {
+                CAN_Frame_t Local_Frame = {0};
+
+                (void)CANSIM_u8BenchSend(Local_u32Sequence);
+                Local_u32Sequence++;
+                /*background frames of the more urgent nodes, one each per period*/
+                Local_Frame.Id = CAN_FRAME_ID_STD(CANSIM_BENCH_ID_BACKGROUND);
+                Local_Frame.DLC = 8;
+                (void)CANSIM_u8PeerTransmit(2, &Local_Frame);
+                Local_Frame.Id = CAN_FRAME_ID_STD(CANSIM_BENCH_ID_BACKGROUND + 1);
+                (void)CANSIM_u8PeerTransmit(3, &Local_Frame);
+            }
+            CANSIM_VoidRun(CANSIM_BENCH_POLL_BITS);
+            Local_u32Bits += CANSIM_BENCH_POLL_BITS;
+            (void)CANSIM_u32BenchDrain(&Local_Echo);
+        }
+        /*the last echoes, still read at the poll period*/
+        for(Local_u32Bits=0;Local_u32Bits<4 * Local_u32Period;Local_u32Bits+=CANSIM_BENCH_POLL_BITS)
+        {
+            CANSIM_VoidRun(CANSIM_BENCH_POLL_BITS);
+            (void)CANSIM_u32BenchDrain(&Local_Echo);
+        }
+        CANSIM_VoidBenchSettle();
+        snprintf(Local_Name, sizeof(Local_Name), "TX latency, 1 frame / %u bits", (unsigned)Local_u32Period);
+        CANSIM_VoidBenchPrintLatency(Local_Name, &CANSIM_BenchLatency, Local_f64BitUs);
+        snprintf(Local_Name, sizeof(Local_Name), "round trip, 1 frame / %u bits", (unsigned)Local_u32Period);
+        CANSIM_VoidBenchPrintLatency(Local_Name, &Local_Echo, Local_f64BitUs);
+    }
+    return 0;
+}
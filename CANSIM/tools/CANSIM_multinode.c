@@ -0,0 +1,386 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANSIM_multinode.c
+ *  module:  CANSIM Module
+ *  @details:  multi-node test of the CAN driver on the virtual bus: the driver on node 0 and CANSIM_NODES - 1
+ *             peers exchange traffic, every check prints PASS / FAIL and the exit code is the number of
+ *             failed checks. Build and run on a Linux host from this directory (-I. resolves the ../../LIB
+ *             includes of the drivers):
+ *               gcc -O2 -DCAN_SIMULATION -I. -o cansim_multinode CANSIM_multinode.c ../CANSIM_program.c \
+ *                   ../../CAN/CAN_program.c
+ *               ./cansim_multinode
+*********************************************************************************************************************/
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+#include "../../CAN/CAN_config.h"
+#include "../CANSIM_interface.h"
+#include "../../CAN/CAN_private.h"
+
+#include <stdio.h>
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+#if CANSIM_NODES < 4
+#error "the multi-node test needs at least 4 nodes"
+#endif
+
+/*frames each node sends in the broadcast check*/
+#define CANSIM_TEST_FRAMES              (200)
+/*bit times between two polls of the application*/
+#define CANSIM_TEST_POLL_BITS           (50)
+/*identifier of the frames of node N in the broadcast check, one per node: the driver queue sends by identifier,
+  the order of a sender is kept only among frames of the same identifier*/
+#define CANSIM_TEST_ID(NODE)            (((uint32)(NODE) + 1) * 0x100)
+/*received frames kept per node*/
+#define CANSIM_TEST_LOG_SIZE            (1024)
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA TYPES AND STRUCTURES
+---------------------------------------------------------------------------------------------------------------------*/
+/*frames received by one node, in bus order*/
+typedef struct
+{
+    uint16 Count;
+    uint32 Id[CANSIM_TEST_LOG_SIZE];
+    uint32 Sequence[CANSIM_TEST_LOG_SIZE];
+}CANSIM_TestLog_t;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA
+---------------------------------------------------------------------------------------------------------------------*/
+void USB_HP_CAN1_TX_IRQHandler(void);
+void USB_LP_CAN1_RX0_IRQHandler(void);
+void CAN1_RX1_IRQHandler(void);
+void CAN1_SCE_IRQHandler(void);
+
+static const CANSIM_Irq_t CANSIM_TestIrq = {USB_HP_CAN1_TX_IRQHandler, USB_LP_CAN1_RX0_IRQHandler,
+                                            CAN1_RX1_IRQHandler, CAN1_SCE_IRQHandler};
+static const CAN_FilterBankImage_t CANSIM_TestAcceptAll[] = {CAN_FILTER_BANK_MASK32(0, CAN_RX_FIFO0, 0, 0)};
+
+static CANSIM_TestLog_t CANSIM_TestLogs[CANSIM_NODES];
+static uint8 CANSIM_TestFailures = 0;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Description     : print the result of one check and count the failures
+*******************************************************************************/
+static void CANSIM_VoidTestCheck(const char* pName,uint8 u8Passed)
+{
+    printf("%-58s %s\n", pName, (u8Passed != 0) ? "PASS" : "FAIL");
+    CANSIM_TestFailures += (u8Passed != 0) ? 0 : 1;
+}
+
+/******************************************************************************
+* \Description     : append a received frame to the log of a node
+*******************************************************************************/
+static void CANSIM_VoidTestLog(uint8 u8Node,const CAN_Frame_t* pFrame)
+{
+    CANSIM_TestLog_t* Local_pLog = &CANSIM_TestLogs[u8Node];
+
+    if(Local_pLog->Count < CANSIM_TEST_LOG_SIZE)
+    {
+        Local_pLog->Id[Local_pLog->Count] = CAN_FRAME_GET_STD(pFrame->Id);
+        Local_pLog->Sequence[Local_pLog->Count] = pFrame->Data.Words[0];
+        Local_pLog->Count++;
+    }
+}
+
+/******************************************************************************
+* \Description     : receive handler of the peers
+*******************************************************************************/
+static void CANSIM_VoidTestPeer(uint8 u8Node)
+{
+    CAN_Frame_t Local_Frame;
+
+    while(CANSIM_u8PeerReceive(u8Node, &Local_Frame) == OK)
+    {
+        CANSIM_VoidTestLog(u8Node, &Local_Frame);
+    }
+}
+
+/******************************************************************************
+* \Description     : main loop of node 0: read its RX ring into the log
+*******************************************************************************/
+static void CANSIM_VoidTestPoll(void)
+{
+    CAN_Frame_t Local_Frame;
+
+    while(MCAN_u16RxRingRead(CAN_RX_FIFO0, &Local_Frame, 1) == 1)
+    {
+        CANSIM_VoidTestLog(0, &Local_Frame);
+    }
+}
+
+/******************************************************************************
+* \Description     : run the bus with node 0 polled at CANSIM_TEST_POLL_BITS
+*******************************************************************************/
+static void CANSIM_VoidTestRun(uint32 u32Bits)
+{
+    uint32 Local_u32Bits;
+
+    for(Local_u32Bits=0;Local_u32Bits<u32Bits;Local_u32Bits+=CANSIM_TEST_POLL_BITS)
+    {
+        CANSIM_VoidRun(CANSIM_TEST_POLL_BITS);
+        CANSIM_VoidTestPoll();
+    }
+}
+
+/******************************************************************************
+* \Description     : fresh bus with the driver on node 0 (filters given) and the peers 1 .. CANSIM_NODES - 1,
+*                    u8Silent peer in silent mode (listens without acknowledge), CANSIM_NODES for none
+*******************************************************************************/
+static void CANSIM_VoidTestSetup(const CAN_FilterBankImage_t* pFilters,uint8 u8Filters,uint8 u8Silent)
+{
+    /*TransmitFifoPriority CAN_DISABLE: mailboxes in request order, a sender keeps the order of its frames*/
+    CAN_InitTypeDef Local_Config = {CAN_MODE_NORMAL, CAN_DISABLE, CAN_ENABLE, CAN_DISABLE, CAN_ENABLE,
+                                    CAN_DISABLE, CAN_DISABLE};
+    uint8 Local_u8Node;
+
+    /*frames left by the previous check*/
+    while(MCAN_u8TxQueueCount() != 0)
+    {
+        CANSIM_VoidTestRun(1000);
+    }
+    CANSIM_VoidTestRun(1000);
+
+    CANSIM_VoidInit();
+    CANSIM_VoidAttachIrq(0, &CANSIM_TestIrq);
+    MCAN_VoidInit(&Local_Config);
+    MCAN_VoidApplyFilters(pFilters, u8Filters);
+    MCAN_VoidEnableRxRing(CAN_RX_FIFO0);
+    MCAN_VoidEnableRxRing(CAN_RX_FIFO1);
+    MCAN_VoidStart();
+    for(Local_u8Node=1;Local_u8Node<CANSIM_NODES;Local_u8Node++)
+    {
+        (void)CANSIM_u8PeerStart(Local_u8Node, (Local_u8Node == u8Silent) ? CANSIM_PEER_SILENT : CANSIM_PEER_NORMAL);
+        CANSIM_VoidSetPeerHandler(Local_u8Node, CANSIM_VoidTestPeer);
+        /*peers in request order too (TXFP), like node 0*/
+        CANSIM_VoidSelect(Local_u8Node);
+        CAN_Control->MCR |= ((uint32)1 << 2);
+    }
+    CANSIM_VoidSelect(0);
+    for(Local_u8Node=0;Local_u8Node<CANSIM_NODES;Local_u8Node++)
+    {
+        CANSIM_TestLogs[Local_u8Node].Count = 0;
+    }
+}
+
+/******************************************************************************
+* \Description     : request a frame on a node: the driver for node 0, the peer functions otherwise
+*******************************************************************************/
+static Std_ReturnType CANSIM_u8TestSend(uint8 u8Node,uint32 u32StdId,uint32 u32Sequence)
+{
+    CAN_Frame_t Local_Frame = {0};
+
+    Local_Frame.Id = CAN_FRAME_ID_STD(u32StdId);
+    Local_Frame.DLC = 8;
+    Local_Frame.Data.Words[0] = u32Sequence;
+    Local_Frame.Data.Words[1] = u8Node;
+    if(u8Node == 0)
+    {
+        return (MCAN_u8TransmitFrame(&Local_Frame) != CAN_TX_QUEUE_FULL) ? OK : N_OK;
+    }
+    return CANSIM_u8PeerTransmit(u8Node, &Local_Frame);
+}
+
+/******************************************************************************
+* \Description     : every node receives every frame of the others once, in the order of each sender
+*******************************************************************************/
+static void CANSIM_VoidTestBroadcast(void)
+{
+    uint32 Local_au32Sent[CANSIM_NODES] = {0};
+    uint8 Local_u8Passed = 1;
+    uint8 Local_u8Node;
+    uint8 Local_u8Sender;
+    uint16 Local_u16Itr;
+    uint32 Local_u32Rounds = 0;
+
+    CANSIM_VoidTestSetup(CANSIM_TestAcceptAll, 1, CANSIM_NODES);
+    /*every node keeps its mailboxes (and node 0 its queue) busy until it sent all its frames*/
+    while(Local_u32Rounds < 100000)
+    {
+        uint8 Local_u8Done = 1;
+
+        for(Local_u8Node=0;Local_u8Node<CANSIM_NODES;Local_u8Node++)
+        {
+            while(Local_au32Sent[Local_u8Node] < CANSIM_TEST_FRAMES &&
+                  CANSIM_u8TestSend(Local_u8Node, CANSIM_TEST_ID(Local_u8Node),
+                                    Local_au32Sent[Local_u8Node]) == OK)
+            {
+                Local_au32Sent[Local_u8Node]++;
+            }
+            Local_u8Done &= (Local_au32Sent[Local_u8Node] == CANSIM_TEST_FRAMES) ? 1 : 0;
+        }
+        if(Local_u8Done != 0)
+        {
+            break;
+        }
+        CANSIM_VoidTestRun(CANSIM_TEST_POLL_BITS);
+        Local_u32Rounds++;
+    }
+    CANSIM_VoidTestRun(20000);
+
+    for(Local_u8Node=0;Local_u8Node<CANSIM_NODES;Local_u8Node++)
+    {
+        uint32 Local_au32Next[CANSIM_NODES] = {0};
+        const CANSIM_TestLog_t* Local_pLog = &CANSIM_TestLogs[Local_u8Node];
+
+        for(Local_u16Itr=0;Local_u16Itr<Local_pLog->Count;Local_u16Itr++)
+        {
+            Local_u8Sender = (uint8)(Local_pLog->Id[Local_u16Itr] / 0x100 - 1);
+            if(Local_u8Sender >= CANSIM_NODES || Local_u8Sender == Local_u8Node ||
+               Local_pLog->Sequence[Local_u16Itr] != Local_au32Next[Local_u8Sender])
+            {
+                Local_u8Passed = 0;
+                break;
+            }
+            Local_au32Next[Local_u8Sender]++;
+        }
+        Local_u8Passed &= (Local_pLog->Count == (CANSIM_NODES - 1) * CANSIM_TEST_FRAMES) ? 1 : 0;
+    }
+    CANSIM_VoidTestCheck("broadcast: every frame once, in order, at every node", Local_u8Passed);
+}
+
+/******************************************************************************
+* \Description     : frames requested on the same bit by several nodes leave by identifier, the listener
+*                    sees them sorted and the losing nodes retry
+*******************************************************************************/
+static void CANSIM_VoidTestArbitration(void)
+{
+    static const uint32 Local_Ids[3] = {0x250, 0x120, 0x3A0};
+    uint8 Local_u8Node;
+    CANSIM_Stats_t Local_Stats;
+    const CANSIM_TestLog_t* Local_pLog = &CANSIM_TestLogs[3];
+
+    CANSIM_VoidTestSetup(CANSIM_TestAcceptAll, 1, 3);
+    CANSIM_VoidRun(200);
+    /*nodes 0 .. 2 request before the bus runs again: they start the same frame together*/
+    for(Local_u8Node=0;Local_u8Node<3;Local_u8Node++)
+    {
+        (void)CANSIM_u8TestSend(Local_u8Node, Local_Ids[Local_u8Node], Local_u8Node);
+    }
+    CANSIM_VoidTestRun(2000);
+    CANSIM_VoidGetStats(&Local_Stats);
+    CANSIM_VoidTestCheck("arbitration: lowest identifier first at the listener",
+                         (uint8)(Local_pLog->Count == 3 && Local_pLog->Id[0] == 0x120 &&
+                                 Local_pLog->Id[1] == 0x250 && Local_pLog->Id[2] == 0x3A0));
+    CANSIM_VoidTestCheck("arbitration: the losers lost and retried (3 losses)",
+                         (uint8)(Local_Stats.ArbitrationLost == 3 && Local_Stats.Frames == 3));
+}
+
+/******************************************************************************
+* \Description     : node 0 keeps only the identifiers of its filter list, to the FIFO of each bank
+*******************************************************************************/
+static void CANSIM_VoidTestFilters(void)
+{
+    static const CAN_FilterBankImage_t Local_Filters[] =
+    {
+        CAN_FILTER_BANK_LIST16(0, CAN_RX_FIFO0, CAN_FILTER16_STD(0x101), CAN_FILTER16_STD(0x102),
+                               CAN_FILTER16_STD(0x103), CAN_FILTER16_STD(0x104)),
+        CAN_FILTER_BANK_MASK32(1, CAN_RX_FIFO1, CAN_FILTER32_STD(0x600), CAN_FILTER32_STD_MASK(0x700))
+    };
+    CAN_Frame_t Local_Frame;
+    uint32 Local_u32Id;
+    uint16 Local_u16Fifo0 = 0;
+    uint16 Local_u16Fifo1 = 0;
+    uint8 Local_u8Passed = 1;
+
+    CANSIM_VoidTestSetup(Local_Filters, 2, CANSIM_NODES);
+    for(Local_u32Id=0x100;Local_u32Id<0x108;Local_u32Id++)
+    {
+        while(CANSIM_u8TestSend(1, Local_u32Id, Local_u32Id) != OK)
+        {
+            CANSIM_VoidRun(CANSIM_TEST_POLL_BITS);
+        }
+        while(CANSIM_u8TestSend(2, Local_u32Id + 0x500, Local_u32Id) != OK)
+        {
+            CANSIM_VoidRun(CANSIM_TEST_POLL_BITS);
+        }
+    }
+    CANSIM_VoidRun(5000);
+    while(MCAN_u16RxRingRead(CAN_RX_FIFO0, &Local_Frame, 1) == 1)
+    {
+        Local_u32Id = CAN_FRAME_GET_STD(Local_Frame.Id);
+        Local_u8Passed &= (Local_u32Id >= 0x101 && Local_u32Id <= 0x104) ? 1 : 0;
+        Local_u16Fifo0++;
+    }
+    while(MCAN_u16RxRingRead(CAN_RX_FIFO1, &Local_Frame, 1) == 1)
+    {
+        Local_u32Id = CAN_FRAME_GET_STD(Local_Frame.Id);
+        Local_u8Passed &= ((Local_u32Id & 0x700) == 0x600) ? 1 : 0;
+        Local_u16Fifo1++;
+    }
+    CANSIM_VoidTestCheck("filters: list to FIFO 0, mask to FIFO 1, others dropped",
+                         (uint8)(Local_u8Passed != 0 && Local_u16Fifo0 == 4 && Local_u16Fifo1 == 8));
+}
+
+/******************************************************************************
+* \Description     : node 0 goes bus-off with a full TX queue while the peers keep talking, recovers and
+*                    replays every frame it had accepted
+*******************************************************************************/
+static void CANSIM_VoidTestBusOff(void)
+{
+    CAN_BusOffEpisode_t Local_Episode;
+    uint32 Local_u32Accepted = 0;
+    uint32 Local_u32Seq;
+    uint16 Local_u16Itr;
+    uint16 Local_u16Node0 = 0;
+    uint16 Local_u16Peer = 0;
+
+    CANSIM_VoidTestSetup(CANSIM_TestAcceptAll, 1, CANSIM_NODES);
+    MCAN_VoidSetRecoveryMode(CAN_RECOVERY_ABOM);
+    CANSIM_VoidInjectErrors(0, 40);
+    for(Local_u32Seq=0;Local_u32Seq<CAN_TX_QUEUE_SIZE + 3;Local_u32Seq++)
+    {
+        Local_u32Accepted += (CANSIM_u8TestSend(0, 0x100 + Local_u32Seq, Local_u32Seq) == OK) ? 1 : 0;
+    }
+    /*a peer frame every 400 bits leaves the bus free for the replay*/
+    for(Local_u32Seq=0;Local_u32Seq<400;Local_u32Seq++)
+    {
+        if((Local_u32Seq & 0x3) == 0)
+        {
+            (void)CANSIM_u8TestSend(2, 0x050, Local_u32Seq);
+        }
+        CANSIM_VoidTestRun(100);
+        MCAN_VoidRecoveryTick();
+    }
+    for(Local_u16Itr=0;Local_u16Itr<CANSIM_TestLogs[1].Count;Local_u16Itr++)
+    {
+        Local_u16Node0 += (CANSIM_TestLogs[1].Id[Local_u16Itr] >= 0x100) ? 1 : 0;
+    }
+    for(Local_u16Itr=0;Local_u16Itr<CANSIM_TestLogs[0].Count;Local_u16Itr++)
+    {
+        Local_u16Peer += (CANSIM_TestLogs[0].Id[Local_u16Itr] == 0x050) ? 1 : 0;
+    }
+    CANSIM_VoidTestCheck("bus-off: one episode, back to active",
+                         (uint8)(MCAN_u8GetBusOffEpisodes(&Local_Episode, 1) == 1 &&
+                                 MCAN_u8RecoveryState() == CAN_RECOVERY_ACTIVE));
+    CANSIM_VoidTestCheck("bus-off: every accepted frame replayed after the recovery",
+                         (uint8)(Local_u32Accepted == CAN_TX_QUEUE_SIZE + 3 && Local_u16Node0 == Local_u32Accepted));
+    CANSIM_VoidTestCheck("bus-off: peer traffic received again after the recovery", (uint8)(Local_u16Peer > 0));
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    printf("CANSIM multi-node test, %u nodes\n", (unsigned)CANSIM_NODES);
+    CANSIM_VoidTestBroadcast();
+    CANSIM_VoidTestArbitration();
+    CANSIM_VoidTestFilters();
+    CANSIM_VoidTestBusOff();
+    printf("%u check(s) failed\n", (unsigned)CANSIM_TestFailures);
+    return CANSIM_TestFailures;
+}
@@ -0,0 +1,201 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANSIM_timestamp.c
+ *  module:  CANSIM Module
+ *  @details:  settling test of the 64-bit RX time stamps of the CAN driver on the virtual bus: a peer sends
+ *             frames of random identifier, length and data (so random stuff bits), node 0 serves its RX
+ *             interrupt after a random latency and the stamp of every frame is compared with its real start
+ *             of frame. Idle gaps longer than 2^16 bits wrap TIME. The cycle counter follows the bus time, so
+ *             latencies and errors are whole bit times (1 us at 1 Mbit/s). The model hands a frame to FIFO 0 at
+ *             the end of EOF, one bit after the receiver validates it (where the driver counts its length to),
+ *             so the best stamp here is one bit late. Every check prints PASS / FAIL and the exit code is the
+ *             number of failed checks. Build and run on a Linux host from this directory
+ *             (-I. resolves the ../../LIB includes of the drivers):
+ *               gcc -O2 -DCAN_SIMULATION -I. -o cansim_timestamp CANSIM_timestamp.c ../CANSIM_program.c \
+ *                   ../../CAN/CAN_program.c
+ *               ./cansim_timestamp
+*********************************************************************************************************************/
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+#include "../../CAN/CAN_config.h"
+#include "../CANSIM_interface.h"
+#include "../../CAN/CAN_private.h"
+
+#include <stdio.h>
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*frames of the run*/
+#define CANSIM_TS_FRAMES                (20000)
+/*frames within which the stamps must settle to one bit time*/
+#define CANSIM_TS_SETTLE_FRAMES         (5000)
+/*largest interrupt latency, in bit times*/
+#define CANSIM_TS_MAX_LATENCY           (30)
+/*largest idle gap between two frames in bit times, and one frame in CANSIM_TS_WRAP_EVERY followed by a gap
+  longer than the TIME counter*/
+#define CANSIM_TS_MAX_GAP               (2000)
+#define CANSIM_TS_WRAP_EVERY            (500)
+#define CANSIM_TS_WRAP_GAP              (70000)
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA
+---------------------------------------------------------------------------------------------------------------------*/
+void USB_HP_CAN1_TX_IRQHandler(void);
+void USB_LP_CAN1_RX0_IRQHandler(void);
+void CAN1_RX1_IRQHandler(void);
+void CAN1_SCE_IRQHandler(void);
+
+/*no RX0 handler: the test serves it itself after the latency*/
+static const CANSIM_Irq_t CANSIM_TsIrq = {USB_HP_CAN1_TX_IRQHandler, NULL, CAN1_RX1_IRQHandler, CAN1_SCE_IRQHandler};
+static const CAN_FilterBankImage_t CANSIM_TsAcceptAll[] = {CAN_FILTER_BANK_MASK32(0, CAN_RX_FIFO0, 0, 0)};
+
+static uint32 CANSIM_TsSeed = 1;
+static uint8 CANSIM_TsFailures = 0;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Description     : print the result of one check and count the failures
+*******************************************************************************/
+static void CANSIM_VoidTsCheck(const char* pName,uint8 u8Passed)
+{
+    printf("%-58s %s\n", pName, (u8Passed != 0) ? "PASS" : "FAIL");
+    CANSIM_TsFailures += (u8Passed != 0) ? 0 : 1;
+}
+
+/******************************************************************************
+* \Description     : xorshift32, the same sequence on every run
+*******************************************************************************/
+static uint32 CANSIM_u32TsRandom(uint32 u32Range)
+{
+    CANSIM_TsSeed ^= CANSIM_TsSeed << 13;
+    CANSIM_TsSeed ^= CANSIM_TsSeed >> 17;
+    CANSIM_TsSeed ^= CANSIM_TsSeed << 5;
+    return CANSIM_TsSeed % u32Range;
+}
+
+/******************************************************************************
+* \Description     : send one random frame from the peer and serve the RX interrupt of node 0 a random
+*                    latency after the frame became valid
+* \Parameters (out): pError stamp minus real start of frame, in HCLK cycles
+* \Return value:   : Std_ReturnType N_OK when node 0 did not receive the frame
+*******************************************************************************/
+static Std_ReturnType CANSIM_u8TsFrame(sint64* pError)
+{
+    CAN_Frame_t Local_Frame = {0};
+    const CAN_Frame_t* Local_pFrame;
+    uint32 Local_u32Bits = 0;
+    uint64 Local_u64Now;
+    uint64 Local_u64Sof;
+
+    Local_Frame.Id = (CANSIM_u32TsRandom(2) == 0) ? CAN_FRAME_ID_STD(CANSIM_u32TsRandom(0x800)) :
+                                                    CAN_FRAME_ID_EXT(CANSIM_u32TsRandom(0x20000000));
+    Local_Frame.DLC = (uint8)CANSIM_u32TsRandom(9);
+    Local_Frame.Data.Words[0] = CANSIM_u32TsRandom(0xFFFFFFFF);
+    Local_Frame.Data.Words[1] = CANSIM_u32TsRandom(0xFFFFFFFF);
+    if(CANSIM_u8PeerTransmit(1, &Local_Frame) != OK)
+    {
+        return N_OK;
+    }
+    /*bit by bit up to the bit where the frame is in FIFO 0*/
+    while(CAN_Control->RFR[CAN_RX_FIFO0].B.FMP == 0)
+    {
+        CANSIM_VoidRun(1);
+        if(++Local_u32Bits > 1000)
+        {
+            return N_OK;
+        }
+    }
+    CANSIM_VoidRun(CANSIM_u32TsRandom(CANSIM_TS_MAX_LATENCY + 1));
+    USB_LP_CAN1_RX0_IRQHandler();
+    if(MCAN_u16RxRingPeek(CAN_RX_FIFO0, &Local_pFrame) == 0)
+    {
+        return N_OK;
+    }
+    /*TIME is the start of frame bit of the bus, modulo 2^16, and the latency is far below 2^16 bits*/
+    Local_u64Now = CANSIM_u64GetBits();
+    Local_u64Sof = Local_u64Now - (uint16)((uint16)Local_u64Now - Local_pFrame->TimeStamp);
+    *pError = (sint64)(MCAN_u64RxStamp(Local_pFrame) - Local_u64Sof * MCAN_u32CyclesPerBit());
+    MCAN_VoidRxRingRelease(CAN_RX_FIFO0, 1);
+    return OK;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    CAN_InitTypeDef Local_Config = {CAN_MODE_NORMAL, CAN_DISABLE, CAN_ENABLE, CAN_DISABLE, CAN_ENABLE,
+                                    CAN_DISABLE, CAN_DISABLE};
+    sint64 Local_s64Error = 0;
+    sint64 Local_s64First = 0;
+    sint64 Local_s64Previous = 0;
+    uint32 Local_u32Frame;
+    uint32 Local_u32SettledAt = 0;
+    uint32 Local_u32Early = 0;
+    uint32 Local_u32Later = 0;
+    uint32 Local_u32Received = 0;
+    uint32 Local_u32CyclesPerBit;
+
+    CANSIM_VoidInit();
+    CANSIM_VoidAttachIrq(0, &CANSIM_TsIrq);
+    MCAN_VoidInit(&Local_Config);
+    MCAN_VoidApplyFilters(CANSIM_TsAcceptAll, 1);
+    MCAN_VoidEnableRxRing(CAN_RX_FIFO0);
+    (void)MCAN_u8EnableTimeStamps();
+    MCAN_VoidStart();
+    (void)CANSIM_u8PeerStart(1, CANSIM_PEER_NORMAL);
+    CANSIM_VoidSelect(0);
+    CANSIM_VoidRun(100);
+    Local_u32CyclesPerBit = MCAN_u32CyclesPerBit();
+    printf("CANSIM time stamp test, %u cycles per bit (%u kbit/s at %u MHz)\n", (unsigned)Local_u32CyclesPerBit,
+           (unsigned)(CANSIM_HCLK_HZ / 1000 / Local_u32CyclesPerBit), (unsigned)(CANSIM_HCLK_HZ / 1000000));
+
+    for(Local_u32Frame=0;Local_u32Frame<CANSIM_TS_FRAMES;Local_u32Frame++)
+    {
+        CANSIM_VoidRun(((Local_u32Frame % CANSIM_TS_WRAP_EVERY) == CANSIM_TS_WRAP_EVERY - 1) ?
+                       CANSIM_TS_WRAP_GAP : CANSIM_u32TsRandom(CANSIM_TS_MAX_GAP));
+        if(CANSIM_u8TsFrame(&Local_s64Error) != OK)
+        {
+            continue;
+        }
+        Local_u32Received++;
+        if(Local_u32Received == 1)
+        {
+            Local_s64First = Local_s64Error;
+        }
+        else if(Local_s64Error > Local_s64Previous)
+        {
+            Local_u32Later++;
+        }
+        else{}
+        Local_u32Early += (Local_s64Error < 0) ? 1 : 0;
+        /*settled: at most one bit time from the next frame on*/
+        if(Local_s64Error > (sint64)Local_u32CyclesPerBit)
+        {
+            Local_u32SettledAt = Local_u32Received;
+        }
+        else{}
+        Local_s64Previous = Local_s64Error;
+    }
+    printf("first frame late by %lld cycles, one bit or less after frame %u, last error %lld cycles\n",
+           (long long)Local_s64First, (unsigned)Local_u32SettledAt, (long long)Local_s64Error);
+
+    CANSIM_VoidTsCheck("every frame received and stamped", (uint8)(Local_u32Received == CANSIM_TS_FRAMES));
+    CANSIM_VoidTsCheck("no stamp before the real start of frame", (uint8)(Local_u32Early == 0));
+    CANSIM_VoidTsCheck("the error never grows (TIME wraps included)", (uint8)(Local_u32Later == 0));
+    CANSIM_VoidTsCheck("settled to one bit time within the first frames",
+                       (uint8)(Local_u32SettledAt < CANSIM_TS_SETTLE_FRAMES));
+    printf("%u check(s) failed\n", (unsigned)CANSIM_TsFailures);
+    return CANSIM_TsFailures;
+}
@@ -0,0 +1,51 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANTT_config.h
+ *  module:  CANTT Module
+ *  @details:  Configuration header file for the time-triggered CAN schedule
+*********************************************************************************************************************/
+#ifndef _CANTT_CONFIG_H
+#define _CANTT_CONFIG_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*options of CANTT_ROLE*/
+#define CANTT_ROLE_SLAVE                (0)    /*!< follows the reference message of the time master */
+#define CANTT_ROLE_MASTER               (1)    /*!< sends the reference message at the start of each basic cycle */
+
+#define CANTT_ROLE                      CANTT_ROLE_SLAVE
+
+/*reference message: identifier in CAN_Frame_t layout (CAN_FRAME_ID_STD / CAN_FRAME_ID_EXT) and data
+  length, data byte 0 carries the basic cycle number*/
+#define CANTT_REF_ID                    CAN_FRAME_ID_STD(0x001)
+#define CANTT_REF_DLC                   (1)
+
+/*master: time window of the reference message at the start of the basic cycle, in bit times*/
+#define CANTT_REF_WINDOW_BITS           (80)
+
+/*length of a basic cycle in bit times (at most 65535)*/
+#define CANTT_CYCLE_BITS                (2000)
+
+/*basic cycles in the matrix, a power of two from 1 to 128*/
+#define CANTT_MATRIX_CYCLES             (4)
+
+/*number of slots of the schedule (master: the reference message not included)*/
+#define CANTT_MAX_SLOTS                 (16)
+
+/*transmit mailbox kept for the schedule, the TX queue keeps the two others*/
+#define CANTT_MAILBOX                   (2)
+
+/*HCLK cycles the timer interrupt is requested ahead of a window: its entry latency and the mailbox load*/
+#define CANTT_LOAD_LEAD_CYCLES          (144)
+
+/*slave: basic cycles without reference message before the schedule stops sending*/
+#define CANTT_REF_LOSS_CYCLES           (2)
+
+#endif
@@ -0,0 +1,149 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANTT_interface.h
+ *  module:  CANTT Module
+ *  @details:  interface header file for the time-triggered CAN schedule: a matrix of basic cycles, each
+ *             started by a reference message, with one exclusive time window per scheduled frame. The frames
+ *             go through a reserved mailbox loaded by a timer interrupt at the start of their window, the
+ *             windows are placed on the 64-bit time stamp of the reference message (MCAN_u8EnableTimeStamps)
+*********************************************************************************************************************/
+#ifndef _CANTT_INTERFACE_H
+#define _CANTT_INTERFACE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+#include "../../LIB/Std_Types.h"
+#include "../../LIB/Bit_Math.h"
+
+#include "../CAN/CAN_interface.h"
+#include "CANTT_config.h"
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/** @defgroup CANTT_state state of the schedule in CANTT_Status_t **/
+#define CANTT_STATE_OFF                 (0)
+#define CANTT_STATE_WAIT_REF            (1)    /*!< slave: no reference message yet or lost, nothing is sent */
+#define CANTT_STATE_SYNC                (2)
+
+/** @defgroup CANTT_slot initializer of CANTT_Slot_t for a static const schedule **/
+#define CANTT_SLOT(ID,DLC,OFFSET_BITS,WINDOW_BITS,BASE,REPEAT)  {(ID),(DLC),(BASE),(REPEAT),(OFFSET_BITS),(WINDOW_BITS)}
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL DATA TYPES AND STRUCTURES
+---------------------------------------------------------------------------------------------------------------------*/
+/**
+  * @brief  one scheduled frame: sent in the basic cycles c of the matrix with c % Repeat == BaseCycle,
+  *         in the window OffsetBits .. OffsetBits + WindowBits after the start of the reference message
+  */
+typedef struct
+{
+  uint32 Id;                    /*!< @ref CAN_frame_id */
+  uint8 DLC;                    /*!< data length 0-8 */
+  uint8 BaseCycle;              /*!< first basic cycle, less than Repeat */
+  uint8 Repeat;                 /*!< power of two up to CANTT_MATRIX_CYCLES */
+  uint16 OffsetBits;            /*!< start of the window in bit times */
+  uint16 WindowBits;            /*!< length of the window in bit times: a frame not started by then is aborted */
+}CANTT_Slot_t;
+
+/**
+  * @brief  counters of the schedule
+  */
+typedef struct
+{
+  uint8 State;                  /*!< @ref CANTT_state */
+  uint32 Cycles;                /*!< basic cycles run */
+  uint32 Sent;                  /*!< frames sent in their window (master: reference messages included) */
+  uint32 Missed;                /*!< windows passed without loading the frame (late timer, mailbox busy) */
+  uint32 Aborted;               /*!< frames loaded but not sent in their window */
+  uint32 RefLost;               /*!< slave: times the reference message was lost */
+  uint32 MaxJitterCycles;       /*!< largest distance between a start of frame and its window start, HCLK cycles */
+}CANTT_Status_t;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANTT_u8Init(const CANTT_Slot_t* pSlots,uint8 u8Count)
+* \Description     : check the schedule, reserve CANTT_MAILBOX and start: the master sends its first reference
+*                    message, the slave waits for one (attach CANTT_VoidReferenceHandler to its filter).
+*                    The slots are sorted by OffsetBits and the windows of slots sharing a basic cycle do not
+*                    overlap (nor the reference window of the master). Call after MCAN_u8EnableTimeStamps
+*                    and MCAN_VoidStart
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pSlots schedule, u8Count number of slots
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK on an invalid schedule, without time stamps or when running
+*******************************************************************************/
+Std_ReturnType CANTT_u8Init(const CANTT_Slot_t* pSlots,uint8 u8Count);
+
+/******************************************************************************
+* \Syntax          : void CANTT_VoidStop(void)
+* \Description     : stop the schedule and give the mailbox back to the TX queue, with the interrupts masked
+*                    (MCAN_u32EnterCritical) so the timer interrupt does not run in between
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANTT_VoidStop(void);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANTT_u8Write(uint8 u8Slot,const uint8* pData)
+* \Description     : store the latest value of a slot (DLC bytes copied), sent in its next window. The timer
+*                    interrupt only reads the other copy, so no masking is needed
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Slot index in the schedule given to CANTT_u8Init, pData data bytes
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK on an invalid slot
+*******************************************************************************/
+Std_ReturnType CANTT_u8Write(uint8 u8Slot,const uint8* pData);
+
+/******************************************************************************
+* \Syntax          : void CANTT_VoidReferenceHandler(const CAN_Frame_t* pFrame,void* pContext)
+* \Description     : slave: CAN_FrameHandler_t for the filter of the reference message
+*                    (MCAN_VoidSetFilterHandler), hands its time stamp and cycle number to the timer interrupt.
+*                    The first window of a cycle must leave room for the reference message and its dispatch
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pFrame received frame, pContext unused
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANTT_VoidReferenceHandler(const CAN_Frame_t* pFrame,void* pContext);
+
+/******************************************************************************
+* \Syntax          : uint32 CANTT_u32TimerHandler(void)
+* \Description     : schedule, call from a timer interrupt of lower or equal priority than the CAN TX
+*                    interrupt: loads the frame of each window as it starts, aborts it at the window end and
+*                    follows the reference message. Program a one-shot compare with the returned delay for a
+*                    jitter of the interrupt latency; a periodic tick also works with its period as jitter
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint32 HCLK cycles until the next call, 0 when stopped
+*******************************************************************************/
+uint32 CANTT_u32TimerHandler(void);
+
+/******************************************************************************
+* \Syntax          : void CANTT_VoidGetStatus(CANTT_Status_t* pStatus)
+* \Description     : read the state and the counters of the schedule
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): pStatus state and counters
+* \Return value:   : None
+*******************************************************************************/
+void CANTT_VoidGetStatus(CANTT_Status_t* pStatus);
+
+#endif
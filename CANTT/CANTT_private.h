@@ -0,0 +1,51 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANTT_private.h
+ *  module:  CANTT Module
+ *  @details:  private header file for the time-triggered CAN schedule
+*********************************************************************************************************************/
+#ifndef _CANTT_PRIVATE_H
+#define _CANTT_PRIVATE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*master: the reference message is window 0 of every basic cycle, the slots follow it*/
+#if CANTT_ROLE == CANTT_ROLE_MASTER
+#define CANTT_REF_WINDOWS               (1)
+#else
+#define CANTT_REF_WINDOWS               (0)
+#endif
+#define CANTT_MAX_WINDOWS               (CANTT_MAX_SLOTS + CANTT_REF_WINDOWS)
+
+/*no window in the reserved mailbox*/
+#define CANTT_NONE                      (0xFF)
+
+/*a frame still on the bus at the end of its window is polled every CANTT_POLL_BITS bit times*/
+#define CANTT_POLL_BITS                 (16)
+
+/*slave without reference: the timer interrupt polls CANTT_IDLE_DIVIDER times per basic cycle*/
+#define CANTT_IDLE_DIVIDER              (8)
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL DATA TYPES AND STRUCTURES
+---------------------------------------------------------------------------------------------------------------------*/
+/*one window of the basic cycle in HCLK cycles, its frame written by the application in two copies: the
+  timer interrupt loads Frame[Active], CANTT_u8Write fills the other copy and swaps Active*/
+typedef struct
+{
+    CAN_Frame_t Frame[2];
+    volatile uint8 Active;
+    uint8 Base;
+    uint8 RepeatMask;                   /*the window is used in the cycles c with (c ^ Base) & RepeatMask == 0*/
+    uint32 StartCycles;                 /*from the start of frame of the reference message*/
+    uint32 WindowCycles;
+}CANTT_Window_t;
+
+#endif
@@ -0,0 +1,494 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  CANTT_program.c
+ *  module:  CANTT Module
+ *  @details:  program file for the time-triggered CAN schedule
+*********************************************************************************************************************/
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+
+#include "../../LIB/Std_Types.h"
+#include "../../LIB/Bit_Math.h"
+
+#include "CANTT_config.h"
+#include "CANTT_interface.h"
+#include "CANTT_private.h"
+
+#include "../SYSTick/SYSTick_interface.h"
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA
+---------------------------------------------------------------------------------------------------------------------*/
+static CANTT_Window_t CANTT_Windows[CANTT_MAX_WINDOWS];
+static uint8 CANTT_WindowCount = 0;
+static volatile uint8 CANTT_State = CANTT_STATE_OFF;
+static uint32 CANTT_CyclesPerBit = 0;
+static uint32 CANTT_CycleCycles = 0;       /*basic cycle length in HCLK cycles*/
+
+/*current basic cycle: start of frame of its reference message, number and next window*/
+static uint64 CANTT_RefCycles = 0;
+static uint8 CANTT_Cycle = 0;
+static uint8 CANTT_Next = 0;
+static uint8 CANTT_RefSeen = 0;
+static uint8 CANTT_RefMisses = 0;
+
+/*window in the reserved mailbox*/
+static uint8 CANTT_Loaded = CANTT_NONE;
+static uint64 CANTT_LoadedStart = 0;
+static uint64 CANTT_LoadedEnd = 0;
+
+/*reference message handed over by CANTT_VoidReferenceHandler, Pending written last*/
+static volatile uint8 CANTT_RefPending = 0;
+static uint64 CANTT_RefPendingCycles = 0;
+static uint8 CANTT_RefPendingCycle = 0;
+
+static CANTT_Status_t CANTT_Status;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Description     : two slots share a basic cycle and their windows overlap
+*******************************************************************************/
+static uint8 CANTT_u8Overlap(const CANTT_Slot_t* pFirst,const CANTT_Slot_t* pSecond)
+{
+    uint8 Local_u8Mask = (uint8)(((pFirst->Repeat < pSecond->Repeat) ? pFirst->Repeat : pSecond->Repeat) - 1);
+
+    /*c = Base1 mod R1 and c = Base2 mod R2 have a solution when the bases agree modulo the smaller power of two*/
+    if(((pFirst->BaseCycle ^ pSecond->BaseCycle) & Local_u8Mask) != 0)
+    {
+        return 0;
+    }
+    return (uint8)((uint32)pFirst->OffsetBits + pFirst->WindowBits > pSecond->OffsetBits &&
+                   (uint32)pSecond->OffsetBits + pSecond->WindowBits > pFirst->OffsetBits);
+}
+
+/******************************************************************************
+* \Description     : fill a window from its slot, times converted to HCLK cycles
+*******************************************************************************/
+static void CANTT_VoidSetWindow(CANTT_Window_t* pWindow,const CANTT_Slot_t* pSlot)
+{
+    uint8 Local_u8Copy;
+
+    for(Local_u8Copy=0;Local_u8Copy<2;Local_u8Copy++)
+    {
+        pWindow->Frame[Local_u8Copy].Id = pSlot->Id;
+        pWindow->Frame[Local_u8Copy].DLC = pSlot->DLC;
+        pWindow->Frame[Local_u8Copy].FMI = 0;
+        pWindow->Frame[Local_u8Copy].TimeStamp = 0;
+        pWindow->Frame[Local_u8Copy].Data.Words[0] = 0;
+        pWindow->Frame[Local_u8Copy].Data.Words[1] = 0;
+    }
+    pWindow->Active = 0;
+    pWindow->Base = pSlot->BaseCycle;
+    pWindow->RepeatMask = (uint8)(pSlot->Repeat - 1);
+    pWindow->StartCycles = (uint32)pSlot->OffsetBits * CANTT_CyclesPerBit;
+    pWindow->WindowCycles = (uint32)pSlot->WindowBits * CANTT_CyclesPerBit;
+}
+
+/******************************************************************************
+* \Description     : move to the next basic cycle, one cycle length after the current reference. A slave
+*                    corrects it with the reference message and stops after CANTT_REF_LOSS_CYCLES without
+*******************************************************************************/
+static void CANTT_VoidNextCycle(void)
+{
+    CANTT_RefCycles += CANTT_CycleCycles;
+    CANTT_Cycle = (uint8)((CANTT_Cycle + 1) & (CANTT_MATRIX_CYCLES - 1));
+    CANTT_Next = 0;
+    CANTT_Status.Cycles++;
+#if CANTT_ROLE == CANTT_ROLE_SLAVE
+    if(CANTT_RefSeen != 0)
+    {
+        CANTT_RefMisses = 0;
+    }
+    else if(++CANTT_RefMisses >= CANTT_REF_LOSS_CYCLES)
+    {
+        CANTT_State = CANTT_STATE_WAIT_REF;
+        CANTT_Status.RefLost++;
+    }
+    else{}
+    CANTT_RefSeen = 0;
+#endif
+}
+
+/******************************************************************************
+* \Description     : slave: take the reference message handed over by the handler. The reference of the
+*                    current cycle only corrects its start, a later one starts the next cycle
+*******************************************************************************/
+static void CANTT_VoidTakeReference(uint64 u64Now)
+{
+    uint64 Local_u64Ref;
+    uint8 Local_u8Cycle;
+
+    if(CANTT_RefPending == 0)
+    {
+        return;
+    }
+    Local_u64Ref = CANTT_RefPendingCycles;
+    Local_u8Cycle = CANTT_RefPendingCycle;
+    CANTT_RefPending = 0;
+
+    if(CANTT_State == CANTT_STATE_SYNC)
+    {
+        if(Local_u64Ref + (CANTT_CycleCycles / 2) < CANTT_RefCycles)
+        {
+            /*older than the current cycle*/
+            return;
+        }
+        if(Local_u64Ref >= CANTT_RefCycles + (CANTT_CycleCycles / 2))
+        {
+            /*came before the end of the predicted cycle*/
+            CANTT_VoidNextCycle();
+        }
+    }
+    CANTT_RefCycles = Local_u64Ref;
+    CANTT_Cycle = (uint8)(Local_u8Cycle & (CANTT_MATRIX_CYCLES - 1));
+    CANTT_RefSeen = 1;
+    if(CANTT_State != CANTT_STATE_SYNC)
+    {
+        /*(re)synchronized: the windows already over are not counted as missed*/
+        CANTT_State = CANTT_STATE_SYNC;
+        CANTT_RefMisses = 0;
+        CANTT_Next = 0;
+        while(CANTT_Next < CANTT_WindowCount &&
+              CANTT_RefCycles + CANTT_Windows[CANTT_Next].StartCycles + CANTT_Windows[CANTT_Next].WindowCycles <= u64Now)
+        {
+            CANTT_Next++;
+        }
+    }
+}
+
+/******************************************************************************
+* \Description     : follow the frame in the reserved mailbox: abort it at the end of its window, count it
+*                    when done. A master reference message moves the cycle start to its actual start of frame
+*******************************************************************************/
+static void CANTT_VoidCheckMailbox(uint64 u64Now)
+{
+    uint64 Local_u64Sof = 0;
+    uint64 Local_u64Jitter;
+    uint8 Local_u8Status;
+
+    if(CANTT_Loaded == CANTT_NONE)
+    {
+        return;
+    }
+    Local_u8Status = MCAN_u8ReservedMailboxStatus(&Local_u64Sof);
+    if(Local_u8Status == CAN_RESERVED_PENDING)
+    {
+        if(u64Now >= CANTT_LoadedEnd)
+        {
+            /*no effect once the frame is on the bus*/
+            MCAN_VoidAbortReservedMailbox();
+        }
+        return;
+    }
+    if(Local_u8Status == CAN_RESERVED_SENT)
+    {
+        CANTT_Status.Sent++;
+        if(Local_u64Sof != 0)
+        {
+            Local_u64Jitter = (Local_u64Sof >= CANTT_LoadedStart) ? (Local_u64Sof - CANTT_LoadedStart) :
+                                                                    (CANTT_LoadedStart - Local_u64Sof);
+            if(Local_u64Jitter > CANTT_Status.MaxJitterCycles)
+            {
+                CANTT_Status.MaxJitterCycles = (uint32)Local_u64Jitter;
+            }
+            if(CANTT_REF_WINDOWS != 0 && CANTT_Loaded == 0)
+            {
+                CANTT_RefCycles = Local_u64Sof;
+            }
+        }
+    }
+    else
+    {
+        CANTT_Status.Aborted++;
+    }
+    CANTT_Loaded = CANTT_NONE;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANTT_u8Init(const CANTT_Slot_t* pSlots,uint8 u8Count)
+* \Description     : check the schedule, reserve the mailbox and start
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pSlots schedule, u8Count number of slots
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK on an invalid schedule, without time stamps or when running
+*******************************************************************************/
+Std_ReturnType CANTT_u8Init(const CANTT_Slot_t* pSlots,uint8 u8Count)
+{
+    static const CANTT_Slot_t Local_RefSlot = CANTT_SLOT(CANTT_REF_ID,CANTT_REF_DLC,0,CANTT_REF_WINDOW_BITS,0,1);
+    uint32 Local_u32CyclesPerBit = MCAN_u32CyclesPerBit();
+    uint8 Local_u8Itr;
+    uint8 Local_u8Other;
+
+    if(Local_u32CyclesPerBit == 0 || u8Count > CANTT_MAX_SLOTS || CANTT_State != CANTT_STATE_OFF)
+    {
+        return N_OK;
+    }
+    for(Local_u8Itr=0;Local_u8Itr<u8Count;Local_u8Itr++)
+    {
+        const CANTT_Slot_t* Local_pSlot = &pSlots[Local_u8Itr];
+        if(Local_pSlot->DLC > 8 || Local_pSlot->WindowBits == 0 ||
+           Local_pSlot->Repeat == 0 || (Local_pSlot->Repeat & (Local_pSlot->Repeat - 1)) != 0 ||
+           Local_pSlot->Repeat > CANTT_MATRIX_CYCLES || Local_pSlot->BaseCycle >= Local_pSlot->Repeat ||
+           (uint32)Local_pSlot->OffsetBits + Local_pSlot->WindowBits > CANTT_CYCLE_BITS)
+        {
+            return N_OK;
+        }
+        if(Local_u8Itr > 0 && Local_pSlot->OffsetBits < pSlots[Local_u8Itr-1].OffsetBits)
+        {
+            return N_OK;
+        }
+        if(CANTT_REF_WINDOWS != 0 && CANTT_u8Overlap(&Local_RefSlot,Local_pSlot))
+        {
+            return N_OK;
+        }
+        for(Local_u8Other=0;Local_u8Other<Local_u8Itr;Local_u8Other++)
+        {
+            if(CANTT_u8Overlap(&pSlots[Local_u8Other],Local_pSlot))
+            {
+                return N_OK;
+            }
+        }
+    }
+    if(MCAN_u8ReserveMailbox(CANTT_MAILBOX) != OK)
+    {
+        return N_OK;
+    }
+
+    CANTT_CyclesPerBit = Local_u32CyclesPerBit;
+    CANTT_CycleCycles = (uint32)CANTT_CYCLE_BITS * Local_u32CyclesPerBit;
+    if(CANTT_REF_WINDOWS != 0)
+    {
+        CANTT_VoidSetWindow(&CANTT_Windows[0],&Local_RefSlot);
+    }
+    for(Local_u8Itr=0;Local_u8Itr<u8Count;Local_u8Itr++)
+    {
+        CANTT_VoidSetWindow(&CANTT_Windows[Local_u8Itr + CANTT_REF_WINDOWS],&pSlots[Local_u8Itr]);
+    }
+    CANTT_WindowCount = (uint8)(u8Count + CANTT_REF_WINDOWS);
+    CANTT_Loaded = CANTT_NONE;
+    CANTT_RefPending = 0;
+    CANTT_RefSeen = 0;
+    CANTT_RefMisses = 0;
+    CANTT_Cycle = 0;
+    CANTT_Next = 0;
+    CANTT_Status.Cycles = 0;
+    CANTT_Status.Sent = 0;
+    CANTT_Status.Missed = 0;
+    CANTT_Status.Aborted = 0;
+    CANTT_Status.RefLost = 0;
+    CANTT_Status.MaxJitterCycles = 0;
+#if CANTT_ROLE == CANTT_ROLE_MASTER
+    /*first reference message at the next timer interrupt*/
+    CANTT_RefCycles = MSYSTICK_u64GetCycles() + CANTT_LOAD_LEAD_CYCLES;
+    CANTT_State = CANTT_STATE_SYNC;
+#else
+    CANTT_State = CANTT_STATE_WAIT_REF;
+#endif
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : void CANTT_VoidStop(void)
+* \Description     : stop the schedule and give the mailbox back to the TX queue
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANTT_VoidStop(void)
+{
+    /*the timer interrupt must not load a window between the state change and the mailbox release*/
+    uint32 Local_u32Irq = MCAN_u32EnterCritical();
+
+    CANTT_State = CANTT_STATE_OFF;
+    MCAN_VoidAbortReservedMailbox();
+    CANTT_Loaded = CANTT_NONE;
+    (void)MCAN_u8ReserveMailbox(CAN_MAILBOX_NONE);
+    MCAN_VoidExitCritical(Local_u32Irq);
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType CANTT_u8Write(uint8 u8Slot,const uint8* pData)
+* \Description     : store the latest value of a slot, sent in its next window
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u8Slot index in the schedule, pData data bytes
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK on an invalid slot
+*******************************************************************************/
+Std_ReturnType CANTT_u8Write(uint8 u8Slot,const uint8* pData)
+{
+    CANTT_Window_t* Local_pWindow;
+    uint8 Local_u8Copy;
+    uint8 Local_u8Itr;
+
+    if((uint16)u8Slot + CANTT_REF_WINDOWS >= CANTT_WindowCount)
+    {
+        return N_OK;
+    }
+    Local_pWindow = &CANTT_Windows[u8Slot + CANTT_REF_WINDOWS];
+    Local_u8Copy = (uint8)(Local_pWindow->Active ^ 1);
+    for(Local_u8Itr=0;Local_u8Itr<Local_pWindow->Frame[Local_u8Copy].DLC;Local_u8Itr++)
+    {
+        Local_pWindow->Frame[Local_u8Copy].Data.Bytes[Local_u8Itr] = pData[Local_u8Itr];
+    }
+    /*one byte store: the timer interrupt sees the old or the new copy, never a mix*/
+    Local_pWindow->Active = Local_u8Copy;
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : void CANTT_VoidReferenceHandler(const CAN_Frame_t* pFrame,void* pContext)
+* \Description     : slave: hand the time stamp and cycle number of the reference message to the timer interrupt
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pFrame received frame, pContext unused
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void CANTT_VoidReferenceHandler(const CAN_Frame_t* pFrame,void* pContext)
+{
+    /*the handler runs on the frame in the RX ring, its stamp is there*/
+    uint64 Local_u64Sof = MCAN_u64RxStamp(pFrame);
+
+    (void)pContext;
+    /*a reference not taken yet is kept: the timer interrupt may be reading it*/
+    if(CANTT_REF_WINDOWS != 0 || CANTT_State == CANTT_STATE_OFF || CANTT_RefPending != 0 ||
+       pFrame->Id != CANTT_REF_ID || pFrame->DLC == 0 || Local_u64Sof == 0)
+    {
+        return;
+    }
+    CANTT_RefPendingCycles = Local_u64Sof;
+    CANTT_RefPendingCycle = pFrame->Data.Bytes[0];
+    CANTT_RefPending = 1;
+}
+
+/******************************************************************************
+* \Syntax          : uint32 CANTT_u32TimerHandler(void)
+* \Description     : schedule, call from the timer interrupt
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint32 HCLK cycles until the next call, 0 when stopped
+*******************************************************************************/
+uint32 CANTT_u32TimerHandler(void)
+{
+    uint64 Local_u64Now = MSYSTICK_u64GetCycles();
+    uint64 Local_u64Wake;
+    uint64 Local_u64Start;
+    CANTT_Window_t* Local_pWindow;
+    CAN_Frame_t Local_Frame;
+
+    if(CANTT_State == CANTT_STATE_OFF)
+    {
+        return 0;
+    }
+    CANTT_VoidTakeReference(Local_u64Now);
+    CANTT_VoidCheckMailbox(Local_u64Now);
+
+    for(;;)
+    {
+        if(CANTT_State != CANTT_STATE_SYNC)
+        {
+            return CANTT_CycleCycles / CANTT_IDLE_DIVIDER;
+        }
+        if(CANTT_Next >= CANTT_WindowCount)
+        {
+            /*end of the basic cycle*/
+            Local_u64Start = CANTT_RefCycles + CANTT_CycleCycles;
+            if(Local_u64Now + CANTT_LOAD_LEAD_CYCLES < Local_u64Start)
+            {
+                break;
+            }
+            CANTT_VoidNextCycle();
+            continue;
+        }
+        Local_pWindow = &CANTT_Windows[CANTT_Next];
+        if(((CANTT_Cycle ^ Local_pWindow->Base) & Local_pWindow->RepeatMask) != 0)
+        {
+            /*not used in this basic cycle*/
+            CANTT_Next++;
+            continue;
+        }
+        Local_u64Start = CANTT_RefCycles + Local_pWindow->StartCycles;
+        if(Local_u64Now + CANTT_LOAD_LEAD_CYCLES < Local_u64Start)
+        {
+            break;
+        }
+        /*the previous frame overran into this window, or the interrupt came too late*/
+        if(CANTT_Loaded != CANTT_NONE || Local_u64Now >= Local_u64Start + Local_pWindow->WindowCycles)
+        {
+            CANTT_Status.Missed++;
+        }
+        else
+        {
+            Local_Frame = Local_pWindow->Frame[Local_pWindow->Active];
+            if(CANTT_REF_WINDOWS != 0 && CANTT_Next == 0)
+            {
+                Local_Frame.Data.Bytes[0] = CANTT_Cycle;
+            }
+            if(MCAN_u8LoadReservedMailbox(&Local_Frame) == OK)
+            {
+                CANTT_Loaded = CANTT_Next;
+                CANTT_LoadedStart = Local_u64Start;
+                CANTT_LoadedEnd = Local_u64Start + Local_pWindow->WindowCycles;
+            }
+            else
+            {
+                CANTT_Status.Missed++;
+            }
+        }
+        CANTT_Next++;
+    }
+
+    /*next window (or cycle end) minus the lead, the end of the loaded window if sooner*/
+    Local_u64Wake = Local_u64Start - CANTT_LOAD_LEAD_CYCLES;
+    if(CANTT_Loaded != CANTT_NONE)
+    {
+        if(CANTT_LoadedEnd > Local_u64Now)
+        {
+            if(CANTT_LoadedEnd < Local_u64Wake)
+            {
+                Local_u64Wake = CANTT_LoadedEnd;
+            }
+        }
+        else if(Local_u64Now + (uint32)CANTT_POLL_BITS * CANTT_CyclesPerBit < Local_u64Wake)
+        {
+            /*still on the bus after its window*/
+            Local_u64Wake = Local_u64Now + (uint32)CANTT_POLL_BITS * CANTT_CyclesPerBit;
+        }
+        else{}
+    }
+    return (uint32)(Local_u64Wake - Local_u64Now);
+}
+
+/******************************************************************************
+* \Syntax          : void CANTT_VoidGetStatus(CANTT_Status_t* pStatus)
+* \Description     : read the state and the counters of the schedule
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): pStatus state and counters
+* \Return value:   : None
+*******************************************************************************/
+void CANTT_VoidGetStatus(CANTT_Status_t* pStatus)
+{
+    *pStatus = CANTT_Status;
+    pStatus->State = CANTT_State;
+}
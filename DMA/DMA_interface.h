@@ -185,4 +185,24 @@ void MDMA_VoidDisableInterrupt(uint8 channelNumber);
 void MDMA_VoidPollOnTransmission(uint8 channelNumber) ;
 
 
+/******************************************************************************
+* @brief           : start a new transfer on a channel set up by MDMA_VoidChannelInit, keeping its configuration
+* @param           :  channelNumber  channel 0-6 to restart.
+* @param           :  pMemory  memory address of the new transfer.
+* @param           :  u16Count  number of data to transfer, 1-65535.
+* @retval          : void
+*******************************************************************************/
+void MDMA_VoidReloadChannel(uint8 channelNumber,const void* pMemory,uint16 u16Count);
+/******************************************************************************
+* @brief           : read how many data the running transfer still has to move (CNDTR)
+* @param           :  channelNumber  channel 0-6.
+* @retval          : uint16 remaining data, counts down to 0 then reloads in circular mode
+*******************************************************************************/
+uint16 MDMA_u16GetRemaining(uint8 channelNumber);
+/******************************************************************************
+* @brief           : clear the pending flags of a channel (complete, half, error) before enabling its interrupts
+* @param           :  channelNumber  channel 0-6.
+* @retval          : void
+*******************************************************************************/
+void MDMA_VoidClearFlags(uint8 channelNumber);
 #endif
@@ -79,10 +79,10 @@ void MDMA_VoidChannelInit(const DMA_InitTypeDef* pInitConfig)
     else{}
     
     /*set the peripheral address(initial address in case of pointer increament)*/
-    DMA->CHx[Local_u8ChannelNummber].CPARx = (uint32)pInitConfig->DMA_Peripheral_address;
+    DMA->CHx[Local_u8ChannelNummber].CPARx = (uint32)(uintptr_t)pInitConfig->DMA_Peripheral_address;
     
     /*set the memory address(initial address in case of pointer increament)*/
-    DMA->CHx[Local_u8ChannelNummber].CMARx = (uint32)pInitConfig->DMA_Memory_address;
+    DMA->CHx[Local_u8ChannelNummber].CMARx = (uint32)(uintptr_t)pInitConfig->DMA_Memory_address;
 
     /*set number of transactions*/
     DMA->CHx[Local_u8ChannelNummber].CNDTRx.B.NDT = pInitConfig->DMA_Data_Number;
@@ -379,4 +379,41 @@ void DMA1_Channel7_IRQHandler(void)
 void MDMA_VoidDisableChannel(uint8 channel_Number)
 {
     DMA->CHx[channel_Number].CCRx.B.EN=0;
-}
\ No newline at end of file
+}
+
+/******************************************************************************
+* @brief           : start a new transfer on a channel set up by MDMA_VoidChannelInit, keeping its configuration
+* @param           :  channelNumber  channel 0-6 to restart.
+* @param           :  pMemory  memory address of the new transfer.
+* @param           :  u16Count  number of data to transfer, 1-65535.
+* @retval          : void
+*******************************************************************************/
+void MDMA_VoidReloadChannel(uint8 channelNumber,const void* pMemory,uint16 u16Count)
+{
+    /*CMAR and CNDTR are only writable while the channel is disabled*/
+    DMA->CHx[channelNumber].CCRx.B.EN=DMA_DISABLE;
+    DMA->CHx[channelNumber].CMARx = (uint32)(uintptr_t)pMemory;
+    DMA->CHx[channelNumber].CNDTRx.r = u16Count;
+    DMA->CHx[channelNumber].CCRx.B.EN=DMA_ENABLE;
+}
+
+/******************************************************************************
+* @brief           : read how many data the running transfer still has to move (CNDTR)
+* @param           :  channelNumber  channel 0-6.
+* @retval          : uint16 remaining data, counts down to 0 then reloads in circular mode
+*******************************************************************************/
+uint16 MDMA_u16GetRemaining(uint8 channelNumber)
+{
+    return (uint16)DMA->CHx[channelNumber].CNDTRx.B.NDT;
+}
+
+/******************************************************************************
+* @brief           : clear the pending flags of a channel (complete, half, error) before enabling its interrupts
+* @param           :  channelNumber  channel 0-6.
+* @retval          : void
+*******************************************************************************/
+void MDMA_VoidClearFlags(uint8 channelNumber)
+{
+    /*CGIFx clears the three flags of the channel at once*/
+    DMA->IFCR = (uint32)1 << (4*channelNumber);
+}
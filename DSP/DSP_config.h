@@ -0,0 +1,24 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  DSP_config.h
+ *  module:  DSP Module
+ *  @details:  Configuration header file for DSP Module
+*********************************************************************************************************************/
+#ifndef _DSP_CONFIG_H
+#define _DSP_CONFIG_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*ADC resolution of the samples fed to the filters (right aligned)*/
+#define DSP_ADC_RESOLUTION_BITS         12
+/*raw count that maps to 0 in fixed point*/
+#define DSP_ADC_MIDSCALE                (1 << (DSP_ADC_RESOLUTION_BITS - 1))
+
+#endif
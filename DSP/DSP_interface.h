@@ -0,0 +1,191 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  DSP_interface.h
+ *  module:  DSP Module
+ *  @details:  interface header file for fixed-point DSP (FIR / biquad IIR / FFT) on ADC sample streams
+*********************************************************************************************************************/
+#ifndef _DSP_INTERFACE_H
+#define _DSP_INTERFACE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+#include "../../LIB/Std_Types.h"
+#include "../../LIB/Bit_Math.h"
+
+#include "DSP_config.h"
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/** @defgroup ADC_Conversion_Macros convert raw right-aligned ADC counts to signed fixed point around mid-scale */
+#define DSP_ADC_TO_Q15(RAW)         ((sint16)(((sint32)(RAW) - DSP_ADC_MIDSCALE) << (15 - DSP_ADC_RESOLUTION_BITS + 1)))
+#define DSP_ADC_TO_Q31(RAW)         ((sint32)(((sint32)(RAW) - DSP_ADC_MIDSCALE) << (31 - DSP_ADC_RESOLUTION_BITS + 1)))
+
+/** @defgroup FIR_State_Size number of state words the caller must provide for a FIR instance */
+#define DSP_FIR_STATE_SIZE(NUM_TAPS, MAX_BLOCK)     ((NUM_TAPS) + (MAX_BLOCK) - 1)
+
+/** @defgroup Biquad_Sizes coefficient / state words per biquad stage */
+#define DSP_BIQUAD_COEFFS_PER_STAGE     (5)
+#define DSP_BIQUAD_STATE_PER_STAGE      (4)
+
+/** @defgroup FFT_Sizes supported FFT sizes (powers of two) */
+#define DSP_FFT_MIN_SIZE                (64)
+#define DSP_FFT_MAX_SIZE                (1024)
+
+/** @defgroup Window_t window applied while loading samples */
+#define DSP_WINDOW_NONE                 (0x0)/*!< rectangular  */
+#define DSP_WINDOW_HANN                 (0x1)/*!< Hann  */
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL DATA TYPES AND STRUCTURES
+---------------------------------------------------------------------------------------------------------------------*/
+/**
+  * @brief  Q15 FIR filter instance.
+  *         State persists between blocks so an ADC DMA stream can be processed half-buffer by half-buffer.
+  */
+typedef struct
+{
+    uint16 NumTaps;                     /*!< Specifies the number of filter taps */
+    uint16 MaxBlockSize;                /*!< Specifies the largest block processed in one pass,
+                                             longer blocks are split internally */
+    const sint16* pCoeffs;              /*!< Specifies the Q15 coefficients b[0] .. b[NumTaps-1] in natural order */
+    sint16* pState;                     /*!< Specifies the state buffer of @ref DSP_FIR_STATE_SIZE words */
+} DSP_FirQ15_t;
+
+/**
+  * @brief  Cascaded biquad (direct form I) instance with Q31 coefficients and state.
+  *         per stage: y = b0*x + b1*x1 + b2*x2 + a1*y1 + a2*y2
+  *         a1 and a2 are the negated denominator coefficients.
+  */
+typedef struct
+{
+    uint8 NumStages;                    /*!< Specifies the number of second order sections */
+    uint8 PostShift;                    /*!< Specifies the coefficient scaling: coefficients are stored as
+                                             real value * 2^(31-PostShift), allows |coeff| < 2^PostShift */
+    const sint32* pCoeffs;              /*!< Specifies {b0,b1,b2,a1,a2} per stage */
+    sint32* pState;                     /*!< Specifies {x1,x2,y1,y2} per stage */
+} DSP_BiquadQ31_t;
+
+/**
+  * @brief  Spectral features extracted from a magnitude spectrum, small enough to be sent instead of raw samples.
+  */
+typedef struct
+{
+    uint16 PeakBin;                     /*!< index of the strongest bin (DC excluded) */
+    uint16 PeakMagnitude;               /*!< magnitude of the strongest bin */
+    uint16 CentroidBinQ8;               /*!< magnitude weighted mean bin index in Q8 (bin * 256) */
+    uint16 RmsMagnitude;                /*!< root mean square of the bin magnitudes (DC excluded) */
+} DSP_SpectralFeatures_t;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* @brief           : initialize Q15 FIR instance and clear its state
+* @param (in)      : pFir instance to initialize @ref DSP_FirQ15_t
+* @param (in)      : u16NumTaps number of taps
+* @param (in)      : pCoeffs Q15 coefficients
+* @param (in)      : pState state buffer of DSP_FIR_STATE_SIZE(u16NumTaps,u16MaxBlockSize) words
+* @param (in)      : u16MaxBlockSize largest block processed in one pass
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidFirQ15Init(DSP_FirQ15_t* pFir,uint16 u16NumTaps,const sint16* pCoeffs,sint16* pState,uint16 u16MaxBlockSize);
+
+/******************************************************************************
+* @brief           : run Q15 FIR filter on a block of Q15 samples
+* @param (in)      : pFir filter instance
+* @param (in)      : pIn input block
+* @param (out)     : pOut output block (may not alias pIn)
+* @param (in)      : u16Count number of samples
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidFirQ15(DSP_FirQ15_t* pFir,const sint16* pIn,sint16* pOut,uint16 u16Count);
+
+/******************************************************************************
+* @brief           : run Q15 FIR filter directly on raw ADC counts (e.g. one DMA half-buffer)
+* @param (in)      : pFir filter instance
+* @param (in)      : pAdc raw right-aligned ADC samples
+* @param (out)     : pOut Q15 output block
+* @param (in)      : u16Count number of samples
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidFirQ15Adc(DSP_FirQ15_t* pFir,const uint16* pAdc,sint16* pOut,uint16 u16Count);
+
+/******************************************************************************
+* @brief           : initialize biquad cascade instance and clear its state
+* @param (in)      : pBiquad instance to initialize @ref DSP_BiquadQ31_t
+* @param (in)      : u8NumStages number of second order sections
+* @param (in)      : pCoeffs {b0,b1,b2,a1,a2} per stage
+* @param (in)      : pState buffer of 4 words per stage
+* @param (in)      : u8PostShift coefficient scaling shift (0 when all |coeff| < 1)
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidBiquadQ31Init(DSP_BiquadQ31_t* pBiquad,uint8 u8NumStages,const sint32* pCoeffs,sint32* pState,uint8 u8PostShift);
+
+/******************************************************************************
+* @brief           : run biquad cascade on a block of Q31 samples
+* @param (in)      : pBiquad filter instance
+* @param (in)      : pIn input block
+* @param (out)     : pOut output block (may alias pIn)
+* @param (in)      : u16Count number of samples
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidBiquadQ31(DSP_BiquadQ31_t* pBiquad,const sint32* pIn,sint32* pOut,uint16 u16Count);
+
+/******************************************************************************
+* @brief           : run biquad cascade directly on raw ADC counts, result in Q15
+* @param (in)      : pBiquad filter instance
+* @param (in)      : pAdc raw right-aligned ADC samples
+* @param (out)     : pOut Q15 output block
+* @param (in)      : u16Count number of samples
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidBiquadQ31Adc(DSP_BiquadQ31_t* pBiquad,const uint16* pAdc,sint16* pOut,uint16 u16Count);
+
+/******************************************************************************
+* @brief           : copy a frame from an ADC circular (DMA) buffer into an FFT buffer,
+*                    removing the DC component and optionally applying a window
+* @param (in)      : pRing raw ADC circular buffer
+* @param (in)      : u16RingSize number of samples in the circular buffer
+* @param (in)      : u16Start index of the oldest sample of the frame (wraps around the ring end)
+* @param (out)     : pData complex interleaved {re,im} Q15 buffer of 2*u16Size words
+* @param (in)      : u16Size FFT size
+* @param (in)      : u8Window window type @ref Window_t
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidFftLoadAdc(const uint16* pRing,uint16 u16RingSize,uint16 u16Start,sint16* pData,uint16 u16Size,uint8 u8Window);
+
+/******************************************************************************
+* @brief           : in-place complex Q15 FFT (radix-4 passes, one radix-2 pass when log2(size) is odd)
+*                    output is in natural order and scaled by 1/u16Size
+* @param (in/out)  : pData complex interleaved {re,im} Q15 buffer of 2*u16Size words
+* @param (in)      : u16Size FFT size, power of two from DSP_FFT_MIN_SIZE to DSP_FFT_MAX_SIZE
+* @retval          : Std_ReturnType N_OK when the size is not supported
+*******************************************************************************/
+Std_ReturnType DSP_u8FftQ15(sint16* pData,uint16 u16Size);
+
+/******************************************************************************
+* @brief           : compute the magnitude of the first u16Bins complex bins
+* @param (in)      : pData complex interleaved {re,im} Q15 FFT output
+* @param (out)     : pMag magnitude per bin
+* @param (in)      : u16Bins number of bins (u16Size/2 for real input)
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidFftMagnitude(const sint16* pData,uint16* pMag,uint16 u16Bins);
+
+/******************************************************************************
+* @brief           : extract the peak bin and summary features from a magnitude spectrum
+* @param (in)      : pMag magnitude per bin
+* @param (in)      : u16Bins number of bins
+* @param (out)     : pFeatures extracted features @ref DSP_SpectralFeatures_t
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidSpectralFeatures(const uint16* pMag,uint16 u16Bins,DSP_SpectralFeatures_t* pFeatures);
+
+#endif
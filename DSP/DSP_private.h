@@ -0,0 +1,28 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  DSP_private.h
+ *  module:  DSP Module
+ *  @details:  private header file for DSP Module
+*********************************************************************************************************************/
+#ifndef _DSP_PRIVATE_H
+#define _DSP_PRIVATE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/** @brief saturate a wide accumulator to the Q15 / Q31 range */
+#define DSP_SAT_Q15(X)      ((sint16)(((X) > 32767) ? 32767 : (((X) < -32768) ? -32768 : (X))))
+#define DSP_SAT_Q31(X)      ((sint32)(((X) > (sint64)0x7FFFFFFF) ? (sint64)0x7FFFFFFF : \
+                                      (((X) < -(sint64)0x80000000) ? -(sint64)0x80000000 : (X))))
+
+/** @brief resolution of the flash sine table (full circle), quarter wave is stored */
+#define DSP_SINE_TABLE_POINTS       (1024)
+#define DSP_SINE_QUARTER            (DSP_SINE_TABLE_POINTS / 4)
+
+#endif
@@ -0,0 +1,632 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  DSP_program.c
+ *  module:  DSP Module
+ *  @details:  program file for fixed-point DSP Module
+*********************************************************************************************************************/
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+
+#include "../../LIB/Std_Types.h"
+#include "../../LIB/Bit_Math.h"
+
+#include "DSP_config.h"
+#include "DSP_private.h"
+#include "DSP_interface.h"
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA
+---------------------------------------------------------------------------------------------------------------------*/
+/*Q15 quarter wave sin(2*pi*i/1024), i = 0..256; const so it is placed in flash.
+*every FFT twiddle and the Hann window up to 1024 points are derived from it by symmetry*/
+static const sint16 DSP_SineQ15Table[DSP_SINE_QUARTER + 1] =
+{
+        0,   201,   402,   603,   804,  1005,  1206,  1407,  1608,  1809,  2009,  2210,
+     2411,  2611,  2811,  3012,  3212,  3412,  3612,  3812,  4011,  4211,  4410,  4609,
+     4808,  5007,  5205,  5404,  5602,  5800,  5998,  6195,  6393,  6590,  6787,  6983,
+     7180,  7376,  7571,  7767,  7962,  8157,  8351,  8546,  8740,  8933,  9127,  9319,
+     9512,  9704,  9896, 10088, 10279, 10469, 10660, 10850, 11039, 11228, 11417, 11605,
+    11793, 11980, 12167, 12354, 12540, 12725, 12910, 13095, 13279, 13463, 13646, 13828,
+    14010, 14192, 14373, 14553, 14733, 14912, 15091, 15269, 15447, 15624, 15800, 15976,
+    16151, 16326, 16500, 16673, 16846, 17018, 17190, 17361, 17531, 17700, 17869, 18037,
+    18205, 18372, 18538, 18703, 18868, 19032, 19195, 19358, 19520, 19681, 19841, 20001,
+    20160, 20318, 20475, 20632, 20788, 20943, 21097, 21251, 21403, 21555, 21706, 21856,
+    22006, 22154, 22302, 22449, 22595, 22740, 22884, 23028, 23170, 23312, 23453, 23593,
+    23732, 23870, 24008, 24144, 24279, 24414, 24548, 24680, 24812, 24943, 25073, 25202,
+    25330, 25457, 25583, 25708, 25833, 25956, 26078, 26199, 26320, 26439, 26557, 26674,
+    26791, 26906, 27020, 27133, 27246, 27357, 27467, 27576, 27684, 27791, 27897, 28002,
+    28106, 28209, 28311, 28411, 28511, 28610, 28707, 28803, 28899, 28993, 29086, 29178,
+    29269, 29359, 29448, 29535, 29622, 29707, 29792, 29875, 29957, 30038, 30118, 30196,
+    30274, 30350, 30425, 30499, 30572, 30644, 30715, 30784, 30853, 30920, 30986, 31050,
+    31114, 31177, 31238, 31298, 31357, 31415, 31471, 31527, 31581, 31634, 31686, 31737,
+    31786, 31834, 31881, 31927, 31972, 32015, 32058, 32099, 32138, 32177, 32214, 32251,
+    32286, 32319, 32352, 32383, 32413, 32442, 32470, 32496, 32522, 32546, 32568, 32590,
+    32610, 32629, 32647, 32664, 32679, 32693, 32706, 32718, 32729, 32738, 32746, 32753,
+    32758, 32762, 32766, 32767, 32767
+};
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* @brief           : filter u16Count samples already placed after the history in the state buffer,
+*                    then shift the newest NumTaps-1 samples down as history for the next block
+* @param (in)      : pFir filter instance
+* @param (out)     : pOut Q15 output block
+* @param (in)      : u16Count number of new samples (<= MaxBlockSize)
+* @retval          : void
+*******************************************************************************/
+static void DSP_VoidFirQ15Core(DSP_FirQ15_t* pFir,sint16* pOut,uint16 u16Count)
+{
+    const sint16* Local_pLastCoeff = &pFir->pCoeffs[pFir->NumTaps-1];
+    sint16* Local_pState = pFir->pState;
+    uint16 Local_u16Out;
+    uint16 Local_u16Tap;
+
+    for(Local_u16Out=0;Local_u16Out<u16Count;Local_u16Out++)
+    {
+        /*x[n-k] = state[n + NumTaps-1 - k] so walk the samples forward and the coefficients backward*/
+        const sint16* Local_pX = &Local_pState[Local_u16Out];
+        const sint16* Local_pB = Local_pLastCoeff;
+        /*64-bit accumulation of 16x16 products maps to SMLAL and can not overflow*/
+        sint64 Local_s64Acc = 0;
+
+        /*inner loop unrolled by 4 taps*/
+        Local_u16Tap = pFir->NumTaps >> 2;
+        while(Local_u16Tap > 0)
+        {
+            Local_s64Acc += (sint64)Local_pB[0]  * Local_pX[0];
+            Local_s64Acc += (sint64)Local_pB[-1] * Local_pX[1];
+            Local_s64Acc += (sint64)Local_pB[-2] * Local_pX[2];
+            Local_s64Acc += (sint64)Local_pB[-3] * Local_pX[3];
+            Local_pB -= 4;
+            Local_pX += 4;
+            Local_u16Tap--;
+        }
+        /*remaining taps*/
+        Local_u16Tap = pFir->NumTaps & 0x3;
+        while(Local_u16Tap > 0)
+        {
+            Local_s64Acc += (sint64)(*Local_pB--) * (*Local_pX++);
+            Local_u16Tap--;
+        }
+
+        /*Q30 -> Q15 with rounding*/
+        Local_s64Acc = (Local_s64Acc + (1 << 14)) >> 15;
+        pOut[Local_u16Out] = DSP_SAT_Q15(Local_s64Acc);
+    }
+
+    /*keep the last NumTaps-1 samples as history for the next block*/
+    for(Local_u16Tap=0;Local_u16Tap<(pFir->NumTaps-1);Local_u16Tap++)
+    {
+        Local_pState[Local_u16Tap] = Local_pState[Local_u16Tap + u16Count];
+    }
+}
+
+/******************************************************************************
+* @brief           : sin(2*pi*u16Index/1024) in Q15 from the quarter wave table
+* @param (in)      : u16Index angle index, 0 .. 1023
+* @retval          : sint16 Q15 sine
+*******************************************************************************/
+static sint16 DSP_s16Sin(uint16 u16Index)
+{
+    uint16 Local_u16Rem = u16Index & (DSP_SINE_QUARTER - 1);
+    sint16 Local_s16Val;
+    switch((u16Index >> 8) & 0x3)
+    {
+    case 0:
+        Local_s16Val = DSP_SineQ15Table[Local_u16Rem];
+        break;
+    case 1:
+        Local_s16Val = DSP_SineQ15Table[DSP_SINE_QUARTER - Local_u16Rem];
+        break;
+    case 2:
+        Local_s16Val = -DSP_SineQ15Table[Local_u16Rem];
+        break;
+    default:
+        Local_s16Val = -DSP_SineQ15Table[DSP_SINE_QUARTER - Local_u16Rem];
+        break;
+    }
+    return Local_s16Val;
+}
+
+/******************************************************************************
+* @brief           : cos(2*pi*u16Index/1024) in Q15 from the quarter wave table
+* @param (in)      : u16Index angle index, 0 .. 1023
+* @retval          : sint16 Q15 cosine
+*******************************************************************************/
+static sint16 DSP_s16Cos(uint16 u16Index)
+{
+    return DSP_s16Sin((u16Index + DSP_SINE_QUARTER) & (DSP_SINE_TABLE_POINTS - 1));
+}
+
+/******************************************************************************
+* @brief           : integer square root (bitwise, no division)
+* @param (in)      : u32Value value
+* @retval          : uint32 floor(sqrt(u32Value))
+*******************************************************************************/
+static uint32 DSP_u32Sqrt(uint32 u32Value)
+{
+    uint32 Local_u32Root = 0;
+    uint32 Local_u32Bit = (uint32)1 << 30;
+    while(Local_u32Bit > u32Value)
+    {
+        Local_u32Bit >>= 2;
+    }
+    while(Local_u32Bit != 0)
+    {
+        if(u32Value >= Local_u32Root + Local_u32Bit)
+        {
+            u32Value -= Local_u32Root + Local_u32Bit;
+            Local_u32Root = (Local_u32Root >> 1) + Local_u32Bit;
+        }
+        else
+        {
+            Local_u32Root >>= 1;
+        }
+        Local_u32Bit >>= 2;
+    }
+    return Local_u32Root;
+}
+
+/******************************************************************************
+* @brief           : multiply complex (re,im) by the twiddle exp(-j*2*pi*u16Index/1024) and store as Q15
+* @param (out)     : pOut destination {re,im}
+* @param (in)      : s32Re real part
+* @param (in)      : s32Im imaginary part
+* @param (in)      : u16Index twiddle index in the 1024 point table
+* @retval          : void
+*******************************************************************************/
+static void DSP_VoidTwiddleStore(sint16* pOut,sint32 s32Re,sint32 s32Im,uint16 u16Index)
+{
+    sint32 Local_s32Cos = DSP_s16Cos(u16Index);
+    sint32 Local_s32Sin = DSP_s16Sin(u16Index);
+    sint32 Local_s32Re = (s32Re * Local_s32Cos + s32Im * Local_s32Sin) >> 15;
+    sint32 Local_s32Im = (s32Im * Local_s32Cos - s32Re * Local_s32Sin) >> 15;
+    pOut[0] = DSP_SAT_Q15(Local_s32Re);
+    pOut[1] = DSP_SAT_Q15(Local_s32Im);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* @brief           : initialize Q15 FIR instance and clear its state
+* @param (in)      : pFir instance to initialize @ref DSP_FirQ15_t
+* @param (in)      : u16NumTaps number of taps
+* @param (in)      : pCoeffs Q15 coefficients
+* @param (in)      : pState state buffer of DSP_FIR_STATE_SIZE(u16NumTaps,u16MaxBlockSize) words
+* @param (in)      : u16MaxBlockSize largest block processed in one pass
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidFirQ15Init(DSP_FirQ15_t* pFir,uint16 u16NumTaps,const sint16* pCoeffs,sint16* pState,uint16 u16MaxBlockSize)
+{
+    uint16 Local_u16Itr;
+    pFir->NumTaps = u16NumTaps;
+    pFir->MaxBlockSize = u16MaxBlockSize;
+    pFir->pCoeffs = pCoeffs;
+    pFir->pState = pState;
+    /*zero history*/
+    for(Local_u16Itr=0;Local_u16Itr<DSP_FIR_STATE_SIZE(u16NumTaps,u16MaxBlockSize);Local_u16Itr++)
+    {
+        pState[Local_u16Itr] = 0;
+    }
+}
+
+/******************************************************************************
+* @brief           : run Q15 FIR filter on a block of Q15 samples
+* @param (in)      : pFir filter instance
+* @param (in)      : pIn input block
+* @param (out)     : pOut output block (may not alias pIn)
+* @param (in)      : u16Count number of samples
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidFirQ15(DSP_FirQ15_t* pFir,const sint16* pIn,sint16* pOut,uint16 u16Count)
+{
+    sint16* Local_pNew = &pFir->pState[pFir->NumTaps-1];
+    while(u16Count > 0)
+    {
+        uint16 Local_u16Block = (u16Count > pFir->MaxBlockSize) ? pFir->MaxBlockSize : u16Count;
+        uint16 Local_u16Itr;
+        /*append the new samples after the history*/
+        for(Local_u16Itr=0;Local_u16Itr<Local_u16Block;Local_u16Itr++)
+        {
+            Local_pNew[Local_u16Itr] = pIn[Local_u16Itr];
+        }
+        DSP_VoidFirQ15Core(pFir,pOut,Local_u16Block);
+        pIn += Local_u16Block;
+        pOut += Local_u16Block;
+        u16Count -= Local_u16Block;
+    }
+}
+
+/******************************************************************************
+* @brief           : run Q15 FIR filter directly on raw ADC counts (e.g. one DMA half-buffer)
+* @param (in)      : pFir filter instance
+* @param (in)      : pAdc raw right-aligned ADC samples
+* @param (out)     : pOut Q15 output block
+* @param (in)      : u16Count number of samples
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidFirQ15Adc(DSP_FirQ15_t* pFir,const uint16* pAdc,sint16* pOut,uint16 u16Count)
+{
+    sint16* Local_pNew = &pFir->pState[pFir->NumTaps-1];
+    while(u16Count > 0)
+    {
+        uint16 Local_u16Block = (u16Count > pFir->MaxBlockSize) ? pFir->MaxBlockSize : u16Count;
+        uint16 Local_u16Itr;
+        /*the conversion to Q15 is done while appending to the state, no extra buffer is needed*/
+        for(Local_u16Itr=0;Local_u16Itr<Local_u16Block;Local_u16Itr++)
+        {
+            Local_pNew[Local_u16Itr] = DSP_ADC_TO_Q15(pAdc[Local_u16Itr]);
+        }
+        DSP_VoidFirQ15Core(pFir,pOut,Local_u16Block);
+        pAdc += Local_u16Block;
+        pOut += Local_u16Block;
+        u16Count -= Local_u16Block;
+    }
+}
+
+/******************************************************************************
+* @brief           : initialize biquad cascade instance and clear its state
+* @param (in)      : pBiquad instance to initialize @ref DSP_BiquadQ31_t
+* @param (in)      : u8NumStages number of second order sections
+* @param (in)      : pCoeffs {b0,b1,b2,a1,a2} per stage
+* @param (in)      : pState buffer of 4 words per stage
+* @param (in)      : u8PostShift coefficient scaling shift (0 when all |coeff| < 1)
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidBiquadQ31Init(DSP_BiquadQ31_t* pBiquad,uint8 u8NumStages,const sint32* pCoeffs,sint32* pState,uint8 u8PostShift)
+{
+    uint16 Local_u16Itr;
+    pBiquad->NumStages = u8NumStages;
+    pBiquad->PostShift = u8PostShift;
+    pBiquad->pCoeffs = pCoeffs;
+    pBiquad->pState = pState;
+    for(Local_u16Itr=0;Local_u16Itr<(u8NumStages*DSP_BIQUAD_STATE_PER_STAGE);Local_u16Itr++)
+    {
+        pState[Local_u16Itr] = 0;
+    }
+}
+
+/******************************************************************************
+* @brief           : run biquad cascade on a block of Q31 samples
+* @param (in)      : pBiquad filter instance
+* @param (in)      : pIn input block
+* @param (out)     : pOut output block (may alias pIn)
+* @param (in)      : u16Count number of samples
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidBiquadQ31(DSP_BiquadQ31_t* pBiquad,const sint32* pIn,sint32* pOut,uint16 u16Count)
+{
+    const sint32* Local_pCoeff = pBiquad->pCoeffs;
+    sint32* Local_pState = pBiquad->pState;
+    uint8 Local_u8Shift = 31 - pBiquad->PostShift;
+    uint8 Local_u8Stage;
+
+    /*stage outer loop: coefficients and state stay in registers for the whole block,
+    *the first stage reads pIn and every following stage works in place on pOut*/
+    for(Local_u8Stage=0;Local_u8Stage<pBiquad->NumStages;Local_u8Stage++)
+    {
+        sint32 b0 = Local_pCoeff[0], b1 = Local_pCoeff[1], b2 = Local_pCoeff[2];
+        sint32 a1 = Local_pCoeff[3], a2 = Local_pCoeff[4];
+        sint32 x1 = Local_pState[0], x2 = Local_pState[1];
+        sint32 y1 = Local_pState[2], y2 = Local_pState[3];
+        uint16 Local_u16Itr;
+
+        for(Local_u16Itr=0;Local_u16Itr<u16Count;Local_u16Itr++)
+        {
+            sint32 x0 = pIn[Local_u16Itr];
+            sint64 Local_s64Acc;
+            sint32 y0;
+            Local_s64Acc  = (sint64)b0 * x0;
+            Local_s64Acc += (sint64)b1 * x1;
+            Local_s64Acc += (sint64)b2 * x2;
+            Local_s64Acc += (sint64)a1 * y1;
+            Local_s64Acc += (sint64)a2 * y2;
+            Local_s64Acc >>= Local_u8Shift;
+            y0 = DSP_SAT_Q31(Local_s64Acc);
+            x2 = x1; x1 = x0;
+            y2 = y1; y1 = y0;
+            pOut[Local_u16Itr] = y0;
+        }
+
+        /*save the stage state for the next block*/
+        Local_pState[0] = x1; Local_pState[1] = x2;
+        Local_pState[2] = y1; Local_pState[3] = y2;
+
+        Local_pCoeff += DSP_BIQUAD_COEFFS_PER_STAGE;
+        Local_pState += DSP_BIQUAD_STATE_PER_STAGE;
+        pIn = pOut;
+    }
+}
+
+/******************************************************************************
+* @brief           : run biquad cascade directly on raw ADC counts, result in Q15
+* @param (in)      : pBiquad filter instance
+* @param (in)      : pAdc raw right-aligned ADC samples
+* @param (out)     : pOut Q15 output block
+* @param (in)      : u16Count number of samples
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidBiquadQ31Adc(DSP_BiquadQ31_t* pBiquad,const uint16* pAdc,sint16* pOut,uint16 u16Count)
+{
+    uint8 Local_u8Shift = 31 - pBiquad->PostShift;
+    uint16 Local_u16Itr;
+
+    /*sample outer loop: the Q31 intermediate never leaves registers so no scratch buffer is needed*/
+    for(Local_u16Itr=0;Local_u16Itr<u16Count;Local_u16Itr++)
+    {
+        const sint32* Local_pCoeff = pBiquad->pCoeffs;
+        sint32* Local_pState = pBiquad->pState;
+        sint32 Local_s32X = DSP_ADC_TO_Q31(pAdc[Local_u16Itr]);
+        sint64 Local_s64Out;
+        uint8 Local_u8Stage;
+
+        for(Local_u8Stage=0;Local_u8Stage<pBiquad->NumStages;Local_u8Stage++)
+        {
+            sint64 Local_s64Acc;
+            sint32 y0;
+            Local_s64Acc  = (sint64)Local_pCoeff[0] * Local_s32X;
+            Local_s64Acc += (sint64)Local_pCoeff[1] * Local_pState[0];
+            Local_s64Acc += (sint64)Local_pCoeff[2] * Local_pState[1];
+            Local_s64Acc += (sint64)Local_pCoeff[3] * Local_pState[2];
+            Local_s64Acc += (sint64)Local_pCoeff[4] * Local_pState[3];
+            Local_s64Acc >>= Local_u8Shift;
+            y0 = DSP_SAT_Q31(Local_s64Acc);
+            Local_pState[1] = Local_pState[0]; Local_pState[0] = Local_s32X;
+            Local_pState[3] = Local_pState[2]; Local_pState[2] = y0;
+            Local_s32X = y0;
+            Local_pCoeff += DSP_BIQUAD_COEFFS_PER_STAGE;
+            Local_pState += DSP_BIQUAD_STATE_PER_STAGE;
+        }
+
+        /*Q31 -> Q15 with rounding*/
+        Local_s64Out = ((sint64)Local_s32X + (1 << 15)) >> 16;
+        pOut[Local_u16Itr] = DSP_SAT_Q15(Local_s64Out);
+    }
+}
+
+/******************************************************************************
+* @brief           : copy a frame from an ADC circular (DMA) buffer into an FFT buffer,
+*                    removing the DC component and optionally applying a window
+* @param (in)      : pRing raw ADC circular buffer
+* @param (in)      : u16RingSize number of samples in the circular buffer
+* @param (in)      : u16Start index of the oldest sample of the frame (wraps around the ring end)
+* @param (out)     : pData complex interleaved {re,im} Q15 buffer of 2*u16Size words
+* @param (in)      : u16Size FFT size
+* @param (in)      : u8Window window type @ref Window_t
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidFftLoadAdc(const uint16* pRing,uint16 u16RingSize,uint16 u16Start,sint16* pData,uint16 u16Size,uint8 u8Window)
+{
+    uint32 Local_u32Sum = 0;
+    uint16 Local_u16Mean;
+    uint16 Local_u16Step = DSP_SINE_TABLE_POINTS / u16Size;
+    uint16 Local_u16Idx = u16Start;
+    uint16 Local_u16Itr;
+
+    /*first pass: DC estimate*/
+    for(Local_u16Itr=0;Local_u16Itr<u16Size;Local_u16Itr++)
+    {
+        Local_u32Sum += pRing[Local_u16Idx];
+        Local_u16Idx++;
+        if(Local_u16Idx >= u16RingSize)
+        {
+            Local_u16Idx = 0;
+        }
+    }
+    /*size is a power of two: the mean is a shift*/
+    Local_u16Itr = u16Size;
+    while(Local_u16Itr > 1)
+    {
+        Local_u32Sum >>= 1;
+        Local_u16Itr >>= 1;
+    }
+    Local_u16Mean = (uint16)Local_u32Sum;
+
+    /*second pass: remove DC, scale to Q15, window*/
+    Local_u16Idx = u16Start;
+    for(Local_u16Itr=0;Local_u16Itr<u16Size;Local_u16Itr++)
+    {
+        sint32 Local_s32Sample = ((sint32)pRing[Local_u16Idx] - Local_u16Mean) << (15 - DSP_ADC_RESOLUTION_BITS + 1);
+        if(u8Window == DSP_WINDOW_HANN)
+        {
+            /*w[n] = 0.5 - 0.5*cos(2*pi*n/N) in Q15*/
+            sint32 Local_s32W = (32768 - (sint32)DSP_s16Cos((uint16)(Local_u16Itr * Local_u16Step) & (DSP_SINE_TABLE_POINTS - 1))) >> 1;
+            Local_s32Sample = (Local_s32Sample * Local_s32W) >> 15;
+        }
+        pData[2*Local_u16Itr]     = DSP_SAT_Q15(Local_s32Sample);
+        pData[2*Local_u16Itr + 1] = 0;
+        Local_u16Idx++;
+        if(Local_u16Idx >= u16RingSize)
+        {
+            Local_u16Idx = 0;
+        }
+    }
+}
+
+/******************************************************************************
+* @brief           : in-place complex Q15 FFT (radix-4 passes, one radix-2 pass when log2(size) is odd)
+*                    output is in natural order and scaled by 1/u16Size
+* @param (in/out)  : pData complex interleaved {re,im} Q15 buffer of 2*u16Size words
+* @param (in)      : u16Size FFT size, power of two from DSP_FFT_MIN_SIZE to DSP_FFT_MAX_SIZE
+* @retval          : Std_ReturnType N_OK when the size is not supported
+*******************************************************************************/
+Std_ReturnType DSP_u8FftQ15(sint16* pData,uint16 u16Size)
+{
+    uint16 Local_u16Group;
+    uint16 Local_u16Itr;
+    uint16 Local_u16Rev;
+
+    if(u16Size < DSP_FFT_MIN_SIZE || u16Size > DSP_FFT_MAX_SIZE || (u16Size & (u16Size - 1)) != 0)
+    {
+        return N_OK;
+    }
+
+    /*decimation in frequency, two radix-2 stages fused into one radix-4 butterfly per pass.
+    *for group size G and quarter Q=G/4 the butterfly on x0..x3 = x[k], x[k+Q], x[k+2Q], x[k+3Q] is:
+    *   x[k]    = x0+x1+x2+x3
+    *   x[k+Q]  = (x0-x1+x2-x3) * W^2k
+    *   x[k+2Q] = (x0-x2 -j(x1-x3)) * W^k
+    *   x[k+3Q] = (x0-x2 +j(x1-x3)) * W^3k        W = exp(-j*2*pi/G)
+    *which keeps the plain bit-reversed output order of radix-2, inputs are scaled by 1/4 per pass*/
+    for(Local_u16Group=u16Size;Local_u16Group>=4;Local_u16Group>>=2)
+    {
+        uint16 Local_u16Quarter = Local_u16Group >> 2;
+        uint16 Local_u16Step = DSP_SINE_TABLE_POINTS / Local_u16Group;
+        uint16 Local_u16Base;
+        for(Local_u16Base=0;Local_u16Base<u16Size;Local_u16Base+=Local_u16Group)
+        {
+            uint16 k;
+            for(k=0;k<Local_u16Quarter;k++)
+            {
+                sint16* p0 = &pData[2*(Local_u16Base + k)];
+                sint16* p1 = p0 + 2*Local_u16Quarter;
+                sint16* p2 = p1 + 2*Local_u16Quarter;
+                sint16* p3 = p2 + 2*Local_u16Quarter;
+                sint32 x0r = p0[0] >> 2, x0i = p0[1] >> 2;
+                sint32 x1r = p1[0] >> 2, x1i = p1[1] >> 2;
+                sint32 x2r = p2[0] >> 2, x2i = p2[1] >> 2;
+                sint32 x3r = p3[0] >> 2, x3i = p3[1] >> 2;
+                sint32 s02r = x0r + x2r, s02i = x0i + x2i;
+                sint32 d02r = x0r - x2r, d02i = x0i - x2i;
+                sint32 s13r = x1r + x3r, s13i = x1i + x3i;
+                sint32 d13r = x1r - x3r, d13i = x1i - x3i;
+                uint16 Local_u16W = k * Local_u16Step;
+
+                p0[0] = (sint16)(s02r + s13r);
+                p0[1] = (sint16)(s02i + s13i);
+                if(k == 0)
+                {
+                    /*W^0 = 1: skip the multiplies*/
+                    p1[0] = (sint16)(s02r - s13r);
+                    p1[1] = (sint16)(s02i - s13i);
+                    p2[0] = (sint16)(d02r + d13i);
+                    p2[1] = (sint16)(d02i - d13r);
+                    p3[0] = (sint16)(d02r - d13i);
+                    p3[1] = (sint16)(d02i + d13r);
+                }
+                else
+                {
+                    DSP_VoidTwiddleStore(p1,s02r - s13r,s02i - s13i,2*Local_u16W);
+                    DSP_VoidTwiddleStore(p2,d02r + d13i,d02i - d13r,Local_u16W);
+                    DSP_VoidTwiddleStore(p3,d02r - d13i,d02i + d13r,3*Local_u16W);
+                }
+            }
+        }
+    }
+
+    /*odd power of two: one last radix-2 pass with span 1 (all twiddles are 1)*/
+    if(Local_u16Group == 2)
+    {
+        for(Local_u16Itr=0;Local_u16Itr<u16Size;Local_u16Itr+=2)
+        {
+            sint16* p0 = &pData[2*Local_u16Itr];
+            sint32 ar = p0[0] >> 1, ai = p0[1] >> 1;
+            sint32 br = p0[2] >> 1, bi = p0[3] >> 1;
+            p0[0] = (sint16)(ar + br);
+            p0[1] = (sint16)(ai + bi);
+            p0[2] = (sint16)(ar - br);
+            p0[3] = (sint16)(ai - bi);
+        }
+    }
+
+    /*bit reversal to natural order*/
+    Local_u16Rev = 0;
+    for(Local_u16Itr=0;Local_u16Itr<u16Size;Local_u16Itr++)
+    {
+        uint16 Local_u16Bit;
+        if(Local_u16Itr < Local_u16Rev)
+        {
+            sint16 Local_s16Tmp;
+            Local_s16Tmp = pData[2*Local_u16Itr];
+            pData[2*Local_u16Itr] = pData[2*Local_u16Rev];
+            pData[2*Local_u16Rev] = Local_s16Tmp;
+            Local_s16Tmp = pData[2*Local_u16Itr + 1];
+            pData[2*Local_u16Itr + 1] = pData[2*Local_u16Rev + 1];
+            pData[2*Local_u16Rev + 1] = Local_s16Tmp;
+        }
+        /*reversed increment*/
+        Local_u16Bit = u16Size >> 1;
+        while(Local_u16Rev & Local_u16Bit)
+        {
+            Local_u16Rev ^= Local_u16Bit;
+            Local_u16Bit >>= 1;
+        }
+        Local_u16Rev |= Local_u16Bit;
+    }
+    return OK;
+}
+
+/******************************************************************************
+* @brief           : compute the magnitude of the first u16Bins complex bins
+* @param (in)      : pData complex interleaved {re,im} Q15 FFT output
+* @param (out)     : pMag magnitude per bin
+* @param (in)      : u16Bins number of bins (u16Size/2 for real input)
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidFftMagnitude(const sint16* pData,uint16* pMag,uint16 u16Bins)
+{
+    uint16 Local_u16Itr;
+    for(Local_u16Itr=0;Local_u16Itr<u16Bins;Local_u16Itr++)
+    {
+        sint32 Local_s32Re = pData[2*Local_u16Itr];
+        sint32 Local_s32Im = pData[2*Local_u16Itr + 1];
+        uint32 Local_u32Power = (uint32)(Local_s32Re * Local_s32Re) + (uint32)(Local_s32Im * Local_s32Im);
+        pMag[Local_u16Itr] = (uint16)DSP_u32Sqrt(Local_u32Power);
+    }
+}
+
+/******************************************************************************
+* @brief           : extract the peak bin and summary features from a magnitude spectrum
+* @param (in)      : pMag magnitude per bin
+* @param (in)      : u16Bins number of bins
+* @param (out)     : pFeatures extracted features @ref DSP_SpectralFeatures_t
+* @retval          : void
+*******************************************************************************/
+void DSP_VoidSpectralFeatures(const uint16* pMag,uint16 u16Bins,DSP_SpectralFeatures_t* pFeatures)
+{
+    uint64 Local_u64Weighted = 0;
+    uint64 Local_u64Power = 0;
+    uint32 Local_u32Sum = 0;
+    uint16 Local_u16Itr;
+
+    pFeatures->PeakBin = 0;
+    pFeatures->PeakMagnitude = 0;
+    pFeatures->CentroidBinQ8 = 0;
+    pFeatures->RmsMagnitude = 0;
+    if(u16Bins < 2)
+    {
+        return;
+    }
+
+    /*bin 0 (DC) is skipped*/
+    for(Local_u16Itr=1;Local_u16Itr<u16Bins;Local_u16Itr++)
+    {
+        uint16 Local_u16Mag = pMag[Local_u16Itr];
+        if(Local_u16Mag > pFeatures->PeakMagnitude)
+        {
+            pFeatures->PeakMagnitude = Local_u16Mag;
+            pFeatures->PeakBin = Local_u16Itr;
+        }
+        Local_u32Sum += Local_u16Mag;
+        Local_u64Weighted += (uint32)Local_u16Mag * Local_u16Itr;
+        Local_u64Power += (uint32)Local_u16Mag * Local_u16Mag;
+    }
+
+    /*the only divisions: once per spectrum*/
+    if(Local_u32Sum != 0)
+    {
+        pFeatures->CentroidBinQ8 = (uint16)((Local_u64Weighted << 8) / Local_u32Sum);
+    }
+    pFeatures->RmsMagnitude = (uint16)DSP_u32Sqrt((uint32)(Local_u64Power / (u16Bins - 1)));
+}
@@ -0,0 +1,271 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  DSP_bench.c
+ *  module:  DSP Module
+ *  @details:  host benchmark of the fixed-point filters and FFT: each kernel is run on a synthetic 12-bit ADC
+ *             stream in DMA half-buffer blocks and reported in cycles per sample (time stamp counter on x86,
+ *             nanoseconds times DSP_BENCH_HOST_MHZ elsewhere). Build and run on a Linux host from this
+ *             directory (-I. resolves the ../../LIB includes of the module):
+ *               gcc -O2 -I. -o dsp_bench DSP_bench.c ../DSP_program.c && ./dsp_bench [iterations]
+ *             The numbers compare the kernels and catch regressions; they are not Cortex-M3 cycles, measure
+ *             those on the target with the DWT cycle counter
+*********************************************************************************************************************/
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+#include "../DSP_interface.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*samples per call, one half of a 256 sample ADC DMA buffer*/
+#define DSP_BENCH_BLOCK             (128)
+/*length of the synthetic ADC stream, a whole number of blocks*/
+#define DSP_BENCH_STREAM            (DSP_BENCH_BLOCK * 32)
+#define DSP_BENCH_FIR_MAX_TAPS      (64)
+#define DSP_BENCH_MAX_STAGES        (4)
+/*passes over the stream when no count is given, the best pass is reported*/
+#define DSP_BENCH_ITERATIONS        (50)
+/*clock used to turn nanoseconds into cycles when there is no time stamp counter*/
+#define DSP_BENCH_HOST_MHZ          (1000)
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA
+---------------------------------------------------------------------------------------------------------------------*/
+static uint16 DSP_BenchAdc[DSP_BENCH_STREAM];
+static sint16 DSP_BenchQ15[DSP_BENCH_STREAM];
+static sint32 DSP_BenchQ31[DSP_BENCH_STREAM];
+static sint16 DSP_BenchOut15[DSP_BENCH_BLOCK];
+static sint32 DSP_BenchOut31[DSP_BENCH_BLOCK];
+static sint16 DSP_BenchFft[2 * DSP_FFT_MAX_SIZE];
+static uint16 DSP_BenchMag[DSP_FFT_MAX_SIZE / 2];
+
+static sint16 DSP_BenchFirCoeffs[DSP_BENCH_FIR_MAX_TAPS];
+static sint16 DSP_BenchFirState[DSP_FIR_STATE_SIZE(DSP_BENCH_FIR_MAX_TAPS, DSP_BENCH_BLOCK)];
+/*2nd order Butterworth low-pass at fs/10 with PostShift 1 (|a1| > 1), repeated for the longer cascades*/
+static const sint32 DSP_BenchBiquadSection[DSP_BIQUAD_COEFFS_PER_STAGE] =
+{
+    (sint32)(0.067455273889 * 1073741824.0), (sint32)(0.134910547778 * 1073741824.0),
+    (sint32)(0.067455273889 * 1073741824.0), (sint32)(1.142980502540 * 1073741824.0),
+    (sint32)(-0.412801598096 * 1073741824.0)
+};
+static sint32 DSP_BenchBiquadCoeffs[DSP_BENCH_MAX_STAGES * DSP_BIQUAD_COEFFS_PER_STAGE];
+static sint32 DSP_BenchBiquadState[DSP_BENCH_MAX_STAGES * DSP_BIQUAD_STATE_PER_STAGE];
+
+/*keeps the outputs alive so the kernels are not optimized away*/
+static volatile sint32 DSP_BenchSink;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Description     : current time in cycles of the host
+*******************************************************************************/
+static uint64 DSP_u64BenchCycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint64)__rdtsc();
+#else
+    struct timespec Local_Now;
+    clock_gettime(CLOCK_MONOTONIC, &Local_Now);
+    return ((uint64)Local_Now.tv_sec * 1000000000ULL + (uint64)Local_Now.tv_nsec) * DSP_BENCH_HOST_MHZ / 1000;
+#endif
+}
+
+/******************************************************************************
+* \Description     : two tones and a little noise around mid-scale, as a 12-bit ADC would deliver them
+*******************************************************************************/
+static void DSP_VoidBenchMakeStream(void)
+{
+    uint32 Local_u32Seed = 12345;
+    uint32 Local_u32Itr;
+
+    for(Local_u32Itr=0;Local_u32Itr<DSP_BENCH_STREAM;Local_u32Itr++)
+    {
+        /*triangle waves keep the host build free of libm*/
+        sint32 Local_s32Slow = (sint32)(Local_u32Itr % 64) - 32;
+        sint32 Local_s32Fast = (sint32)(Local_u32Itr % 6) - 3;
+        sint32 Local_s32Raw;
+
+        Local_u32Seed = Local_u32Seed * 1103515245UL + 12345UL;
+        Local_s32Slow = (Local_s32Slow < 0) ? -Local_s32Slow : Local_s32Slow;
+        Local_s32Raw = DSP_ADC_MIDSCALE + (Local_s32Slow - 16) * 48 + Local_s32Fast * 60 +
+                       (sint32)((Local_u32Seed >> 16) & 0x3F) - 32;
+        DSP_BenchAdc[Local_u32Itr] = (uint16)Local_s32Raw;
+        DSP_BenchQ15[Local_u32Itr] = DSP_ADC_TO_Q15(Local_s32Raw);
+        DSP_BenchQ31[Local_u32Itr] = DSP_ADC_TO_Q31(Local_s32Raw);
+    }
+}
+
+/******************************************************************************
+* \Description     : moving average taps, their sum is just below 1.0 in Q15
+*******************************************************************************/
+static void DSP_VoidBenchFirInit(DSP_FirQ15_t* pFir,uint16 u16Taps)
+{
+    uint16 Local_u16Itr;
+
+    for(Local_u16Itr=0;Local_u16Itr<u16Taps;Local_u16Itr++)
+    {
+        DSP_BenchFirCoeffs[Local_u16Itr] = (sint16)(32767 / u16Taps);
+    }
+    DSP_VoidFirQ15Init(pFir,u16Taps,DSP_BenchFirCoeffs,DSP_BenchFirState,DSP_BENCH_BLOCK);
+}
+
+/******************************************************************************
+* \Description     : cascade of u8Stages copies of the low-pass section
+*******************************************************************************/
+static void DSP_VoidBenchBiquadInit(DSP_BiquadQ31_t* pBiquad,uint8 u8Stages)
+{
+    uint8 Local_u8Stage;
+    uint8 Local_u8Coeff;
+
+    for(Local_u8Stage=0;Local_u8Stage<u8Stages;Local_u8Stage++)
+    {
+        for(Local_u8Coeff=0;Local_u8Coeff<DSP_BIQUAD_COEFFS_PER_STAGE;Local_u8Coeff++)
+        {
+            DSP_BenchBiquadCoeffs[Local_u8Stage * DSP_BIQUAD_COEFFS_PER_STAGE + Local_u8Coeff] =
+                DSP_BenchBiquadSection[Local_u8Coeff];
+        }
+    }
+    DSP_VoidBiquadQ31Init(pBiquad,u8Stages,DSP_BenchBiquadCoeffs,DSP_BenchBiquadState,1);
+}
+
+/******************************************************************************
+* \Description     : print one result line: best pass over the stream divided by the samples of a pass
+*******************************************************************************/
+static void DSP_VoidBenchReport(const char* pName,uint64 u64Best,uint32 u32Samples)
+{
+    printf("%-28s %10.2f\n", pName, (double)u64Best / (double)u32Samples);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+int main(int argc,char** argv)
+{
+    static const uint16 Local_FirTaps[] = {16, 32, 64};
+    static const uint8 Local_BiquadStages[] = {1, 2, 4};
+    static const uint16 Local_FftSizes[] = {64, 256, 1024};
+    uint32 Local_u32Iterations = (argc > 1) ? (uint32)strtoul(argv[1], NULL, 0) : DSP_BENCH_ITERATIONS;
+    char Local_Name[32];
+    uint32 Local_u32Case;
+    uint32 Local_u32Pass;
+    uint32 Local_u32Block;
+
+    if(Local_u32Iterations == 0)
+    {
+        Local_u32Iterations = 1;
+    }
+    DSP_VoidBenchMakeStream();
+    printf("DSP host benchmark, block %u samples, best of %u passes over %u samples\n",
+           (unsigned)DSP_BENCH_BLOCK, (unsigned)Local_u32Iterations, (unsigned)DSP_BENCH_STREAM);
+    printf("%-28s %10s\n", "kernel", "cyc/sample");
+
+    for(Local_u32Case=0;Local_u32Case<sizeof(Local_FirTaps)/sizeof(Local_FirTaps[0]);Local_u32Case++)
+    {
+        DSP_FirQ15_t Local_Fir;
+        uint64 Local_u64Best = ~0ULL;
+        uint64 Local_u64BestAdc = ~0ULL;
+
+        DSP_VoidBenchFirInit(&Local_Fir,Local_FirTaps[Local_u32Case]);
+        for(Local_u32Pass=0;Local_u32Pass<Local_u32Iterations;Local_u32Pass++)
+        {
+            uint64 Local_u64Start = DSP_u64BenchCycles();
+            uint64 Local_u64Time;
+
+            for(Local_u32Block=0;Local_u32Block<DSP_BENCH_STREAM;Local_u32Block+=DSP_BENCH_BLOCK)
+            {
+                DSP_VoidFirQ15(&Local_Fir,&DSP_BenchQ15[Local_u32Block],DSP_BenchOut15,DSP_BENCH_BLOCK);
+                DSP_BenchSink += DSP_BenchOut15[0];
+            }
+            Local_u64Time = DSP_u64BenchCycles() - Local_u64Start;
+            Local_u64Best = (Local_u64Time < Local_u64Best) ? Local_u64Time : Local_u64Best;
+
+            Local_u64Start = DSP_u64BenchCycles();
+            for(Local_u32Block=0;Local_u32Block<DSP_BENCH_STREAM;Local_u32Block+=DSP_BENCH_BLOCK)
+            {
+                DSP_VoidFirQ15Adc(&Local_Fir,&DSP_BenchAdc[Local_u32Block],DSP_BenchOut15,DSP_BENCH_BLOCK);
+                DSP_BenchSink += DSP_BenchOut15[0];
+            }
+            Local_u64Time = DSP_u64BenchCycles() - Local_u64Start;
+            Local_u64BestAdc = (Local_u64Time < Local_u64BestAdc) ? Local_u64Time : Local_u64BestAdc;
+        }
+        snprintf(Local_Name, sizeof(Local_Name), "FIR Q15 %u taps", (unsigned)Local_FirTaps[Local_u32Case]);
+        DSP_VoidBenchReport(Local_Name, Local_u64Best, DSP_BENCH_STREAM);
+        snprintf(Local_Name, sizeof(Local_Name), "FIR Q15 ADC %u taps", (unsigned)Local_FirTaps[Local_u32Case]);
+        DSP_VoidBenchReport(Local_Name, Local_u64BestAdc, DSP_BENCH_STREAM);
+    }
+
+    for(Local_u32Case=0;Local_u32Case<sizeof(Local_BiquadStages)/sizeof(Local_BiquadStages[0]);Local_u32Case++)
+    {
+        DSP_BiquadQ31_t Local_Biquad;
+        uint64 Local_u64Best = ~0ULL;
+        uint64 Local_u64BestAdc = ~0ULL;
+
+        DSP_VoidBenchBiquadInit(&Local_Biquad,Local_BiquadStages[Local_u32Case]);
+        for(Local_u32Pass=0;Local_u32Pass<Local_u32Iterations;Local_u32Pass++)
+        {
+            uint64 Local_u64Start = DSP_u64BenchCycles();
+            uint64 Local_u64Time;
+
+            for(Local_u32Block=0;Local_u32Block<DSP_BENCH_STREAM;Local_u32Block+=DSP_BENCH_BLOCK)
+            {
+                DSP_VoidBiquadQ31(&Local_Biquad,&DSP_BenchQ31[Local_u32Block],DSP_BenchOut31,DSP_BENCH_BLOCK);
+                DSP_BenchSink += DSP_BenchOut31[0];
+            }
+            Local_u64Time = DSP_u64BenchCycles() - Local_u64Start;
+            Local_u64Best = (Local_u64Time < Local_u64Best) ? Local_u64Time : Local_u64Best;
+
+            Local_u64Start = DSP_u64BenchCycles();
+            for(Local_u32Block=0;Local_u32Block<DSP_BENCH_STREAM;Local_u32Block+=DSP_BENCH_BLOCK)
+            {
+                DSP_VoidBiquadQ31Adc(&Local_Biquad,&DSP_BenchAdc[Local_u32Block],DSP_BenchOut15,DSP_BENCH_BLOCK);
+                DSP_BenchSink += DSP_BenchOut15[0];
+            }
+            Local_u64Time = DSP_u64BenchCycles() - Local_u64Start;
+            Local_u64BestAdc = (Local_u64Time < Local_u64BestAdc) ? Local_u64Time : Local_u64BestAdc;
+        }
+        snprintf(Local_Name, sizeof(Local_Name), "biquad Q31 %u stages", (unsigned)Local_BiquadStages[Local_u32Case]);
+        DSP_VoidBenchReport(Local_Name, Local_u64Best, DSP_BENCH_STREAM);
+        snprintf(Local_Name, sizeof(Local_Name), "biquad Q31 ADC %u stages", (unsigned)Local_BiquadStages[Local_u32Case]);
+        DSP_VoidBenchReport(Local_Name, Local_u64BestAdc, DSP_BENCH_STREAM);
+    }
+
+    /*FFT: load + transform + magnitude of one frame, per input sample*/
+    for(Local_u32Case=0;Local_u32Case<sizeof(Local_FftSizes)/sizeof(Local_FftSizes[0]);Local_u32Case++)
+    {
+        uint16 Local_u16Size = Local_FftSizes[Local_u32Case];
+        uint64 Local_u64Best = ~0ULL;
+
+        for(Local_u32Pass=0;Local_u32Pass<Local_u32Iterations;Local_u32Pass++)
+        {
+            uint64 Local_u64Start = DSP_u64BenchCycles();
+            uint64 Local_u64Time;
+
+            DSP_VoidFftLoadAdc(DSP_BenchAdc,DSP_BENCH_STREAM,(uint16)(Local_u32Pass % DSP_BENCH_STREAM),
+                               DSP_BenchFft,Local_u16Size,DSP_WINDOW_HANN);
+            (void)DSP_u8FftQ15(DSP_BenchFft,Local_u16Size);
+            DSP_VoidFftMagnitude(DSP_BenchFft,DSP_BenchMag,(uint16)(Local_u16Size / 2));
+            Local_u64Time = DSP_u64BenchCycles() - Local_u64Start;
+            Local_u64Best = (Local_u64Time < Local_u64Best) ? Local_u64Time : Local_u64Best;
+            DSP_BenchSink += DSP_BenchMag[1];
+        }
+        snprintf(Local_Name, sizeof(Local_Name), "FFT Q15 %u points", (unsigned)Local_u16Size);
+        DSP_VoidBenchReport(Local_Name, Local_u64Best, Local_u16Size);
+    }
+    return 0;
+}
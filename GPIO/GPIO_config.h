@@ -24,6 +24,20 @@
 ///*max number of pins to be initialized*/
 #define NUM_OF_INIT_PINS    6
 
+/*reads of LCKR after the lock key before MGPIO_u8LockPins reports a failure (LCKK reads 1 on the second read)*/
+#define GPIO_LOCK_READ_TRIES    (4)
+
+/*board pin map applied by MGPIO_VoidApplyPinMap, reduced at compile time to one CRL / CRH / ODR image per port.
+  One line per pin: X(P, port, pin, mode, level) with level the initial output (PIN_HIGH / PIN_LOW), or the pull
+  of an INPUT_PULLUP_PULLDOWN pin (PIN_HIGH up, PIN_LOW down). A pin listed twice fails the build.
+  The pins not listed keep their configuration. Example:
+    X(P, _GPIOC_PORT, pin13, OUTPUT_SPEED_2MHZ_PUSHPULL,      PIN_HIGH)    LED off
+    X(P, _GPIOA_PORT, pin0,  INPUT_PULLUP_PULLDOWN,           PIN_HIGH)    button, pull-up
+    X(P, _GPIOB_PORT, pin8,  INPUT_FLOATING,                  PIN_LOW)     CAN RX
+    X(P, _GPIOB_PORT, pin9,  OUTPUT_SPEED_50MHZ_AFPUSHPULL,   PIN_HIGH)    CAN TX*/
+#define GPIO_PIN_MAP(X,P)                                                                   \
+    X(P, _GPIOC_PORT, pin13, OUTPUT_SPEED_2MHZ_PUSHPULL,      PIN_HIGH)
+
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL DATA
 ---------------------------------------------------------------------------------------------------------------------*/
@@ -22,6 +22,17 @@
 #include "GPIO_private.h"
 #include "GPIO_config.h"
 
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/** @defgroup GPIO_ports number of ports, size of the GPIO_PortImage_t tables **/
+#define GPIO_PORTS                          (7)
+
+/** @defgroup GPIO_pin_handle port and pin in one byte for the inline pin functions, usable in static const tables **/
+#define GPIO_PIN_HANDLE(PORT,PIN)           ((GPIO_PinHandle_t)(((uint8)(PORT) << 4) | (uint8)(PIN)))
+#define GPIO_HANDLE_PORT(HANDLE)            ((uint8)(HANDLE) >> 4)
+#define GPIO_HANDLE_PIN(HANDLE)             ((uint8)(HANDLE) & 0x0F)
+
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL DATA TYPES AND STRUCTURES
 ---------------------------------------------------------------------------------------------------------------------*/
@@ -119,6 +130,23 @@ typedef struct
     GPIO_PinNum Pin;
 }GPIO_Cfg_Type;
 
+/*port in bits 7:4, pin in bits 3:0, built with GPIO_PIN_HANDLE*/
+typedef uint8 GPIO_PinHandle_t;
+
+/**
+  * @brief  final configuration of the pins of one port, written with one store per register by
+  *         MGPIO_VoidApplyPortImages; the pins outside the masks keep their configuration
+  */
+typedef struct
+{
+    uint32 Crl;                 /*!< CRL nibbles of the pins 0-7 */
+    uint32 CrlMask;             /*!< CRL nibbles given */
+    uint32 Crh;                 /*!< CRH nibbles of the pins 8-15 */
+    uint32 CrhMask;             /*!< CRH nibbles given */
+    uint16 Odr;                 /*!< output level, or pull-up (1) / pull-down (0) */
+    uint16 PinMask;             /*!< pins given (bit n = pin n), 0 leaves the port untouched */
+}GPIO_PortImage_t;
+
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL FUNCTIONS
 ---------------------------------------------------------------------------------------------------------------------*/
@@ -198,7 +226,8 @@ GPIO_PinLevel MGPIO_GPIO_PinLevelGetPinValue(GPIO_Num Copy_uint8Port , GPIO_PinN
 
 /******************************************************************************
 * \Syntax          : void MGPIO_VoidLockPin(GPIO_Num Copy_uint8Port , GPIO_PinNum Copy_uint8Pin)                                      
-* \Description     : Lock pin value in GPIO Port                                                                             
+* \Description     : Lock pin value in GPIO Port, see MGPIO_u8LockPins: a port is locked once until reset,
+*                    lock all its pins with one MGPIO_u8LockPins call
 * \Sync\Async      : Synchronous                                               
 * \Reentrancy      : Non Reentrant                                             
 * \Parameters (in) : GPIO_Num Port Name , GPIO_PinNum pin number in port                    
@@ -207,5 +236,185 @@ GPIO_PinLevel MGPIO_GPIO_PinLevelGetPinValue(GPIO_Num Copy_uint8Port , GPIO_PinN
 *******************************************************************************/
 void MGPIO_VoidLockPin(GPIO_Num Copy_uint8Port , GPIO_PinNum Copy_uint8Pin);
 
+/******************************************************************************
+* \Syntax          : Std_ReturnType MGPIO_u8LockPins(GPIO_Num Copy_u8Port , uint16 Copy_u16Mask)
+* \Description     : freeze the configuration (CRL / CRH nibbles) of the pins of the mask with one LCKK key
+*                    sequence, until the next reset. The key is accepted once per port: the pins not locked
+*                    then cannot be locked later
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : Copy_u8Port port, Copy_u16Mask pins to lock (bit n = pin n)
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK on an invalid port or empty mask, when the port was locked before
+*                    without all the pins of the mask, or when LCKK does not read 1 within GPIO_LOCK_READ_TRIES
+*******************************************************************************/
+Std_ReturnType MGPIO_u8LockPins(GPIO_Num Copy_u8Port , uint16 Copy_u16Mask);
+
+/******************************************************************************
+* \Syntax          : void MGPIO_VoidApplyPinMap(void)
+* \Description     : configure the pins of GPIO_PIN_MAP (GPIO_config.h) from the images reduced at compile
+*                    time: per port one BSRR store for the levels, then one CRL and one CRH write. The clocks
+*                    of the ports are enabled first
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MGPIO_VoidApplyPinMap(void);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType MGPIO_u8BuildPortImages(const GPIO_Cfg_Type* pTable,uint8 u8Count,
+*                                                           GPIO_PortImage_t* pImages)
+* \Description     : run time builder of the port images from a pin table (for example the low power set):
+*                    PinMode and Pin / Port of each entry, the level from PinInitLevel, or from PinPUPDType for
+*                    INPUT_PULLUP_PULLDOWN. Build once, apply with MGPIO_VoidApplyPortImages
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : pTable pins, u8Count number of pins
+* \Parameters (out): pImages GPIO_PORTS images
+* \Return value:   : Std_ReturnType N_OK on a pin given twice or out of range, pImages then incomplete
+*******************************************************************************/
+Std_ReturnType MGPIO_u8BuildPortImages(const GPIO_Cfg_Type* pTable,uint8 u8Count,GPIO_PortImage_t* pImages);
+
+/******************************************************************************
+* \Syntax          : void MGPIO_VoidApplyPortImages(const GPIO_PortImage_t* pImages)
+* \Description     : configure the ports from their images: per port with pins one BSRR store for the levels
+*                    (outputs start at their level), then one CRL and one CRH write, read-modify-write only when
+*                    part of the register is given. The clocks of the ports must be enabled
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pImages GPIO_PORTS images
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MGPIO_VoidApplyPortImages(const GPIO_PortImage_t* pImages);
+
+/*inline pin access: no call and no port switch, with a constant handle each one is a single register access
+  (BSRR / BRR store, IDR load). The handle is not checked*/
+/******************************************************************************
+* \Syntax          : void MGPIO_VoidPinSet(GPIO_PinHandle_t Copy_Handle)
+* \Description     : drive a pin high with one BSRR store
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : Copy_Handle GPIO_PIN_HANDLE(port,pin)
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+static inline void MGPIO_VoidPinSet(GPIO_PinHandle_t Copy_Handle)
+{
+    GPIO_PORT(GPIO_HANDLE_PORT(Copy_Handle))->BSRR = (uint32)1 << GPIO_HANDLE_PIN(Copy_Handle);
+}
+
+/******************************************************************************
+* \Syntax          : void MGPIO_VoidPinReset(GPIO_PinHandle_t Copy_Handle)
+* \Description     : drive a pin low with one BRR store
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : Copy_Handle GPIO_PIN_HANDLE(port,pin)
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+static inline void MGPIO_VoidPinReset(GPIO_PinHandle_t Copy_Handle)
+{
+    GPIO_PORT(GPIO_HANDLE_PORT(Copy_Handle))->BRR = (uint32)1 << GPIO_HANDLE_PIN(Copy_Handle);
+}
+
+/******************************************************************************
+* \Syntax          : void MGPIO_VoidPinWrite(GPIO_PinHandle_t Copy_Handle,GPIO_PinLevel Copy_Level)
+* \Description     : drive a pin with one BSRR store, set half for PIN_HIGH and reset half for PIN_LOW
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : Copy_Handle GPIO_PIN_HANDLE(port,pin), Copy_Level PIN_HIGH or PIN_LOW
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+static inline void MGPIO_VoidPinWrite(GPIO_PinHandle_t Copy_Handle,GPIO_PinLevel Copy_Level)
+{
+    GPIO_PORT(GPIO_HANDLE_PORT(Copy_Handle))->BSRR =
+        (uint32)1 << (GPIO_HANDLE_PIN(Copy_Handle) + ((Copy_Level == PIN_HIGH) ? 0 : 16));
+}
+
+/******************************************************************************
+* \Syntax          : void MGPIO_VoidPinToggle(GPIO_PinHandle_t Copy_Handle)
+* \Description     : invert a pin output: ODR is read and the opposite level written to BSRR, so the other
+*                    pins of the port are not rewritten (an interrupt changing them in between is kept)
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : Copy_Handle GPIO_PIN_HANDLE(port,pin)
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+static inline void MGPIO_VoidPinToggle(GPIO_PinHandle_t Copy_Handle)
+{
+    volatile GPIO_t* Local_pPort = GPIO_PORT(GPIO_HANDLE_PORT(Copy_Handle));
+    uint32 Local_u32Bit = (uint32)1 << GPIO_HANDLE_PIN(Copy_Handle);
+
+    Local_pPort->BSRR = ((Local_pPort->ODR & Local_u32Bit) != 0) ? (Local_u32Bit << 16) : Local_u32Bit;
+}
+
+/******************************************************************************
+* \Syntax          : GPIO_PinLevel MGPIO_PinLevelPinRead(GPIO_PinHandle_t Copy_Handle)
+* \Description     : read a pin input with one IDR load
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : Copy_Handle GPIO_PIN_HANDLE(port,pin)
+* \Parameters (out): None
+* \Return value:   : GPIO_PinLevel  High or LOW
+*******************************************************************************/
+static inline GPIO_PinLevel MGPIO_PinLevelPinRead(GPIO_PinHandle_t Copy_Handle)
+{
+    return (GPIO_PinLevel)READ_BIT(GPIO_PORT(GPIO_HANDLE_PORT(Copy_Handle))->IDR,GPIO_HANDLE_PIN(Copy_Handle));
+}
+
+/*port access: all the pins of the mask change in the same BSRR store, for 8/16-bit parallel buses*/
+/******************************************************************************
+* \Syntax          : void MGPIO_VoidPortWrite(GPIO_Num Copy_u8Port,uint16 Copy_u16Mask,uint16 Copy_u16Value)
+* \Description     : drive the pins of the mask to the bits of the value with one BSRR store: the bits set in
+*                    the value go to the set half, the bits clear to the reset half. The pins outside the mask
+*                    are not touched. The port is not checked
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : Copy_u8Port port, Copy_u16Mask pins to drive (bit n = pin n), Copy_u16Value levels
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+static inline void MGPIO_VoidPortWrite(GPIO_Num Copy_u8Port,uint16 Copy_u16Mask,uint16 Copy_u16Value)
+{
+    GPIO_PORT(Copy_u8Port)->BSRR = ((uint32)(uint16)(~Copy_u16Value & Copy_u16Mask) << 16) |
+                                   (uint32)(Copy_u16Value & Copy_u16Mask);
+}
+
+/******************************************************************************
+* \Syntax          : uint16 MGPIO_u16PortRead(GPIO_Num Copy_u8Port,uint16 Copy_u16Mask)
+* \Description     : read the inputs of the pins of the mask with one IDR load. The port is not checked
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : Copy_u8Port port, Copy_u16Mask pins to read (bit n = pin n)
+* \Parameters (out): None
+* \Return value:   : uint16 levels of the pins of the mask, the other bits 0
+*******************************************************************************/
+static inline uint16 MGPIO_u16PortRead(GPIO_Num Copy_u8Port,uint16 Copy_u16Mask)
+{
+    return (uint16)(GPIO_PORT(Copy_u8Port)->IDR & Copy_u16Mask);
+}
+
+/******************************************************************************
+* \Syntax          : void MGPIO_VoidPortToggle(GPIO_Num Copy_u8Port,uint16 Copy_u16Mask)
+* \Description     : invert the outputs of the pins of the mask: ODR is read once and the opposite levels
+*                    written in one BSRR store, the other pins are not rewritten. The port is not checked
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : Copy_u8Port port, Copy_u16Mask pins to invert (bit n = pin n)
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+static inline void MGPIO_VoidPortToggle(GPIO_Num Copy_u8Port,uint16 Copy_u16Mask)
+{
+    volatile GPIO_t* Local_pPort = GPIO_PORT(Copy_u8Port);
+    uint32 Local_u32High = Local_pPort->ODR & Copy_u16Mask;
+
+    Local_pPort->BSRR = (Local_u32High << 16) | (Copy_u16Mask & ~Local_u32High);
+}
 
 #endif
@@ -67,11 +67,49 @@ typedef struct{
 #define 	GPIOF 		((GPIO_t *) GPIOF_Base_Address)
 #define 	GPIOG 		((GPIO_t *) GPIOG_Base_Address)
 
+/*the ports are 0x400 apart from port A: the base of a port number is a multiply-add, no switch or table load*/
+#define     GPIO_PORT_BASE(PORT)    ((uint32)GPIOA_Base_Address + ((uint32)(PORT) * 0x400UL))
+#define     GPIO_PORT(PORT)         ((volatile GPIO_t *) GPIO_PORT_BASE(PORT))
+
 
 
 /*lock key bit*/
 #define LCKK  16
 
+/*reduction of GPIO_PIN_MAP to the images of port P: each line adds its bits when its port is P. The sums
+  equal the ORs as long as no pin is listed twice, which GPIO_MAP_PINS / GPIO_MAP_PINS_OR check*/
+#define GPIO_MAP_CR_TERM(P,PORT,PIN,MODE,LEVEL,HIGH)  \
+    + ((((PORT) == (P)) && (((PIN) >= 8) == (HIGH))) ? ((uint32)(MODE) << (((PIN) & 7) * 4)) : 0UL)
+#define GPIO_MAP_CR_MASK_TERM(P,PORT,PIN,MODE,LEVEL,HIGH)  \
+    + ((((PORT) == (P)) && (((PIN) >= 8) == (HIGH))) ? (0xFUL << (((PIN) & 7) * 4)) : 0UL)
+#define GPIO_MAP_CRL_TERM(P,PORT,PIN,MODE,LEVEL)        GPIO_MAP_CR_TERM(P,PORT,PIN,MODE,LEVEL,0)
+#define GPIO_MAP_CRH_TERM(P,PORT,PIN,MODE,LEVEL)        GPIO_MAP_CR_TERM(P,PORT,PIN,MODE,LEVEL,1)
+#define GPIO_MAP_CRL_MASK_TERM(P,PORT,PIN,MODE,LEVEL)   GPIO_MAP_CR_MASK_TERM(P,PORT,PIN,MODE,LEVEL,0)
+#define GPIO_MAP_CRH_MASK_TERM(P,PORT,PIN,MODE,LEVEL)   GPIO_MAP_CR_MASK_TERM(P,PORT,PIN,MODE,LEVEL,1)
+#define GPIO_MAP_ODR_TERM(P,PORT,PIN,MODE,LEVEL)        \
+    + ((((PORT) == (P)) && ((LEVEL) == PIN_HIGH)) ? (1UL << (PIN)) : 0UL)
+#define GPIO_MAP_PIN_TERM(P,PORT,PIN,MODE,LEVEL)        + (((PORT) == (P)) ? (1UL << (PIN)) : 0UL)
+#define GPIO_MAP_PIN_OR_TERM(P,PORT,PIN,MODE,LEVEL)     | (((PORT) == (P)) ? (1UL << (PIN)) : 0UL)
+#define GPIO_MAP_LINE_TERM(P,PORT,PIN,MODE,LEVEL)       + 1UL
+#define GPIO_MAP_VALID_TERM(P,PORT,PIN,MODE,LEVEL)      + ((((PORT) <= _GPIOG_PORT) && ((PIN) <= pin15)) ? 1UL : 0UL)
+
+#define GPIO_MAP_CRL(P)                 (0UL GPIO_PIN_MAP(GPIO_MAP_CRL_TERM,P))
+#define GPIO_MAP_CRL_MASK(P)            (0UL GPIO_PIN_MAP(GPIO_MAP_CRL_MASK_TERM,P))
+#define GPIO_MAP_CRH(P)                 (0UL GPIO_PIN_MAP(GPIO_MAP_CRH_TERM,P))
+#define GPIO_MAP_CRH_MASK(P)            (0UL GPIO_PIN_MAP(GPIO_MAP_CRH_MASK_TERM,P))
+#define GPIO_MAP_ODR(P)                 (0UL GPIO_PIN_MAP(GPIO_MAP_ODR_TERM,P))
+#define GPIO_MAP_PINS(P)                (0UL GPIO_PIN_MAP(GPIO_MAP_PIN_TERM,P))
+#define GPIO_MAP_PINS_OR(P)             (0UL GPIO_PIN_MAP(GPIO_MAP_PIN_OR_TERM,P))
+#define GPIO_MAP_LINES                  (0UL GPIO_PIN_MAP(GPIO_MAP_LINE_TERM,0))
+#define GPIO_MAP_VALID_LINES            (0UL GPIO_PIN_MAP(GPIO_MAP_VALID_TERM,0))
+
+/*GPIO_PortImage_t initializer of port P*/
+#define GPIO_MAP_IMAGE(P)               {GPIO_MAP_CRL(P),GPIO_MAP_CRL_MASK(P),GPIO_MAP_CRH(P),GPIO_MAP_CRH_MASK(P), \
+                                         (uint16)GPIO_MAP_ODR(P),(uint16)GPIO_MAP_PINS(P)}
+
+/*compile time check: the build fails on a negative array size when COND is false*/
+#define GPIO_MAP_ASSERT(COND,NAME)      typedef char NAME[(COND) ? 1 : -1]
+
 
 
 
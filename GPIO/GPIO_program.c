@@ -20,6 +20,34 @@
 #include "GPIO_config.h"
 #include "GPIO_private.h"
 #include "GPIO_interface.h"
+#include "../../LIB/Bit_Band.h"
+
+#include "../RCC/RCC_interface.h"
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA
+---------------------------------------------------------------------------------------------------------------------*/
+/*GPIO_PIN_MAP checks: no pin listed twice in a port (the sum of its bits differs from their OR), no line out
+  of range*/
+GPIO_MAP_ASSERT(GPIO_MAP_PINS(_GPIOA_PORT) == GPIO_MAP_PINS_OR(_GPIOA_PORT),GPIO_PinMap_PinTwiceInPortA);
+GPIO_MAP_ASSERT(GPIO_MAP_PINS(_GPIOB_PORT) == GPIO_MAP_PINS_OR(_GPIOB_PORT),GPIO_PinMap_PinTwiceInPortB);
+GPIO_MAP_ASSERT(GPIO_MAP_PINS(_GPIOC_PORT) == GPIO_MAP_PINS_OR(_GPIOC_PORT),GPIO_PinMap_PinTwiceInPortC);
+GPIO_MAP_ASSERT(GPIO_MAP_PINS(_GPIOD_PORT) == GPIO_MAP_PINS_OR(_GPIOD_PORT),GPIO_PinMap_PinTwiceInPortD);
+GPIO_MAP_ASSERT(GPIO_MAP_PINS(_GPIOE_PORT) == GPIO_MAP_PINS_OR(_GPIOE_PORT),GPIO_PinMap_PinTwiceInPortE);
+GPIO_MAP_ASSERT(GPIO_MAP_PINS(_GPIOF_PORT) == GPIO_MAP_PINS_OR(_GPIOF_PORT),GPIO_PinMap_PinTwiceInPortF);
+GPIO_MAP_ASSERT(GPIO_MAP_PINS(_GPIOG_PORT) == GPIO_MAP_PINS_OR(_GPIOG_PORT),GPIO_PinMap_PinTwiceInPortG);
+GPIO_MAP_ASSERT(GPIO_MAP_LINES == GPIO_MAP_VALID_LINES,GPIO_PinMap_PortOrPinOutOfRange);
+
+/*GPIO_PIN_MAP reduced to the port images, nothing is computed at run time*/
+static const GPIO_PortImage_t GPIO_PinMapImages[GPIO_PORTS] =
+{
+    GPIO_MAP_IMAGE(_GPIOA_PORT),
+    GPIO_MAP_IMAGE(_GPIOB_PORT),
+    GPIO_MAP_IMAGE(_GPIOC_PORT),
+    GPIO_MAP_IMAGE(_GPIOD_PORT),
+    GPIO_MAP_IMAGE(_GPIOE_PORT),
+    GPIO_MAP_IMAGE(_GPIOF_PORT),
+    GPIO_MAP_IMAGE(_GPIOG_PORT)
+};
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL FUNCTIONS
 ---------------------------------------------------------------------------------------------------------------------*/
@@ -129,32 +157,11 @@
 void MGPIO_VoidSetPinMode_TYPE(GPIO_Num Copy_u8Port , GPIO_PinNum Copy_u8Pin , GPIO_PinModeType Copy_u8Mode)
 {
 	volatile GPIO_t* PortReg=NULL;
-	switch(Copy_u8Port)
+	if(Copy_u8Port > _GPIOG_PORT)
 	{
-		case _GPIOA_PORT:
-		PortReg = GPIOA;
-		break;
-		case _GPIOB_PORT:
-		PortReg = GPIOB;
-		break;
-		case _GPIOC_PORT:
-		PortReg = GPIOC;
-		break;
-        case _GPIOD_PORT:
-		PortReg = GPIOD;
-		break;
-		case _GPIOE_PORT:
-		PortReg = GPIOE;
-		break;
-		case _GPIOF_PORT:
-		PortReg = GPIOF;
-		break;
-		case _GPIOG_PORT:
-		PortReg = GPIOG;
-		break;
-		default:
-		break;
+		return;
 	}
+	PortReg = GPIO_PORT(Copy_u8Port);
     // /*Set pin mode MODEx*/
     // uint8* Reg;
     // if(Copy_u8Pin<=pin7)
@@ -253,40 +260,19 @@ void MGPIO_VoidSetPinMode_TYPE(GPIO_Num Copy_u8Port , GPIO_PinNum Copy_u8Pin , G
 void MGPIO_VoidSetPullType(GPIO_Num Copy_u8Port , GPIO_PinNum Copy_u8Pin , GPIO_PinPUPDType Copy_u8PullType)
 {
     volatile GPIO_t* PortReg=NULL;
-	switch(Copy_u8Port)
+	if(Copy_u8Port > _GPIOG_PORT)
 	{
-		case _GPIOA_PORT:
-		PortReg = GPIOA;
-		break;
-		case _GPIOB_PORT:
-		PortReg = GPIOB;
-		break;
-		case _GPIOC_PORT:
-		PortReg = GPIOC;
-		break;
-        case _GPIOD_PORT:
-		PortReg = GPIOD;
-		break;
-		case _GPIOE_PORT:
-		PortReg = GPIOE;
-		break;
-		case _GPIOF_PORT:
-		PortReg = GPIOF;
-		break;
-        case _GPIOG_PORT:
-		PortReg = GPIOG;
-		break;
-		default:
-		break;
+		return;
 	}
+	PortReg = GPIO_PORT(Copy_u8Port);
     /*floating input or pull-up/pull-down*/
     switch (Copy_u8PullType)
     {
     case PULL_UP:
-        SET_BIT(PortReg->ODR,Copy_u8Pin);
+        BB_SET_BIT(PortReg->ODR,Copy_u8Pin);
         break;
     case PULL_DOWN:
-        CLEAR_BIT(PortReg->ODR,Copy_u8Pin);
+        BB_CLEAR_BIT(PortReg->ODR,Copy_u8Pin);
         break;
     default:
         break;
@@ -305,33 +291,11 @@ void MGPIO_VoidSetPullType(GPIO_Num Copy_u8Port , GPIO_PinNum Copy_u8Pin , GPIO_
 *******************************************************************************/
 void MGPIO_VoidSetPinValue(GPIO_Num Copy_uint8Port , GPIO_PinNum Copy_uint8Pin ,GPIO_PinLevel  Copy_uint8Value)
 {
-    switch(Copy_uint8Port)
+    if(Copy_uint8Port <= _GPIOG_PORT)
     {
-        case _GPIOA_PORT:
-        	Copy_uint8Value == PIN_HIGH?SET_BIT(GPIOA->BSRR,Copy_uint8Pin):SET_BIT(GPIOA->BRR,(Copy_uint8Pin));
-        break;
-        case _GPIOB_PORT:
-        	Copy_uint8Value == PIN_HIGH?SET_BIT(GPIOB->BSRR,Copy_uint8Pin):SET_BIT(GPIOB->BRR,(Copy_uint8Pin));
-        break;
-        case _GPIOC_PORT:
-        	Copy_uint8Value == PIN_HIGH?SET_BIT(GPIOC->BSRR,Copy_uint8Pin):SET_BIT(GPIOC->BRR,(Copy_uint8Pin));
-        break;
-        case _GPIOD_PORT:
-        	Copy_uint8Value == PIN_HIGH?SET_BIT(GPIOD->BSRR,Copy_uint8Pin):SET_BIT(GPIOD->BRR,(Copy_uint8Pin));
-        break;
-        case _GPIOE_PORT:
-        	Copy_uint8Value == PIN_HIGH?SET_BIT(GPIOE->BSRR,Copy_uint8Pin):SET_BIT(GPIOE->BRR,(Copy_uint8Pin));
-        break;
-        case _GPIOF_PORT:
-        	Copy_uint8Value == PIN_HIGH?SET_BIT(GPIOF->BSRR,Copy_uint8Pin):SET_BIT(GPIOF->BRR,(Copy_uint8Pin));
-        break;
-        case _GPIOG_PORT:
-        	Copy_uint8Value == PIN_HIGH?SET_BIT(GPIOG->BSRR,Copy_uint8Pin):SET_BIT(GPIOG->BRR,(Copy_uint8Pin));
-        break;
-        default:
-        break;
+        MGPIO_VoidPinWrite(GPIO_PIN_HANDLE(Copy_uint8Port,Copy_uint8Pin),Copy_uint8Value);
     }
-    
+    else{}
 }
 
 /******************************************************************************
@@ -345,32 +309,11 @@ void MGPIO_VoidSetPinValue(GPIO_Num Copy_uint8Port , GPIO_PinNum Copy_uint8Pin ,
 *******************************************************************************/
 void MGPIO_VoidTogglePinValue(GPIO_Num Copy_uint8Port , GPIO_PinNum Copy_uint8Pin )
 {
-	switch(Copy_uint8Port)
-	    {
-	        case _GPIOA_PORT:
-	        TOGGLE_BIT(GPIOA->ODR,Copy_uint8Pin);
-	        break;
-	        case _GPIOB_PORT:
-	        TOGGLE_BIT(GPIOB->ODR,Copy_uint8Pin);
-	        break;
-	        case _GPIOC_PORT:
-	        TOGGLE_BIT(GPIOC->ODR,Copy_uint8Pin);
-	        break;
-	        case _GPIOD_PORT:
-	        TOGGLE_BIT(GPIOD->ODR,Copy_uint8Pin);
-	        break;
-	        case _GPIOE_PORT:
-	        TOGGLE_BIT(GPIOE->ODR,Copy_uint8Pin);
-	        break;
-	        case _GPIOF_PORT:
-	        TOGGLE_BIT(GPIOF->ODR,Copy_uint8Pin);
-	        break;
-	        case _GPIOG_PORT:
-	        TOGGLE_BIT(GPIOG->ODR,Copy_uint8Pin);
-	        break;
-	        default:
-	        break;
-	    }
+    if(Copy_uint8Port <= _GPIOG_PORT)
+    {
+        MGPIO_VoidPinToggle(GPIO_PIN_HANDLE(Copy_uint8Port,Copy_uint8Pin));
+    }
+    else{}
 }
 /******************************************************************************
 * \Syntax          : GPIO_PinLevel MGPIO_GPIO_PinLevelGetPinValue(GPIO_Num Copy_uint8Port , GPIO_PinNum Copy_uint8Pin)                                      
@@ -384,40 +327,19 @@ void MGPIO_VoidTogglePinValue(GPIO_Num Copy_uint8Port , GPIO_PinNum Copy_uint8Pi
 GPIO_PinLevel MGPIO_GPIO_PinLevelGetPinValue(GPIO_Num Copy_uint8Port , GPIO_PinNum Copy_uint8Pin)
 {
     uint8 LOC_uint8ReturnValue = PIN_LOW;
-    switch(Copy_uint8Port)
+    if(Copy_uint8Port <= _GPIOG_PORT)
     {
-        case _GPIOA_PORT:
-        LOC_uint8ReturnValue = READ_BIT(GPIOA->IDR,Copy_uint8Pin);
-        break;
-        case _GPIOB_PORT:
-        LOC_uint8ReturnValue = READ_BIT(GPIOB->IDR,Copy_uint8Pin);
-        break;
-        case _GPIOC_PORT:
-        LOC_uint8ReturnValue = READ_BIT(GPIOC->IDR,Copy_uint8Pin);
-        break;
-        case _GPIOD_PORT:
-        LOC_uint8ReturnValue = READ_BIT(GPIOD->IDR,Copy_uint8Pin);
-        break;
-        case _GPIOE_PORT:
-        LOC_uint8ReturnValue = READ_BIT(GPIOE->IDR,Copy_uint8Pin);
-        break;
-        case _GPIOF_PORT:
-        LOC_uint8ReturnValue = READ_BIT(GPIOF->IDR,Copy_uint8Pin);
-        break;
-        case _GPIOG_PORT:
-        LOC_uint8ReturnValue = READ_BIT(GPIOG->IDR,Copy_uint8Pin);
-        break;
-        default:
-        LOC_uint8ReturnValue = PIN_LOW;
-        break;
+        LOC_uint8ReturnValue = MGPIO_PinLevelPinRead(GPIO_PIN_HANDLE(Copy_uint8Port,Copy_uint8Pin));
     }
+    else{}
     return  LOC_uint8ReturnValue;
 
 }
 
 /******************************************************************************
 * \Syntax          : void MGPIO_VoidLockPin(GPIO_Num Copy_uint8Port , GPIO_PinNum Copy_uint8Pin)                                      
-* \Description     : Lock pin value in GPIO Port                                                                             
+* \Description     : Lock pin value in GPIO Port, see MGPIO_u8LockPins: a port is locked once until reset,
+*                    lock all its pins with one MGPIO_u8LockPins call
 * \Sync\Async      : Synchronous                                               
 * \Reentrancy      : Non Reentrant                                             
 * \Parameters (in) : GPIO_Num Port Name , GPIO_PinNum pin number in port                    
@@ -426,27 +348,198 @@ GPIO_PinLevel MGPIO_GPIO_PinLevelGetPinValue(GPIO_Num Copy_uint8Port , GPIO_PinN
 *******************************************************************************/
 void MGPIO_VoidLockPin(GPIO_Num Copy_uint8Port , GPIO_PinNum Copy_uint8Pin)
 {
-    switch(Copy_uint8Port)	
-  {
-	  case _GPIOA_PORT  :
-            SET_BIT(GPIOA->LCKR,Copy_uint8Pin );
-            SET_BIT(GPIOA->LCKR,LCKK );
-            while(!(READ_BIT(GPIOA->LCKR,LCKK)));
-	  
-	  break ; 
-	  /*************************************************/
-	  case _GPIOB_PORT  :
-            SET_BIT(GPIOB->LCKR,Copy_uint8Pin );
-            SET_BIT(GPIOB->LCKR,LCKK );
-            while(!(READ_BIT(GPIOB->LCKR,LCKK)));
-	  
-	  break ; 
-	  /*************************************************/
-	    case _GPIOC_PORT  :
-            SET_BIT(GPIOC->LCKR,Copy_uint8Pin );
-            SET_BIT(GPIOC->LCKR,LCKK );
-            while(!(READ_BIT(GPIOC->LCKR,LCKK)));
+    (void)MGPIO_u8LockPins(Copy_uint8Port,(uint16)(1U << Copy_uint8Pin));
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType MGPIO_u8LockPins(GPIO_Num Copy_u8Port , uint16 Copy_u16Mask)
+* \Description     : freeze the configuration (CRL / CRH nibbles) of the pins of the mask with one LCKK key
+*                    sequence, until the next reset. The key is accepted once per port: the pins not locked
+*                    then cannot be locked later
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : Copy_u8Port port, Copy_u16Mask pins to lock (bit n = pin n)
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK on an invalid port or empty mask, when the port was locked before
+*                    without all the pins of the mask, or when LCKK does not read 1 within GPIO_LOCK_READ_TRIES
+*******************************************************************************/
+Std_ReturnType MGPIO_u8LockPins(GPIO_Num Copy_u8Port , uint16 Copy_u16Mask)
+{
+    volatile GPIO_t* Local_pPort;
+    uint32 Local_u32Key;
+    uint8 Local_u8Try;
+
+    if(Copy_u8Port > _GPIOG_PORT || Copy_u16Mask == 0)
+    {
+        return N_OK;
+    }
+    Local_pPort = GPIO_PORT(Copy_u8Port);
+    if(READ_BIT(Local_pPort->LCKR,LCKK) == 1)
+    {
+        /*already locked: the key sequence is ignored, only the pins locked then are frozen*/
+        return ((Local_pPort->LCKR & Copy_u16Mask) == Copy_u16Mask) ? OK : N_OK;
+    }
+
+    /*key: LCKK=1, LCKK=0, LCKK=1 with the same pins in each write, then two reads. Full writes: a
+      read-modify-write or a different mask aborts the sequence*/
+    Local_u32Key = ((uint32)1 << LCKK) | Copy_u16Mask;
+    Local_pPort->LCKR = Local_u32Key;
+    Local_pPort->LCKR = Copy_u16Mask;
+    Local_pPort->LCKR = Local_u32Key;
+    (void)Local_pPort->LCKR;
+    for(Local_u8Try=0;Local_u8Try<GPIO_LOCK_READ_TRIES;Local_u8Try++)
+    {
+        if(READ_BIT(Local_pPort->LCKR,LCKK) == 1)
+        {
+            return ((Local_pPort->LCKR & Copy_u16Mask) == Copy_u16Mask) ? OK : N_OK;
+        }
+    }
+    return N_OK;
+}
+
+/******************************************************************************
+* \Syntax          : void MGPIO_VoidApplyPinMap(void)
+* \Description     : configure the pins of GPIO_PIN_MAP (GPIO_config.h) from the images reduced at compile
+*                    time: per port one BSRR store for the levels, then one CRL and one CRH write. The clocks
+*                    of the ports are enabled first
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MGPIO_VoidApplyPinMap(void)
+{
+    uint8 Local_u8Port;
+
+    for(Local_u8Port=_GPIOA_PORT;Local_u8Port<GPIO_PORTS;Local_u8Port++)
+    {
+        if(GPIO_PinMapImages[Local_u8Port].PinMask != 0)
+        {
+            MRCC_voidEnableClock(RCC_APB2,PERIPHERAL_EN_IOPA + Local_u8Port);
+        }
+        else{}
+    }
+    MGPIO_VoidApplyPortImages(GPIO_PinMapImages);
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType MGPIO_u8BuildPortImages(const GPIO_Cfg_Type* pTable,uint8 u8Count,
+*                                                           GPIO_PortImage_t* pImages)
+* \Description     : run time builder of the port images from a pin table (for example the low power set):
+*                    PinMode and Pin / Port of each entry, the level from PinInitLevel, or from PinPUPDType for
+*                    INPUT_PULLUP_PULLDOWN. Build once, apply with MGPIO_VoidApplyPortImages
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : pTable pins, u8Count number of pins
+* \Parameters (out): pImages GPIO_PORTS images
+* \Return value:   : Std_ReturnType N_OK on a pin given twice or out of range, pImages then incomplete
+*******************************************************************************/
+Std_ReturnType MGPIO_u8BuildPortImages(const GPIO_Cfg_Type* pTable,uint8 u8Count,GPIO_PortImage_t* pImages)
+{
+    uint8 Local_u8Itr;
+    uint8 Local_u8Pin;
+    uint8 Local_u8Shift;
+    uint16 Local_u16Bit;
+    uint8 Local_u8High;
+    GPIO_PortImage_t* Local_pImage;
+
+    for(Local_u8Itr=0;Local_u8Itr<GPIO_PORTS;Local_u8Itr++)
+    {
+        pImages[Local_u8Itr].Crl = 0;
+        pImages[Local_u8Itr].CrlMask = 0;
+        pImages[Local_u8Itr].Crh = 0;
+        pImages[Local_u8Itr].CrhMask = 0;
+        pImages[Local_u8Itr].Odr = 0;
+        pImages[Local_u8Itr].PinMask = 0;
+    }
+    for(Local_u8Itr=0;Local_u8Itr<u8Count;Local_u8Itr++)
+    {
+        Local_u8Pin = pTable[Local_u8Itr].Pin;
+        if(pTable[Local_u8Itr].Port > _GPIOG_PORT || Local_u8Pin > pin15)
+        {
+            return N_OK;
+        }
+        Local_pImage = &pImages[pTable[Local_u8Itr].Port];
+        Local_u16Bit = (uint16)(1U << Local_u8Pin);
+        if((Local_pImage->PinMask & Local_u16Bit) != 0)
+        {
+            /*the same pin given twice*/
+            return N_OK;
+        }
+        Local_pImage->PinMask |= Local_u16Bit;
 
-	  break ; 
-  }
+        Local_u8Shift = (uint8)((Local_u8Pin & 7) * 4);
+        if(Local_u8Pin <= pin7)
+        {
+            Local_pImage->Crl |= (uint32)pTable[Local_u8Itr].PinMode << Local_u8Shift;
+            Local_pImage->CrlMask |= 0xFUL << Local_u8Shift;
+        }
+        else
+        {
+            Local_pImage->Crh |= (uint32)pTable[Local_u8Itr].PinMode << Local_u8Shift;
+            Local_pImage->CrhMask |= 0xFUL << Local_u8Shift;
+        }
+
+        if(pTable[Local_u8Itr].PinMode == INPUT_PULLUP_PULLDOWN)
+        {
+            Local_u8High = (pTable[Local_u8Itr].PinPUPDType == PULL_UP);
+        }
+        else
+        {
+            Local_u8High = (pTable[Local_u8Itr].PinInitLevel == PIN_HIGH);
+        }
+        if(Local_u8High)
+        {
+            Local_pImage->Odr |= Local_u16Bit;
+        }
+        else{}
+    }
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : void MGPIO_VoidApplyPortImages(const GPIO_PortImage_t* pImages)
+* \Description     : configure the ports from their images: per port with pins one BSRR store for the levels
+*                    (outputs start at their level), then one CRL and one CRH write, read-modify-write only when
+*                    part of the register is given. The clocks of the ports must be enabled
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pImages GPIO_PORTS images
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MGPIO_VoidApplyPortImages(const GPIO_PortImage_t* pImages)
+{
+    uint8 Local_u8Port;
+    volatile GPIO_t* Local_pPort;
+
+    for(Local_u8Port=_GPIOA_PORT;Local_u8Port<GPIO_PORTS;Local_u8Port++)
+    {
+        if(pImages[Local_u8Port].PinMask == 0)
+        {
+            continue;
+        }
+        Local_pPort = GPIO_PORT(Local_u8Port);
+        /*levels before modes: an output or a pull is never enabled at the old ODR level*/
+        MGPIO_VoidPortWrite((GPIO_Num)Local_u8Port,pImages[Local_u8Port].PinMask,pImages[Local_u8Port].Odr);
+        if(pImages[Local_u8Port].CrlMask == 0xFFFFFFFFUL)
+        {
+            Local_pPort->CRL.R = pImages[Local_u8Port].Crl;
+        }
+        else if(pImages[Local_u8Port].CrlMask != 0)
+        {
+            Local_pPort->CRL.R = (Local_pPort->CRL.R & ~pImages[Local_u8Port].CrlMask) | pImages[Local_u8Port].Crl;
+        }
+        else{}
+        if(pImages[Local_u8Port].CrhMask == 0xFFFFFFFFUL)
+        {
+            Local_pPort->CRH.R = pImages[Local_u8Port].Crh;
+        }
+        else if(pImages[Local_u8Port].CrhMask != 0)
+        {
+            Local_pPort->CRH.R = (Local_pPort->CRH.R & ~pImages[Local_u8Port].CrhMask) | pImages[Local_u8Port].Crh;
+        }
+        else{}
+    }
 }
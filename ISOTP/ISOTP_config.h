@@ -0,0 +1,34 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  ISOTP_config.h
+ *  module:  ISOTP Module
+ *  @details:  Configuration header file for ISO 15765-2 transport layer
+*********************************************************************************************************************/
+#ifndef _ISOTP_CONFIG_H
+#define _ISOTP_CONFIG_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*period of the ISOTP_VoidTick calls in microseconds (e.g. the SYSTick period)*/
+#define ISOTP_TICK_US                   (1000)
+
+/*N_Bs: longest wait for a flow control frame after a first frame or a block, in ms*/
+#define ISOTP_TIMEOUT_BS_MS             (1000)
+/*N_Cr: longest wait for the next consecutive frame, in ms*/
+#define ISOTP_TIMEOUT_CR_MS             (1000)
+
+/*number of successive flow control WAIT frames accepted before the transmission is aborted*/
+#define ISOTP_MAX_WFT                   (10)
+
+/*consecutive frames handed to the CAN TX queue per tick when the receiver asks for STmin 0,
+*keep it below CAN_TX_QUEUE_SIZE; one tick of frames at the bus rate keeps the bus busy*/
+#define ISOTP_MAX_CF_PER_TICK           (8)
+
+#endif
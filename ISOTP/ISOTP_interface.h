@@ -0,0 +1,171 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  ISOTP_interface.h
+ *  module:  ISOTP Module
+ *  @details:  interface header file for ISO 15765-2 (ISO-TP) segmentation of payloads up to 4095 bytes over CAN
+*********************************************************************************************************************/
+#ifndef _ISOTP_INTERFACE_H
+#define _ISOTP_INTERFACE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+#include "../../LIB/Std_Types.h"
+#include "../../LIB/Bit_Math.h"
+
+#include "../CAN/CAN_interface.h"
+#include "ISOTP_config.h"
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/** @defgroup ISOTP_length largest payload of one message (12-bit first frame length) **/
+#define ISOTP_MAX_LENGTH                (4095)
+
+/** @defgroup ISOTP_result result passed to the indication / confirmation callbacks **/
+#define ISOTP_RESULT_OK                 (0x0)  /*!< message completely received / handed to the CAN driver */
+#define ISOTP_RESULT_TIMEOUT_BS         (0x1)  /*!< no flow control frame within N_Bs */
+#define ISOTP_RESULT_TIMEOUT_CR         (0x2)  /*!< no consecutive frame within N_Cr */
+#define ISOTP_RESULT_WRONG_SN           (0x3)  /*!< consecutive frame out of sequence */
+#define ISOTP_RESULT_OVERFLOW           (0x4)  /*!< message longer than the receive buffer / receiver reported overflow */
+#define ISOTP_RESULT_INVALID_FS         (0x5)  /*!< flow control frame with a reserved flow status */
+#define ISOTP_RESULT_WFT_OVERRUN        (0x6)  /*!< more than ISOTP_MAX_WFT flow control WAIT frames */
+#define ISOTP_RESULT_UNEXPECTED_PDU     (0x7)  /*!< reception interrupted by a new single / first frame */
+
+/** @defgroup ISOTP_stmin STmin encodings **/
+#define ISOTP_STMIN_MS(MS)              ((uint8)(MS))                /*!< 0 - 127 ms */
+#define ISOTP_STMIN_100US(N)            ((uint8)(0xF0 + (N)))        /*!< 100 - 900 us, N = 1 - 9 */
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL DATA TYPES AND STRUCTURES
+---------------------------------------------------------------------------------------------------------------------*/
+/**
+  * @brief  addressing and flow control parameters of one channel (normal addressing, one pair of identifiers)
+  */
+typedef struct
+{
+  uint32 TxId;                  /*!< identifier of the frames sent, @ref CAN_frame_id */
+  uint32 RxId;                  /*!< identifier of the frames received, @ref CAN_frame_id */
+  uint8 BlockSize;              /*!< BS announced in our flow control frames, 0 = the sender never waits */
+  uint8 STmin;                  /*!< STmin announced in our flow control frames @ref ISOTP_stmin */
+  uint8 Padding;                /*!< value of the unused data bytes, every frame is sent with DLC 8 */
+}ISOTP_Config_t;
+
+struct ISOTP_Channel_TAG;
+
+/**
+  * @brief  end of a reception (indication) or of a transmission (confirmation)
+  *         u16Length is the message length, u8Result @ref ISOTP_result
+  */
+typedef void (*ISOTP_Notification_t)(struct ISOTP_Channel_TAG* pChannel,uint16 u16Length,uint8 u8Result);
+
+/**
+  * @brief  one transport channel, allocated by the caller and set up with ISOTP_VoidInit.
+  *         The fields are the state of the protocol and are not meant to be written by the application.
+  */
+typedef struct ISOTP_Channel_TAG
+{
+  const ISOTP_Config_t* pConfig;
+
+  /*reception*/
+  uint8* pRxBuffer;             /*!< caller buffer the message is reassembled in */
+  uint16 RxBufferSize;
+  uint16 RxLength;              /*!< length announced by the first frame */
+  uint16 RxIndex;               /*!< bytes received so far */
+  uint16 RxTimer;               /*!< N_Cr countdown in ticks */
+  uint8 RxState;
+  uint8 RxSN;                   /*!< sequence number expected in the next consecutive frame */
+  uint8 RxBlockCount;           /*!< consecutive frames left before our next flow control frame */
+  uint8 RxFcPending;            /*!< flow status still to send (CAN TX queue was full), 0xFF when none */
+  ISOTP_Notification_t RxIndication;
+
+  /*transmission*/
+  const uint8* pTxData;         /*!< caller buffer, not copied: keep it until the confirmation */
+  uint16 TxLength;
+  uint16 TxIndex;               /*!< bytes handed to the CAN driver so far */
+  uint16 TxTimer;               /*!< N_Bs or STmin countdown in ticks */
+  uint16 TxSTminTicks;          /*!< STmin of the receiver in ticks, 0 sends bursts */
+  uint8 TxState;
+  uint8 TxSN;                   /*!< sequence number of the next consecutive frame */
+  uint8 TxBlockSize;            /*!< BS of the receiver */
+  uint8 TxBlockCount;           /*!< consecutive frames left in the current block */
+  uint8 TxWaitCount;            /*!< successive flow control WAIT frames */
+  ISOTP_Notification_t TxConfirmation;
+}ISOTP_Channel_t;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Syntax          : void ISOTP_VoidInit(ISOTP_Channel_t* pChannel,const ISOTP_Config_t* pConfig,
+*                                        ISOTP_Notification_t pRxIndication,ISOTP_Notification_t pTxConfirmation)
+* \Description     : reset a channel. Frames are fed with ISOTP_VoidOnFrame, usually attached to the filter of
+*                    RxId with MCAN_VoidSetFilterHandler(bank,filter,ISOTP_VoidOnFrame,pChannel).
+*                    ISOTP_VoidOnFrame, ISOTP_VoidTick and ISOTP_u8Transmit of a channel must not preempt each
+*                    other: call them from the main loop (tick on a timer flag) or from interrupts of one priority
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pConfig channel parameters (kept by reference), pRxIndication end of reception,
+*                    pTxConfirmation end of transmission (both may be NULL)
+* \Parameters (out): pChannel channel to reset
+* \Return value:   : None
+*******************************************************************************/
+void ISOTP_VoidInit(ISOTP_Channel_t* pChannel,const ISOTP_Config_t* pConfig,
+                    ISOTP_Notification_t pRxIndication,ISOTP_Notification_t pTxConfirmation);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType ISOTP_u8SetRxBuffer(ISOTP_Channel_t* pChannel,uint8* pBuffer,uint16 u16Size)
+* \Description     : give the buffer the next messages are reassembled in; the payload of every frame is
+*                    copied from the CAN frame straight to its place in this buffer. The buffer stays attached,
+*                    call again from the indication to switch buffers (double buffering)
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pChannel channel, pBuffer buffer, u16Size buffer size (longer messages are refused)
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK while a multi-frame reception is in progress
+*******************************************************************************/
+Std_ReturnType ISOTP_u8SetRxBuffer(ISOTP_Channel_t* pChannel,uint8* pBuffer,uint16 u16Size);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType ISOTP_u8Transmit(ISOTP_Channel_t* pChannel,const uint8* pData,uint16 u16Length)
+* \Description     : send a message: single frame up to 7 bytes, otherwise first frame then consecutive frames
+*                    paced by the flow control of the receiver
+* \Sync\Async      : ASynchronous (TxConfirmation when the last frame is handed to the CAN driver or on error)
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pChannel channel, pData payload (not copied), u16Length 1 - ISOTP_MAX_LENGTH
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK when a transmission is in progress, the length is invalid
+*                    or the CAN TX queue is full
+*******************************************************************************/
+Std_ReturnType ISOTP_u8Transmit(ISOTP_Channel_t* pChannel,const uint8* pData,uint16 u16Length);
+
+/******************************************************************************
+* \Syntax          : void ISOTP_VoidOnFrame(const CAN_Frame_t* pFrame,void* pContext)
+* \Description     : process a received frame, signature of CAN_FrameHandler_t so it can be attached to a filter
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pFrame received frame (frames with another identifier than RxId are ignored),
+*                    pContext the ISOTP_Channel_t
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void ISOTP_VoidOnFrame(const CAN_Frame_t* pFrame,void* pContext);
+
+/******************************************************************************
+* \Syntax          : void ISOTP_VoidTick(ISOTP_Channel_t* pChannel)
+* \Description     : time base of the channel, call every ISOTP_TICK_US: sends the consecutive frames when
+*                    STmin has elapsed and runs the N_Bs / N_Cr timeouts
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pChannel channel
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void ISOTP_VoidTick(ISOTP_Channel_t* pChannel);
+
+#endif
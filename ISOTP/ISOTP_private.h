@@ -0,0 +1,56 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  ISOTP_private.h
+ *  module:  ISOTP Module
+ *  @details:  private header file for ISO 15765-2 transport layer
+*********************************************************************************************************************/
+#ifndef _ISOTP_PRIVATE_H
+#define _ISOTP_PRIVATE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*protocol control information, high nibble of the first data byte*/
+#define ISOTP_PCI_SF                    (0x00)
+#define ISOTP_PCI_FF                    (0x10)
+#define ISOTP_PCI_CF                    (0x20)
+#define ISOTP_PCI_FC                    (0x30)
+#define ISOTP_PCI_TYPE_MASK             (0xF0)
+
+/*flow status of a flow control frame*/
+#define ISOTP_FS_CTS                    (0x0)
+#define ISOTP_FS_WAIT                   (0x1)
+#define ISOTP_FS_OVFLW                  (0x2)
+
+/*no flow control frame waiting to be sent*/
+#define ISOTP_FC_NONE                   (0xFF)
+
+/*payload bytes per frame type (classic CAN, normal addressing)*/
+#define ISOTP_SF_MAX_DATA               (7)
+#define ISOTP_FF_DATA                   (6)
+#define ISOTP_CF_DATA                   (7)
+
+/*reception states*/
+#define ISOTP_RX_IDLE                   (0)
+#define ISOTP_RX_WAIT_CF                (1)
+
+/*transmission states*/
+#define ISOTP_TX_IDLE                   (0)
+#define ISOTP_TX_WAIT_FC                (1)
+#define ISOTP_TX_SEND_CF                (2)
+
+/*timeouts in ticks*/
+#define ISOTP_MS_TO_TICKS(MS)           ((uint16)(((uint32)(MS) * 1000 + ISOTP_TICK_US - 1) / ISOTP_TICK_US))
+#define ISOTP_TIMEOUT_BS_TICKS          ISOTP_MS_TO_TICKS(ISOTP_TIMEOUT_BS_MS)
+#define ISOTP_TIMEOUT_CR_TICKS          ISOTP_MS_TO_TICKS(ISOTP_TIMEOUT_CR_MS)
+
+/*STmin above 0x7F ms or in the reserved ranges is handled as the longest value (ISO 15765-2)*/
+#define ISOTP_STMIN_MAX_US              (127000UL)
+
+#endif
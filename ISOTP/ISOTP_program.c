@@ -0,0 +1,500 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  ISOTP_program.c
+ *  module:  ISOTP Module
+ *  @details:  program file for ISO 15765-2 transport layer (normal addressing, classic CAN)
+*********************************************************************************************************************/
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+
+#include "../../LIB/Std_Types.h"
+#include "../../LIB/Bit_Math.h"
+
+#include "ISOTP_config.h"
+#include "ISOTP_private.h"
+#include "ISOTP_interface.h"
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Description     : copy payload bytes between a frame and the caller buffer
+*******************************************************************************/
+static void ISOTP_VoidCopy(uint8* pDst,const uint8* pSrc,uint8 u8Count)
+{
+    while(u8Count-- > 0)
+    {
+        *pDst++ = *pSrc++;
+    }
+}
+
+/******************************************************************************
+* \Description     : start a frame of the channel: TX identifier, DLC 8, padding and the PCI byte
+*******************************************************************************/
+static void ISOTP_VoidFrameInit(const ISOTP_Channel_t* pChannel,CAN_Frame_t* pFrame,uint8 u8Pci)
+{
+    uint32 Local_u32Fill = (uint32)pChannel->pConfig->Padding * 0x01010101UL;
+
+    pFrame->Id = pChannel->pConfig->TxId;
+    pFrame->DLC = 8;
+    pFrame->Data.Words[0] = Local_u32Fill;
+    pFrame->Data.Words[1] = Local_u32Fill;
+    pFrame->Data.Bytes[0] = u8Pci;
+}
+
+/******************************************************************************
+* \Description     : STmin of a flow control frame converted to ticks (rounded up so it is never shorter)
+*******************************************************************************/
+static uint16 ISOTP_u16STminTicks(uint8 u8STmin)
+{
+    uint32 Local_u32Us;
+
+    if(u8STmin <= 0x7F)
+    {
+        Local_u32Us = (uint32)u8STmin * 1000;
+    }
+    else if(u8STmin >= 0xF1 && u8STmin <= 0xF9)
+    {
+        Local_u32Us = (uint32)(u8STmin - 0xF0) * 100;
+    }
+    else
+    {
+        Local_u32Us = ISOTP_STMIN_MAX_US;
+    }
+    return (uint16)((Local_u32Us + ISOTP_TICK_US - 1) / ISOTP_TICK_US);
+}
+
+/******************************************************************************
+* \Description     : end the reception and notify the application
+*******************************************************************************/
+static void ISOTP_VoidRxEnd(ISOTP_Channel_t* pChannel,uint16 u16Length,uint8 u8Result)
+{
+    pChannel->RxState = ISOTP_RX_IDLE;
+    if(pChannel->RxIndication!=NULL)
+    {
+        pChannel->RxIndication(pChannel,u16Length,u8Result);
+    }
+}
+
+/******************************************************************************
+* \Description     : end the transmission and notify the application
+*******************************************************************************/
+static void ISOTP_VoidTxEnd(ISOTP_Channel_t* pChannel,uint8 u8Result)
+{
+    pChannel->TxState = ISOTP_TX_IDLE;
+    if(pChannel->TxConfirmation!=NULL)
+    {
+        pChannel->TxConfirmation(pChannel,pChannel->TxLength,u8Result);
+    }
+}
+
+/******************************************************************************
+* \Description     : send our flow control frame, kept pending and retried from the tick when the
+*                    CAN TX queue is full
+*******************************************************************************/
+static void ISOTP_VoidSendFlowControl(ISOTP_Channel_t* pChannel,uint8 u8FlowStatus)
+{
+    CAN_Frame_t Local_Frame;
+
+    ISOTP_VoidFrameInit(pChannel,&Local_Frame,ISOTP_PCI_FC | u8FlowStatus);
+    Local_Frame.Data.Bytes[1] = pChannel->pConfig->BlockSize;
+    Local_Frame.Data.Bytes[2] = pChannel->pConfig->STmin;
+    if(MCAN_u8TransmitFrame(&Local_Frame)==CAN_TX_QUEUE_FULL)
+    {
+        pChannel->RxFcPending = u8FlowStatus;
+    }
+    else
+    {
+        pChannel->RxFcPending = ISOTP_FC_NONE;
+    }
+}
+
+/******************************************************************************
+* \Description     : send the consecutive frames due now: one, or up to ISOTP_MAX_CF_PER_TICK when the
+*                    receiver asked for STmin 0; stops at the end of the message or of the block
+*******************************************************************************/
+static void ISOTP_VoidSendConsecutive(ISOTP_Channel_t* pChannel)
+{
+    uint8 Local_u8Burst = (pChannel->TxSTminTicks==0) ? ISOTP_MAX_CF_PER_TICK : 1;
+    CAN_Frame_t Local_Frame;
+    uint16 Local_u16Left;
+    uint8 Local_u8Size;
+
+    while(Local_u8Burst-- > 0)
+    {
+        Local_u16Left = pChannel->TxLength - pChannel->TxIndex;
+        Local_u8Size = (Local_u16Left < ISOTP_CF_DATA) ? (uint8)Local_u16Left : ISOTP_CF_DATA;
+        ISOTP_VoidFrameInit(pChannel,&Local_Frame,ISOTP_PCI_CF | pChannel->TxSN);
+        ISOTP_VoidCopy(&Local_Frame.Data.Bytes[1],&pChannel->pTxData[pChannel->TxIndex],Local_u8Size);
+        if(MCAN_u8TransmitFrame(&Local_Frame)==CAN_TX_QUEUE_FULL)
+        {
+            /*retried on the next tick*/
+            pChannel->TxTimer = 0;
+            return;
+        }
+        pChannel->TxIndex += Local_u8Size;
+        pChannel->TxSN = (pChannel->TxSN + 1) & 0x0F;
+        if(pChannel->TxIndex >= pChannel->TxLength)
+        {
+            ISOTP_VoidTxEnd(pChannel,ISOTP_RESULT_OK);
+            return;
+        }
+        if(pChannel->TxBlockSize!=0 && --pChannel->TxBlockCount==0)
+        {
+            pChannel->TxState = ISOTP_TX_WAIT_FC;
+            pChannel->TxTimer = ISOTP_TIMEOUT_BS_TICKS;
+            return;
+        }
+    }
+    pChannel->TxTimer = pChannel->TxSTminTicks;
+}
+
+/******************************************************************************
+* \Description     : single frame: the whole message in one frame
+*******************************************************************************/
+static void ISOTP_VoidRxSingle(ISOTP_Channel_t* pChannel,const CAN_Frame_t* pFrame,uint8 u8Dlc)
+{
+    uint8 Local_u8Length = pFrame->Data.Bytes[0] & 0x0F;
+
+    if(Local_u8Length==0 || Local_u8Length > ISOTP_SF_MAX_DATA || Local_u8Length >= u8Dlc)
+    {
+        return;
+    }
+    if(pChannel->RxState!=ISOTP_RX_IDLE)
+    {
+        ISOTP_VoidRxEnd(pChannel,pChannel->RxIndex,ISOTP_RESULT_UNEXPECTED_PDU);
+    }
+    if(pChannel->pRxBuffer==NULL || Local_u8Length > pChannel->RxBufferSize)
+    {
+        ISOTP_VoidRxEnd(pChannel,Local_u8Length,ISOTP_RESULT_OVERFLOW);
+        return;
+    }
+    ISOTP_VoidCopy(pChannel->pRxBuffer,&pFrame->Data.Bytes[1],Local_u8Length);
+    ISOTP_VoidRxEnd(pChannel,Local_u8Length,ISOTP_RESULT_OK);
+}
+
+/******************************************************************************
+* \Description     : first frame: check the length against the buffer and answer with a flow control frame
+*******************************************************************************/
+static void ISOTP_VoidRxFirst(ISOTP_Channel_t* pChannel,const CAN_Frame_t* pFrame,uint8 u8Dlc)
+{
+    uint16 Local_u16Length = ((uint16)(pFrame->Data.Bytes[0] & 0x0F) << 8) | pFrame->Data.Bytes[1];
+
+    /*FF_DL 0 (escape to a 32-bit length above 4095) is not supported*/
+    if(Local_u16Length <= ISOTP_SF_MAX_DATA || u8Dlc < 8)
+    {
+        return;
+    }
+    if(pChannel->RxState!=ISOTP_RX_IDLE)
+    {
+        ISOTP_VoidRxEnd(pChannel,pChannel->RxIndex,ISOTP_RESULT_UNEXPECTED_PDU);
+    }
+    if(pChannel->pRxBuffer==NULL || Local_u16Length > pChannel->RxBufferSize)
+    {
+        ISOTP_VoidSendFlowControl(pChannel,ISOTP_FS_OVFLW);
+        ISOTP_VoidRxEnd(pChannel,Local_u16Length,ISOTP_RESULT_OVERFLOW);
+        return;
+    }
+    ISOTP_VoidCopy(pChannel->pRxBuffer,&pFrame->Data.Bytes[2],ISOTP_FF_DATA);
+    pChannel->RxLength = Local_u16Length;
+    pChannel->RxIndex = ISOTP_FF_DATA;
+    pChannel->RxSN = 1;
+    pChannel->RxBlockCount = pChannel->pConfig->BlockSize;
+    pChannel->RxTimer = ISOTP_TIMEOUT_CR_TICKS;
+    pChannel->RxState = ISOTP_RX_WAIT_CF;
+    ISOTP_VoidSendFlowControl(pChannel,ISOTP_FS_CTS);
+}
+
+/******************************************************************************
+* \Description     : consecutive frame: payload copied to its place in the caller buffer
+*******************************************************************************/
+static void ISOTP_VoidRxConsecutive(ISOTP_Channel_t* pChannel,const CAN_Frame_t* pFrame,uint8 u8Dlc)
+{
+    uint16 Local_u16Left = pChannel->RxLength - pChannel->RxIndex;
+    uint8 Local_u8Size = (Local_u16Left < ISOTP_CF_DATA) ? (uint8)Local_u16Left : ISOTP_CF_DATA;
+
+    if(pChannel->RxState!=ISOTP_RX_WAIT_CF)
+    {
+        return;
+    }
+    if((pFrame->Data.Bytes[0] & 0x0F)!=pChannel->RxSN)
+    {
+        ISOTP_VoidRxEnd(pChannel,pChannel->RxIndex,ISOTP_RESULT_WRONG_SN);
+        return;
+    }
+    if(u8Dlc <= Local_u8Size)
+    {
+        return;
+    }
+    ISOTP_VoidCopy(&pChannel->pRxBuffer[pChannel->RxIndex],&pFrame->Data.Bytes[1],Local_u8Size);
+    pChannel->RxIndex += Local_u8Size;
+    pChannel->RxSN = (pChannel->RxSN + 1) & 0x0F;
+    if(pChannel->RxIndex >= pChannel->RxLength)
+    {
+        ISOTP_VoidRxEnd(pChannel,pChannel->RxLength,ISOTP_RESULT_OK);
+        return;
+    }
+    pChannel->RxTimer = ISOTP_TIMEOUT_CR_TICKS;
+    if(pChannel->pConfig->BlockSize!=0 && --pChannel->RxBlockCount==0)
+    {
+        pChannel->RxBlockCount = pChannel->pConfig->BlockSize;
+        ISOTP_VoidSendFlowControl(pChannel,ISOTP_FS_CTS);
+    }
+}
+
+/******************************************************************************
+* \Description     : flow control frame of the receiver of our message
+*******************************************************************************/
+static void ISOTP_VoidRxFlowControl(ISOTP_Channel_t* pChannel,const CAN_Frame_t* pFrame,uint8 u8Dlc)
+{
+    if(pChannel->TxState!=ISOTP_TX_WAIT_FC || u8Dlc < 3)
+    {
+        return;
+    }
+    switch(pFrame->Data.Bytes[0] & 0x0F)
+    {
+        case ISOTP_FS_CTS:
+            pChannel->TxBlockSize = pFrame->Data.Bytes[1];
+            pChannel->TxBlockCount = pFrame->Data.Bytes[1];
+            pChannel->TxSTminTicks = ISOTP_u16STminTicks(pFrame->Data.Bytes[2]);
+            pChannel->TxWaitCount = 0;
+            pChannel->TxState = ISOTP_TX_SEND_CF;
+            if(pChannel->TxSTminTicks==0)
+            {
+                /*no pacing asked: start the block now instead of on the next tick*/
+                ISOTP_VoidSendConsecutive(pChannel);
+            }
+            else
+            {
+                /*send on a tick so the following frames are spaced by whole ticks*/
+                pChannel->TxTimer = 1;
+            }
+            break;
+        case ISOTP_FS_WAIT:
+            if(++pChannel->TxWaitCount > ISOTP_MAX_WFT)
+            {
+                ISOTP_VoidTxEnd(pChannel,ISOTP_RESULT_WFT_OVERRUN);
+            }
+            else
+            {
+                pChannel->TxTimer = ISOTP_TIMEOUT_BS_TICKS;
+            }
+            break;
+        case ISOTP_FS_OVFLW:
+            ISOTP_VoidTxEnd(pChannel,ISOTP_RESULT_OVERFLOW);
+            break;
+        default:
+            ISOTP_VoidTxEnd(pChannel,ISOTP_RESULT_INVALID_FS);
+            break;
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Syntax          : void ISOTP_VoidInit(ISOTP_Channel_t* pChannel,const ISOTP_Config_t* pConfig,
+*                                        ISOTP_Notification_t pRxIndication,ISOTP_Notification_t pTxConfirmation)
+* \Description     : reset a channel. Frames are fed with ISOTP_VoidOnFrame, usually attached to the filter of
+*                    RxId with MCAN_VoidSetFilterHandler(bank,filter,ISOTP_VoidOnFrame,pChannel).
+*                    ISOTP_VoidOnFrame, ISOTP_VoidTick and ISOTP_u8Transmit of a channel must not preempt each
+*                    other: call them from the main loop (tick on a timer flag) or from interrupts of one priority
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pConfig channel parameters (kept by reference), pRxIndication end of reception,
+*                    pTxConfirmation end of transmission (both may be NULL)
+* \Parameters (out): pChannel channel to reset
+* \Return value:   : None
+*******************************************************************************/
+void ISOTP_VoidInit(ISOTP_Channel_t* pChannel,const ISOTP_Config_t* pConfig,
+                    ISOTP_Notification_t pRxIndication,ISOTP_Notification_t pTxConfirmation)
+{
+    pChannel->pConfig = pConfig;
+
+    pChannel->pRxBuffer = NULL;
+    pChannel->RxBufferSize = 0;
+    pChannel->RxLength = 0;
+    pChannel->RxIndex = 0;
+    pChannel->RxTimer = 0;
+    pChannel->RxState = ISOTP_RX_IDLE;
+    pChannel->RxSN = 0;
+    pChannel->RxBlockCount = 0;
+    pChannel->RxFcPending = ISOTP_FC_NONE;
+    pChannel->RxIndication = pRxIndication;
+
+    pChannel->pTxData = NULL;
+    pChannel->TxLength = 0;
+    pChannel->TxIndex = 0;
+    pChannel->TxTimer = 0;
+    pChannel->TxSTminTicks = 0;
+    pChannel->TxState = ISOTP_TX_IDLE;
+    pChannel->TxSN = 0;
+    pChannel->TxBlockSize = 0;
+    pChannel->TxBlockCount = 0;
+    pChannel->TxWaitCount = 0;
+    pChannel->TxConfirmation = pTxConfirmation;
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType ISOTP_u8SetRxBuffer(ISOTP_Channel_t* pChannel,uint8* pBuffer,uint16 u16Size)
+* \Description     : give the buffer the next messages are reassembled in; the payload of every frame is
+*                    copied from the CAN frame straight to its place in this buffer. The buffer stays attached,
+*                    call again from the indication to switch buffers (double buffering)
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pChannel channel, pBuffer buffer, u16Size buffer size (longer messages are refused)
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK while a multi-frame reception is in progress
+*******************************************************************************/
+Std_ReturnType ISOTP_u8SetRxBuffer(ISOTP_Channel_t* pChannel,uint8* pBuffer,uint16 u16Size)
+{
+    if(pChannel->RxState!=ISOTP_RX_IDLE)
+    {
+        return N_OK;
+    }
+    pChannel->pRxBuffer = pBuffer;
+    pChannel->RxBufferSize = u16Size;
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType ISOTP_u8Transmit(ISOTP_Channel_t* pChannel,const uint8* pData,uint16 u16Length)
+* \Description     : send a message: single frame up to 7 bytes, otherwise first frame then consecutive frames
+*                    paced by the flow control of the receiver
+* \Sync\Async      : ASynchronous (TxConfirmation when the last frame is handed to the CAN driver or on error)
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pChannel channel, pData payload (not copied), u16Length 1 - ISOTP_MAX_LENGTH
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK when a transmission is in progress, the length is invalid
+*                    or the CAN TX queue is full
+*******************************************************************************/
+Std_ReturnType ISOTP_u8Transmit(ISOTP_Channel_t* pChannel,const uint8* pData,uint16 u16Length)
+{
+    CAN_Frame_t Local_Frame;
+
+    if(pChannel->TxState!=ISOTP_TX_IDLE || pData==NULL || u16Length==0 || u16Length > ISOTP_MAX_LENGTH)
+    {
+        return N_OK;
+    }
+    if(u16Length <= ISOTP_SF_MAX_DATA)
+    {
+        ISOTP_VoidFrameInit(pChannel,&Local_Frame,ISOTP_PCI_SF | (uint8)u16Length);
+        ISOTP_VoidCopy(&Local_Frame.Data.Bytes[1],pData,(uint8)u16Length);
+        if(MCAN_u8TransmitFrame(&Local_Frame)==CAN_TX_QUEUE_FULL)
+        {
+            return N_OK;
+        }
+        pChannel->TxLength = u16Length;
+        ISOTP_VoidTxEnd(pChannel,ISOTP_RESULT_OK);
+        return OK;
+    }
+
+    ISOTP_VoidFrameInit(pChannel,&Local_Frame,ISOTP_PCI_FF | (uint8)(u16Length >> 8));
+    Local_Frame.Data.Bytes[1] = (uint8)u16Length;
+    ISOTP_VoidCopy(&Local_Frame.Data.Bytes[2],pData,ISOTP_FF_DATA);
+    if(MCAN_u8TransmitFrame(&Local_Frame)==CAN_TX_QUEUE_FULL)
+    {
+        return N_OK;
+    }
+    pChannel->pTxData = pData;
+    pChannel->TxLength = u16Length;
+    pChannel->TxIndex = ISOTP_FF_DATA;
+    pChannel->TxSN = 1;
+    pChannel->TxWaitCount = 0;
+    pChannel->TxTimer = ISOTP_TIMEOUT_BS_TICKS;
+    pChannel->TxState = ISOTP_TX_WAIT_FC;
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : void ISOTP_VoidOnFrame(const CAN_Frame_t* pFrame,void* pContext)
+* \Description     : process a received frame, signature of CAN_FrameHandler_t so it can be attached to a filter
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pFrame received frame (frames with another identifier than RxId are ignored),
+*                    pContext the ISOTP_Channel_t
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void ISOTP_VoidOnFrame(const CAN_Frame_t* pFrame,void* pContext)
+{
+    ISOTP_Channel_t* pChannel = (ISOTP_Channel_t*)pContext;
+    /*DLC 9-15 means 8 bytes*/
+    uint8 Local_u8Dlc = (pFrame->DLC > 8) ? 8 : pFrame->DLC;
+
+    if(pFrame->Id!=pChannel->pConfig->RxId || Local_u8Dlc==0)
+    {
+        return;
+    }
+    switch(pFrame->Data.Bytes[0] & ISOTP_PCI_TYPE_MASK)
+    {
+        case ISOTP_PCI_SF:
+            ISOTP_VoidRxSingle(pChannel,pFrame,Local_u8Dlc);
+            break;
+        case ISOTP_PCI_FF:
+            ISOTP_VoidRxFirst(pChannel,pFrame,Local_u8Dlc);
+            break;
+        case ISOTP_PCI_CF:
+            ISOTP_VoidRxConsecutive(pChannel,pFrame,Local_u8Dlc);
+            break;
+        case ISOTP_PCI_FC:
+            ISOTP_VoidRxFlowControl(pChannel,pFrame,Local_u8Dlc);
+            break;
+        default:
+            break;
+    }
+}
+
+/******************************************************************************
+* \Syntax          : void ISOTP_VoidTick(ISOTP_Channel_t* pChannel)
+* \Description     : time base of the channel, call every ISOTP_TICK_US: sends the consecutive frames when
+*                    STmin has elapsed and runs the N_Bs / N_Cr timeouts
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pChannel channel
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void ISOTP_VoidTick(ISOTP_Channel_t* pChannel)
+{
+    /*reception*/
+    if(pChannel->RxFcPending!=ISOTP_FC_NONE)
+    {
+        ISOTP_VoidSendFlowControl(pChannel,pChannel->RxFcPending);
+    }
+    if(pChannel->RxState==ISOTP_RX_WAIT_CF && --pChannel->RxTimer==0)
+    {
+        ISOTP_VoidRxEnd(pChannel,pChannel->RxIndex,ISOTP_RESULT_TIMEOUT_CR);
+    }
+
+    /*transmission*/
+    switch(pChannel->TxState)
+    {
+        case ISOTP_TX_WAIT_FC:
+            if(--pChannel->TxTimer==0)
+            {
+                ISOTP_VoidTxEnd(pChannel,ISOTP_RESULT_TIMEOUT_BS);
+            }
+            break;
+        case ISOTP_TX_SEND_CF:
+            if(pChannel->TxTimer > 0)
+            {
+                pChannel->TxTimer--;
+            }
+            if(pChannel->TxTimer==0)
+            {
+                ISOTP_VoidSendConsecutive(pChannel);
+            }
+            break;
+        default:
+            break;
+    }
+}
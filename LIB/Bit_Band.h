@@ -0,0 +1,65 @@
+/*---------------------------------------------------------------------------------------------------------------------
+ *  FILE DESCRIPTION
+ *  -----------------
+ *         File:  Bit_Band.h
+ *       Module:  Bit Band Module
+ *  Description:  Cortex-M3 bit-band alias macros: a single bit of the first 1MB of SRAM (0x20000000) or of the
+ *                peripherals (0x40000000) is one word of its alias region (0x22000000 / 0x42000000), so setting,
+ *                clearing or reading it is one load or store. The write is a locked read-modify-write on the
+ *                bus and cannot be broken by an interrupt touching the other bits of the same register.
+ *                The alias is computed from the register address, at compile time when the address is constant.
+ *                Write-1-to-clear flags (DMA IFCR, CAN TSR/RFR...) need no bit-band: a plain store of the bit
+ *                is already single and atomic.
+ *                Off target (host simulation, syntax checks) there is no alias region and the macros fall back
+ *                to the read-modify-write of Bit_Math.h
+---------------------------------------------------------------------------------------------------------------------*/
+#ifndef BIT_BAND_H
+#define BIT_BAND_H
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+#include "Std_Types.h"
+#include "Bit_Math.h"
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL CONSTANT MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+#ifndef BIT_BAND_ENABLE
+#if defined(__arm__) || defined(__thumb__)
+#define BIT_BAND_ENABLE                 1
+#else
+#define BIT_BAND_ENABLE                 0
+#endif
+#endif
+
+#define BIT_BAND_SRAM_BASE              0x20000000UL
+#define BIT_BAND_SRAM_ALIAS             0x22000000UL
+#define BIT_BAND_PERI_BASE              0x40000000UL
+#define BIT_BAND_PERI_ALIAS             0x42000000UL
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTION MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*alias word of bit BIT of the word at ADDR: region base + 0x02000000 + byte offset * 32 + bit * 4.
+  ADDR must be in the first 1MB of SRAM or of the peripherals*/
+#define BIT_BAND_ALIAS(ADDR,BIT)        (*(volatile uint32*)(((uint32)(uintptr_t)(ADDR) & 0xF0000000UL) + 0x02000000UL + \
+                                         (((uint32)(uintptr_t)(ADDR) & 0x000FFFFFUL) << 5) + ((uint32)(BIT) << 2)))
+#define BIT_BAND_SRAM(ADDR,BIT)         (*(volatile uint32*)(BIT_BAND_SRAM_ALIAS + \
+                                         (((uint32)(uintptr_t)(ADDR) - BIT_BAND_SRAM_BASE) << 5) + ((uint32)(BIT) << 2)))
+#define BIT_BAND_PERI(ADDR,BIT)         (*(volatile uint32*)(BIT_BAND_PERI_ALIAS + \
+                                         (((uint32)(uintptr_t)(ADDR) - BIT_BAND_PERI_BASE) << 5) + ((uint32)(BIT) << 2)))
+
+/*bit access on a register or an SRAM word given as an lvalue, as SET_BIT / CLEAR_BIT / READ_BIT*/
+#if BIT_BAND_ENABLE == 1
+#define BB_SET_BIT(REG,BIT)             (BIT_BAND_ALIAS(&(REG),(BIT)) = 1UL)
+#define BB_CLEAR_BIT(REG,BIT)           (BIT_BAND_ALIAS(&(REG),(BIT)) = 0UL)
+#define BB_WRITE_BIT(REG,BIT,VALUE)     (BIT_BAND_ALIAS(&(REG),(BIT)) = ((VALUE) != 0) ? 1UL : 0UL)
+#define BB_READ_BIT(REG,BIT)            (BIT_BAND_ALIAS(&(REG),(BIT)))
+#else
+#define BB_SET_BIT(REG,BIT)             SET_BIT((REG),(BIT))
+#define BB_CLEAR_BIT(REG,BIT)           CLEAR_BIT((REG),(BIT))
+#define BB_WRITE_BIT(REG,BIT,VALUE)     (((VALUE) != 0) ? SET_BIT((REG),(BIT)) : CLEAR_BIT((REG),(BIT)))
+#define BB_READ_BIT(REG,BIT)            READ_BIT((REG),(BIT))
+#endif
+
+#endif
@@ -6,14 +6,24 @@
 ---------------------------------------------------------------------------------------------------------------------*/
 #ifndef STD_TYPES_H
 #define STD_TYPES_H
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+/*fixed width types of the compiler: the same widths on the target and on 64-bit hosts (CAN_SIMULATION builds),
+  uintptr_t for the addresses written to registers*/
+#include <stdint.h>
+
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL DATA TYPES AND STRUCTURES
 ---------------------------------------------------------------------------------------------------------------------*/
-typedef unsigned char         uint8;         
-typedef unsigned short        uint16;   
-typedef unsigned long         uint32;
-typedef signed long           sint32;
-typedef unsigned long long    uint64;
+typedef uint8_t               uint8;
+typedef uint16_t              uint16;
+typedef uint32_t              uint32;
+typedef int8_t                sint8;
+typedef int16_t               sint16;
+typedef int32_t               sint32;
+typedef uint64_t              uint64;
+typedef int64_t               sint64;
 
 typedef enum
 {
@@ -23,6 +33,8 @@ typedef enum
 /*---------------------------------------------------------------------------------------------------------------------
     GLOBAL MACROS
 ---------------------------------------------------------------------------------------------------------------------*/
+#ifndef NULL
 #define NULL                    ((void*)0)
+#endif
 
 #endif 
\ No newline at end of file
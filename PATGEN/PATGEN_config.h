@@ -0,0 +1,35 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  PATGEN_config.h
+ *  module:  PATGEN Module
+ *  @details:  Configuration header file for the timer paced DMA to GPIO pattern generator
+*********************************************************************************************************************/
+#ifndef _PATGEN_CONFIG_H
+#define _PATGEN_CONFIG_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*options of PATGEN_TIMER: the update DMA request of the timer paces the pattern, each timer owns a DMA1 channel
+  (TIM2_UP ch2, TIM3_UP ch3, TIM4_UP ch7, TIM1_UP ch5) that is then not usable by other drivers*/
+#define PATGEN_TIM1                     (1)
+#define PATGEN_TIM2                     (2)
+#define PATGEN_TIM3                     (3)
+#define PATGEN_TIM4                     (4)
+
+#define PATGEN_TIMER                    PATGEN_TIM2
+
+/*port driven by the pattern words, @ref GPIO_Num*/
+#define PATGEN_PORT                     _GPIOB_PORT
+
+/*shortest step in timer clock cycles: a 32-bit DMA transfer to the APB2 GPIO takes some cycles of the bus matrix,
+  shorter steps are skipped by the DMA and the waveform stretches*/
+#define PATGEN_MIN_STEP_CYCLES          (16)
+
+#endif
@@ -0,0 +1,142 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  PATGEN_interface.h
+ *  module:  PATGEN Module
+ *  @details:  interface header file for the pattern generator: a table of 32-bit BSRR words in RAM is moved by
+ *             the update DMA request of a timer into the BSRR of PATGEN_PORT, one word per timer period. All the
+ *             pins of a word change in the same bus cycle and no CPU time is spent per edge
+*********************************************************************************************************************/
+#ifndef _PATGEN_INTERFACE_H
+#define _PATGEN_INTERFACE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+#include "../../LIB/Std_Types.h"
+#include "../../LIB/Bit_Math.h"
+
+#include "../GPIO/GPIO_interface.h"
+#include "PATGEN_config.h"
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/** @defgroup PATGEN_word pattern word driving the pins of MASK to the bits of VALUE, the other pins kept **/
+#define PATGEN_WORD(MASK,VALUE)         ((((uint32)(uint16)(~(VALUE) & (MASK))) << 16) | (uint32)((VALUE) & (MASK)))
+
+/** @defgroup PATGEN_mode playback of PATGEN_u8Start **/
+#define PATGEN_MODE_ONE_SHOT            (0)    /*!< the pattern once, the pins keep the last word */
+#define PATGEN_MODE_CIRCULAR            (1)    /*!< the pattern repeated until stopped */
+#define PATGEN_MODE_DOUBLE_BUFFER       (2)    /*!< circular, each half refilled by the callback while the
+                                                    other one plays */
+
+/** @defgroup PATGEN_event event of PATGEN_Callback_t **/
+#define PATGEN_EVENT_HALF               (0)    /*!< double buffer: the first half was played, refill it */
+#define PATGEN_EVENT_FULL               (1)    /*!< double buffer: the second half was played, refill it */
+#define PATGEN_EVENT_SWAPPED            (2)    /*!< the pattern given to PATGEN_u8Queue started */
+#define PATGEN_EVENT_DONE               (3)    /*!< one shot: the last word was written, the timer is stopped */
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL DATA TYPES AND STRUCTURES
+---------------------------------------------------------------------------------------------------------------------*/
+/**
+  * @brief  notification of the generator, from the DMA interrupt: u16First / u16Count are the words of the
+  *         pattern concerned (the free half for @ref PATGEN_EVENT_HALF / @ref PATGEN_EVENT_FULL)
+  */
+typedef void (*PATGEN_Callback_t)(uint8 u8Event,uint16 u16First,uint16 u16Count);
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Syntax          : void PATGEN_VoidInit(uint16 u16PinMask)
+* \Description     : set the pins of the mask as 50 MHz push-pull outputs of PATGEN_PORT, set up the timer as a
+*                    stopped time base with its update DMA request and the DMA1 channel of the request
+*                    (memory to BSRR, 32-bit). Enable the DMA1 channel interrupt in the NVIC for the callback
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u16PinMask pins driven by the patterns (bit n = pin n)
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void PATGEN_VoidInit(uint16 u16PinMask);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType PATGEN_u8SetStep(uint32 u32Cycles)
+* \Description     : set the time between two words in timer clock cycles, split in prescaler and auto-reload.
+*                    Above 65536 cycles the step is rounded down to a multiple of the prescaler. Takes effect
+*                    at the next update, a running pattern changes rate without a glitch
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u32Cycles step, from PATGEN_MIN_STEP_CYCLES
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK below PATGEN_MIN_STEP_CYCLES
+*******************************************************************************/
+Std_ReturnType PATGEN_u8SetStep(uint32 u32Cycles);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType PATGEN_u8Start(const uint32* pPattern,uint16 u16Count,uint8 u8Mode)
+* \Description     : play a pattern, the first word written at once and the next ones one step apart. A running
+*                    pattern is stopped first. The pattern stays in RAM until stopped (or done in one shot)
+* \Sync\Async      : Asynchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pPattern words (@ref PATGEN_word), u16Count number of words (even in double buffer),
+*                    u8Mode @ref PATGEN_mode
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK on an empty pattern, an odd double buffer or an invalid mode
+*******************************************************************************/
+Std_ReturnType PATGEN_u8Start(const uint32* pPattern,uint16 u16Count,uint8 u8Mode);
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType PATGEN_u8Queue(const uint32* pPattern,uint16 u16Count)
+* \Description     : play another pattern after the end of the running one, in its mode (one shot patterns are
+*                    chained). The swap is done in the DMA complete interrupt: it is seamless when the step is
+*                    longer than the interrupt latency, otherwise the first word of the old pattern is repeated
+* \Sync\Async      : Asynchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pPattern words (@ref PATGEN_word), u16Count number of words
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK when stopped, in double buffer, on an empty pattern or a pattern
+*                    already queued
+*******************************************************************************/
+Std_ReturnType PATGEN_u8Queue(const uint32* pPattern,uint16 u16Count);
+
+/******************************************************************************
+* \Syntax          : void PATGEN_VoidStop(void)
+* \Description     : stop the timer and the DMA channel, the pins keep the last word written
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void PATGEN_VoidStop(void);
+
+/******************************************************************************
+* \Syntax          : void PATGEN_VoidSetCallback(PATGEN_Callback_t pCallback)
+* \Description     : set the notification of the generator, NULL for none
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pCallback notification
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void PATGEN_VoidSetCallback(PATGEN_Callback_t pCallback);
+
+/******************************************************************************
+* \Syntax          : uint16 PATGEN_u16GetPosition(void)
+* \Description     : index of the next word of the running pattern to be written
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint16 word index, 0 when stopped
+*******************************************************************************/
+uint16 PATGEN_u16GetPosition(void);
+
+#endif
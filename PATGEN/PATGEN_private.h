@@ -0,0 +1,83 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  PATGEN_private.h
+ *  module:  PATGEN Module
+ *  @details:  private header file for the timer paced DMA to GPIO pattern generator: the registers of the
+ *             timers used as time base only (no capture / compare)
+*********************************************************************************************************************/
+#ifndef _PATGEN_PRIVATE_H
+#define _PATGEN_PRIVATE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL DATA TYPES AND STRUCTURES
+---------------------------------------------------------------------------------------------------------------------*/
+/** @brief PATGEN_TIM_t time base registers of TIM1-TIM4, the capture / compare registers are not used */
+typedef struct
+{
+    uint32 CR1;
+    uint32 CR2;
+    uint32 SMCR;
+    uint32 DIER;
+    uint32 SR;
+    uint32 EGR;
+    uint32 CCMR1;
+    uint32 CCMR2;
+    uint32 CCER;
+    uint32 CNT;
+    uint32 PSC;
+    uint32 ARR;
+}PATGEN_TIM_t;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*TIMx_CR1*/
+#define PATGEN_CR1_CEN                  (0)
+#define PATGEN_CR1_ARPE                 (7)
+/*TIMx_DIER: update DMA request*/
+#define PATGEN_DIER_UDE                 (8)
+/*TIMx_EGR: update generation, reloads PSC / ARR and requests one DMA transfer*/
+#define PATGEN_EGR_UG                   (0)
+
+/*timer, its bus clock and the DMA1 channel (index 0-6) of its update request*/
+#if PATGEN_TIMER == PATGEN_TIM1
+#define PATGEN_TIM_Base_Address         0x40012C00
+#define PATGEN_TIM_BUS                  RCC_APB2
+#define PATGEN_TIM_EN                   PERIPHERAL_EN_TIM1
+#define PATGEN_DMA_PERIPHERAL           DMA_PERIPHERAL_TIM1_UP
+#define PATGEN_DMA_CHANNEL              (4)
+#elif PATGEN_TIMER == PATGEN_TIM2
+#define PATGEN_TIM_Base_Address         0x40000000
+#define PATGEN_TIM_BUS                  RCC_APB1
+#define PATGEN_TIM_EN                   PERIPHERAL_EN_TIM2
+#define PATGEN_DMA_PERIPHERAL           DMA_PERIPHERAL_TIM2_UP
+#define PATGEN_DMA_CHANNEL              (1)
+#elif PATGEN_TIMER == PATGEN_TIM3
+#define PATGEN_TIM_Base_Address         0x40000400
+#define PATGEN_TIM_BUS                  RCC_APB1
+#define PATGEN_TIM_EN                   PERIPHERAL_EN_TIM3
+#define PATGEN_DMA_PERIPHERAL           DMA_PERIPHERAL_TIM3_UP
+#define PATGEN_DMA_CHANNEL              (2)
+#elif PATGEN_TIMER == PATGEN_TIM4
+#define PATGEN_TIM_Base_Address         0x40000800
+#define PATGEN_TIM_BUS                  RCC_APB1
+#define PATGEN_TIM_EN                   PERIPHERAL_EN_TIM4
+#define PATGEN_DMA_PERIPHERAL           DMA_PERIPHERAL_TIM4_UP
+#define PATGEN_DMA_CHANNEL              (6)
+#else
+#error "PATGEN_TIMER must be PATGEN_TIM1, PATGEN_TIM2, PATGEN_TIM3 or PATGEN_TIM4"
+#endif
+
+#define     PATGEN_TIM          ((volatile PATGEN_TIM_t *) PATGEN_TIM_Base_Address)
+
+/*state of the generator*/
+#define PATGEN_IDLE                     (0)
+#define PATGEN_RUNNING                  (1)
+
+#endif
@@ -0,0 +1,314 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  PATGEN_program.c
+ *  module:  PATGEN Module
+ *  @details:  program file for the pattern generator: the timer only counts, each update requests one DMA
+ *             transfer of the next pattern word to the BSRR of PATGEN_PORT. The DMA interrupt is only used at
+ *             the end (or half) of a pattern, for the swaps, the refills and the one shot stop
+*********************************************************************************************************************/
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+#include "../../LIB/Std_Types.h"
+#include "../../LIB/Bit_Math.h"
+#include "../../LIB/Bit_Band.h"
+
+#include "PATGEN_config.h"
+#include "PATGEN_interface.h"
+#include "PATGEN_private.h"
+
+#include "../RCC/RCC_interface.h"
+#include "../DMA/DMA_interface.h"
+#include "../GPIO/GPIO_interface.h"
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA
+---------------------------------------------------------------------------------------------------------------------*/
+/*channel set up once by PATGEN_VoidInit, the memory side and the circular mode given by each start*/
+static DMA_InitTypeDef PATGEN_Dma;
+
+static volatile uint8 PATGEN_State = PATGEN_IDLE;
+static uint8 PATGEN_Mode = PATGEN_MODE_ONE_SHOT;
+static volatile uint16 PATGEN_Count = 0;
+
+/*pattern given to PATGEN_u8Queue, taken by the complete interrupt*/
+static const uint32* volatile PATGEN_pNext = NULL;
+static volatile uint16 PATGEN_NextCount = 0;
+
+static PATGEN_Callback_t PATGEN_pCallback = NULL;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Description     : stop the timer, drop its DMA request and disable the channel
+*******************************************************************************/
+static void PATGEN_VoidHalt(void)
+{
+    BB_CLEAR_BIT(PATGEN_TIM->CR1,PATGEN_CR1_CEN);
+    BB_CLEAR_BIT(PATGEN_TIM->DIER,PATGEN_DIER_UDE);
+    MDMA_VoidDisableChannel(PATGEN_DMA_CHANNEL);
+    PATGEN_State = PATGEN_IDLE;
+}
+
+/******************************************************************************
+* \Description     : call the notification of the application if any
+*******************************************************************************/
+static void PATGEN_VoidNotify(uint8 u8Event,uint16 u16First,uint16 u16Count)
+{
+    if(PATGEN_pCallback != NULL)
+    {
+        PATGEN_pCallback(u8Event,u16First,u16Count);
+    }
+    else{}
+}
+
+/******************************************************************************
+* \Description     : DMA half transfer interrupt, double buffer only: the first half was played
+*******************************************************************************/
+static void PATGEN_VoidHalfIrq(void)
+{
+    PATGEN_VoidNotify(PATGEN_EVENT_HALF,0,(uint16)(PATGEN_Count / 2));
+}
+
+/******************************************************************************
+* \Description     : DMA transfer complete interrupt: refill, swap to the queued pattern or end the one shot.
+*                    The timer keeps running during a swap, so the new pattern keeps the step
+*******************************************************************************/
+static void PATGEN_VoidCompleteIrq(void)
+{
+    const uint32* Local_pNext = PATGEN_pNext;
+
+    if(PATGEN_Mode == PATGEN_MODE_DOUBLE_BUFFER)
+    {
+        PATGEN_VoidNotify(PATGEN_EVENT_FULL,(uint16)(PATGEN_Count / 2),(uint16)(PATGEN_Count / 2));
+    }
+    else if(Local_pNext != NULL)
+    {
+        MDMA_VoidReloadChannel(PATGEN_DMA_CHANNEL,Local_pNext,PATGEN_NextCount);
+        PATGEN_Count = PATGEN_NextCount;
+        PATGEN_pNext = NULL;
+        PATGEN_VoidNotify(PATGEN_EVENT_SWAPPED,0,PATGEN_Count);
+    }
+    else if(PATGEN_Mode == PATGEN_MODE_ONE_SHOT)
+    {
+        PATGEN_VoidHalt();
+        PATGEN_VoidNotify(PATGEN_EVENT_DONE,0,PATGEN_Count);
+    }
+    else{}
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Syntax          : void PATGEN_VoidInit(uint16 u16PinMask)
+* \Description     : set the pins of the mask as 50 MHz push-pull outputs of PATGEN_PORT, set up the timer as a
+*                    stopped time base with its update DMA request and the DMA1 channel of the request
+*                    (memory to BSRR, 32-bit). Enable the DMA1 channel interrupt in the NVIC for the callback
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u16PinMask pins driven by the patterns (bit n = pin n)
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void PATGEN_VoidInit(uint16 u16PinMask)
+{
+    uint8 Local_u8Pin;
+
+    MRCC_voidEnableClock(RCC_AHB,_PERIPHERAL_EN_DMA1EN);
+    MRCC_voidEnableClock(PATGEN_TIM_BUS,PATGEN_TIM_EN);
+    MRCC_voidEnableClock(RCC_APB2,PERIPHERAL_EN_IOPA + PATGEN_PORT);
+
+    for(Local_u8Pin=pin0;Local_u8Pin<=pin15;Local_u8Pin++)
+    {
+        if(READ_BIT(u16PinMask,Local_u8Pin) == 1)
+        {
+            MGPIO_VoidSetPinMode_TYPE(PATGEN_PORT,Local_u8Pin,OUTPUT_SPEED_50MHZ_PUSHPULL);
+        }
+        else{}
+    }
+
+    /*time base only: up counting, buffered auto-reload so a new step starts on an update*/
+    PATGEN_TIM->CR1 = (uint32)1 << PATGEN_CR1_ARPE;
+    PATGEN_TIM->CR2 = 0;
+    PATGEN_TIM->SMCR = 0;
+    PATGEN_TIM->DIER = 0;
+    PATGEN_TIM->CNT = 0;
+
+    /*memory to the BSRR of the port, one 32-bit word per request*/
+    PATGEN_Dma.Peripheral = PATGEN_DMA_PERIPHERAL;
+    PATGEN_Dma.DMA_Peripheral_address = (uint32*)&GPIO_PORT(PATGEN_PORT)->BSRR;
+    PATGEN_Dma.DMA_Memory_address = NULL;
+    PATGEN_Dma.DMA_Data_Number = 0;
+    PATGEN_Dma.DMA_Channel_Priority = DMA_PRIORITY_VERY_HIGH;
+    PATGEN_Dma.DMA_Mem2MemMode = DMA_DISABLE;
+    PATGEN_Dma.DMA_Direction = DMA_DIRECTION_READ_FROM_MEMORY;
+    PATGEN_Dma.DMA_CircularMode = DMA_DISABLE;
+    PATGEN_Dma.DMA_PERIPHERAL_PTR_INC = DMA_DISABLE;
+    PATGEN_Dma.DMA_MEMORY_PTR_INC = DMA_ENABLE;
+    PATGEN_Dma.DMA_PERIPHERAL_Data_Size = DMA_SIZE_32_BIT;
+    PATGEN_Dma.DMA_MEMORY_Data_Size = DMA_SIZE_32_BIT;
+    MDMA_VoidChannelInit(&PATGEN_Dma);
+    MDMA_VoidDisableChannel(PATGEN_DMA_CHANNEL);
+
+    PATGEN_State = PATGEN_IDLE;
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType PATGEN_u8SetStep(uint32 u32Cycles)
+* \Description     : set the time between two words in timer clock cycles, split in prescaler and auto-reload.
+*                    Above 65536 cycles the step is rounded down to a multiple of the prescaler. Takes effect
+*                    at the next update, a running pattern changes rate without a glitch
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : u32Cycles step, from PATGEN_MIN_STEP_CYCLES
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK below PATGEN_MIN_STEP_CYCLES
+*******************************************************************************/
+Std_ReturnType PATGEN_u8SetStep(uint32 u32Cycles)
+{
+    uint32 Local_u32Prescaler;
+
+    if(u32Cycles < PATGEN_MIN_STEP_CYCLES)
+    {
+        return N_OK;
+    }
+    /*smallest prescaler leaving the auto-reload in 16 bits: (PSC+1)*65536 >= u32Cycles*/
+    Local_u32Prescaler = (u32Cycles - 1) >> 16;
+    PATGEN_TIM->PSC = Local_u32Prescaler;
+    PATGEN_TIM->ARR = (u32Cycles / (Local_u32Prescaler + 1)) - 1;
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType PATGEN_u8Start(const uint32* pPattern,uint16 u16Count,uint8 u8Mode)
+* \Description     : play a pattern, the first word written at once and the next ones one step apart. A running
+*                    pattern is stopped first. The pattern stays in RAM until stopped (or done in one shot)
+* \Sync\Async      : Asynchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pPattern words (@ref PATGEN_word), u16Count number of words (even in double buffer),
+*                    u8Mode @ref PATGEN_mode
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK on an empty pattern, an odd double buffer or an invalid mode
+*******************************************************************************/
+Std_ReturnType PATGEN_u8Start(const uint32* pPattern,uint16 u16Count,uint8 u8Mode)
+{
+    if(pPattern == NULL || u16Count == 0 || u8Mode > PATGEN_MODE_DOUBLE_BUFFER ||
+       (u8Mode == PATGEN_MODE_DOUBLE_BUFFER && (u16Count & 1) != 0))
+    {
+        return N_OK;
+    }
+    PATGEN_VoidHalt();
+    MDMA_VoidDisableInterrupt(PATGEN_DMA_CHANNEL);
+
+    PATGEN_Mode = u8Mode;
+    PATGEN_Count = u16Count;
+    PATGEN_pNext = NULL;
+
+    /*CMAR, CNDTR and CIRC are only writable with the channel disabled: init enables it again*/
+    PATGEN_Dma.DMA_Memory_address = (uint32*)pPattern;
+    PATGEN_Dma.DMA_Data_Number = u16Count;
+    PATGEN_Dma.DMA_CircularMode = (u8Mode == PATGEN_MODE_ONE_SHOT) ? DMA_DISABLE : DMA_ENABLE;
+    MDMA_VoidChannelInit(&PATGEN_Dma);
+
+    /*flags left by an earlier pattern would call the handlers at once*/
+    MDMA_VoidClearFlags(PATGEN_DMA_CHANNEL);
+    MDMA_VoidEnableInterrupt(PATGEN_DMA_CHANNEL,DMA_INTERRUPT_COMPLETE_TRANSMISSION,PATGEN_VoidCompleteIrq);
+    if(u8Mode == PATGEN_MODE_DOUBLE_BUFFER)
+    {
+        MDMA_VoidEnableInterrupt(PATGEN_DMA_CHANNEL,DMA_INTERRUPT_HALF_TRANSMISSION,PATGEN_VoidHalfIrq);
+    }
+    else{}
+
+    PATGEN_State = PATGEN_RUNNING;
+    /*the update generation loads PSC / ARR and requests the first word now, the counter paces the others*/
+    PATGEN_TIM->CNT = 0;
+    BB_SET_BIT(PATGEN_TIM->DIER,PATGEN_DIER_UDE);
+    PATGEN_TIM->EGR = (uint32)1 << PATGEN_EGR_UG;
+    BB_SET_BIT(PATGEN_TIM->CR1,PATGEN_CR1_CEN);
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : Std_ReturnType PATGEN_u8Queue(const uint32* pPattern,uint16 u16Count)
+* \Description     : play another pattern after the end of the running one, in its mode (one shot patterns are
+*                    chained). The swap is done in the DMA complete interrupt: it is seamless when the step is
+*                    longer than the interrupt latency, otherwise the first word of the old pattern is repeated
+* \Sync\Async      : Asynchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pPattern words (@ref PATGEN_word), u16Count number of words
+* \Parameters (out): None
+* \Return value:   : Std_ReturnType N_OK when stopped, in double buffer, on an empty pattern or a pattern
+*                    already queued
+*******************************************************************************/
+Std_ReturnType PATGEN_u8Queue(const uint32* pPattern,uint16 u16Count)
+{
+    if(pPattern == NULL || u16Count == 0 || PATGEN_State != PATGEN_RUNNING ||
+       PATGEN_Mode == PATGEN_MODE_DOUBLE_BUFFER || PATGEN_pNext != NULL)
+    {
+        return N_OK;
+    }
+    /*the count first: the interrupt takes the pattern as soon as the pointer is set*/
+    PATGEN_NextCount = u16Count;
+    PATGEN_pNext = pPattern;
+    return OK;
+}
+
+/******************************************************************************
+* \Syntax          : void PATGEN_VoidStop(void)
+* \Description     : stop the timer and the DMA channel, the pins keep the last word written
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void PATGEN_VoidStop(void)
+{
+    PATGEN_VoidHalt();
+    MDMA_VoidDisableInterrupt(PATGEN_DMA_CHANNEL);
+    PATGEN_pNext = NULL;
+}
+
+/******************************************************************************
+* \Syntax          : void PATGEN_VoidSetCallback(PATGEN_Callback_t pCallback)
+* \Description     : set the notification of the generator, NULL for none
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pCallback notification
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void PATGEN_VoidSetCallback(PATGEN_Callback_t pCallback)
+{
+    PATGEN_pCallback = pCallback;
+}
+
+/******************************************************************************
+* \Syntax          : uint16 PATGEN_u16GetPosition(void)
+* \Description     : index of the next word of the running pattern to be written
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint16 word index, 0 when stopped
+*******************************************************************************/
+uint16 PATGEN_u16GetPosition(void)
+{
+    uint16 Local_u16Remaining;
+
+    if(PATGEN_State != PATGEN_RUNNING)
+    {
+        return 0;
+    }
+    Local_u16Remaining = MDMA_u16GetRemaining(PATGEN_DMA_CHANNEL);
+    /*circular: CNDTR reloads to the count after the last word*/
+    return (uint16)((Local_u16Remaining >= PATGEN_Count) ? 0 : (PATGEN_Count - Local_u16Remaining));
+}
@@ -17,7 +17,8 @@
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL MACROS
 ---------------------------------------------------------------------------------------------------------------------*/
-
+/*frequency of the crystal / external clock on OSC_IN (4 - 16 MHz), used to compute the bus clocks*/
+#define 	RCC_HSE_FREQ_HZ   	(8000000UL)
       
 /*__________________________________________________________________________*/
 /* Note: Select value only if you have PLL as input clock source */
@@ -218,4 +218,49 @@ void MRCC_voidDisableClock(uint8 Copy_uint8BusId, uint8 Copy_uint8PeripheralId);
  */
 void MRCC_VoidSetADCPrescaler(uint8 ADCPRE);
 
+/******************************************************************************
+* \Syntax          : uint32 MRCC_u32GetSysClockHz(void)
+* \Description     : frequency of SYSCLK decoded from the clock actually selected (CFGR.SWS), the PLL source,
+*                    PLLXTPRE and PLLMUL. HSE is taken as RCC_HSE_FREQ_HZ
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint32 frequency in Hz
+*******************************************************************************/
+uint32 MRCC_u32GetSysClockHz(void);
+
+/******************************************************************************
+* \Syntax          : uint32 MRCC_u32GetHclkHz(void)
+* \Description     : frequency of the AHB clock (SYSCLK / HPRE)
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint32 frequency in Hz
+*******************************************************************************/
+uint32 MRCC_u32GetHclkHz(void);
+
+/******************************************************************************
+* \Syntax          : uint32 MRCC_u32GetPclk1Hz(void)
+* \Description     : frequency of the APB1 clock (HCLK / PPRE1), clock of CAN, USART2/3, I2C, SPI2
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint32 frequency in Hz
+*******************************************************************************/
+uint32 MRCC_u32GetPclk1Hz(void);
+
+/******************************************************************************
+* \Syntax          : uint32 MRCC_u32GetPclk2Hz(void)
+* \Description     : frequency of the APB2 clock (HCLK / PPRE2), clock of USART1, SPI1, ADC, GPIO
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint32 frequency in Hz
+*******************************************************************************/
+uint32 MRCC_u32GetPclk2Hz(void);
+
 #endif
@@ -49,7 +49,23 @@ typedef struct{
 /*RCC_CFGR Register Bits*/
 #define SW0        			 0
 #define SW1        			 1
-#define PLLSRC     			 22
+#define PLLSRC     			 16
+#define PLLXTPRE_BIT		 17
+
+/*RCC_CFGR fields read back by the clock getters*/
+#define RCC_CFGR_SWS(CFGR)        (((CFGR) >> 2) & 0x3)
+#define RCC_CFGR_HPRE(CFGR)       (((CFGR) >> 4) & 0xF)
+#define RCC_CFGR_PPRE1(CFGR)      (((CFGR) >> 8) & 0x7)
+#define RCC_CFGR_PPRE2(CFGR)      (((CFGR) >> 11) & 0x7)
+#define RCC_CFGR_PLLMUL(CFGR)     (((CFGR) >> 18) & 0xF)
+
+/*SWS: clock used as system clock*/
+#define RCC_SWS_HSI               0
+#define RCC_SWS_HSE               1
+#define RCC_SWS_PLL               2
+
+/*internal RC oscillator*/
+#define RCC_HSI_FREQ_HZ           (8000000UL)
 
 /*RCC_CR Register Bits*/
 #define PLL_ON     			 24
@@ -20,6 +20,7 @@
 //#include "RCC_private.h"
 //#include "RCC_config.h"
 #include "RCC_interface.h"
+#include "../../LIB/Bit_Band.h"
 
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL FUNCTION IMPLEMENTION
@@ -149,13 +150,13 @@ void MRCC_voidEnableClock(uint8 Copy_uint8BusId, uint8 Copy_uint8PeripheralId)
 	{
 		switch (Copy_uint8BusId)
 		{
-			case RCC_AHB : SET_BIT(RCC->AHBENR  , Copy_uint8PeripheralId);   
+			case RCC_AHB : BB_SET_BIT(RCC->AHBENR  , Copy_uint8PeripheralId);   
 			break;
 			
-			case RCC_APB1 : SET_BIT(RCC->APB1ENR , Copy_uint8PeripheralId);   
+			case RCC_APB1 : BB_SET_BIT(RCC->APB1ENR , Copy_uint8PeripheralId);   
 			break;
 			
-			case RCC_APB2 : SET_BIT(RCC->APB2ENR , Copy_uint8PeripheralId);   
+			case RCC_APB2 : BB_SET_BIT(RCC->APB2ENR , Copy_uint8PeripheralId);   
 			break;
 		}
 	}
@@ -178,14 +179,14 @@ void MRCC_voidDisableClock(uint8 Copy_uint8BusId, uint8 Copy_uint8PeripheralId)
 	{
 		switch (Copy_uint8BusId)
 		{
-			case RCC_AHB : CLEAR_BIT(RCC->AHBENR  , Copy_uint8PeripheralId);   
+			case RCC_AHB : BB_CLEAR_BIT(RCC->AHBENR  , Copy_uint8PeripheralId);   
 			break;
 			
 			
-			case RCC_APB1 : CLEAR_BIT(RCC->APB1ENR , Copy_uint8PeripheralId);   
+			case RCC_APB1 : BB_CLEAR_BIT(RCC->APB1ENR , Copy_uint8PeripheralId);   
 			break;
 			
-			case RCC_APB2 : CLEAR_BIT(RCC->APB2ENR , Copy_uint8PeripheralId);   
+			case RCC_APB2 : BB_CLEAR_BIT(RCC->APB2ENR , Copy_uint8PeripheralId);   
 			break;
 		}
 	}
@@ -204,4 +205,108 @@ void MRCC_VoidSetADCPrescaler(uint8 ADCPRE)
 	RCC->CFGR = RCC->CFGR & (~(0b111<<14));//clear this section
 	RCC->CFGR |= (ADCPRE<<14);
 		
-}
\ No newline at end of file
+}
+
+
+/******************************************************************************
+* \Description     : shift of a PPRE1 / PPRE2 code: 0xx = /1, 100 = /2 ... 111 = /16
+*******************************************************************************/
+static uint8 RCC_u8ApbShift(uint32 Copy_u32Ppre)
+{
+	return (Copy_u32Ppre & 0x4) ? (uint8)((Copy_u32Ppre & 0x3) + 1) : 0;
+}
+
+/******************************************************************************
+* \Syntax          : uint32 MRCC_u32GetSysClockHz(void)
+* \Description     : frequency of SYSCLK decoded from the clock actually selected (CFGR.SWS)
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint32 frequency in Hz
+*******************************************************************************/
+uint32 MRCC_u32GetSysClockHz(void)
+{
+	uint32 Local_u32Cfgr = RCC->CFGR;
+	uint32 Local_u32Clock = RCC_HSI_FREQ_HZ;
+	uint32 Local_u32Mul;
+
+	switch (RCC_CFGR_SWS(Local_u32Cfgr))
+	{
+		case RCC_SWS_HSE : Local_u32Clock = RCC_HSE_FREQ_HZ;
+		break;
+
+		case RCC_SWS_PLL :
+			/*PLLMUL 0000 = x2 ... 1110 = x16, 1111 = x16*/
+			Local_u32Mul = RCC_CFGR_PLLMUL(Local_u32Cfgr) + 2;
+			if (Local_u32Mul > 16)
+			{
+				Local_u32Mul = 16;
+			}
+			if (READ_BIT(Local_u32Cfgr, PLLSRC))
+			{
+				Local_u32Clock = READ_BIT(Local_u32Cfgr, PLLXTPRE_BIT) ? (RCC_HSE_FREQ_HZ / 2) : RCC_HSE_FREQ_HZ;
+			}
+			else
+			{
+				Local_u32Clock = RCC_HSI_FREQ_HZ / 2;
+			}
+			Local_u32Clock *= Local_u32Mul;
+		break;
+
+		default :
+		break;
+	}
+	return Local_u32Clock;
+}
+
+/******************************************************************************
+* \Syntax          : uint32 MRCC_u32GetHclkHz(void)
+* \Description     : frequency of the AHB clock (SYSCLK / HPRE)
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint32 frequency in Hz
+*******************************************************************************/
+uint32 MRCC_u32GetHclkHz(void)
+{
+	/*HPRE 0xxx = /1, 1000 = /2 ... 1011 = /16, 1100 = /64 ... 1111 = /512 (no /32)*/
+	static const uint8 Local_u8HpreShift[8] = {1, 2, 3, 4, 6, 7, 8, 9};
+	uint32 Local_u32Hpre = RCC_CFGR_HPRE(RCC->CFGR);
+	uint32 Local_u32Clock = MRCC_u32GetSysClockHz();
+
+	if (Local_u32Hpre & 0x8)
+	{
+		Local_u32Clock >>= Local_u8HpreShift[Local_u32Hpre & 0x7];
+	}
+	return Local_u32Clock;
+}
+
+/******************************************************************************
+* \Syntax          : uint32 MRCC_u32GetPclk1Hz(void)
+* \Description     : frequency of the APB1 clock (HCLK / PPRE1)
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint32 frequency in Hz
+*******************************************************************************/
+uint32 MRCC_u32GetPclk1Hz(void)
+{
+	return MRCC_u32GetHclkHz() >> RCC_u8ApbShift(RCC_CFGR_PPRE1(RCC->CFGR));
+}
+
+/******************************************************************************
+* \Syntax          : uint32 MRCC_u32GetPclk2Hz(void)
+* \Description     : frequency of the APB2 clock (HCLK / PPRE2)
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : uint32 frequency in Hz
+*******************************************************************************/
+uint32 MRCC_u32GetPclk2Hz(void)
+{
+	return MRCC_u32GetHclkHz() >> RCC_u8ApbShift(RCC_CFGR_PPRE2(RCC->CFGR));
+}
@@ -0,0 +1,36 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  SLCAN_config.h
+ *  module:  SLCAN Module
+ *  @details:  Configuration header file for the SLCAN (Lawicel) serial to CAN gateway
+*********************************************************************************************************************/
+#ifndef _SLCAN_CONFIG_H
+#define _SLCAN_CONFIG_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*USART1 baud rate. A loaded 1 Mbit/s bus needs up to 27 characters per 131 bit extended frame,
+  2.06 Mbaud: keep 3 Mbaud (BRR 24 at PCLK2 72 MHz) or more for full load*/
+#define SLCAN_BAUDRATE                  (3000000UL)
+
+/*size of each of the two TX buffers (one sent by DMA while the other is filled), at least 2 frames*/
+#define SLCAN_TX_BUFFER_SIZE            (512)
+
+/*circular DMA RX buffer, holds the characters received between two parser runs*/
+#define SLCAN_RX_BUFFER_SIZE            (256)
+
+/*bit rate used by O / L when no S command was received: index of the S command 0-8*/
+#define SLCAN_DEFAULT_BITRATE           (8)
+
+/*answers of the V and N commands, at most 7 characters*/
+#define SLCAN_VERSION                   "V1013"
+#define SLCAN_SERIAL_NUMBER             "N0001"
+
+#endif
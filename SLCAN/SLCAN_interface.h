@@ -0,0 +1,76 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  SLCAN_interface.h
+ *  module:  SLCAN Module
+ *  @details:  interface header file for the SLCAN (Lawicel) gateway between USART1 and CAN.
+ *             Received frames are encoded into the ASCII protocol in batches and sent by DMA,
+ *             host commands are received by circular DMA and parsed as they arrive
+*********************************************************************************************************************/
+#ifndef _SLCAN_INTERFACE_H
+#define _SLCAN_INTERFACE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+#include "../../LIB/Std_Types.h"
+#include "../../LIB/Bit_Math.h"
+
+#include "../CAN/CAN_interface.h"
+#include "SLCAN_config.h"
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL DATA TYPES AND STRUCTURES
+---------------------------------------------------------------------------------------------------------------------*/
+/**
+  * @brief  gateway counters since SLCAN_VoidInit
+  */
+typedef struct
+{
+  uint32 FramesToHost;          /*!< CAN frames encoded to the serial line */
+  uint32 FramesToCan;           /*!< t / T / r / R commands accepted by the CAN TX queue */
+  uint32 TxQueueFull;           /*!< t / T / r / R commands refused because the CAN TX queue was full */
+  uint32 CommandErrors;         /*!< malformed, unknown or refused commands (answered with BELL) */
+  uint32 SerialBacklog;         /*!< times both TX buffers were full, frames waited in the CAN RX rings */
+}SLCAN_Status_t;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Syntax          : void SLCAN_VoidInit(void)
+* \Description     : set up USART1 at SLCAN_BAUDRATE with DMA1 channel 4 (TX) and channel 5 (RX, circular),
+*                    the RX rings of both FIFOs and the notifications the gateway runs from.
+*                    Call after MCAN_VoidInit and the filter setup; the channel stays closed until the host
+*                    sends O or L. Supported commands: Sn, O, L, C, t, T, r, R, F, V, N.
+*                    The CAN RX0 / RX1, DMA1 channel 4 / 5 and USART1 interrupts must be enabled in the NVIC
+*                    with one priority: the gateway has no locks and relies on them not preempting each other.
+*                    The commands call MCAN_u8TransmitFrame, MCAN_u8SetBitrate, MCAN_VoidStart and MCAN_VoidStop
+*                    from these interrupts, so the CAN TX (USB_HP_CAN1_TX) and SCE (CAN_SCE) interrupts must
+*                    have that same priority too: the mailboxes are not refilled and no bus-off is handled
+*                    while the controller is being reconfigured
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void SLCAN_VoidInit(void);
+
+/******************************************************************************
+* \Syntax          : void SLCAN_VoidGetStatus(SLCAN_Status_t* pStatus)
+* \Description     : read the gateway counters
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): pStatus counters
+* \Return value:   : None
+*******************************************************************************/
+void SLCAN_VoidGetStatus(SLCAN_Status_t* pStatus);
+
+#endif
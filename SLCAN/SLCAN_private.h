@@ -0,0 +1,45 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  SLCAN_private.h
+ *  module:  SLCAN Module
+ *  @details:  private header file for the SLCAN (Lawicel) serial to CAN gateway
+*********************************************************************************************************************/
+#ifndef _SLCAN_PRIVATE_H
+#define _SLCAN_PRIVATE_H
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL MACROS
+---------------------------------------------------------------------------------------------------------------------*/
+/*DMA1 channels of USART1 (index 0-6)*/
+#define SLCAN_DMA_TX_CHANNEL            (3)     /*ch4 USART1_TX*/
+#define SLCAN_DMA_RX_CHANNEL            (4)     /*ch5 USART1_RX*/
+
+/*longest frame: 'T' + 8 id digits + dlc + 16 data digits + CR*/
+#define SLCAN_FRAME_MAX_CHARS           (27)
+/*longest command line without the CR*/
+#define SLCAN_LINE_MAX                  (SLCAN_FRAME_MAX_CHARS - 1)
+/*longest answer to a command (V / N with CR), kept free in the TX buffer for the parser*/
+#define SLCAN_REPLY_MAX                 (8)
+
+#define SLCAN_CR                        ('\r')
+#define SLCAN_BELL                      (0x07)
+
+/*channel state*/
+#define SLCAN_CLOSED                    (0)
+#define SLCAN_OPEN                      (1)
+#define SLCAN_LISTEN                    (2)
+
+/*status flags of the F command*/
+#define SLCAN_FLAG_TX_FULL              (0x02)
+#define SLCAN_FLAG_OVERRUN              (0x08)
+
+/*invalid hex digit*/
+#define SLCAN_NOT_HEX                   (0xFF)
+
+#endif
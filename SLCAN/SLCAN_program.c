@@ -0,0 +1,542 @@
+/*********************************************************************************
+* @author    : Hossam Ahmed
+* @version   : V01
+* @date      : 19 Oct 2026
+*********************************************************************************/
+/*******************************************************************************************************************
+ *  *  FILE DESCRIPTION
+ *  --------------------
+ *  @file:  SLCAN_program.c
+ *  module:  SLCAN Module
+ *  @details:  program file for the SLCAN (Lawicel) serial to CAN gateway
+*********************************************************************************************************************/
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  INCLUDES
+---------------------------------------------------------------------------------------------------------------------*/
+
+#include "../../LIB/Std_Types.h"
+#include "../../LIB/Bit_Math.h"
+
+#include "../CAN/CAN_config.h"
+#include "SLCAN_config.h"
+#include "SLCAN_interface.h"
+#include "SLCAN_private.h"
+
+#include "../RCC/RCC_interface.h"
+#include "../DMA/DMA_interface.h"
+#include "../UART/UART_interface.h"
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA
+---------------------------------------------------------------------------------------------------------------------*/
+/*upper case ASCII of every byte value, so a data byte is encoded with two loads and no arithmetic*/
+#define SLCAN_HEX(N)            ((uint8)((N) < 10 ? '0' + (N) : 'A' - 10 + (N)))
+#define SLCAN_HEX_PAIR(B)       {SLCAN_HEX((B) >> 4), SLCAN_HEX((B) & 0xF)}
+#define SLCAN_HEX_ROW(H)        SLCAN_HEX_PAIR((H) + 0x0), SLCAN_HEX_PAIR((H) + 0x1), SLCAN_HEX_PAIR((H) + 0x2), \
+                                SLCAN_HEX_PAIR((H) + 0x3), SLCAN_HEX_PAIR((H) + 0x4), SLCAN_HEX_PAIR((H) + 0x5), \
+                                SLCAN_HEX_PAIR((H) + 0x6), SLCAN_HEX_PAIR((H) + 0x7), SLCAN_HEX_PAIR((H) + 0x8), \
+                                SLCAN_HEX_PAIR((H) + 0x9), SLCAN_HEX_PAIR((H) + 0xA), SLCAN_HEX_PAIR((H) + 0xB), \
+                                SLCAN_HEX_PAIR((H) + 0xC), SLCAN_HEX_PAIR((H) + 0xD), SLCAN_HEX_PAIR((H) + 0xE), \
+                                SLCAN_HEX_PAIR((H) + 0xF)
+
+static const uint8 SLCAN_HexTable[256][2] =
+{
+    SLCAN_HEX_ROW(0x00), SLCAN_HEX_ROW(0x10), SLCAN_HEX_ROW(0x20), SLCAN_HEX_ROW(0x30),
+    SLCAN_HEX_ROW(0x40), SLCAN_HEX_ROW(0x50), SLCAN_HEX_ROW(0x60), SLCAN_HEX_ROW(0x70),
+    SLCAN_HEX_ROW(0x80), SLCAN_HEX_ROW(0x90), SLCAN_HEX_ROW(0xA0), SLCAN_HEX_ROW(0xB0),
+    SLCAN_HEX_ROW(0xC0), SLCAN_HEX_ROW(0xD0), SLCAN_HEX_ROW(0xE0), SLCAN_HEX_ROW(0xF0)
+};
+
+/*bit rates of the S0 - S8 commands*/
+static const uint32 SLCAN_BitrateTable[9] = {10000, 20000, 50000, 100000, 125000, 250000, 500000, 800000, 1000000};
+
+/*TX: ping-pong buffers, one in flight on DMA channel 4 while the other is filled*/
+static uint8 SLCAN_TxBuffer[2][SLCAN_TX_BUFFER_SIZE];
+static uint16 SLCAN_TxFill = 0;                 /*characters in the buffer being filled*/
+static uint8 SLCAN_TxFillIndex = 0;             /*buffer being filled*/
+static uint8 SLCAN_TxBusy = 0;                  /*the other buffer is being sent*/
+
+/*RX: circular buffer written by DMA channel 5, parsed up to the DMA position*/
+static uint8 SLCAN_RxBuffer[SLCAN_RX_BUFFER_SIZE];
+static uint16 SLCAN_RxTail = 0;
+static uint8 SLCAN_Line[SLCAN_LINE_MAX];
+static uint8 SLCAN_LineLength = 0;
+static uint8 SLCAN_LineOverflow = 0;
+
+static uint8 SLCAN_State = SLCAN_CLOSED;
+static uint8 SLCAN_BitrateIndex = SLCAN_DEFAULT_BITRATE;
+static uint32 SLCAN_LastOverruns = 0;
+static SLCAN_Status_t SLCAN_Status;
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Description     : write one frame in the ASCII protocol, at most SLCAN_FRAME_MAX_CHARS characters
+* \Parameters (in) : pOut where to write, pFrame received frame
+* \Return value:   : uint8* first character after the frame
+*******************************************************************************/
+static uint8* SLCAN_pu8EncodeFrame(uint8* pOut,const CAN_Frame_t* pFrame)
+{
+    uint32 Local_u32Id = pFrame->Id;
+    /*DLC 9-15 means 8 bytes: the protocol has digits 0-8 and the data union holds 8 bytes*/
+    uint8 Local_u8Dlc = (pFrame->DLC > 8) ? 8 : pFrame->DLC;
+    uint8 Local_u8Itr;
+
+    if(CAN_FRAME_IS_EXT(Local_u32Id))
+    {
+        *pOut++ = CAN_FRAME_IS_REMOTE(Local_u32Id) ? 'R' : 'T';
+        Local_u32Id = CAN_FRAME_GET_EXT(Local_u32Id);
+        pOut[0] = SLCAN_HexTable[(uint8)(Local_u32Id >> 24)][0];
+        pOut[1] = SLCAN_HexTable[(uint8)(Local_u32Id >> 24)][1];
+        pOut[2] = SLCAN_HexTable[(uint8)(Local_u32Id >> 16)][0];
+        pOut[3] = SLCAN_HexTable[(uint8)(Local_u32Id >> 16)][1];
+        pOut[4] = SLCAN_HexTable[(uint8)(Local_u32Id >> 8)][0];
+        pOut[5] = SLCAN_HexTable[(uint8)(Local_u32Id >> 8)][1];
+        pOut[6] = SLCAN_HexTable[(uint8)Local_u32Id][0];
+        pOut[7] = SLCAN_HexTable[(uint8)Local_u32Id][1];
+        pOut += 8;
+    }
+    else
+    {
+        *pOut++ = CAN_FRAME_IS_REMOTE(Local_u32Id) ? 'r' : 't';
+        Local_u32Id = CAN_FRAME_GET_STD(Local_u32Id);
+        pOut[0] = SLCAN_HexTable[(uint8)(Local_u32Id >> 8)][1];
+        pOut[1] = SLCAN_HexTable[(uint8)Local_u32Id][0];
+        pOut[2] = SLCAN_HexTable[(uint8)Local_u32Id][1];
+        pOut += 3;
+    }
+    *pOut++ = (uint8)('0' + Local_u8Dlc);
+    if(!CAN_FRAME_IS_REMOTE(pFrame->Id))
+    {
+        for(Local_u8Itr=0;Local_u8Itr<Local_u8Dlc;Local_u8Itr++)
+        {
+            pOut[0] = SLCAN_HexTable[pFrame->Data.Bytes[Local_u8Itr]][0];
+            pOut[1] = SLCAN_HexTable[pFrame->Data.Bytes[Local_u8Itr]][1];
+            pOut += 2;
+        }
+    }
+    *pOut++ = SLCAN_CR;
+    return pOut;
+}
+
+/******************************************************************************
+* \Description     : send the buffer being filled if the DMA channel is idle, then fill the other one
+*******************************************************************************/
+static void SLCAN_VoidTxKick(void)
+{
+    if(SLCAN_TxBusy == 0 && SLCAN_TxFill != 0)
+    {
+        SLCAN_TxBusy = 1;
+        MDMA_VoidReloadChannel(SLCAN_DMA_TX_CHANNEL, SLCAN_TxBuffer[SLCAN_TxFillIndex], SLCAN_TxFill);
+        SLCAN_TxFillIndex ^= 1;
+        SLCAN_TxFill = 0;
+    }
+}
+
+/******************************************************************************
+* \Description     : append an answer to the buffer being filled, the caller checked SLCAN_REPLY_MAX is free
+* \Parameters (in) : pText answer, u8Length characters (CR included)
+*******************************************************************************/
+static void SLCAN_VoidReply(const uint8* pText,uint8 u8Length)
+{
+    uint8* Local_pOut = &SLCAN_TxBuffer[SLCAN_TxFillIndex][SLCAN_TxFill];
+    uint8 Local_u8Itr;
+
+    for(Local_u8Itr=0;Local_u8Itr<u8Length;Local_u8Itr++)
+    {
+        Local_pOut[Local_u8Itr] = pText[Local_u8Itr];
+    }
+    SLCAN_TxFill += u8Length;
+}
+
+/******************************************************************************
+* \Description     : encode the frames waiting in both RX rings, in batches taken with MCAN_u16RxRingPeek.
+*                    Stops when the buffer being filled cannot hold a frame and an answer: the frames
+*                    stay in the ring until the DMA channel frees the other buffer
+*******************************************************************************/
+static void SLCAN_VoidEncodeFrames(void)
+{
+    const CAN_Frame_t* Local_pFrames;
+    uint8* Local_pBase = SLCAN_TxBuffer[SLCAN_TxFillIndex];
+    uint8* Local_pOut = Local_pBase + SLCAN_TxFill;
+    uint8* Local_pLast = Local_pBase + (SLCAN_TX_BUFFER_SIZE - SLCAN_FRAME_MAX_CHARS - SLCAN_REPLY_MAX);
+    uint16 Local_u16Count;
+    uint16 Local_u16Done;
+    uint8 Local_u8Fifo;
+
+    for(Local_u8Fifo=CAN_RX_FIFO0;Local_u8Fifo<=CAN_RX_FIFO1;Local_u8Fifo++)
+    {
+        while((Local_u16Count = MCAN_u16RxRingPeek(Local_u8Fifo,&Local_pFrames)) != 0)
+        {
+            for(Local_u16Done=0;Local_u16Done<Local_u16Count && Local_pOut<=Local_pLast;Local_u16Done++)
+            {
+                Local_pOut = SLCAN_pu8EncodeFrame(Local_pOut,&Local_pFrames[Local_u16Done]);
+            }
+            MCAN_VoidRxRingRelease(Local_u8Fifo,Local_u16Done);
+            SLCAN_Status.FramesToHost += Local_u16Done;
+            SLCAN_TxFill = (uint16)(Local_pOut - Local_pBase);
+            if(Local_u16Done < Local_u16Count)
+            {
+                SLCAN_Status.SerialBacklog++;
+                return;
+            }
+        }
+    }
+}
+
+/******************************************************************************
+* \Description     : value of a hex digit, SLCAN_NOT_HEX for any other character
+*******************************************************************************/
+static uint8 SLCAN_u8Nibble(uint8 u8Char)
+{
+    if(u8Char >= '0' && u8Char <= '9')
+    {
+        return (uint8)(u8Char - '0');
+    }
+    /*lower case the letters, other characters stay out of a - f*/
+    u8Char |= 0x20;
+    if(u8Char >= 'a' && u8Char <= 'f')
+    {
+        return (uint8)(u8Char - 'a' + 10);
+    }
+    return SLCAN_NOT_HEX;
+}
+
+/******************************************************************************
+* \Description     : read u8Digits hex digits
+* \Parameters (in) : pText digits, u8Digits count (at most 8)
+* \Parameters (out): pValue value
+* \Return value:   : Std_ReturnType N_OK on a character that is not a hex digit
+*******************************************************************************/
+static Std_ReturnType SLCAN_u8ParseHex(const uint8* pText,uint8 u8Digits,uint32* pValue)
+{
+    uint32 Local_u32Value = 0;
+    uint8 Local_u8Nibble;
+    uint8 Local_u8Itr;
+
+    for(Local_u8Itr=0;Local_u8Itr<u8Digits;Local_u8Itr++)
+    {
+        Local_u8Nibble = SLCAN_u8Nibble(pText[Local_u8Itr]);
+        if(Local_u8Nibble == SLCAN_NOT_HEX)
+        {
+            return N_OK;
+        }
+        Local_u32Value = (Local_u32Value << 4) | Local_u8Nibble;
+    }
+    *pValue = Local_u32Value;
+    return OK;
+}
+
+/******************************************************************************
+* \Description     : decode a t / T / r / R command line (without CR)
+* \Parameters (in) : pLine command, u8Length characters
+* \Parameters (out): pFrame frame to transmit
+* \Return value:   : Std_ReturnType N_OK when the line is malformed
+*******************************************************************************/
+static Std_ReturnType SLCAN_u8ParseFrame(const uint8* pLine,uint8 u8Length,CAN_Frame_t* pFrame)
+{
+    uint8 Local_u8Extended = (pLine[0] == 'T' || pLine[0] == 'R');
+    uint8 Local_u8Remote = (pLine[0] == 'r' || pLine[0] == 'R');
+    uint8 Local_u8IdDigits = Local_u8Extended ? 8 : 3;
+    uint32 Local_u32Value;
+    uint8 Local_u8Dlc;
+    uint8 Local_u8Itr;
+
+    if(u8Length < 2 + Local_u8IdDigits || SLCAN_u8ParseHex(&pLine[1],Local_u8IdDigits,&Local_u32Value) != OK)
+    {
+        return N_OK;
+    }
+    if(Local_u32Value > (Local_u8Extended ? 0x1FFFFFFFUL : 0x7FFUL))
+    {
+        return N_OK;
+    }
+    pFrame->Id = Local_u8Extended ? CAN_FRAME_ID_EXT(Local_u32Value) : CAN_FRAME_ID_STD(Local_u32Value);
+    if(Local_u8Remote)
+    {
+        pFrame->Id |= CAN_FRAME_ID_RTR;
+    }
+
+    Local_u8Dlc = (uint8)(pLine[1 + Local_u8IdDigits] - '0');
+    if(Local_u8Dlc > 8 || u8Length != 2 + Local_u8IdDigits + (Local_u8Remote ? 0 : 2 * Local_u8Dlc))
+    {
+        return N_OK;
+    }
+    pFrame->DLC = Local_u8Dlc;
+    if(!Local_u8Remote)
+    {
+        pLine += 2 + Local_u8IdDigits;
+        for(Local_u8Itr=0;Local_u8Itr<Local_u8Dlc;Local_u8Itr++)
+        {
+            if(SLCAN_u8ParseHex(&pLine[2 * Local_u8Itr],2,&Local_u32Value) != OK)
+            {
+                return N_OK;
+            }
+            pFrame->Data.Bytes[Local_u8Itr] = (uint8)Local_u32Value;
+        }
+    }
+    return OK;
+}
+
+/******************************************************************************
+* \Description     : execute the command line collected in SLCAN_Line and queue its answer
+*******************************************************************************/
+static void SLCAN_VoidExecute(void)
+{
+    static const uint8 Local_Ok[1] = {SLCAN_CR};
+    static const uint8 Local_Error[1] = {SLCAN_BELL};
+    static const uint8 Local_StdQueued[2] = {'z', SLCAN_CR};
+    static const uint8 Local_ExtQueued[2] = {'Z', SLCAN_CR};
+    static const uint8 Local_Version[] = SLCAN_VERSION "\r";
+    static const uint8 Local_Serial[] = SLCAN_SERIAL_NUMBER "\r";
+    uint8 Local_Flags[4];
+    CAN_Frame_t Local_Frame;
+    CAN_RxRingStatus_t Local_Ring;
+    uint32 Local_u32Overruns;
+    uint8 Local_u8Mode;
+
+    if(SLCAN_LineOverflow != 0 || SLCAN_LineLength == 0)
+    {
+        /*an empty line only resynchronizes the host*/
+        if(SLCAN_LineOverflow != 0)
+        {
+            SLCAN_Status.CommandErrors++;
+            SLCAN_VoidReply(Local_Error,1);
+        }
+        else
+        {
+            SLCAN_VoidReply(Local_Ok,1);
+        }
+        return;
+    }
+
+    switch(SLCAN_Line[0])
+    {
+    case 't':
+    case 'T':
+    case 'r':
+    case 'R':
+        if(SLCAN_State != SLCAN_OPEN || SLCAN_u8ParseFrame(SLCAN_Line,SLCAN_LineLength,&Local_Frame) != OK)
+        {
+            break;
+        }
+        if(MCAN_u8TransmitFrame(&Local_Frame) == CAN_TX_QUEUE_FULL)
+        {
+            SLCAN_Status.TxQueueFull++;
+            SLCAN_VoidReply(Local_Error,1);
+            return;
+        }
+        SLCAN_Status.FramesToCan++;
+        SLCAN_VoidReply(CAN_FRAME_IS_EXT(Local_Frame.Id) ? Local_ExtQueued : Local_StdQueued,2);
+        return;
+
+    case 'S':
+        if(SLCAN_State != SLCAN_CLOSED || SLCAN_LineLength != 2 || SLCAN_Line[1] < '0' || SLCAN_Line[1] > '8')
+        {
+            break;
+        }
+        SLCAN_BitrateIndex = (uint8)(SLCAN_Line[1] - '0');
+        SLCAN_VoidReply(Local_Ok,1);
+        return;
+
+    case 'O':
+    case 'L':
+        /*the CAN TX / SCE interrupts share the gateway priority (SLCAN_VoidInit), they cannot run in between*/
+        Local_u8Mode = (SLCAN_Line[0] == 'O') ? CAN_MODE_NORMAL : CAN_MODE_SILENT;
+        if(SLCAN_State != SLCAN_CLOSED || SLCAN_LineLength != 1 ||
+           MCAN_u8SetBitrate(SLCAN_BitrateTable[SLCAN_BitrateIndex],Local_u8Mode) != OK)
+        {
+            break;
+        }
+        MCAN_VoidStart();
+        SLCAN_State = (SLCAN_Line[0] == 'O') ? SLCAN_OPEN : SLCAN_LISTEN;
+        SLCAN_VoidReply(Local_Ok,1);
+        return;
+
+    case 'C':
+        if(SLCAN_State == SLCAN_CLOSED || SLCAN_LineLength != 1)
+        {
+            break;
+        }
+        MCAN_VoidStop();
+        SLCAN_State = SLCAN_CLOSED;
+        SLCAN_VoidReply(Local_Ok,1);
+        return;
+
+    case 'F':
+        MCAN_VoidGetRxRingStatus(CAN_RX_FIFO0,&Local_Ring);
+        Local_u32Overruns = Local_Ring.SoftwareOverruns + Local_Ring.HardwareOverruns;
+        MCAN_VoidGetRxRingStatus(CAN_RX_FIFO1,&Local_Ring);
+        Local_u32Overruns += Local_Ring.SoftwareOverruns + Local_Ring.HardwareOverruns;
+        Local_Flags[1] = 0;
+        if(Local_u32Overruns != SLCAN_LastOverruns)
+        {
+            Local_Flags[1] |= SLCAN_FLAG_OVERRUN;
+            SLCAN_LastOverruns = Local_u32Overruns;
+        }
+        if(MCAN_u8TxQueueCount() >= CAN_TX_QUEUE_SIZE)
+        {
+            Local_Flags[1] |= SLCAN_FLAG_TX_FULL;
+        }
+        Local_Flags[0] = 'F';
+        Local_Flags[2] = SLCAN_HexTable[Local_Flags[1]][1];
+        Local_Flags[1] = SLCAN_HexTable[Local_Flags[1]][0];
+        Local_Flags[3] = SLCAN_CR;
+        SLCAN_VoidReply(Local_Flags,4);
+        return;
+
+    case 'V':
+        SLCAN_VoidReply(Local_Version,sizeof(Local_Version) - 1);
+        return;
+
+    case 'N':
+        SLCAN_VoidReply(Local_Serial,sizeof(Local_Serial) - 1);
+        return;
+
+    default:
+        /*s (BTR values), Z (time stamps), X (auto poll), filters: not supported*/
+        break;
+    }
+    SLCAN_Status.CommandErrors++;
+    SLCAN_VoidReply(Local_Error,1);
+}
+
+/******************************************************************************
+* \Description     : parse the characters DMA channel 5 wrote since the last call. Runs on half / complete
+*                    transfer, on idle line and after every TX buffer. A line ending while the TX buffer
+*                    cannot take its answer is left for the next call
+*******************************************************************************/
+static void SLCAN_VoidRxParse(void)
+{
+    uint16 Local_u16Head = (uint16)(SLCAN_RX_BUFFER_SIZE - MDMA_u16GetRemaining(SLCAN_DMA_RX_CHANNEL));
+    uint8 Local_u8Char;
+
+    if(Local_u16Head >= SLCAN_RX_BUFFER_SIZE)
+    {
+        Local_u16Head = 0;
+    }
+    while(SLCAN_RxTail != Local_u16Head)
+    {
+        Local_u8Char = SLCAN_RxBuffer[SLCAN_RxTail];
+        if(Local_u8Char == SLCAN_CR)
+        {
+            if(SLCAN_TxFill > SLCAN_TX_BUFFER_SIZE - SLCAN_REPLY_MAX)
+            {
+                break;
+            }
+            SLCAN_VoidExecute();
+            SLCAN_LineLength = 0;
+            SLCAN_LineOverflow = 0;
+        }
+        else if(Local_u8Char == '\n')
+        {
+            /*some hosts end lines with CR LF*/
+        }
+        else if(SLCAN_LineLength < SLCAN_LINE_MAX)
+        {
+            SLCAN_Line[SLCAN_LineLength++] = Local_u8Char;
+        }
+        else
+        {
+            SLCAN_LineOverflow = 1;
+        }
+        SLCAN_RxTail = (SLCAN_RxTail + 1 == SLCAN_RX_BUFFER_SIZE) ? 0 : SLCAN_RxTail + 1;
+    }
+}
+
+/******************************************************************************
+* \Description     : run every path of the gateway: send the filled buffer, answer the pending commands,
+*                    encode the waiting frames and send them if the channel is still idle.
+*                    Callback of the CAN FMP notifications and of the DMA / USART interrupts
+*******************************************************************************/
+static void SLCAN_VoidPump(void)
+{
+    SLCAN_VoidTxKick();
+    SLCAN_VoidRxParse();
+    SLCAN_VoidEncodeFrames();
+    SLCAN_VoidTxKick();
+}
+
+/******************************************************************************
+* \Description     : DMA channel 4 complete: the buffer in flight is free again
+*******************************************************************************/
+static void SLCAN_VoidTxComplete(void)
+{
+    SLCAN_TxBusy = 0;
+    SLCAN_VoidPump();
+}
+
+/*---------------------------------------------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+---------------------------------------------------------------------------------------------------------------------*/
+/******************************************************************************
+* \Syntax          : void SLCAN_VoidInit(void)
+* \Description     : set up USART1, DMA1 channels 4 / 5, the RX rings and the notifications of the gateway
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : None
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void SLCAN_VoidInit(void)
+{
+    DMA_InitTypeDef Local_Dma;
+
+    MRCC_voidEnableClock(RCC_AHB,_PERIPHERAL_EN_DMA1EN);
+    MUSART1_voidInit();
+    MUSART1_VoidSetBaudRate(SLCAN_BAUDRATE);
+
+    /*TX: memory to DR byte by byte, started for each buffer by SLCAN_VoidTxKick*/
+    Local_Dma.Peripheral = DMA_PERIPHERAL_USART1_TX;
+    Local_Dma.DMA_Peripheral_address = (uint32*)&USART_DR;
+    Local_Dma.DMA_Memory_address = (uint32*)SLCAN_TxBuffer[0];
+    Local_Dma.DMA_Data_Number = 0;
+    Local_Dma.DMA_Channel_Priority = DMA_PRIORITY_HIGH;
+    Local_Dma.DMA_Mem2MemMode = DMA_DISABLE;
+    Local_Dma.DMA_Direction = DMA_DIRECTION_READ_FROM_MEMORY;
+    Local_Dma.DMA_CircularMode = DMA_DISABLE;
+    Local_Dma.DMA_PERIPHERAL_PTR_INC = DMA_DISABLE;
+    Local_Dma.DMA_MEMORY_PTR_INC = DMA_ENABLE;
+    Local_Dma.DMA_PERIPHERAL_Data_Size = DMA_SIZE_8_BIT;
+    Local_Dma.DMA_MEMORY_Data_Size = DMA_SIZE_8_BIT;
+    MDMA_VoidChannelInit(&Local_Dma);
+    MDMA_VoidDisableChannel(SLCAN_DMA_TX_CHANNEL);
+    MDMA_VoidEnableInterrupt(SLCAN_DMA_TX_CHANNEL,DMA_INTERRUPT_COMPLETE_TRANSMISSION,SLCAN_VoidTxComplete);
+
+    /*RX: DR to the circular buffer, runs forever; the parser follows the DMA position*/
+    Local_Dma.Peripheral = DMA_PERIPHERAL_USART1_RX;
+    Local_Dma.DMA_Memory_address = (uint32*)SLCAN_RxBuffer;
+    Local_Dma.DMA_Data_Number = SLCAN_RX_BUFFER_SIZE;
+    Local_Dma.DMA_Direction = DMA_DIRECTION_READ_FROM_PERIPHERAL;
+    Local_Dma.DMA_CircularMode = DMA_ENABLE;
+    MDMA_VoidChannelInit(&Local_Dma);
+    MDMA_VoidEnableInterrupt(SLCAN_DMA_RX_CHANNEL,DMA_INTERRUPT_HALF_TRANSMISSION,SLCAN_VoidPump);
+    MDMA_VoidEnableInterrupt(SLCAN_DMA_RX_CHANNEL,DMA_INTERRUPT_COMPLETE_TRANSMISSION,SLCAN_VoidPump);
+    MUSART1_VoidEnableIdleInterrupt(SLCAN_VoidPump);
+
+    MUSART1_VoidEnableDMATransmission();
+    MUSART1_VoidEnableDMAReception();
+
+    /*CAN side: the RX interrupts drain the FIFOs into the rings, the notification encodes the batch*/
+    MCAN_VoidEnableRxRing(CAN_RX_FIFO0);
+    MCAN_VoidEnableRxRing(CAN_RX_FIFO1);
+    MCAN_VoidEnableNotifications(RX_FIFO0_FMP,SLCAN_VoidPump);
+    MCAN_VoidEnableNotifications(RX_FIFO1_FMP,SLCAN_VoidPump);
+
+    MUSART1_voidEnable();
+}
+
+/******************************************************************************
+* \Syntax          : void SLCAN_VoidGetStatus(SLCAN_Status_t* pStatus)
+* \Description     : read the gateway counters
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Reentrant
+* \Parameters (in) : None
+* \Parameters (out): pStatus counters
+* \Return value:   : None
+*******************************************************************************/
+void SLCAN_VoidGetStatus(SLCAN_Status_t* pStatus)
+{
+    *pStatus = SLCAN_Status;
+}
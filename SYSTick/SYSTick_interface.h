@@ -18,9 +18,9 @@
 ---------------------------------------------------------------------------------------------------------------------*/
 #include "../../LIB//Std_Types.h"
 #include "../../LIB//Bit_Math.h"
-#include "SYSTICK_config.h"
+#include "SYSTick_config.h"
 
-#include "SYSTICK_private.h"
+#include "SYSTick_private.h"
 
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL DATA TYPES AND STRUCTURES
@@ -98,4 +98,27 @@ uint32 MSYSTICK_u32GetTick();
 *******************************************************************************/
 uint32 MSYSTICK_VoidDelay(uint32 Delay);
 
+/******************************************************************************
+* \Syntax          : void MSYSTICK_VoidEnableCycleCounter(void)                                      
+* \Description     : start the DWT cycle counter (HCLK cycles) that MSYSTICK_u64GetCycles extends to 64 bits.
+*                    The extension is kept by the SysTick interrupt: SysTick must run with a period below
+*                    2^31 HCLK cycles (29 s at 72 MHz)                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : None                    
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MSYSTICK_VoidEnableCycleCounter(void);
+/******************************************************************************
+* \Syntax          : uint64 MSYSTICK_u64GetCycles(void)                                      
+* \Description     : HCLK cycles since MSYSTICK_VoidEnableCycleCounter, monotonic 64-bit system time base.
+*                    Lock free, callable from any interrupt priority                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Reentrant                                             
+* \Parameters (in) : None                    
+* \Parameters (out): None                                                      
+* \Return value:   : uint64 cycles
+*******************************************************************************/
+uint64 MSYSTICK_u64GetCycles(void);
 #endif
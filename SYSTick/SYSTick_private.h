@@ -46,6 +46,13 @@ typedef union
 #define     STK_VAL         ((volatile uint32*)0xE000E018)
 #define     STK_CALIB       ((volatile uint32*)0xE000E01C)
 
+/*DWT cycle counter, counts HCLK cycles once trace is enabled in DEMCR*/
+#define     SCB_DEMCR       ((volatile uint32*)0xE000EDFC)
+#define     DWT_CTRL        ((volatile uint32*)0xE0001000)
+#define     DWT_CYCCNT      ((volatile uint32*)0xE0001004)
+#define     DEMCR_TRCENA            ((uint32)1 << 24)
+#define     DWT_CTRL_CYCCNTENA      ((uint32)1 << 0)
+
 
 
 #endif
@@ -20,6 +20,9 @@
  *  GLOBAL DATA
 ---------------------------------------------------------------------------------------------------------------------*/
 static void (*SysTick_CallBack)(void) = NULL;
+/*half periods (2^31 cycles) of the cycle counter seen by the SysTick interrupt, bit 0 is the msb of CYCCNT*/
+static volatile uint32 SysTick_CycleHalfPeriods = 0;
+static uint8 SysTick_CycleCounterEnabled = 0;
 
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL FUNCTION IMPLEMENTION
@@ -113,9 +116,52 @@ uint32 MSYSTICK_VoidDelay(uint32 Delay)
     while(MSYSTICK_u32GetTick()>start_time-Delay);
 }
 
+/******************************************************************************
+* \Syntax          : void MSYSTICK_VoidEnableCycleCounter(void)                                      
+* \Description     : start the DWT cycle counter (HCLK cycles) that MSYSTICK_u64GetCycles extends to 64 bits                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Non Reentrant                                             
+* \Parameters (in) : None                    
+* \Parameters (out): None                                                      
+* \Return value:   : None
+*******************************************************************************/
+void MSYSTICK_VoidEnableCycleCounter(void)
+{
+    (*SCB_DEMCR) |= DEMCR_TRCENA;
+    (*DWT_CYCCNT) = 0U;
+    (*DWT_CTRL) |= DWT_CTRL_CYCCNTENA;
+    SysTick_CycleHalfPeriods = 0;
+    SysTick_CycleCounterEnabled = 1;
+}
+/******************************************************************************
+* \Syntax          : uint64 MSYSTICK_u64GetCycles(void)                                      
+* \Description     : HCLK cycles since MSYSTICK_VoidEnableCycleCounter                                                                             
+* \Sync\Async      : Synchronous                                               
+* \Reentrancy      : Reentrant                                             
+* \Parameters (in) : None                    
+* \Parameters (out): None                                                      
+* \Return value:   : uint64 cycles
+*******************************************************************************/
+uint64 MSYSTICK_u64GetCycles(void)
+{
+    /*one word written by the SysTick interrupt only: no lock. CYCCNT can be at most one half period
+      ahead of it, seen as a different msb*/
+    uint32 Local_u32Half = SysTick_CycleHalfPeriods;
+    uint32 Local_u32Count = (*DWT_CYCCNT);
+
+    if((Local_u32Count >> 31) != (Local_u32Half & 1U))
+    {
+        Local_u32Half++;
+    }
+    return ((uint64)Local_u32Half << 31) | (Local_u32Count & 0x7FFFFFFFUL);
+}
 /*SysTick Handler */ 
 void SysTick_Handler(void)
 {
+    if(SysTick_CycleCounterEnabled != 0 && ((*DWT_CYCCNT) >> 31) != (SysTick_CycleHalfPeriods & 1U))
+    {
+        SysTick_CycleHalfPeriods++;
+    }
     if(SysTick_CallBack != NULL)
     {
         SysTick_CallBack();
@@ -160,4 +160,28 @@ void MUSART1_VoidDisableDMATransmission(void);
 *******************************************************************************/
 void MUSART1_VoidDisableDMAReception(void);
 
+/******************************************************************************
+* \Syntax          : void MUSART1_VoidSetBaudRate(uint32 u32BaudRate)
+* \Description     : set BRR for the baud rate from the clock APB2 really runs at (16x oversampling),
+*                    for rates the BAUD_RATE table of UART_config.h does not hold
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : uint32 u32BaudRate baud rate in bit/s
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MUSART1_VoidSetBaudRate(uint32 u32BaudRate);
+
+/******************************************************************************
+* \Syntax          : void MUSART1_VoidEnableIdleInterrupt(void (*pCallback)(void))
+* \Description     : call pCallback from the USART1 interrupt when the RX line goes idle after a character,
+*                    the end of a burst received by DMA. The USART1 interrupt must be enabled in the NVIC
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pCallback function called on every idle line
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MUSART1_VoidEnableIdleInterrupt(void (*pCallback)(void));
+
 #endif
@@ -19,6 +19,11 @@
 #include "../../LIB/Bit_Math.h"
 #include "../AFIO/AFIO_interface.h"
 #include "../GPIO/GPIO_interface.h"
+/*---------------------------------------------------------------------------------------------------------------------
+ *  LOCAL DATA
+---------------------------------------------------------------------------------------------------------------------*/
+static void (*USART1_pIdleCallback)(void) = NULL;
+
 /*---------------------------------------------------------------------------------------------------------------------
  *  GLOBAL FUNCTION IMPLEMENTION
 ---------------------------------------------------------------------------------------------------------------------*/ 
@@ -266,3 +271,47 @@ void MUSART1_VoidDisableDMAReception(void)
 {
     USART_CR3.B.DMAR=0;
 }
+
+/******************************************************************************
+* \Syntax          : void MUSART1_VoidSetBaudRate(uint32 u32BaudRate)
+* \Description     : set BRR for the baud rate from the clock APB2 really runs at (16x oversampling)
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : uint32 u32BaudRate baud rate in bit/s
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MUSART1_VoidSetBaudRate(uint32 u32BaudRate)
+{
+    /*mantissa << 4 | fraction is PCLK2 / baud rate in 1/16 steps, rounded*/
+    USART_BRR = (MRCC_u32GetPclk2Hz() + u32BaudRate / 2) / u32BaudRate;
+}
+
+/******************************************************************************
+* \Syntax          : void MUSART1_VoidEnableIdleInterrupt(void (*pCallback)(void))
+* \Description     : call pCallback from the USART1 interrupt when the RX line goes idle
+* \Sync\Async      : Synchronous
+* \Reentrancy      : Non Reentrant
+* \Parameters (in) : pCallback function called on every idle line
+* \Parameters (out): None
+* \Return value:   : None
+*******************************************************************************/
+void MUSART1_VoidEnableIdleInterrupt(void (*pCallback)(void))
+{
+    USART1_pIdleCallback = pCallback;
+    USART_CR1.B.IDLEIE = 1;
+}
+
+/******************************interrupt handlers************************ */
+void USART1_IRQHandler(void)
+{
+    if(USART_CR1.B.IDLEIE == 1 && USART_SR.B.IDLE == 1)
+    {
+        /*IDLE is cleared by reading SR then DR, with DMA reception DR holds no new character*/
+        (void)USART_DR;
+        if(USART1_pIdleCallback != NULL)
+        {
+            USART1_pIdleCallback();
+        }
+    }
+}